@@ -1,103 +1,104 @@
 #!/usr/bin/env python3
 
 import argparse
-import json
 import os
-import signal
-import time
-import multiprocessing
+import subprocess
 from pathlib import Path
+from typing import Optional
 
 from tools import version_config
 
 
-def SignalHandler(sig, frame):
-    print(f'Signal {sig} received. Aborting...')
-    mainAbort.set()
-    # Don't exit immediately to update the extracted assets file.
-
-def ExtractFile(assetConfig: version_config.AssetConfig, outputPath: Path, outputSourcePath: Path):
+def GetJobArgs(versionConfig: version_config.VersionConfig, assetConfig: version_config.AssetConfig, outputDir: Path) -> str:
     name = assetConfig.name
     xmlPath = assetConfig.xml_path
-    version = globalVersionConfig.version
-    if globalAbort.is_set():
-        # Don't extract if another file wasn't extracted properly.
-        return
 
-    zapdPath = Path("tools") / "ZAPD" / "ZAPD.out"
-    configPath = Path("tools") / "ZAPDConfigs" / version / "Config.xml"
+    outputPath = outputDir / name
+    outputSourcePath = outputPath
 
     outputPath.mkdir(parents=True, exist_ok=True)
     outputSourcePath.mkdir(parents=True, exist_ok=True)
 
-    execStr = f"{zapdPath} e -eh -i {xmlPath} -b {globalBaseromSegmentsDir} -o {outputPath} -osf {outputSourcePath} -gsf 1 -rconf {configPath} --cs-float both {ZAPDArgs}"
+    jobArgs = f"-i {xmlPath} -o {outputPath} -osf {outputSourcePath}"
 
     if name.startswith("code/") or name.startswith("n64dd/") or name.startswith("overlays/"):
         assert assetConfig.start_offset is not None
         assert assetConfig.end_offset is not None
 
-        execStr += f" --start-offset 0x{assetConfig.start_offset:X}"
-        execStr += f" --end-offset 0x{assetConfig.end_offset:X}"
+        jobArgs += f" --start-offset 0x{assetConfig.start_offset:X}"
+        jobArgs += f" --end-offset 0x{assetConfig.end_offset:X}"
 
     if name.startswith("overlays/"):
         overlayName = name.split("/")[1]
-        baseAddress = globalVersionConfig.dmadata_segments[overlayName].vram + assetConfig.start_offset
+        baseAddress = versionConfig.dmadata_segments[overlayName].vram + assetConfig.start_offset
+
+        jobArgs += f" --base-address 0x{baseAddress:X}"
+        jobArgs += " --static"
 
-        execStr += f" --base-address 0x{baseAddress:X}"
-        execStr += " --static"
+    return jobArgs
 
-    if globalUnaccounted:
+def ExtractAssets(versionConfig: version_config.VersionConfig, assets: list, baseromSegmentsDir: Path, outputDir: Path, numCores: int, unaccounted: bool, cachePath: Optional[Path], contentStorePath: Optional[Path], pngProfile: str, incbin: bool, emitObjects: bool) -> bool:
+    """Extracts every asset with a single ZAPD process, which loads the config and the external XMLs only once.
+
+    If cachePath is given, ZAPD skips the assets whose inputs (XML, baserom files, external XMLs, config and ZAPD build) didn't change since they were extracted.
+    If contentStorePath is given, the PNGs and binary files already extracted for another version are linked from there instead of being generated again.
+    pngProfile selects how ZAPD compresses the PNGs, see `--png-profile` in its README.
+    If incbin is set, the textures and blobs are included in the C files with `.incbin`, see `--incbin` in the README of ZAPD.
+    If emitObjects is set, an object file is written next to every C file, see `--emit-objects` in the README of ZAPD."""
+    version = versionConfig.version
+
+    zapdPath = Path("tools") / "ZAPD" / "ZAPD.out"
+    configPath = Path("tools") / "ZAPDConfigs" / version / "Config.xml"
+    inputListPath = outputDir / "zapd_input_list.txt"
+
+    with inputListPath.open("w", encoding="utf-8") as f:
+        for assetConfig in assets:
+            f.write(GetJobArgs(versionConfig, assetConfig, outputDir) + "\n")
+
+    execStr = f"{zapdPath} e -eh -b {baseromSegmentsDir} -gsf 1 -rconf {configPath} --cs-float both -j {numCores} -il {inputListPath} {ZAPDArgs}"
+
+    if unaccounted:
         execStr += " -Wunaccounted"
 
+    if cachePath is not None:
+        execStr += f" -ec {cachePath}"
+
+    if contentStorePath is not None:
+        execStr += f" -cs {contentStorePath}"
+
+    execStr += f" --png-profile {pngProfile}"
+
+    # ZAPD's own files are kept next to the asset tree, not in it: the Makefile builds every .bin file under it as a blob
+    zapdDataDir = outputDir.parent
+
+    # The external XMLs (gameplay_keep, ...) are loaded from their snapshot instead of being parsed every time
+    execStr += f" -xs {zapdDataDir / 'zapd_external_snapshots'}"
+
+    # The config is mapped from its compiled form, which ZAPD compiles again whenever a file of the config changes
+    execStr += f" --compiled-config {zapdDataDir / 'zapd_config.bin'}"
+
+    if incbin:
+        execStr += " --incbin"
+
+    if emitObjects:
+        execStr += " --emit-objects"
+
     print(execStr)
-    exitValue = os.system(execStr)
+    try:
+        exitValue = subprocess.call(execStr, shell=True)
+    except KeyboardInterrupt:
+        print("Interrupted. Aborting...")
+        return False
+
     if exitValue != 0:
-        globalAbort.set()
         print("\n")
-        print(f"Error when extracting from file {xmlPath}", file=os.sys.stderr)
+        print(f"Error when extracting the assets listed in {inputListPath}", file=os.sys.stderr)
         print("Aborting...", file=os.sys.stderr)
         print("\n")
+        return False
 
-def ExtractFunc(assetConfig: version_config.AssetConfig):
-    objectName = assetConfig.name
-    xml_path = assetConfig.xml_path
-    xml_path_str = str(xml_path)
-
-    outPath = globalOutputDir / objectName
-    outSourcePath = outPath
-
-    if xml_path_str in globalExtractedAssetsTracker:
-        timestamp = globalExtractedAssetsTracker[xml_path_str]["timestamp"]
-        modificationTime = int(os.path.getmtime(xml_path))
-        if modificationTime < timestamp:
-            # XML has not been modified since last extraction.
-            return
-
-    currentTimeStamp = int(time.time())
-
-    ExtractFile(assetConfig, outPath, outSourcePath)
-
-    if not globalAbort.is_set():
-        # Only update timestamp on successful extractions
-        if xml_path_str not in globalExtractedAssetsTracker:
-            globalExtractedAssetsTracker[xml_path_str] = globalManager.dict()
-        globalExtractedAssetsTracker[xml_path_str]["timestamp"] = currentTimeStamp
-
-def initializeWorker(versionConfig: version_config.VersionConfig, abort, unaccounted: bool, extractedAssetsTracker: dict, manager, baseromSegmentsDir: Path, outputDir: Path):
-    global globalVersionConfig
-    global globalAbort
-    global globalUnaccounted
-    global globalExtractedAssetsTracker
-    global globalManager
-    global globalBaseromSegmentsDir
-    global globalOutputDir
-    globalVersionConfig = versionConfig
-    globalAbort = abort
-    globalUnaccounted = unaccounted
-    globalExtractedAssetsTracker = extractedAssetsTracker
-    globalManager = manager
-    globalBaseromSegmentsDir = baseromSegmentsDir
-    globalOutputDir = outputDir
+    inputListPath.unlink()
+    return True
 
 def processZAPDArgs(argsZ):
     badZAPDArg = False
@@ -130,6 +131,10 @@ def main():
     parser.add_argument("-f", "--force", help="Force the extraction of every xml instead of checking the touched ones (overwriting current files).", action="store_true")
     parser.add_argument("-j", "--jobs", help="Number of cpu cores to extract with.")
     parser.add_argument("-u", "--unaccounted", help="Enables ZAPD unaccounted detector warning system.", action="store_true")
+    parser.add_argument("--content-store", type=Path, help="Directory of the outputs shared between the extractions of every version, which are linked instead of being generated again.")
+    parser.add_argument("--png-profile", choices=["default", "fast"], default="default", help="How ZAPD compresses the extracted PNGs. `fast` writes them about twice as fast, but bigger.")
+    parser.add_argument("--incbin", help="Include the textures and blobs in the C files with `.incbin` directives for asm_processor, instead of C arrays.", action="store_true")
+    parser.add_argument("--emit-objects", help="Write the object file of every extracted C file, which can be linked instead of compiling it.", action="store_true")
     parser.add_argument("-Z", help="Pass the argument on to ZAPD, e.g. `-ZWunaccounted` to warn about unaccounted blocks in XMLs. Each argument should be passed separately, *without* the leading dash.", metavar="ZAPD_ARG", action="append")
     args = parser.parse_args()
 
@@ -144,64 +149,36 @@ def main():
     global ZAPDArgs
     ZAPDArgs = processZAPDArgs(args.Z) if args.Z else ""
 
-    global mainAbort
-    mainAbort = multiprocessing.Event()
-    manager = multiprocessing.Manager()
-    signal.signal(signal.SIGINT, SignalHandler)
-
-    extraction_times_p = outputDir / "assets_extraction_times.json"
-    extractedAssetsTracker = manager.dict()
-    if extraction_times_p.exists() and not args.force:
-        with extraction_times_p.open(encoding='utf-8') as f:
-            extractedAssetsTracker.update(json.load(f, object_hook=manager.dict))
+    # ZAPD keeps track of what each asset was extracted from, and only extracts again the ones which changed
+    cachePath = outputDir / "zapd_extraction_cache.xml"
+    if args.force:
+        cachePath.unlink(missing_ok=True)
 
     singleAssetName = args.single
     if singleAssetName is not None:
-        assetConfig = None
         for asset in versionConfig.assets:
             if asset.name == singleAssetName:
-                assetConfig = asset
+                # Always extract if -s is used.
+                assets = [asset]
+                cachePath = None
                 break
         else:
             print(f"Error. Asset {singleAssetName} not found in config.", file=os.sys.stderr)
             exit(1)
-
-        initializeWorker(versionConfig, mainAbort, args.unaccounted, extractedAssetsTracker, manager, baseromSegmentsDir, outputDir)
-        # Always extract if -s is used.
-        xml_path_str = str(assetConfig.xml_path)
-        if xml_path_str in extractedAssetsTracker:
-            del extractedAssetsTracker[xml_path_str]
-        ExtractFunc(assetConfig)
     else:
-        class CannotMultiprocessError(Exception):
-            pass
-
-        try:
-            numCores = int(args.jobs or 0)
-            if numCores <= 0:
-                numCores = 1
-            print("Extracting assets with " + str(numCores) + " CPU core" + ("s" if numCores > 1 else "") + ".")
-            try:
-                mp_context = multiprocessing.get_context("fork")
-            except ValueError as e:
-                raise CannotMultiprocessError() from e
-            with mp_context.Pool(numCores, initializer=initializeWorker, initargs=(versionConfig, mainAbort, args.unaccounted, extractedAssetsTracker, manager, baseromSegmentsDir, outputDir)) as p:
-                p.map(ExtractFunc, versionConfig.assets)
-        except (multiprocessing.ProcessError, TypeError, CannotMultiprocessError):
-            print("Warning: Multiprocessing exception occurred.", file=os.sys.stderr)
-            print("Disabling mutliprocessing.", file=os.sys.stderr)
-
-            initializeWorker(versionConfig, mainAbort, args.unaccounted, extractedAssetsTracker, manager, baseromSegmentsDir, outputDir)
-            for assetConfig in versionConfig.assets:
-                ExtractFunc(assetConfig)
-
-    with extraction_times_p.open('w', encoding='utf-8') as f:
-        serializableDict = dict()
-        for xml, data in extractedAssetsTracker.items():
-            serializableDict[xml] = dict(data)
-        json.dump(dict(serializableDict), f, ensure_ascii=False, indent=4)
-
-    if mainAbort.is_set():
+        assets = versionConfig.assets
+
+    numCores = int(args.jobs or 0)
+    if numCores <= 0:
+        numCores = 1
+
+    success = True
+    if len(assets) != 0:
+        print(f"Extracting {len(assets)} asset" + ("s" if len(assets) > 1 else "") + " with " + str(numCores) + " CPU core" + ("s" if numCores > 1 else "") + ".")
+
+        success = ExtractAssets(versionConfig, assets, baseromSegmentsDir, outputDir, numCores, args.unaccounted, cachePath, args.content_store, args.png_profile, args.incbin, args.emit_objects)
+
+    if not success:
         exit(1)
 
 if __name__ == "__main__":
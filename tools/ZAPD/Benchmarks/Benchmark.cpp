@@ -0,0 +1,126 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+extern const char gBuildHash[];
+
+namespace
+{
+double GetElapsedNs(const std::function<void()>& func, uint64_t iterations)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < iterations; i++)
+		func();
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - start).count();
+}
+}  // namespace
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& nOptions) : options(nOptions)
+{
+	if (options.outputPath.empty())
+		output = stdout;
+	else
+		output = fopen(options.outputPath.string().c_str(), "w");
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+	if (output != nullptr && output != stdout)
+		fclose(output);
+}
+
+bool BenchmarkRunner::IsSelected(const std::string& name) const
+{
+	return name.find(options.filter) != std::string::npos;
+}
+
+void BenchmarkRunner::Run(const std::string& name, uint64_t operations, uint64_t bytes,
+                          const std::function<void()>& func, uint64_t outputBytes)
+{
+	if (!IsSelected("micro/" + name))
+		return;
+
+	const double minRunTimeNs = options.minRunTimeMs * 1e6;
+
+	// Also warms up the caches and whatever the first iteration initializes
+	uint64_t iterations = 1;
+	double elapsedNs = GetElapsedNs(func, iterations);
+	while (elapsedNs < minRunTimeNs)
+	{
+		double scale = elapsedNs > 0 ? 1.2 * minRunTimeNs / elapsedNs : 100.0;
+		iterations = static_cast<uint64_t>(iterations * std::clamp(scale, 2.0, 100.0));
+		elapsedNs = GetElapsedNs(func, iterations);
+	}
+
+	std::vector<double> samples;
+	for (uint32_t i = 0; i < options.runs; i++)
+		samples.push_back(GetElapsedNs(func, iterations) / (iterations * operations));
+	std::sort(samples.begin(), samples.end());
+
+	BenchmarkResult result;
+	result.suite = "micro";
+	result.name = name;
+	result.runs = options.runs;
+	result.iterations = iterations;
+	result.operations = operations;
+	result.bestNs = samples.front();
+	result.medianNs = samples[samples.size() / 2];
+	result.bytes = bytes;
+	result.outputBytes = outputBytes;
+	Report(result);
+}
+
+void BenchmarkRunner::Report(const BenchmarkResult& result)
+{
+	double iterationNs = result.bestNs * result.operations;
+	double mbPerS = result.bytes != 0 ? result.bytes * 1e3 / iterationNs : 0.0;
+
+	fprintf(output, "{\"suite\":\"%s\",\"name\":\"%s\",\"build\":\"%s\",\"runs\":%" PRIu32
+	        ",\"iterations\":%" PRIu64 ",\"operations\":%" PRIu64
+	        ",\"best_ns\":%.3f,\"median_ns\":%.3f,\"bytes\":%" PRIu64
+	        ",\"mb_per_s\":%.2f,\"output_bytes\":%" PRIu64 ",\"max_rss_kb\":%" PRIi64 "}\n",
+	        result.suite.c_str(), result.name.c_str(), gBuildHash, result.runs, result.iterations,
+	        result.operations, result.bestNs, result.medianNs, result.bytes, mbPerS,
+	        result.outputBytes, result.maxRssKb);
+	fflush(output);
+
+	if (result.bestNs >= 1e6)
+		fprintf(stderr, "%-8s %-48s %12.2f ms", result.suite.c_str(), result.name.c_str(),
+		        result.bestNs / 1e6);
+	else
+		fprintf(stderr, "%-8s %-48s %12.2f ns", result.suite.c_str(), result.name.c_str(),
+		        result.bestNs);
+	if (result.bytes != 0)
+		fprintf(stderr, " %10.1f MB/s", mbPerS);
+	if (result.outputBytes != 0)
+		fprintf(stderr, " %10" PRIu64 " B out", result.outputBytes);
+	if (result.maxRssKb >= 0)
+		fprintf(stderr, " %10" PRIi64 " KB", result.maxRssKb);
+	fprintf(stderr, "\n");
+
+	reportedCount++;
+}
+
+void BenchmarkRunner::Check(const std::string& name, const std::function<bool()>& func)
+{
+	if (!IsSelected("check/" + name))
+		return;
+
+	bool passed = func();
+
+	fprintf(output,
+	        "{\"suite\":\"check\",\"name\":\"%s\",\"build\":\"%s\",\"passed\":%s}\n",
+	        name.c_str(), gBuildHash, passed ? "true" : "false");
+	fflush(output);
+
+	fprintf(stderr, "%-8s %-48s %12s\n", "check", name.c_str(), passed ? "ok" : "FAILED");
+
+	reportedCount++;
+	if (!passed)
+		failedCount++;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Utils/Directory.h"
+
+struct BenchmarkOptions
+{
+	fs::path zapdPath = "ZAPD.out";
+	// Where the synthetic segments are generated and the pipeline benchmarks extract to
+	fs::path workDir = "build/bench";
+	// When set, the pipeline benchmarks extract the segments of an extracted baserom of this
+	// version of the game instead of the synthetic ones
+	fs::path gameRoot;
+	std::string version;
+	std::vector<std::string> xmlPaths;
+
+	// Where the results are written, stdout if empty
+	fs::path outputPath;
+	std::string filter;
+	uint32_t runs = 5;
+	double minRunTimeMs = 50.0;
+};
+
+struct BenchmarkResult
+{
+	std::string suite;
+	std::string name;
+	uint32_t runs = 0;
+	uint64_t iterations = 0;   // per run
+	uint64_t operations = 1;   // per iteration
+	double bestNs = 0;         // per operation
+	double medianNs = 0;       // per operation
+	uint64_t bytes = 0;        // processed per iteration, 0 if it doesn't apply
+	uint64_t outputBytes = 0;  // produced per iteration, 0 if it doesn't apply
+	int64_t maxRssKb = -1;     // of the extraction, for the pipeline benchmarks
+};
+
+/**
+ * Times benchmarks and prints their results, one JSON object per line on stdout or in the output
+ * file, so they can be collected and compared across commits. A human readable version is printed
+ * to stderr.
+ */
+class BenchmarkRunner
+{
+public:
+	const BenchmarkOptions options;
+
+	explicit BenchmarkRunner(const BenchmarkOptions& nOptions);
+	~BenchmarkRunner();
+
+	BenchmarkRunner(const BenchmarkRunner&) = delete;
+	BenchmarkRunner& operator=(const BenchmarkRunner&) = delete;
+
+	bool IsOutputOpen() const { return output != nullptr; }
+
+	bool IsSelected(const std::string& name) const;
+
+	/**
+	 * Calls `func` repeatedly for at least `minRunTimeMs` per run, `runs` times, and reports the
+	 * time of an operation. Each call does `operations` operations (lookups, display lists, ...)
+	 * and processes `bytes` bytes, and may produce `outputBytes` bytes (compressed files, ...).
+	 */
+	void Run(const std::string& name, uint64_t operations, uint64_t bytes,
+	         const std::function<void()>& func, uint64_t outputBytes = 0);
+
+	void Report(const BenchmarkResult& result);
+
+	/**
+	 * Runs `func`, which compares some code with a reference implementation of it, prints what
+	 * differs and returns false if anything does, and reports whether it passed.
+	 */
+	void Check(const std::string& name, const std::function<bool()>& func);
+
+	size_t GetReportedCount() const { return reportedCount; }
+	size_t GetFailedCount() const { return failedCount; }
+
+protected:
+	FILE* output = nullptr;
+	size_t reportedCount = 0;
+	size_t failedCount = 0;
+};
+
+/**
+ * Keeps the compiler from optimizing away the computation of `value`.
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Checks that the optimized code paths produce exactly what the code they replaced did, so the
+ * benchmarks only compare implementations that agree.
+ */
+void RunChecks(BenchmarkRunner& runner);
+
+/**
+ * Benchmarks of the hot functions of an extraction, on synthetic data generated in the work
+ * directory.
+ */
+void RunMicroBenchmarks(BenchmarkRunner& runner);
+
+/**
+ * Benchmarks of whole extractions done by `ZAPD.out`, from the XML to the source files, of
+ * either the synthetic segments or the representative XMLs of a game version.
+ * Returns false if an extraction failed.
+ */
+bool RunPipelineBenchmarks(BenchmarkRunner& runner);
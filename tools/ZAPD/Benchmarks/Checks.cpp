@@ -0,0 +1,1272 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <limits>
+#include <png.h>
+#include <random>
+#include <type_traits>
+
+#include "Crc32Reference.h"
+#include "ExtractionContext.h"
+#include "ImageBackend.h"
+#include "RangedLookupReference.h"
+#include "SyntheticSegments.h"
+#include "TextureCodec.h"
+#include "TextureFormats.h"
+#include "Utils/BitConverter.h"
+#include "Utils/Hash.h"
+#include "Utils/NumericEmitter.h"
+#include "Utils/StringHelper.h"
+#include "ZAnimation.h"
+#include "ZArray.h"
+#include "ZBackground.h"
+#include "ZBlob.h"
+#include "ZFile.h"
+#include "ZPlayerAnimationData.h"
+#include "ZSymbol.h"
+#include "ZTexture.h"
+#include "tinyxml2.h"
+
+namespace
+{
+std::string Escape(const std::string& text)
+{
+	std::string escaped;
+
+	for (char c : text)
+	{
+		if (c == '\n')
+			escaped += "\\n";
+		else if (c == '\t')
+			escaped += "\\t";
+		else
+			escaped += c;
+	}
+
+	return escaped;
+}
+
+/**
+ * Prints where `actual` starts to differ from `expected`, if it does.
+ */
+bool CompareText(const std::string& what, const std::string& actual, const std::string& expected)
+{
+	if (actual == expected)
+		return true;
+
+	size_t length = std::min(actual.size(), expected.size());
+	size_t i = std::mismatch(actual.begin(), actual.begin() + length, expected.begin()).first -
+	           actual.begin();
+	size_t start = i > 40 ? i - 40 : 0;
+
+	fprintf(stderr, "%s differs at character %zu:\n  got:      \"%s\"\n  expected: \"%s\"\n",
+	        what.c_str(), i, Escape(actual.substr(start, 80)).c_str(),
+	        Escape(expected.substr(start, 80)).c_str());
+	return false;
+}
+
+/* NumericEmitter */
+
+template <typename T>
+T GetRandomNumber(std::mt19937_64& random, size_t index)
+{
+	// The edge cases first, then numbers of every length
+	switch (index)
+	{
+	case 0:
+		return 0;
+	case 1:
+		return std::numeric_limits<T>::min();
+	case 2:
+		return std::numeric_limits<T>::max();
+	case 3:
+		return static_cast<T>(-1);
+	}
+
+	uint64_t value = random() >> (random() % 64);
+	return static_cast<T>(random() % 2 != 0 ? 0 - value : value);
+}
+
+/**
+ * What `NumericEmitter::Array` writes, formatted with `printf` one number at a time.
+ */
+template <typename T>
+std::string FormatArray(const std::vector<T>& values, const NumericArrayLayout& layout)
+{
+	std::string output;
+	size_t perLine = layout.perLine != 0 ? layout.perLine : values.size();
+
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		size_t column = i % perLine;
+		T value = values[i];
+
+		if (column == 0)
+			output += layout.lineStart;
+
+		switch (layout.format)
+		{
+		case NumericArrayLayout::Format::Decimal:
+			if constexpr (std::is_signed_v<T>)
+				StringHelper::AppendFormat(output, "%*lli", layout.width,
+				                           static_cast<long long>(value));
+			else
+				StringHelper::AppendFormat(output, "%*llu", layout.width,
+				                           static_cast<unsigned long long>(value));
+			break;
+
+		case NumericArrayLayout::Format::SignedHex:
+			if constexpr (std::is_signed_v<T>)
+			{
+				if (value < 0)
+				{
+					StringHelper::AppendFormat(output, "-0x%0*llX", layout.width,
+					                           0ULL - static_cast<unsigned long long>(value));
+					break;
+				}
+			}
+			[[fallthrough]];
+
+		case NumericArrayLayout::Format::Hex:
+			StringHelper::AppendFormat(
+				output, "0x%0*llX", layout.width,
+				static_cast<unsigned long long>(static_cast<std::make_unsigned_t<T>>(value)));
+			break;
+		}
+
+		output += ", ";
+
+		if (column == perLine - 1)
+		{
+			if (layout.offsetComments)
+				StringHelper::AppendFormat(output, " // 0x%06X",
+				                           static_cast<uint32_t>(layout.baseOffset +
+				                                                 (i - column) * sizeof(T)));
+
+			if (layout.endLastLine || i + 1 < values.size())
+				output += layout.lineEnd;
+		}
+	}
+
+	return output;
+}
+
+/**
+ * Writes arrays of every length in every layout, with `Array` and with `ArrayBE` from the
+ * big-endian bytes followed by a byte too short to be a number, after some existing text.
+ */
+template <typename T>
+bool CheckArrayLayouts(std::mt19937_64& random, const char* typeName)
+{
+	const NumericArrayLayout::Format formats[] = {NumericArrayLayout::Format::Hex,
+	                                              NumericArrayLayout::Format::SignedHex,
+	                                              NumericArrayLayout::Format::Decimal};
+	const int widths[] = {0, 1, 2, 4, 6, 8, 16, 24};
+	const size_t lineLengths[] = {0, 1, 4, 7, 8, 14, 16};
+
+	for (NumericArrayLayout::Format format : formats)
+	{
+		for (int width : widths)
+		{
+			for (size_t perLine : lineLengths)
+			{
+				for (uint32_t variant = 0; variant < 8; variant++)
+				{
+					NumericArrayLayout layout;
+					layout.format = format;
+					layout.width = width;
+					layout.perLine = perLine;
+					layout.lineStart = (variant & 1) != 0 ? "\t" : "";
+					layout.lineEnd = (variant & 1) != 0 ? "\n    " : " \n";
+					layout.endLastLine = (variant & 2) != 0;
+					layout.offsetComments = (variant & 4) != 0;
+					layout.baseOffset = random() % 0x1000000;
+
+					std::vector<T> values(random() % 48);
+					std::vector<uint8_t> bytes;
+					for (size_t i = 0; i < values.size(); i++)
+					{
+						values[i] = GetRandomNumber<T>(random, i);
+						for (size_t b = sizeof(T); b > 0; b--)
+							bytes.push_back(static_cast<uint64_t>(values[i]) >> ((b - 1) * 8));
+					}
+					if (sizeof(T) > 1)
+						bytes.push_back(random());
+
+					std::string expected = "{\n" + FormatArray(values, layout);
+					std::string actual = "{\n";
+					std::string actualBE = "{\n";
+					NumericEmitter(actual).Array(values.data(), values.size(), layout);
+					NumericEmitter(actualBE).ArrayBE<T>(bytes, layout);
+
+					std::string what = StringHelper::Sprintf(
+						"%s array of %zu, format %i, width %i, %zu per line, variant %u",
+						typeName, values.size(), static_cast<int>(format), width, perLine,
+						variant);
+					if (!CompareText("Array of " + what, actual, expected) ||
+					    !CompareText("ArrayBE of " + what, actualBE, expected))
+						return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool CheckNumbers()
+{
+	std::mt19937_64 random(0x5A415044);
+
+	for (size_t i = 0; i < 200000; i++)
+	{
+		int64_t value = GetRandomNumber<int64_t>(random, i);
+		int width = random() % 24;
+		std::string actual;
+		NumericEmitter emitter(actual);
+
+		emitter.Hex(value, width);
+		emitter.Decimal(value, width);
+		emitter.UnsignedDecimal(value, width);
+		emitter.OffsetComment(value);
+
+		std::string expected = StringHelper::Sprintf(
+			"0x%0*llX%*lli%*llu // 0x%06X", width, static_cast<unsigned long long>(value), width,
+			static_cast<long long>(value), width, static_cast<unsigned long long>(value),
+			static_cast<uint32_t>(value));
+		if (!CompareText(StringHelper::Sprintf("Numbers of width %i", width), actual, expected))
+			return false;
+	}
+
+	return true;
+}
+
+bool CheckNumericEmitter()
+{
+	std::mt19937_64 random(0x5A415044);
+
+	return CheckNumbers() && CheckArrayLayouts<uint8_t>(random, "u8") &&
+	       CheckArrayLayouts<int8_t>(random, "s8") && CheckArrayLayouts<uint16_t>(random, "u16") &&
+	       CheckArrayLayouts<int16_t>(random, "s16") &&
+	       CheckArrayLayouts<uint32_t>(random, "u32") &&
+	       CheckArrayLayouts<int32_t>(random, "s32") &&
+	       CheckArrayLayouts<uint64_t>(random, "u64") && CheckArrayLayouts<int64_t>(random, "s64");
+}
+
+/* Resource bodies */
+
+// The bodies of the resources as they were written before `NumericEmitter`, with one `Sprintf`
+// per number
+
+std::string GetOldTextureBody(ByteSpan textureDataRaw, bool dWordAligned, offset_t rawDataIndex)
+{
+	std::string sourceOutput;
+	size_t texSizeInc = (dWordAligned) ? 8 : 4;
+
+	for (size_t i = 0; i < textureDataRaw.size(); i += texSizeInc)
+	{
+		if (i % 32 == 0)
+			sourceOutput += "    ";
+		if (dWordAligned)
+			sourceOutput += StringHelper::Sprintf(
+				"0x%016llX, ",
+				static_cast<unsigned long long>(BitConverter::ToUInt64BE(textureDataRaw, i)));
+		else
+			sourceOutput += StringHelper::Sprintf(
+				"0x%08llX, ",
+				static_cast<unsigned long long>(BitConverter::ToUInt32BE(textureDataRaw, i)));
+		if (i % 32 == 24)
+			sourceOutput += StringHelper::Sprintf(
+				" // 0x%06X \n", static_cast<uint32_t>(rawDataIndex + ((i / 32) * 32)));
+	}
+	sourceOutput += "\n";
+
+	return sourceOutput;
+}
+
+std::string GetOldBlobBody(ByteSpan blobData)
+{
+	std::string sourceOutput;
+
+	for (size_t i = 0; i < blobData.size(); i += 1)
+	{
+		if (i % 16 == 0)
+			sourceOutput += "\t";
+
+		sourceOutput += StringHelper::Sprintf("0x%02X, ", blobData[i]);
+
+		if (i % 16 == 15)
+			sourceOutput += "\n";
+	}
+	sourceOutput += "\n";
+
+	return sourceOutput;
+}
+
+std::string GetOldRotationValuesBody(ByteSpan data, offset_t offset, size_t count)
+{
+	std::string valuesStr = "    ";
+
+	for (size_t i = 0; i < count; i++)
+	{
+		valuesStr +=
+			StringHelper::Sprintf("0x%04X, ", BitConverter::ToUInt16BE(data, offset + i * 2));
+
+		if ((i + 1) % 14 == 0)
+			valuesStr += "\n    ";
+	}
+
+	return valuesStr;
+}
+
+std::string GetOldLegacyFrameDataBody(ByteSpan data, offset_t offset, size_t count)
+{
+	std::string frameDataBody = "\t";
+
+	for (size_t i = 0; i < count; i++)
+	{
+		frameDataBody +=
+			StringHelper::Sprintf("0x%04X, ", BitConverter::ToUInt16BE(data, offset + i * 2));
+
+		if (i % 8 == 7 && i + 1 < count)
+			frameDataBody += "\n\t";
+	}
+
+	return frameDataBody;
+}
+
+std::string GetOldPlayerAnimationDataBody(ByteSpan data)
+{
+	std::string declaration = "";
+
+	for (size_t index = 0; index < data.size() / 2; index++)
+	{
+		int16_t entry = BitConverter::ToInt16BE(data, index * 2);
+
+		if (index % 8 == 0)
+			declaration += "\t";
+
+		if (entry < 0)
+			declaration += StringHelper::Sprintf("-0x%04X, ", -entry);
+		else
+			declaration += StringHelper::Sprintf("0x%04X, ", entry);
+
+		if ((index + 1) % 8 == 0)
+			declaration += "\n";
+	}
+
+	return declaration;
+}
+
+std::string GetOldVtxBody(ByteSpan data, offset_t offset)
+{
+	return StringHelper::Sprintf(
+		"VTX(%i, %i, %i, %i, %i, %i, %i, %i, %i)", BitConverter::ToInt16BE(data, offset + 0),
+		BitConverter::ToInt16BE(data, offset + 2), BitConverter::ToInt16BE(data, offset + 4),
+		BitConverter::ToInt16BE(data, offset + 8), BitConverter::ToInt16BE(data, offset + 10),
+		data[offset + 12], data[offset + 13], data[offset + 14], data[offset + 15]);
+}
+
+std::string GetOldScalarBody(const std::string& type, ByteSpan data, offset_t offset)
+{
+	if (type == "s8")
+		return StringHelper::Sprintf("%hhd", static_cast<int8_t>(data[offset]));
+	if (type == "u8")
+		return StringHelper::Sprintf("%hhu", data[offset]);
+	if (type == "x8")
+		return StringHelper::Sprintf("0x%02X", data[offset]);
+	if (type == "s16")
+		return StringHelper::Sprintf("%hd", BitConverter::ToInt16BE(data, offset));
+	if (type == "u16")
+		return StringHelper::Sprintf("%hu", BitConverter::ToUInt16BE(data, offset));
+	if (type == "x16")
+		return StringHelper::Sprintf("0x%04X", BitConverter::ToUInt16BE(data, offset));
+	if (type == "s32")
+		return StringHelper::Sprintf("%d", BitConverter::ToInt32BE(data, offset));
+	if (type == "u32")
+		return StringHelper::Sprintf("%u", BitConverter::ToUInt32BE(data, offset));
+	if (type == "x32")
+		return StringHelper::Sprintf("0x%08X", BitConverter::ToUInt32BE(data, offset));
+	if (type == "s64")
+		return StringHelper::Sprintf(
+			"%lld", static_cast<long long>(BitConverter::ToInt64BE(data, offset)));
+	return StringHelper::Sprintf(
+		"%llu", static_cast<unsigned long long>(BitConverter::ToUInt64BE(data, offset)));
+}
+
+/**
+ * `ZArray`'s body, from the bodies of its elements.
+ */
+std::string GetOldArrayBody(const std::vector<std::string>& elements, bool isExternal)
+{
+	std::string output;
+
+	for (size_t i = 0; i < elements.size(); i++)
+	{
+		output += "\t" + elements[i];
+		if (i < elements.size() - 1 || isExternal)
+			output += ",\n";
+	}
+
+	return output;
+}
+
+std::string GetOldBackgroundBody(ByteSpan data)
+{
+	std::string bodyStr = "    ";
+
+	for (size_t i = 0; i < data.size() / 8; ++i)
+	{
+		bodyStr += StringHelper::Sprintf(
+			"0x%016llX, ",
+			static_cast<unsigned long long>(BitConverter::ToUInt64BE(data, i * 8)));
+
+		if (i % 8 == 7)
+			bodyStr += "\n    ";
+	}
+
+	bodyStr += "\n";
+
+	return bodyStr;
+}
+
+/**
+ * Returns the body of the declaration at the segmented address `ptr`, or a note that there is
+ * none, which won't match the expected body.
+ */
+std::string GetDeclarationBody(ZFile* file, uint32_t ptr)
+{
+	Declaration* decl = file->GetDeclaration(Seg2Filespace(ptr, file->baseAddress));
+	return decl != nullptr ? std::string(decl->declBody) : "(no declaration)";
+}
+
+/**
+ * Sets `actual` to the body of `res`, and returns what it used to be. Textures and backgrounds
+ * are checked as btex and bren write them: from the file `res` saves to `dir`.
+ */
+std::string GetOldResourceBody(ZResource* res, ByteSpan data, const fs::path& dir,
+                               std::string& actual)
+{
+	offset_t offset = res->GetRawDataIndex();
+	ByteSpan rawData = data.subspan(offset, res->GetRawDataSize());
+
+	actual = res->GetBodySourceCode();
+
+	ZTexture* texture = dynamic_cast<ZTexture*>(res);
+	if (texture != nullptr)
+	{
+		bool dWordAligned = offset % 8 == 0;
+		ZTexture built(nullptr);
+
+		texture->Save(dir);
+		built.dWordAligned = dWordAligned;
+		built.FromPNG(dir / (res->GetOutName() + (dWordAligned ? "" : ".u32") + "." +
+		                     res->GetExternalExtension() + ".png"),
+		              texture->GetTextureType());
+		actual = built.GetBodySourceCode();
+
+		// `FromPNG` pads the texture to a multiple of 8 bytes
+		std::vector<uint8_t> padded(rawData.begin(), rawData.end());
+		padded.resize((padded.size() + 7) & ~7);
+		return GetOldTextureBody(padded, dWordAligned, 0);
+	}
+
+	if (dynamic_cast<ZBlob*>(res) != nullptr)
+		return GetOldBlobBody(rawData);
+
+	if (dynamic_cast<ZBackground*>(res) != nullptr)
+	{
+		ZBackground built(nullptr);
+
+		res->Save(dir);
+		built.ParseBinaryFile((dir / (res->GetOutName() + "." + res->GetExternalExtension()))
+		                          .string(),
+		                      false);
+		actual = built.GetBodySourceCode();
+
+		// The JPEG, up to its end of image marker, padded to the size of the screen buffer
+		size_t size = 0;
+		while (BitConverter::ToUInt16BE(rawData, size) != 0xFFD9)
+			size++;
+		std::vector<uint8_t> padded(rawData.begin(), rawData.begin() + size + 2);
+		padded.resize(rawData.size());
+		return GetOldBackgroundBody(padded);
+	}
+
+	if (dynamic_cast<ZPlayerAnimationData*>(res) != nullptr)
+		return GetOldPlayerAnimationDataBody(rawData);
+
+	// The animations declare their frame data instead
+	if (dynamic_cast<ZNormalAnimation*>(res) != nullptr)
+	{
+		uint32_t valuesPtr = BitConverter::ToUInt32BE(rawData, 4);
+		uint32_t indicesPtr = BitConverter::ToUInt32BE(rawData, 8);
+
+		actual = GetDeclarationBody(res->parent, valuesPtr);
+		return GetOldRotationValuesBody(data, valuesPtr & 0xFFFFFF,
+		                                ((indicesPtr - valuesPtr) & 0xFFFFFF) / 2);
+	}
+
+	if (dynamic_cast<ZLegacyAnimation*>(res) != nullptr)
+	{
+		uint32_t frameDataPtr = BitConverter::ToUInt32BE(rawData, 4);
+		uint32_t jointKeyPtr = BitConverter::ToUInt32BE(rawData, 8);
+
+		actual = GetDeclarationBody(res->parent, frameDataPtr);
+		return GetOldLegacyFrameDataBody(data, frameDataPtr & 0xFFFFFF,
+		                                 ((jointKeyPtr - frameDataPtr) & 0xFFFFFF) / 2);
+	}
+
+	std::vector<std::string> elements;
+	ZArray* array = dynamic_cast<ZArray*>(res);
+
+	if (array != nullptr && res->GetName() == "gNumericVtxArray")
+	{
+		for (size_t i = 0; i < rawData.size() / 16; i++)
+			elements.push_back(GetOldVtxBody(data, offset + i * 16));
+		// `ZVtx` is an external resource, so even the last one is followed by a comma
+		return GetOldArrayBody(elements, true);
+	}
+
+	for (const std::string& type : SyntheticSegments::numericScalarTypes)
+	{
+		if (array == nullptr || res->GetName() != "gNumeric" + type + "Array")
+			continue;
+
+		size_t size = std::stoi(type.substr(1)) / 8;
+		for (size_t i = 0; i < rawData.size() / size; i++)
+			elements.push_back(GetOldScalarBody(type, data, offset + i * size));
+		return GetOldArrayBody(elements, false);
+	}
+
+	return "(unexpected resource)";
+}
+
+bool CheckResourceBodies(const fs::path& workDir)
+{
+	fs::path dir = fs::absolute(workDir) / "checks";
+	fs::create_directories(dir);
+
+	SyntheticSegment segment = SyntheticSegments::GenerateNumericArrays();
+	segment.Write(dir);
+
+	tinyxml2::XMLDocument doc;
+	doc.Parse(segment.xml.c_str());
+
+	ExtractionContext ctx;
+	tinyxml2::XMLElement* fileElement = doc.RootElement()->FirstChildElement("File");
+	ZFile* file = new ZFile(&ctx, ZFileMode::Extract, fileElement, dir, dir, "",
+	                        segment.GetXmlPath(dir));
+	ctx.files.push_back(file);
+
+	bool passed = !file->resources.empty();
+
+	for (ZResource* res : file->resources)
+	{
+		std::string actual;
+		std::string expected = GetOldResourceBody(res, segment.data, dir, actual);
+
+		passed &= CompareText("Body of " + res->GetName(), actual, expected);
+	}
+
+	return passed;
+}
+
+/* TextureCodec */
+
+/**
+ * Returns whether `buffer` holds `size` bytes equal to `expected` after its first byte, with
+ * `canary` around them.
+ */
+bool CompareRow(const std::vector<uint8_t>& buffer, const uint8_t* expected, size_t size,
+                uint8_t canary)
+{
+	auto isCanary = [canary](uint8_t b) { return b == canary; };
+
+	return buffer[0] == canary &&
+	       std::equal(buffer.begin() + 1, buffer.begin() + 1 + size, expected) &&
+	       std::all_of(buffer.begin() + 1 + size, buffer.end(), isCanary);
+}
+
+/**
+ * Converts random rows of every width up to a few times the widest kernel, so every tail length
+ * is covered, with every instruction set:
+ * - decoded rows must match the scalar decoder, and encode back to the texels they came from;
+ * - rows of random pixels of every layout a format accepts must encode like the scalar encoder.
+ * The rows start at odd addresses, and the bytes around them must be left alone.
+ */
+bool CheckTextureCodec()
+{
+	const TextureCodec::InstructionSet sets[] = {TextureCodec::InstructionSet::Scalar,
+	                                             TextureCodec::InstructionSet::SSE2,
+	                                             TextureCodec::InstructionSet::AVX2};
+	const size_t maxWidth = 200;
+	const size_t margin = 32;
+	const uint8_t canary = 0xA5;
+
+	std::mt19937 random(0x5A415044);
+	TextureCodec::InstructionSet bestSet = TextureCodec::GetInstructionSet();
+	bool passed = true;
+
+	for (const TextureFormat& format : gTextureFormats)
+	{
+		PixelLayout decodedLayout = TextureCodec::GetDecodedLayout(format.type);
+		std::vector<PixelLayout> layouts = {PixelLayout::Index};
+		if (decodedLayout != PixelLayout::Index)
+			layouts = {PixelLayout::RGB, PixelLayout::RGBA};
+
+		// 4-bit rows must be whole bytes
+		size_t widthStep = format.bitsPerTexel == 4 ? 2 : 1;
+
+		for (size_t width = widthStep; width <= maxWidth && passed; width += widthStep)
+		{
+			size_t texelSize = width * format.bitsPerTexel / 8;
+			size_t pixelSize = width * GetBytesPerPixel(decodedLayout);
+
+			std::vector<uint8_t> texelBuffer(1 + texelSize);
+			uint8_t* texels = &texelBuffer[1];
+			for (size_t i = 0; i < texelSize; i++)
+				texels[i] = random();
+
+			TextureCodec::SetInstructionSet(TextureCodec::InstructionSet::Scalar);
+
+			std::vector<uint8_t> expectedPixels(pixelSize);
+			TextureCodec::DecodeRow(format.type, texels, expectedPixels.data(), width);
+
+			std::vector<std::vector<uint8_t>> layoutPixels;
+			std::vector<std::vector<uint8_t>> expectedTexels;
+			for (PixelLayout layout : layouts)
+			{
+				std::vector<uint8_t> pixels(width * GetBytesPerPixel(layout));
+				for (uint8_t& pixel : pixels)
+					pixel = layout != PixelLayout::Index || format.bitsPerTexel == 8 ? random() :
+				                                                                      random() % 16;
+
+				expectedTexels.emplace_back(texelSize);
+				TextureCodec::EncodeRow(format.type, layout, pixels.data(),
+				                        expectedTexels.back().data(), width);
+				layoutPixels.push_back(std::move(pixels));
+			}
+
+			for (TextureCodec::InstructionSet set : sets)
+			{
+				if (!TextureCodec::IsSupported(set))
+					continue;
+
+				TextureCodec::SetInstructionSet(set);
+				std::string what = StringHelper::Sprintf(
+					"%s of %zu texels with %s", format.name, width,
+					TextureCodec::GetInstructionSetName(set));
+
+				std::vector<uint8_t> pixels(1 + pixelSize + margin, canary);
+				TextureCodec::DecodeRow(format.type, texels, &pixels[1], width);
+				if (!CompareRow(pixels, expectedPixels.data(), pixelSize, canary))
+				{
+					fprintf(stderr, "Decoding %s differs from the scalar decoder\n", what.c_str());
+					passed = false;
+				}
+
+				std::vector<uint8_t> roundTrip(1 + texelSize + margin, canary);
+				TextureCodec::EncodeRow(format.type, decodedLayout, &pixels[1], &roundTrip[1],
+				                        width);
+				if (!CompareRow(roundTrip, texels, texelSize, canary))
+				{
+					fprintf(stderr, "Decoding then encoding %s changes the texels\n",
+					        what.c_str());
+					passed = false;
+				}
+
+				for (size_t i = 0; i < layouts.size(); i++)
+				{
+					std::vector<uint8_t> src(1 + layoutPixels[i].size());
+					std::copy(layoutPixels[i].begin(), layoutPixels[i].end(), src.begin() + 1);
+
+					std::vector<uint8_t> encoded(1 + texelSize + margin, canary);
+					TextureCodec::EncodeRow(format.type, layouts[i], &src[1], &encoded[1], width);
+					if (!CompareRow(encoded, expectedTexels[i].data(), texelSize, canary))
+					{
+						fprintf(stderr,
+						        "Encoding %s from layout %i differs from the scalar encoder\n",
+						        what.c_str(), static_cast<int>(layouts[i]));
+						passed = false;
+					}
+				}
+			}
+		}
+	}
+
+	TextureCodec::SetInstructionSet(bestSet);
+	return passed;
+}
+
+/* ImageBackend */
+
+/**
+ * Returns whether the pixels of `image` are a single block aligned to 64 bytes, whose rows of
+ * `bytesPerPixel` bytes per pixel follow each other.
+ */
+bool CheckImageRows(const ImageBackend& image, size_t bytesPerPixel, const std::string& what)
+{
+	const uint8_t* pixels = image.GetPixels();
+	bool passed = reinterpret_cast<uintptr_t>(pixels) % 64 == 0 &&
+	              image.GetRowSize() == image.GetWidth() * bytesPerPixel;
+
+	for (size_t y = 0; y < image.GetHeight(); y++)
+		passed &= image.GetRow(y) == pixels + y * image.GetRowSize();
+
+	if (!passed)
+		fprintf(stderr, "The pixels of %s aren't contiguous rows aligned to 64 bytes\n",
+		        what.c_str());
+	return passed;
+}
+
+/**
+ * Compares the image `ReadPng` read with the pixels it should have, which are `layout`.
+ */
+bool CompareImage(const ImageBackend& image, uint32_t width, uint32_t height, PixelLayout layout,
+                  const std::vector<uint8_t>& expected, const std::string& what)
+{
+	if (image.GetWidth() != width || image.GetHeight() != height ||
+	    image.GetPixelLayout() != layout)
+	{
+		fprintf(stderr, "%s was read as a %ux%u image of layout %i instead of %ux%u and %i\n",
+		        what.c_str(), image.GetWidth(), image.GetHeight(),
+		        static_cast<int>(image.GetPixelLayout()), width, height, static_cast<int>(layout));
+		return false;
+	}
+
+	if (!CheckImageRows(image, GetBytesPerPixel(layout), what))
+		return false;
+
+	if (!std::equal(expected.begin(), expected.end(), image.GetPixels()))
+	{
+		fprintf(stderr, "The pixels of %s differ\n", what.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Writes `rows`, stored as PNG stores them, with libpng directly, so `ReadPng` can be checked on
+ * the color types and bit depths `WritePng` doesn't write.
+ */
+bool WriteRawPng(const fs::path& path, uint32_t width, uint32_t height, int colorType,
+                 int bitDepth, const std::vector<uint8_t>& rows,
+                 const std::vector<png_color>& palette)
+{
+	FILE* fp = fopen(path.string().c_str(), "wb");
+	if (fp == nullptr)
+	{
+		fprintf(stderr, "Couldn't open '%s'\n", path.string().c_str());
+		return false;
+	}
+
+	png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	png_infop info = png_create_info_struct(png);
+	size_t rowSize = rows.size() / height;
+
+	if (setjmp(png_jmpbuf(png)))
+	{
+		fprintf(stderr, "Couldn't write '%s'\n", path.string().c_str());
+		png_destroy_write_struct(&png, &info);
+		fclose(fp);
+		return false;
+	}
+
+	png_init_io(png, fp);
+	png_set_IHDR(png, info, width, height, bitDepth, colorType, PNG_INTERLACE_NONE,
+	             PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+	if (!palette.empty())
+		png_set_PLTE(png, info, palette.data(), palette.size());
+	png_write_info(png, info);
+	for (uint32_t y = 0; y < height; y++)
+		png_write_row(png, &rows[y * rowSize]);
+	png_write_end(png, nullptr);
+
+	png_destroy_write_struct(&png, &info);
+	fclose(fp);
+	return true;
+}
+
+/**
+ * Writes images of every layout and of odd sizes with `WritePng`, with every `PngEncodeProfile`,
+ * and reads them back, then reads PNGs of the other color types and bit depths btex accepts:
+ * grayscale (with and without alpha, 4 and 8-bit), 16-bit RGB(A) and 4-bit palettes. The pixels
+ * must be a single aligned block, with one byte per channel or palette index.
+ */
+bool CheckImageBackend(const fs::path& workDir)
+{
+	fs::path dir = fs::absolute(workDir) / "checks";
+	fs::create_directories(dir);
+
+	const uint32_t sizes[][2] = {{1, 1}, {3, 5}, {17, 9}, {64, 33}};
+	std::mt19937 random(0x5A415044);
+	bool passed = true;
+
+	for (const auto& [width, height] : sizes)
+	{
+		for (PixelLayout layout : {PixelLayout::RGB, PixelLayout::RGBA, PixelLayout::Index})
+		{
+			std::string what = StringHelper::Sprintf("a %ux%u image of layout %i", width, height,
+			                                         static_cast<int>(layout));
+			fs::path path = dir / StringHelper::Sprintf("image_%ux%u_%i.png", width, height,
+			                                            static_cast<int>(layout));
+			ImageBackend image;
+
+			if (layout == PixelLayout::Index)
+			{
+				image.InitEmptyPaletteImage(width, height);
+				for (size_t i = 0; i < 256; i++)
+					image.SetPaletteIndex(i, random(), random(), random(), random());
+			}
+			else
+				image.InitEmptyRGBImage(width, height, layout == PixelLayout::RGBA);
+
+			if (!CheckImageRows(image, GetBytesPerPixel(layout), what))
+			{
+				passed = false;
+				continue;
+			}
+
+			std::vector<uint8_t> expected(width * height * GetBytesPerPixel(layout));
+			for (uint8_t& byte : expected)
+				byte = random();
+			std::copy(expected.begin(), expected.end(), image.GetPixels());
+
+			// Every profile must store the same pixels
+			for (const std::string& profileName :
+			     StringHelper::Split(PngEncodeProfile::GetNames(), ", "))
+			{
+				PngEncodeProfile profile;
+				PngEncodeProfile::FromName(profileName, profile);
+				image.WritePng(path, profile);
+
+				ImageBackend read;
+				read.ReadPng(path);
+				passed &= CompareImage(read, width, height, layout, expected,
+				                       what + " written with the " + profileName + " profile");
+			}
+		}
+	}
+
+	struct RawPng
+	{
+		const char* name;
+		int colorType;
+		int bitDepth;
+		PixelLayout layout;
+	};
+
+	const RawPng rawPngs[] = {
+		{"gray4", PNG_COLOR_TYPE_GRAY, 4, PixelLayout::RGB},
+		{"gray8", PNG_COLOR_TYPE_GRAY, 8, PixelLayout::RGB},
+		{"gray_alpha8", PNG_COLOR_TYPE_GRAY_ALPHA, 8, PixelLayout::RGBA},
+		{"rgb16", PNG_COLOR_TYPE_RGB, 16, PixelLayout::RGB},
+		{"rgba16", PNG_COLOR_TYPE_RGBA, 16, PixelLayout::RGBA},
+		{"palette4", PNG_COLOR_TYPE_PALETTE, 4, PixelLayout::Index},
+	};
+
+	for (const auto& [width, height] : sizes)
+	{
+		for (const RawPng& rawPng : rawPngs)
+		{
+			std::string what = StringHelper::Sprintf("a %ux%u %s PNG", width, height, rawPng.name);
+			fs::path path = dir / StringHelper::Sprintf("raw_%ux%u_%s.png", width, height,
+			                                            rawPng.name);
+
+			// The samples of the PNG, and the bytes `ReadPng` should turn each into
+			size_t channels = 1;
+			if (rawPng.colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
+				channels = 2;
+			else if (rawPng.colorType == PNG_COLOR_TYPE_RGB)
+				channels = 3;
+			else if (rawPng.colorType == PNG_COLOR_TYPE_RGBA)
+				channels = 4;
+
+			size_t rowSize = (width * channels * rawPng.bitDepth + 7) / 8;
+			std::vector<uint8_t> rows(rowSize * height);
+			std::vector<uint8_t> expected;
+
+			for (uint32_t y = 0; y < height; y++)
+			{
+				for (uint32_t x = 0; x < width; x++)
+				{
+					std::vector<uint8_t> samples;
+
+					for (size_t c = 0; c < channels; c++)
+					{
+						uint8_t sample = random();
+						size_t sampleIndex = x * channels + c;
+
+						if (rawPng.bitDepth == 4)
+						{
+							sample &= 0x0F;
+							rows[y * rowSize + sampleIndex / 2] |=
+								sampleIndex % 2 == 0 ? sample << 4 : sample;
+							if (rawPng.colorType == PNG_COLOR_TYPE_GRAY)
+								sample *= 0x11;
+						}
+						else if (rawPng.bitDepth == 16)
+						{
+							// Only the high byte is kept
+							rows[y * rowSize + sampleIndex * 2] = sample;
+							rows[y * rowSize + sampleIndex * 2 + 1] = random();
+						}
+						else
+							rows[y * rowSize + sampleIndex] = sample;
+
+						samples.push_back(sample);
+					}
+
+					if (rawPng.colorType == PNG_COLOR_TYPE_GRAY ||
+					    rawPng.colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
+						samples.insert(samples.begin(), 2, samples[0]);
+					expected.insert(expected.end(), samples.begin(), samples.end());
+				}
+			}
+
+			std::vector<png_color> palette;
+			if (rawPng.colorType == PNG_COLOR_TYPE_PALETTE)
+			{
+				for (size_t i = 0; i < 16; i++)
+					palette.push_back({static_cast<png_byte>(random()),
+					                   static_cast<png_byte>(random()),
+					                   static_cast<png_byte>(random())});
+			}
+
+			if (!WriteRawPng(path, width, height, rawPng.colorType, rawPng.bitDepth, rows,
+			                 palette))
+			{
+				passed = false;
+				continue;
+			}
+
+			ImageBackend read;
+			read.ReadPng(path);
+			passed &= CompareImage(read, width, height, rawPng.layout, expected, what);
+		}
+	}
+
+	return passed;
+}
+
+/* Hash */
+
+/**
+ * Compares `crc32` with the bitwise `reference` for every length up to 1200 bytes, which covers
+ * the short inputs, the tails of the tables and of the PCLMUL folds, at every alignment, hashed at
+ * once and chained in two parts.
+ */
+bool CheckCrc32(const char* name, uint32_t (*crc32)(const void*, size_t, uint32_t),
+                uint32_t (*reference)(const void*, size_t, uint32_t))
+{
+	const size_t maxSize = 1200;
+	const size_t alignments = 16;
+
+	std::mt19937 random(0x5A415044);
+	std::vector<uint8_t> buffer(alignments + maxSize);
+	for (uint8_t& byte : buffer)
+		byte = random();
+
+	// Bytes with bit 7 set are where `Crc32Signed` and `Crc32` diverge
+	for (size_t i = 0; i < 64; i++)
+		buffer[i] = 0xFF;
+
+	for (size_t alignment = 0; alignment < alignments; alignment++)
+	{
+		const uint8_t* data = &buffer[alignment];
+		uint32_t expected = reference(data, 0, 0);
+
+		for (size_t size = 0; size <= maxSize; size++)
+		{
+			if (size > 0)
+				expected = reference(data + size - 1, 1, expected);
+
+			size_t split = size / 3;
+			uint32_t actual = crc32(data, size, 0);
+			uint32_t chained = crc32(data + split, size - split, crc32(data, split, 0));
+
+			if (actual != expected || chained != expected)
+			{
+				fprintf(stderr,
+				        "%s of %zu bytes at alignment %zu: got %08X (%08X chained), expected "
+				        "%08X\n",
+				        name, size, alignment, actual, chained, expected);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool CheckHash()
+{
+	// The check value of CRC-32, to make sure the reference is the standard one
+	if (Crc32Bitwise<uint32_t>("123456789", 9) != 0xCBF43926)
+	{
+		fprintf(stderr, "The bitwise CRC-32 reference is wrong\n");
+		return false;
+	}
+
+	bool clmulEnabled = Hash::IsCrc32ClmulEnabled();
+	bool passed = CheckCrc32("Crc32Signed", Hash::Crc32Signed, Crc32Bitwise<int32_t>);
+
+	for (bool clmul : {false, true})
+	{
+		if (clmul && !clmulEnabled)
+			continue;
+
+		Hash::SetCrc32ClmulEnabled(clmul);
+		passed &= CheckCrc32(clmul ? "Crc32 with PCLMUL" : "Crc32 with the tables", Hash::Crc32,
+		                     Crc32Bitwise<uint32_t>);
+	}
+
+	Hash::SetCrc32ClmulEnabled(clmulEnabled);
+	return passed;
+}
+
+/* Ranged lookups */
+
+/**
+ * Compares the ranged lookups of `file` with the walks they replaced at every address of the file
+ * and a bit past its end.
+ */
+bool CompareRangedLookups(const ZFile* file, const char* stage)
+{
+	uint32_t end = file->GetRawData().size() + 0x100;
+
+	for (uint32_t address = 0; address < end; address++)
+	{
+		Declaration* decl = file->GetDeclarationRanged(address);
+		Declaration* expectedDecl = GetDeclarationRangedLinear(file, address);
+		ZSymbol* sym = file->GetSymbolResourceRanged(address);
+		ZSymbol* expectedSym = GetSymbolResourceRangedLinear(file, address);
+
+		if (decl != expectedDecl)
+		{
+			fprintf(stderr, "%s, %s: declaration at 0x%06X is %s, expected %s\n",
+			        file->GetName().c_str(), stage, address,
+			        decl != nullptr ? decl->declName.c_str() : "none",
+			        expectedDecl != nullptr ? expectedDecl->declName.c_str() : "none");
+			return false;
+		}
+		if (sym != expectedSym)
+		{
+			fprintf(stderr, "%s, %s: symbol at 0x%06X is %s, expected %s\n",
+			        file->GetName().c_str(), stage, address,
+			        sym != nullptr ? sym->GetName().c_str() : "none",
+			        expectedSym != nullptr ? expectedSym->GetName().c_str() : "none");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * A random size for an overlapping item, mostly within a few buckets of the index and sometimes
+ * over the size it keeps aside as large.
+ */
+size_t GetOverlapSize(std::mt19937& random)
+{
+	if (random() % 8 == 0)
+		return 0x4000 + random() % 0x2000;
+
+	return 1 + random() % 0x400;
+}
+
+/**
+ * Compares the ranged lookups with the walks on the synthetic segments as they are extracted, and
+ * again after overlapping declarations and symbols were added, and some of them were resized or
+ * replaced.
+ */
+bool CheckRangedLookups(const fs::path& workDir)
+{
+	fs::path dir = fs::absolute(workDir) / "checks";
+	fs::create_directories(dir);
+
+	std::mt19937 random(0x5A415044);
+	bool passed = true;
+
+	for (const SyntheticSegment& segment :
+	     {SyntheticSegments::GenerateKeep(), SyntheticSegments::GenerateRoom(),
+	      SyntheticSegments::GenerateSkeletons()})
+	{
+		segment.Write(dir);
+
+		tinyxml2::XMLDocument doc;
+		doc.Parse(segment.xml.c_str());
+
+		ExtractionContext ctx;
+		tinyxml2::XMLElement* fileElement = doc.RootElement()->FirstChildElement("File");
+		ZFile* file = new ZFile(&ctx, ZFileMode::Extract, fileElement, dir, dir, "",
+		                        segment.GetXmlPath(dir));
+		ctx.files.push_back(file);
+
+		if (file->declarations.empty())
+		{
+			fprintf(stderr, "%s has no declarations\n", file->GetName().c_str());
+			passed = false;
+			continue;
+		}
+		if (!CompareRangedLookups(file, "as extracted"))
+		{
+			passed = false;
+			continue;
+		}
+
+		size_t fileSize = file->GetRawData().size();
+
+		// Resized at the same address, like a resource declaring its final size
+		std::vector<offset_t> addresses;
+		for (const auto& [address, decl] : file->declarations)
+			addresses.push_back(address);
+
+		for (offset_t address : addresses)
+		{
+			if (random() % 4 != 0)
+				continue;
+
+			Declaration* decl = file->declarations.at(address);
+			std::string varType(decl->declType);
+			std::string varName(decl->declName);
+			std::string body(decl->declBody);
+			file->AddDeclaration(address, decl->alignment, decl->size * (random() % 4) / 2,
+			                     varType, varName, body);
+		}
+
+		for (size_t i = 0; i < 64; i++)
+		{
+			offset_t address = random() % fileSize;
+			std::string varName = StringHelper::Sprintf("gOverlap_%06X", address);
+			file->AddDeclaration(address, DeclarationAlignment::Align4, GetOverlapSize(random),
+			                     "u8", varName, "");
+		}
+
+		// Symbols overlapping each other and the declarations, some of them replaced by another
+		// one at the same offset and some resized
+		std::vector<ZSymbol*> symbols;
+		for (size_t i = 0; i < 64; i++)
+		{
+			uint32_t offset = random() % fileSize;
+			ZSymbol* sym = new (file) ZSymbol(file);
+			sym->SetName(StringHelper::Sprintf("gSymbol_%06X_%zu", offset, i));
+			sym->SetSymbolInfo("u8", 1, true, GetOverlapSize(random));
+			sym->SetRawDataIndex(offset);
+			file->AddSymbolResource(offset, sym);
+
+			// The file only owns the symbol which replaced it
+			if (i % 8 == 0)
+			{
+				ZSymbol* replacement = new (file) ZSymbol(file);
+				replacement->SetName(StringHelper::Sprintf("gSymbol_%06X_%zu_b", offset, i));
+				replacement->SetSymbolInfo("u16", 2, true, 1 + random() % 0x100);
+				replacement->SetRawDataIndex(offset);
+				file->AddSymbolResource(offset, replacement);
+
+				delete sym;
+				sym = replacement;
+			}
+
+			symbols.push_back(sym);
+		}
+
+		for (ZSymbol* sym : symbols)
+		{
+			if (random() % 4 != 0 || file->GetSymbolResource(sym->GetRawDataIndex()) != sym)
+				continue;
+
+			sym->SetSymbolInfo("u32", 4, true, random() % 0x200);
+			file->AddSymbolResource(sym->GetRawDataIndex(), sym);
+		}
+
+		passed &= CompareRangedLookups(file, "with overlaps");
+	}
+
+	return passed;
+}
+
+/* ZFile object files */
+
+/**
+ * Returns whether `path` is an output of `ctx`.
+ */
+bool IsOutputFile(const ExtractionContext& ctx, const fs::path& path)
+{
+	return std::find(ctx.outputFiles.begin(), ctx.outputFiles.end(), path) !=
+	       ctx.outputFiles.end();
+}
+
+bool CheckObjectFiles(const fs::path& workDir)
+{
+	fs::path dir = fs::absolute(workDir) / "checks";
+	fs::create_directories(dir);
+
+	// A blob covering the whole file, so its object can be written without extracting it
+	SyntheticSegment segment;
+	segment.name = "object_file";
+	for (size_t i = 0; i < 0x40; i++)
+		segment.data.push_back(i);
+	segment.xml = "<Root>\n"
+	              "    <File Name=\"object_file\" Segment=\"6\">\n"
+	              "        <Blob Name=\"gObjectFileBlob\" Size=\"0x40\" Offset=\"0x0\"/>\n"
+	              "    </File>\n"
+	              "</Root>\n";
+	segment.Write(dir);
+
+	tinyxml2::XMLDocument doc;
+	doc.Parse(segment.xml.c_str());
+
+	ExtractionContext ctx;
+	tinyxml2::XMLElement* fileElement = doc.RootElement()->FirstChildElement("File");
+	ZFile* file = new ZFile(&ctx, ZFileMode::Extract, fileElement, dir, dir, "",
+	                        segment.GetXmlPath(dir));
+	ctx.files.push_back(file);
+
+	fs::path objectPath = dir / (segment.name + ".o");
+	bool passed = true;
+
+	if (!file->GenerateObjectFile(objectPath) || !fs::exists(objectPath) ||
+	    !IsOutputFile(ctx, objectPath))
+	{
+		fprintf(stderr, "The object of %s wasn't written\n", segment.name.c_str());
+		passed = false;
+	}
+
+	// Like extracting again once the declarations stopped covering the data, the object of the
+	// previous extraction must not be left behind
+	size_t fileSize = file->GetRawData().size();
+	file->AddDeclaration(fileSize - 2, DeclarationAlignment::Align4, 4, "u8", "gPastTheEnd", "");
+	ctx.outputFiles.clear();
+
+	if (file->GenerateObjectFile(objectPath))
+	{
+		fprintf(stderr, "The object of %s was written past the end of its data\n",
+		        segment.name.c_str());
+		passed = false;
+	}
+	if (fs::exists(objectPath) || IsOutputFile(ctx, objectPath))
+	{
+		fprintf(stderr, "The object of the previous extraction of %s was left behind\n",
+		        segment.name.c_str());
+		passed = false;
+	}
+
+	return passed;
+}
+}  // namespace
+
+void RunChecks(BenchmarkRunner& runner)
+{
+	runner.Check("NumericEmitter", CheckNumericEmitter);
+	runner.Check("NumericEmitter/ResourceBodies",
+	             [&]() { return CheckResourceBodies(runner.options.workDir); });
+	runner.Check("TextureCodec", CheckTextureCodec);
+	runner.Check("ImageBackend", [&]() { return CheckImageBackend(runner.options.workDir); });
+	runner.Check("Hash/Crc32", CheckHash);
+	runner.Check("ZFile/RangedLookups",
+	             [&]() { return CheckRangedLookups(runner.options.workDir); });
+	runner.Check("ZFile/ObjectFiles", [&]() { return CheckObjectFiles(runner.options.workDir); });
+}
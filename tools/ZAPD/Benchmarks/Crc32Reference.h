@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The bit-at-a-time CRC-32 loop `Hash` replaced, chained like `Hash::Crc32`. With an `int32_t`
+ * CRC it is ZAPD's old `CRC32B`, which `Hash::Crc32Signed` reproduces; with an `uint32_t` one it
+ * is the standard CRC-32 of `Hash::Crc32`.
+ */
+template <typename CrcInt>
+uint32_t Crc32Bitwise(const void* data, size_t size, uint32_t crc = 0)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	CrcInt state = static_cast<CrcInt>(~crc);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		state = state ^ bytes[i];
+		for (int bit = 0; bit < 8; bit++)
+		{
+			CrcInt mask = -(state & 1);
+			state = (state >> 1) ^ (0xEDB88320 & mask);
+		}
+	}
+
+	return ~static_cast<uint32_t>(state);
+}
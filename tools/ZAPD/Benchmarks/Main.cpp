@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Benchmark.h"
+#include "Globals.h"
+#include "WarningHandler.h"
+
+extern const char gBuildHash[];
+
+void PrintUsage()
+{
+	fprintf(stderr,
+	        "ZAPDBench.out (%s) [options]\n"
+	        "  --zapd PATH         ZAPD.out to run the pipeline benchmarks with (ZAPD.out)\n"
+	        "  --work-dir DIR      where the segments are generated and extracted (build/bench)\n"
+	        "  --game-root DIR     root of the repo to extract the baserom segments of\n"
+	        "  --version VERSION   game version of the extracted baserom segments to use,\n"
+	        "                      instead of the synthetic ones\n"
+	        "  --xml PATH          XML to extract, relative to the game root (repeatable)\n"
+	        "  --output PATH       file to write the results to, instead of stdout\n"
+	        "  --filter STRING     only run the benchmarks and checks whose name contains STRING\n"
+	        "  --runs N            runs of each benchmark (5)\n"
+	        "  --min-time MS       minimum time of a run of a micro benchmark (50)\n",
+	        gBuildHash);
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkOptions options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+
+		if (!strcmp(arg, "--help") || !strcmp(arg, "-h"))
+		{
+			PrintUsage();
+			return 0;
+		}
+
+		if (i + 1 >= argc)
+		{
+			fprintf(stderr, "Error: Missing value for '%s'\n", arg);
+			return 1;
+		}
+
+		const char* value = argv[++i];
+
+		if (!strcmp(arg, "--zapd"))
+			options.zapdPath = value;
+		else if (!strcmp(arg, "--work-dir"))
+			options.workDir = value;
+		else if (!strcmp(arg, "--game-root"))
+			options.gameRoot = value;
+		else if (!strcmp(arg, "--version"))
+			options.version = value;
+		else if (!strcmp(arg, "--xml"))
+			options.xmlPaths.push_back(value);
+		else if (!strcmp(arg, "--output"))
+			options.outputPath = value;
+		else if (!strcmp(arg, "--filter"))
+			options.filter = value;
+		else if (!strcmp(arg, "--runs"))
+			options.runs = std::max(1, atoi(value));
+		else if (!strcmp(arg, "--min-time"))
+			options.minRunTimeMs = atof(value);
+		else
+		{
+			fprintf(stderr, "Error: Unknown option '%s'\n", arg);
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	BenchmarkRunner runner(options);
+	if (!runner.IsOutputOpen())
+	{
+		fprintf(stderr, "Error: Couldn't open '%s'\n", options.outputPath.c_str());
+		return 1;
+	}
+
+	// The micro benchmarks run the extraction code in this process, which expects the defaults
+	// of `ZAPD.out`
+	Globals* g = new Globals();
+	WarningHandler::Init(argc, argv);
+	RunChecks(runner);
+	RunMicroBenchmarks(runner);
+	bool success = RunPipelineBenchmarks(runner);
+
+	delete g;
+
+	if (!success || runner.GetFailedCount() != 0)
+		return 1;
+
+	if (runner.GetReportedCount() == 0)
+	{
+		fprintf(stderr, "Error: No benchmark matches '%s'\n", options.filter.c_str());
+		return 1;
+	}
+
+	return 0;
+}
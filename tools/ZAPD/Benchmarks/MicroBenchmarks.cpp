@@ -0,0 +1,367 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <random>
+
+#include "Crc32Reference.h"
+#include "ExtractionContext.h"
+#include "ImageBackend.h"
+#include "OutputFormatter.h"
+#include "RangedLookupReference.h"
+#include "SyntheticSegments.h"
+#include "TextureCodec.h"
+#include "TextureFormats.h"
+#include "Utils/BEView.h"
+#include "Utils/BitConverter.h"
+#include "Utils/Hash.h"
+#include "Utils/StringHelper.h"
+#include "ZDisplayList.h"
+#include "ZFile.h"
+#include "ZTexture.h"
+#include "tinyxml2.h"
+
+namespace
+{
+bool IsWordChar(char c)
+{
+	return isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+void RunByteOrderBenchmarks(BenchmarkRunner& runner, const ByteSpan& data)
+{
+	size_t size = data.size() & ~7;
+
+	runner.Run("BitConverter/ToInt16BE", size / 2, size, [&]() {
+		int32_t sum = 0;
+		for (size_t offset = 0; offset < size; offset += 2)
+			sum += BitConverter::ToInt16BE(data, offset);
+		DoNotOptimize(sum);
+	});
+	runner.Run("BitConverter/ToUInt32BE", size / 4, size, [&]() {
+		uint32_t sum = 0;
+		for (size_t offset = 0; offset < size; offset += 4)
+			sum += BitConverter::ToUInt32BE(data, offset);
+		DoNotOptimize(sum);
+	});
+	runner.Run("BitConverter/ToUInt64BE", size / 8, size, [&]() {
+		uint64_t sum = 0;
+		for (size_t offset = 0; offset < size; offset += 8)
+			sum += BitConverter::ToUInt64BE(data, offset);
+		DoNotOptimize(sum);
+	});
+
+	// The same reads from a view of the whole buffer, checked once
+	BEView view(data, 0, size);
+
+	runner.Run("BEView/ReadInt16", size / 2, size, [&]() {
+		int32_t sum = 0;
+		for (size_t offset = 0; offset < size; offset += 2)
+			sum += view.ReadInt16(offset);
+		DoNotOptimize(sum);
+	});
+	runner.Run("BEView/ReadUInt32", size / 4, size, [&]() {
+		uint32_t sum = 0;
+		for (size_t offset = 0; offset < size; offset += 4)
+			sum += view.ReadUInt32(offset);
+		DoNotOptimize(sum);
+	});
+	runner.Run("BEView/ReadUInt64", size / 8, size, [&]() {
+		uint64_t sum = 0;
+		for (size_t offset = 0; offset < size; offset += 8)
+			sum += view.ReadUInt64(offset);
+		DoNotOptimize(sum);
+	});
+
+	std::vector<int16_t> values(size / 2);
+	runner.Run("BEView/ReadArray<int16_t>", size / 2, size, [&]() {
+		view.ReadArray(0, values.data(), values.size());
+		DoNotOptimize(values.data());
+	});
+}
+
+void RunTextureCodecBenchmarks(BenchmarkRunner& runner)
+{
+	// A row at a time, like `ZTexture` converts them
+	const size_t width = 64;
+	const size_t height = 64;
+	const size_t texelCount = width * height;
+
+	std::mt19937 random(0x5A415044);
+	TextureCodec::InstructionSet bestSet = TextureCodec::GetInstructionSet();
+
+	for (TextureCodec::InstructionSet set :
+	     {TextureCodec::InstructionSet::Scalar, TextureCodec::InstructionSet::SSE2,
+	      TextureCodec::InstructionSet::AVX2})
+	{
+		if (!TextureCodec::IsSupported(set))
+			continue;
+
+		TextureCodec::SetInstructionSet(set);
+		std::string setName = TextureCodec::GetInstructionSetName(set);
+
+		for (const TextureFormat& format : gTextureFormats)
+		{
+			PixelLayout layout = TextureCodec::GetDecodedLayout(format.type);
+			size_t texelRowSize = width * format.bitsPerTexel / 8;
+			size_t pixelRowSize = width * GetBytesPerPixel(layout);
+
+			std::vector<uint8_t> texels(texelRowSize * height);
+			std::vector<uint8_t> pixels(pixelRowSize * height);
+			for (uint8_t& texel : texels)
+				texel = random();
+
+			auto decode = [&]() {
+				for (size_t y = 0; y < height; y++)
+				{
+					TextureCodec::DecodeRow(format.type, &texels[y * texelRowSize],
+					                        &pixels[y * pixelRowSize], width);
+				}
+				DoNotOptimize(pixels.data());
+			};
+			auto encode = [&]() {
+				for (size_t y = 0; y < height; y++)
+				{
+					TextureCodec::EncodeRow(format.type, layout, &pixels[y * pixelRowSize],
+					                        &texels[y * texelRowSize], width);
+				}
+				DoNotOptimize(texels.data());
+			};
+
+			std::string name = std::string(format.name) + "/" + setName;
+			runner.Run("TextureCodec/Decode/" + name, texelCount, texels.size(), decode);
+			runner.Run("TextureCodec/Encode/" + name, texelCount, texels.size(), encode);
+		}
+	}
+
+	TextureCodec::SetInstructionSet(bestSet);
+}
+
+void RunPngEncodeBenchmarks(BenchmarkRunner& runner, ZFile* file)
+{
+	// The textures of the object, decoded like `ZTexture` does before writing their PNGs
+	std::vector<std::unique_ptr<ImageBackend>> images;
+	size_t size = 0;
+
+	for (ZResource* res : file->resources)
+	{
+		ZTexture* texture = dynamic_cast<ZTexture*>(res);
+		if (texture == nullptr)
+			continue;
+
+		TextureType type = texture->GetTextureType();
+		uint32_t width = texture->GetWidth();
+		uint32_t height = texture->GetHeight();
+		PixelLayout layout = TextureCodec::GetDecodedLayout(type);
+		auto image = std::make_unique<ImageBackend>();
+
+		if (layout == PixelLayout::Index)
+		{
+			image->InitEmptyPaletteImage(width, height);
+			for (size_t i = 0; i < 256; i++)
+				image->SetPaletteIndex(i, i, i, i, 255);
+		}
+		else
+			image->InitEmptyRGBImage(width, height, layout == PixelLayout::RGBA);
+
+		const uint8_t* texels = file->GetRawData().data() + texture->GetRawDataIndex();
+		size_t texelRowSize = texture->GetRawDataSize() / height;
+		for (size_t y = 0; y < height; y++)
+			TextureCodec::DecodeRow(type, texels + y * texelRowSize, image->GetRow(y), width);
+
+		size += image->GetRowSize() * height;
+		images.push_back(std::move(image));
+	}
+
+	for (const std::string& profileName : StringHelper::Split(PngEncodeProfile::GetNames(), ", "))
+	{
+		std::string name = "ImageBackend/EncodePng/" + profileName;
+		if (!runner.IsSelected("micro/" + name))
+			continue;
+
+		PngEncodeProfile profile;
+		PngEncodeProfile::FromName(profileName, profile);
+
+		// The total size of the PNGs, which the profiles trade for speed
+		size_t pngSize = 0;
+		for (auto& image : images)
+			pngSize += image->EncodePng(profile).size();
+
+		runner.Run(
+			name, images.size(), size,
+			[&]() {
+				for (auto& image : images)
+					DoNotOptimize(image->EncodePng(profile).size());
+			},
+			pngSize);
+	}
+}
+
+void RunCrc32Benchmarks(BenchmarkRunner& runner, ZFile* file)
+{
+	// Each texture is hashed separately, like `ZTexture` does for texture pools
+	std::vector<std::pair<const uint8_t*, size_t>> textures;
+	size_t size = 0;
+
+	for (ZResource* res : file->resources)
+	{
+		ZTexture* texture = dynamic_cast<ZTexture*>(res);
+		if (texture != nullptr)
+		{
+			textures.emplace_back(file->GetRawData().data() + texture->GetRawDataIndex(),
+			                      texture->GetRawDataSize());
+			size += texture->GetRawDataSize();
+		}
+	}
+
+	auto hashTextures = [&](uint32_t (*crc32)(const void*, size_t, uint32_t)) {
+		return [&textures, crc32]() {
+			for (const auto& [data, dataSize] : textures)
+				DoNotOptimize(crc32(data, dataSize, 0));
+		};
+	};
+
+	bool clmulEnabled = Hash::IsCrc32ClmulEnabled();
+
+	runner.Run("Hash/Crc32Signed/Bitwise", textures.size(), size,
+	           hashTextures(&Crc32Bitwise<int32_t>));
+	runner.Run("Hash/Crc32Signed/SliceBy8", textures.size(), size,
+	           hashTextures(&Hash::Crc32Signed));
+	runner.Run("Hash/Crc32/Bitwise", textures.size(), size, hashTextures(&Crc32Bitwise<uint32_t>));
+
+	Hash::SetCrc32ClmulEnabled(false);
+	runner.Run("Hash/Crc32/SliceBy8", textures.size(), size, hashTextures(&Hash::Crc32));
+
+	if (clmulEnabled)
+	{
+		Hash::SetCrc32ClmulEnabled(true);
+		runner.Run("Hash/Crc32/PCLMUL", textures.size(), size, hashTextures(&Hash::Crc32));
+	}
+
+	Hash::SetCrc32ClmulEnabled(clmulEnabled);
+}
+
+void RunDisplayListBenchmarks(BenchmarkRunner& runner, ZFile* file)
+{
+	std::vector<ZDisplayList*> dLists;
+	size_t size = 0;
+
+	for (ZResource* res : file->resources)
+	{
+		ZDisplayList* dList = dynamic_cast<ZDisplayList*>(res);
+		if (dList != nullptr)
+		{
+			dLists.push_back(dList);
+			size += dList->GetRawDataSize();
+		}
+	}
+
+	runner.Run("ZDisplayList/ProcessGfxDis", dLists.size(), size, [&]() {
+		for (ZDisplayList* dList : dLists)
+			DoNotOptimize(dList->ProcessGfxDis("").size());
+	});
+
+	// The text of the display lists, cut where gfxd would write it: one token at a time
+	std::vector<std::string> chunks;
+	std::vector<std::string> texts;
+	size = 0;
+
+	for (ZDisplayList* dList : dLists)
+	{
+		std::string text = dList->ProcessGfxDis("");
+		size_t start = 0;
+
+		for (size_t i = 1; i <= text.size(); i++)
+		{
+			if (i == text.size() || !IsWordChar(text[i]) || !IsWordChar(text[i - 1]))
+			{
+				chunks.push_back(text.substr(start, i - start));
+				start = i;
+			}
+		}
+		size += text.size();
+		texts.push_back(std::move(text));
+	}
+
+	runner.Run("OutputFormatter/Write", chunks.size(), size, [&]() {
+		OutputFormatter formatter;
+		for (const std::string& chunk : chunks)
+			formatter.Write(chunk.c_str(), chunk.size());
+		DoNotOptimize(formatter.GetOutput().size());
+	});
+
+	// Whole declarations at once, like `ZFile` writes them
+	runner.Run("OutputFormatter/WriteDeclarations", texts.size(), size, [&]() {
+		OutputFormatter formatter;
+		for (const std::string& text : texts)
+			formatter.Write(text);
+		DoNotOptimize(formatter.GetOutput().size());
+	});
+}
+
+void RunDeclarationBenchmarks(BenchmarkRunner& runner, ExtractionContext& ctx, ZFile* file)
+{
+	// Looked up in a shuffled order, extraction doesn't look them up sequentially either
+	std::mt19937 random(0x5A415044);
+	std::vector<offset_t> addresses;
+	std::vector<offset_t> rangedAddresses;
+
+	for (const auto& [address, declaration] : file->declarations)
+		addresses.push_back(address);
+	std::shuffle(addresses.begin(), addresses.end(), random);
+
+	for (size_t i = 0; i < addresses.size(); i++)
+		rangedAddresses.push_back(random() % file->GetRawData().size());
+
+	runner.Run("ZFile/GetDeclaration", addresses.size(), 0, [&]() {
+		for (offset_t address : addresses)
+			DoNotOptimize(file->GetDeclaration(address));
+	});
+	runner.Run("ZFile/GetDeclarationRanged", rangedAddresses.size(), 0, [&]() {
+		for (offset_t address : rangedAddresses)
+			DoNotOptimize(file->GetDeclarationRanged(address));
+	});
+	// The walk over every declaration it replaced
+	runner.Run("ZFile/GetDeclarationRanged/Linear", rangedAddresses.size(), 0, [&]() {
+		for (offset_t address : rangedAddresses)
+			DoNotOptimize(GetDeclarationRangedLinear(file, address));
+	});
+
+	std::string declName;
+	runner.Run("ExtractionContext/GetSegmentedPtrName", rangedAddresses.size(), 0, [&]() {
+		for (offset_t address : rangedAddresses)
+		{
+			ctx.GetSegmentedPtrName((file->segment << 24) | address, file, NO_SOURCE_OFFSET, "",
+			                        declName, false);
+			DoNotOptimize(declName.data());
+		}
+	});
+}
+}  // namespace
+
+void RunMicroBenchmarks(BenchmarkRunner& runner)
+{
+	fs::path dir = fs::absolute(runner.options.workDir) / "synthetic";
+	fs::create_directories(dir);
+
+	SyntheticSegment segment = SyntheticSegments::GenerateKeep();
+	segment.Write(dir);
+
+	tinyxml2::XMLDocument doc;
+	doc.Parse(segment.xml.c_str());
+
+	// Parsed like `ZAPD.out` does, but no source file is written
+	ExtractionContext ctx;
+	tinyxml2::XMLElement* fileElement = doc.RootElement()->FirstChildElement("File");
+	ZFile* file = new ZFile(&ctx, ZFileMode::Extract, fileElement, dir, dir, "",
+	                        segment.GetXmlPath(dir));
+	ctx.files.push_back(file);
+
+	RunByteOrderBenchmarks(runner, file->GetRawData());
+	RunTextureCodecBenchmarks(runner);
+	RunPngEncodeBenchmarks(runner, file);
+	RunCrc32Benchmarks(runner, file);
+	RunDisplayListBenchmarks(runner, file);
+	RunDeclarationBenchmarks(runner, ctx, file);
+}
@@ -0,0 +1,206 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SyntheticSegments.h"
+#include "tinyxml2.h"
+
+namespace
+{
+struct PipelineCase
+{
+	std::string name;
+	fs::path xmlPath;
+};
+
+/**
+ * Runs `args` in `workingDir` with its output redirected to `logPath`, and returns its exit code
+ * (or -1 if it couldn't be started) along with its peak memory usage.
+ */
+int RunProcess(const std::vector<std::string>& args, const fs::path& workingDir,
+               const fs::path& logPath, int64_t& maxRssKb)
+{
+	std::vector<char*> argv;
+	for (const std::string& arg : args)
+		argv.push_back(const_cast<char*>(arg.c_str()));
+	argv.push_back(nullptr);
+
+	pid_t pid = fork();
+	if (pid < 0)
+		return -1;
+
+	if (pid == 0)
+	{
+		int log = open(logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (log < 0 || (!workingDir.empty() && chdir(workingDir.c_str()) != 0))
+			_exit(127);
+		dup2(log, STDOUT_FILENO);
+		dup2(log, STDERR_FILENO);
+		execv(argv[0], argv.data());
+		_exit(127);
+	}
+
+	int status;
+	struct rusage usage;
+	if (wait4(pid, &status, 0, &usage) != pid)
+		return -1;
+
+#ifdef __APPLE__
+	maxRssKb = usage.ru_maxrss / 1024;
+#else
+	maxRssKb = usage.ru_maxrss;
+#endif
+
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/**
+ * Returns the size of the baserom files the `File`s of the XML extract.
+ */
+uint64_t GetInputSize(const fs::path& xmlPath, const fs::path& baseromDir)
+{
+	tinyxml2::XMLDocument doc;
+	if (doc.LoadFile(xmlPath.string().c_str()) != tinyxml2::XML_SUCCESS)
+		return 0;
+
+	tinyxml2::XMLElement* root = doc.FirstChildElement("Root");
+	if (root == nullptr)
+		return 0;
+
+	uint64_t size = 0;
+	for (tinyxml2::XMLElement* file = root->FirstChildElement("File"); file != nullptr;
+	     file = file->NextSiblingElement("File"))
+	{
+		const char* name = file->Attribute("Name");
+		std::error_code ec;
+
+		if (name != nullptr && fs::exists(baseromDir / name, ec))
+			size += fs::file_size(baseromDir / name, ec);
+	}
+
+	return size;
+}
+}  // namespace
+
+bool RunPipelineBenchmarks(BenchmarkRunner& runner)
+{
+	const BenchmarkOptions& options = runner.options;
+	fs::path zapdPath = fs::absolute(options.zapdPath);
+	fs::path workDir = fs::absolute(options.workDir);
+	fs::path gameRoot, baseromDir, configPath;
+	std::vector<PipelineCase> cases;
+
+	if (options.version.empty())
+	{
+		baseromDir = workDir / "synthetic";
+		fs::create_directories(baseromDir);
+
+		for (const SyntheticSegment& segment :
+		     {SyntheticSegments::GenerateKeep(), SyntheticSegments::GenerateRoom(),
+		      SyntheticSegments::GenerateSkeletons()})
+		{
+			segment.Write(baseromDir);
+			cases.push_back({"synthetic/" + segment.name, segment.GetXmlPath(baseromDir)});
+		}
+	}
+	else
+	{
+		// Same paths as the extraction of the game, which is done from the root of the repo
+		gameRoot = fs::weakly_canonical(fs::absolute(options.gameRoot));
+		baseromDir = fs::path("extracted") / options.version / "baserom";
+		configPath = fs::path("tools") / "ZAPDConfigs" / options.version / "Config.xml";
+
+		if (!fs::is_directory(gameRoot / baseromDir))
+		{
+			fprintf(stderr, "Error: '%s' doesn't exist, extract the baserom of %s first\n",
+			        (gameRoot / baseromDir).c_str(), options.version.c_str());
+			return false;
+		}
+
+		std::vector<std::string> xmlPaths = options.xmlPaths;
+		if (xmlPaths.empty())
+		{
+			xmlPaths = {
+				"assets/xml/objects/gameplay_keep.xml",
+				"assets/xml/scenes/overworld/spot00.xml",
+				"assets/xml/objects/object_link_boy.xml",
+			};
+		}
+
+		for (const std::string& xmlPath : xmlPaths)
+			cases.push_back({options.version + "/" + fs::path(xmlPath).stem().string(), xmlPath});
+	}
+
+	bool success = true;
+
+	for (const PipelineCase& pipelineCase : cases)
+	{
+		if (!runner.IsSelected("pipeline/" + pipelineCase.name))
+			continue;
+
+		fs::path outDir = workDir / "out" / pipelineCase.name;
+		fs::path logPath = workDir / "out" / (pipelineCase.name + ".log");
+		fs::create_directories(outDir.parent_path());
+
+		std::vector<std::string> args = {
+			zapdPath.string(), "e", "-eh", "-gsf", "1", "--cs-float", "both",
+			"-i", pipelineCase.xmlPath.string(), "-b", baseromDir.string(),
+			"-o", outDir.string(), "-osf", outDir.string(),
+		};
+		if (!configPath.empty())
+		{
+			args.push_back("-rconf");
+			args.push_back(configPath.string());
+		}
+
+		std::vector<double> samples;
+		int64_t maxRssKb = 0;
+
+		for (uint32_t i = 0; i < options.runs; i++)
+		{
+			// Every run extracts from scratch, like the first extraction of the game does
+			fs::remove_all(outDir);
+			fs::create_directories(outDir);
+
+			int64_t runMaxRssKb = 0;
+			auto start = std::chrono::steady_clock::now();
+			int exitCode = RunProcess(args, gameRoot, logPath, runMaxRssKb);
+			auto end = std::chrono::steady_clock::now();
+
+			if (exitCode != 0)
+			{
+				fprintf(stderr, "pipeline/%s: ZAPD exited with code %i, see '%s'\n",
+				        pipelineCase.name.c_str(), exitCode, logPath.c_str());
+				success = false;
+				break;
+			}
+
+			samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+			maxRssKb = std::max(maxRssKb, runMaxRssKb);
+		}
+
+		if (samples.size() != options.runs)
+			continue;
+
+		std::sort(samples.begin(), samples.end());
+
+		BenchmarkResult result;
+		result.suite = "pipeline";
+		result.name = pipelineCase.name;
+		result.runs = options.runs;
+		result.iterations = 1;
+		result.bestNs = samples.front();
+		result.medianNs = samples[samples.size() / 2];
+		result.bytes = GetInputSize(gameRoot / pipelineCase.xmlPath, gameRoot / baseromDir);
+		result.maxRssKb = maxRssKb;
+		runner.Report(result);
+	}
+
+	return success;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "ZFile.h"
+#include "ZSymbol.h"
+
+/**
+ * The walk over every item that `AddressIntervalIndex` replaced in the ranged lookups of `ZFile`:
+ * the first item by address whose range contains `address`.
+ */
+template <typename Map, typename GetSize>
+typename Map::mapped_type FindRangedLinear(const Map& items, uint32_t address, GetSize getSize)
+{
+	for (const auto& [start, item] : items)
+	{
+		if (address >= start && address < start + getSize(item))
+			return item;
+	}
+
+	return nullptr;
+}
+
+inline Declaration* GetDeclarationRangedLinear(const ZFile* file, offset_t address)
+{
+	return FindRangedLinear(file->declarations, address,
+	                        [](const Declaration* decl) { return decl->size; });
+}
+
+inline ZSymbol* GetSymbolResourceRangedLinear(const ZFile* file, uint32_t offset)
+{
+	return FindRangedLinear(file->GetSymbolResources(), offset,
+	                        [](const ZSymbol* sym) { return sym->GetRawDataSize(); });
+}
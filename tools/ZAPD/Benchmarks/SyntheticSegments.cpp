@@ -0,0 +1,562 @@
+#include "SyntheticSegments.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <iterator>
+#include <string_view>
+
+#include "Utils/File.h"
+#include "Utils/StringHelper.h"
+
+namespace
+{
+struct TextureFormat
+{
+	const char* name;
+	uint32_t bitsPerTexel;
+	uint32_t width;
+	uint32_t height;
+	uint32_t paletteSize;  // in colors, 0 if it isn't a CI format
+};
+
+const TextureFormat sTextureFormats[] = {
+	{"rgba16", 16, 32, 32, 0}, {"rgba32", 32, 32, 32, 0}, {"i4", 4, 64, 64, 0},
+	{"i8", 8, 32, 64, 0},      {"ia4", 4, 64, 32, 0},     {"ia8", 8, 32, 32, 0},
+	{"ia16", 16, 32, 32, 0},   {"ci4", 4, 32, 64, 16},    {"ci8", 8, 32, 32, 256},
+};
+
+// What the display lists load: a 32x32 RGBA16 texture
+const uint32_t sDListTexWidth = 32;
+const uint32_t sDListTexHeight = 32;
+
+/**
+ * Appends big-endian data to a segment, and generates its pseudo-random contents.
+ */
+class SegmentBuilder
+{
+public:
+	std::vector<uint8_t> data;
+	uint32_t segment;
+
+	explicit SegmentBuilder(uint32_t nSegment) : segment(nSegment) {}
+
+	uint32_t GetOffset() const { return data.size(); }
+	uint32_t GetSegmentedAddress(uint32_t offset) const { return (segment << 24) | offset; }
+
+	void Align(uint32_t alignment)
+	{
+		while (data.size() % alignment != 0)
+			data.push_back(0);
+	}
+
+	void AppendU8(uint8_t value) { data.push_back(value); }
+
+	void AppendU16(uint16_t value)
+	{
+		data.push_back(value >> 8);
+		data.push_back(value);
+	}
+
+	void AppendU32(uint32_t value)
+	{
+		AppendU16(value >> 16);
+		AppendU16(value);
+	}
+
+	void AppendGfx(uint32_t w0, uint32_t w1)
+	{
+		AppendU32(w0);
+		AppendU32(w1);
+	}
+
+	uint32_t Random()
+	{
+		// xorshift32
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 17;
+		randomState ^= randomState << 5;
+		return randomState;
+	}
+
+	/**
+	 * Appends texels that compress like real textures do: gradients with some noise.
+	 */
+	uint32_t AppendTexture(uint32_t width, uint32_t height, uint32_t bitsPerTexel)
+	{
+		Align(8);
+		uint32_t offset = GetOffset();
+		uint32_t rowSize = width * bitsPerTexel / 8;
+		uint32_t seed = Random();
+
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < rowSize; x++)
+				AppendU8(((x * 3 + y * 5 + seed) & 0xF8) ^ (Random() & 0x07));
+		}
+
+		return offset;
+	}
+
+	/**
+	 * Appends `count` big-endian numbers of `size` bytes: 0, the largest unsigned, smallest and
+	 * largest signed numbers first, then random positive and negative numbers of any length.
+	 */
+	uint32_t AppendNumbers(uint32_t count, uint32_t size)
+	{
+		uint32_t offset = GetOffset();
+		uint64_t signBit = 1ULL << (size * 8 - 1);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint64_t value;
+
+			switch (i)
+			{
+			case 0:
+				value = 0;
+				break;
+			case 1:
+				value = ~0ULL;
+				break;
+			case 2:
+				value = signBit;
+				break;
+			case 3:
+				value = signBit - 1;
+				break;
+			default:
+				value = ((static_cast<uint64_t>(Random()) << 32) | Random()) >> (Random() % 64);
+				if (Random() % 2 != 0)
+					value = 0 - value;
+				break;
+			}
+
+			for (uint32_t b = size; b > 0; b--)
+				AppendU8(value >> ((b - 1) * 8));
+		}
+
+		return offset;
+	}
+
+	uint32_t AppendVertices(uint32_t count)
+	{
+		Align(8);
+		uint32_t offset = GetOffset();
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			AppendU16(Random() % 2000 - 1000);
+			AppendU16(Random() % 2000 - 1000);
+			AppendU16(Random() % 2000 - 1000);
+			AppendU16(0);
+			AppendU16((Random() % sDListTexWidth) << 6);
+			AppendU16((Random() % sDListTexHeight) << 6);
+			AppendU32(Random() | 0xFF);
+		}
+
+		return offset;
+	}
+
+	/**
+	 * Appends a display list which loads the RGBA16 texture at `texOffset` and draws
+	 * `triangleCount` triangles from the `vtxCount` vertices at `vtxOffset`.
+	 */
+	uint32_t AppendDisplayList(uint32_t texOffset, uint32_t vtxOffset, uint32_t vtxCount,
+	                           uint32_t triangleCount)
+	{
+		Align(8);
+		uint32_t offset = GetOffset();
+		uint32_t texAddress = GetSegmentedAddress(texOffset);
+
+		AppendGfx(0xE7000000, 0x00000000);  // gsDPPipeSync
+		AppendGfx(0xFC127E24, 0xFFFFF3F9);  // gsDPSetCombineLERP
+		AppendGfx(0xD9F3FFFF, 0x00000000);  // gsSPClearGeometryMode
+		AppendGfx(0xFA000080, Random() | 0xFF);  // gsDPSetPrimColor
+		AppendGfx(0xD7000002, 0xFFFFFFFF);  // gsSPTexture
+
+		// gsDPLoadTextureBlock(texture, G_IM_FMT_RGBA, G_IM_SIZ_16b, 32, 32, ...)
+		AppendGfx(0xFD100000, texAddress);
+		AppendGfx(0xF5100000, 0x07014050);
+		AppendGfx(0xE6000000, 0x00000000);
+		AppendGfx(0xF3000000,
+		          0x07000000 | ((sDListTexWidth * sDListTexHeight - 1) << 12) | 0x100);
+		AppendGfx(0xE7000000, 0x00000000);
+		AppendGfx(0xF5101000, 0x00014050);
+		AppendGfx(0xF2000000,
+		          ((sDListTexWidth - 1) << 14) | ((sDListTexHeight - 1) << 2));
+
+		for (uint32_t drawn = 0; drawn < triangleCount;)
+		{
+			uint32_t loaded = std::min<uint32_t>(vtxCount, 32);
+			uint32_t firstVtx = Random() % (vtxCount - loaded + 1);
+			uint32_t vtxAddress = GetSegmentedAddress(vtxOffset + firstVtx * 16);
+
+			// gsSPVertex, then as many triangles of these vertices as there are left to draw
+			AppendGfx(0x01000000 | (loaded << 12) | (loaded << 1), vtxAddress);
+			for (uint32_t i = 0; i < 16 && drawn < triangleCount; i += 2)
+			{
+				uint32_t a = Random() % loaded;
+				uint32_t b = Random() % loaded;
+				uint32_t c = Random() % loaded;
+
+				if (triangleCount - drawn == 1)
+				{
+					AppendGfx(0x05000000 | (a << 17) | (b << 9) | (c << 1), 0);
+					drawn++;
+					break;
+				}
+
+				uint32_t d = Random() % loaded;
+				uint32_t e = Random() % loaded;
+				uint32_t f = Random() % loaded;
+				AppendGfx(0x06000000 | (a << 17) | (b << 9) | (c << 1),
+				          (d << 17) | (e << 9) | (f << 1));
+				drawn += 2;
+			}
+		}
+
+		AppendGfx(0xDF000000, 0x00000000);  // gsSPEndDisplayList
+		return offset;
+	}
+
+protected:
+	uint32_t randomState = 0x5A415044;
+};
+
+void AppendXmlElement(std::string& xml, const char* format, ...) ATTRIBUTE_PRINTF(2, 3);
+
+void AppendXmlElement(std::string& xml, const char* format, ...)
+{
+	va_list va;
+	va_start(va, format);
+	xml += "        ";
+	StringHelper::AppendFormatV(xml, format, va);
+	xml += "\n";
+	va_end(va);
+}
+
+std::string GetXml(const std::string& name, uint32_t segment, const std::string& elements)
+{
+	return StringHelper::Sprintf("<Root>\n    <File Name=\"%s\" Segment=\"%u\">\n%s    </File>\n"
+	                             "</Root>\n",
+	                             name.c_str(), segment, elements.c_str());
+}
+}  // namespace
+
+void SyntheticSegment::Write(const fs::path& dir) const
+{
+	File::WriteAllBytes(dir / name, data);
+	File::WriteAllText(GetXmlPath(dir), xml);
+}
+
+fs::path SyntheticSegment::GetXmlPath(const fs::path& dir) const
+{
+	return dir / (name + ".xml");
+}
+
+SyntheticSegment SyntheticSegments::GenerateKeep()
+{
+	const uint32_t textureCount = 72;
+	const uint32_t dListCount = 256;
+
+	SegmentBuilder builder(4);
+	std::string elements;
+	std::vector<uint32_t> dListTextures;
+
+	for (uint32_t i = 0; i < textureCount; i++)
+	{
+		const TextureFormat& format = sTextureFormats[i % std::size(sTextureFormats)];
+		uint32_t tlutOffset = 0;
+
+		if (format.paletteSize != 0)
+		{
+			uint32_t tlutWidth = format.paletteSize == 16 ? 4 : 16;
+
+			tlutOffset = builder.AppendTexture(tlutWidth, format.paletteSize / tlutWidth, 16);
+			AppendXmlElement(elements,
+			                 "<Texture Name=\"gBenchKeep%uTLUT\" OutName=\"bench_keep_%u_tlut\" "
+			                 "Format=\"rgba16\" Width=\"%u\" Height=\"%u\" Offset=\"0x%X\"/>",
+			                 i, i, tlutWidth, format.paletteSize / tlutWidth, tlutOffset);
+		}
+
+		uint32_t offset = builder.AppendTexture(format.width, format.height, format.bitsPerTexel);
+
+		std::string tlutAttribute;
+		if (format.paletteSize != 0)
+			tlutAttribute = StringHelper::Sprintf(" TlutOffset=\"0x%X\"", tlutOffset);
+
+		AppendXmlElement(elements,
+		                 "<Texture Name=\"gBenchKeep%uTex\" OutName=\"bench_keep_%u\" "
+		                 "Format=\"%s\" Width=\"%u\" Height=\"%u\" Offset=\"0x%X\"%s/>",
+		                 i, i, format.name, format.width, format.height, offset,
+		                 tlutAttribute.c_str());
+
+		if (std::string_view(format.name) == "rgba16")
+			dListTextures.push_back(offset);
+	}
+
+	for (uint32_t i = 0; i < dListCount; i++)
+	{
+		uint32_t vtxCount = 16 + builder.Random() % 48;
+		uint32_t vtxOffset = builder.AppendVertices(vtxCount);
+		uint32_t offset = builder.AppendDisplayList(dListTextures[i % dListTextures.size()],
+		                                            vtxOffset, vtxCount, 8 + builder.Random() % 56);
+		AppendXmlElement(elements, "<DList Name=\"gBenchKeep%uDL\" Offset=\"0x%X\"/>", i, offset);
+	}
+
+	uint32_t blobOffset = builder.AppendTexture(0x400, 1, 8);
+	AppendXmlElement(elements, "<Blob Name=\"gBenchKeepBlob\" Size=\"0x400\" Offset=\"0x%X\"/>",
+	                 blobOffset);
+
+	return {"bench_keep", std::move(builder.data), GetXml("bench_keep", 4, elements)};
+}
+
+SyntheticSegment SyntheticSegments::GenerateRoom()
+{
+	const uint32_t meshEntryCount = 192;
+	const uint32_t textureCount = 24;
+
+	SegmentBuilder builder(3);
+
+	// SCENE_CMD_ROOM_SHAPE, SCENE_CMD_END and the RoomShapeNormal, filled in below
+	builder.AppendGfx(0x0A000000, builder.GetSegmentedAddress(0x10));
+	builder.AppendGfx(0x14000000, 0x00000000);
+	builder.AppendU32(meshEntryCount << 16);
+	builder.AppendU32(builder.GetSegmentedAddress(0x1C));
+	builder.AppendU32(builder.GetSegmentedAddress(0x1C + meshEntryCount * 8));
+	uint32_t entriesOffset = builder.GetOffset();
+	builder.data.resize(entriesOffset + meshEntryCount * 8);
+
+	std::vector<uint32_t> textures;
+	for (uint32_t i = 0; i < textureCount; i++)
+		textures.push_back(builder.AppendTexture(sDListTexWidth, sDListTexHeight, 16));
+
+	for (uint32_t i = 0; i < meshEntryCount; i++)
+	{
+		uint32_t vtxCount = 32 + builder.Random() % 96;
+		uint32_t vtxOffset = builder.AppendVertices(vtxCount);
+		uint32_t opa = builder.AppendDisplayList(textures[builder.Random() % textureCount],
+		                                         vtxOffset, vtxCount, 32 + builder.Random() % 96);
+		uint32_t xlu = 0;
+
+		if (i % 4 == 0)
+		{
+			xlu = builder.AppendDisplayList(textures[builder.Random() % textureCount], vtxOffset,
+			                                vtxCount, 4 + builder.Random() % 12);
+		}
+
+		SegmentBuilder entry(builder.segment);
+		entry.AppendU32(builder.GetSegmentedAddress(opa));
+		entry.AppendU32(xlu != 0 ? builder.GetSegmentedAddress(xlu) : 0);
+		std::copy(entry.data.begin(), entry.data.end(),
+		          builder.data.begin() + entriesOffset + i * 8);
+	}
+
+	std::string elements;
+	AppendXmlElement(elements, "<Room Name=\"bench_room_0\" Offset=\"0x0\"/>");
+
+	return {"bench_room_0", std::move(builder.data), GetXml("bench_room_0", 3, elements)};
+}
+
+SyntheticSegment SyntheticSegments::GenerateSkeletons()
+{
+	const uint32_t skeletonCount = 4;
+	const uint32_t limbCount = 21;
+	const uint32_t animationCount = 32;
+
+	SegmentBuilder builder(6);
+	std::string elements;
+
+	uint32_t texOffset = builder.AppendTexture(sDListTexWidth, sDListTexHeight, 16);
+	AppendXmlElement(elements,
+	                 "<Texture Name=\"gBenchSkelTex\" OutName=\"bench_skel\" Format=\"rgba16\" "
+	                 "Width=\"%u\" Height=\"%u\" Offset=\"0x%X\"/>",
+	                 sDListTexWidth, sDListTexHeight, texOffset);
+
+	for (uint32_t i = 0; i < skeletonCount; i++)
+	{
+		bool isFlex = i % 2 != 0;
+		std::vector<uint32_t> limbOffsets;
+
+		for (uint32_t j = 0; j < limbCount; j++)
+		{
+			uint32_t vtxCount = 12 + builder.Random() % 36;
+			uint32_t vtxOffset = builder.AppendVertices(vtxCount);
+			uint32_t dList = builder.AppendDisplayList(texOffset, vtxOffset, vtxCount,
+			                                           8 + builder.Random() % 40);
+
+			// StandardLimb
+			builder.Align(4);
+			limbOffsets.push_back(builder.GetOffset());
+			builder.AppendU16(builder.Random() % 2000 - 1000);
+			builder.AppendU16(builder.Random() % 2000 - 1000);
+			builder.AppendU16(builder.Random() % 2000 - 1000);
+			builder.AppendU8(j + 1 < limbCount ? j + 1 : 0xFF);
+			builder.AppendU8(0xFF);
+			builder.AppendU32(builder.GetSegmentedAddress(dList));
+		}
+
+		uint32_t limbTableOffset = builder.GetOffset();
+		for (uint32_t limbOffset : limbOffsets)
+			builder.AppendU32(builder.GetSegmentedAddress(limbOffset));
+
+		// SkeletonHeader or FlexSkeletonHeader
+		uint32_t offset = builder.GetOffset();
+		builder.AppendU32(builder.GetSegmentedAddress(limbTableOffset));
+		builder.AppendU32(limbCount << 24);
+		if (isFlex)
+			builder.AppendU32(limbCount << 24);
+
+		AppendXmlElement(elements,
+		                 "<Skeleton Name=\"gBenchSkel%uSkel\" Type=\"%s\" LimbType=\"Standard\" "
+		                 "Offset=\"0x%X\"/>",
+		                 i, isFlex ? "Flex" : "Normal", offset);
+	}
+
+	for (uint32_t i = 0; i < animationCount; i++)
+	{
+		// The root translation and the rotation of each limb, half of them animated
+		uint32_t frameCount = 10 + builder.Random() % 50;
+		uint32_t componentCount = (limbCount + 1) * 3;
+		uint32_t staticCount = componentCount / 2;
+
+		uint32_t valuesOffset = builder.GetOffset();
+		for (uint32_t j = 0; j < staticCount + (componentCount - staticCount) * frameCount; j++)
+			builder.AppendU16(builder.Random());
+
+		builder.Align(4);
+		uint32_t indicesOffset = builder.GetOffset();
+		for (uint32_t j = 0; j < componentCount; j++)
+			builder.AppendU16(j < staticCount ? j : staticCount + (j - staticCount) * frameCount);
+
+		// AnimationHeader
+		builder.Align(4);
+		uint32_t offset = builder.GetOffset();
+		builder.AppendU16(frameCount);
+		builder.AppendU16(0);
+		builder.AppendU32(builder.GetSegmentedAddress(valuesOffset));
+		builder.AppendU32(builder.GetSegmentedAddress(indicesOffset));
+		builder.AppendU16(staticCount);
+		builder.AppendU16(0);
+
+		AppendXmlElement(elements, "<Animation Name=\"gBenchSkel%uAnim\" Offset=\"0x%X\"/>", i,
+		                 offset);
+	}
+
+	return {"bench_skel", std::move(builder.data), GetXml("bench_skel", 6, elements)};
+}
+
+const std::vector<std::string> SyntheticSegments::numericScalarTypes = {
+	"s8", "u8", "x8", "s16", "u16", "x16", "s32", "u32", "x32", "s64", "u64",
+};
+
+SyntheticSegment SyntheticSegments::GenerateNumericArrays()
+{
+	SegmentBuilder builder(6);
+	std::string elements;
+
+	// u64 textures, then u32 ones, with and without a partial last line
+	const uint32_t textureSizes[][2] = {{16, 9}, {8, 2}, {6, 3}, {16, 4}};
+	for (uint32_t i = 0; i < std::size(textureSizes); i++)
+	{
+		uint32_t width = textureSizes[i][0];
+		uint32_t height = textureSizes[i][1];
+
+		builder.Align(8);
+		if (i >= 2)
+			builder.AppendU32(0);
+		uint32_t offset = builder.GetOffset();
+		builder.AppendNumbers(width * height, 2);
+		AppendXmlElement(elements,
+		                 "<Texture Name=\"gNumeric%uTex\" OutName=\"numeric_%u\" Format=\"rgba16\" "
+		                 "Width=\"%u\" Height=\"%u\" Offset=\"0x%X\"/>",
+		                 i, i, width, height, offset);
+	}
+
+	for (uint32_t size : {0x3B, 0x10, 0x01})
+	{
+		uint32_t offset = builder.AppendNumbers(size, 1);
+		AppendXmlElement(elements, "<Blob Name=\"gNumericBlob%X\" Size=\"0x%X\" Offset=\"0x%X\"/>",
+		                 size, size, offset);
+	}
+
+	// AnimationHeader, whose frame data is 3 lines and a partial one
+	builder.Align(4);
+	uint32_t valuesOffset = builder.AppendNumbers(14 * 3 + 4, 2);
+	uint32_t indicesOffset = builder.GetOffset();
+	for (uint32_t i = 0; i < 4 * 3; i++)
+		builder.AppendU16(i);
+	uint32_t animOffset = builder.GetOffset();
+	builder.AppendU16(2);
+	builder.AppendU16(0);
+	builder.AppendU32(builder.GetSegmentedAddress(valuesOffset));
+	builder.AppendU32(builder.GetSegmentedAddress(indicesOffset));
+	builder.AppendU16(4);
+	builder.AppendU16(0);
+	AppendXmlElement(elements, "<Animation Name=\"gNumericAnim\" Offset=\"0x%X\"/>", animOffset);
+
+	// LegacyAnimationHeaders of one limb, with and without a partial last line of frame data
+	for (uint32_t count : {19, 16})
+	{
+		builder.Align(4);
+		uint32_t frameDataOffset = builder.AppendNumbers(count, 2);
+		uint32_t jointKeyOffset = builder.GetOffset();
+		for (uint32_t i = 0; i < 2 * 6; i++)
+			builder.AppendU16(i % 2 == 0 ? 1 : 0);
+		uint32_t offset = builder.GetOffset();
+		builder.AppendU16(1);
+		builder.AppendU16(1);
+		builder.AppendU32(builder.GetSegmentedAddress(frameDataOffset));
+		builder.AppendU32(builder.GetSegmentedAddress(jointKeyOffset));
+		AppendXmlElement(elements,
+		                 "<LegacyAnimation Name=\"gNumeric%uLegacyAnim\" Offset=\"0x%X\"/>", count,
+		                 offset);
+	}
+
+	// 2 frames of 67 s16
+	uint32_t playerAnimOffset = builder.AppendNumbers(6 * 22 + 2, 2);
+	AppendXmlElement(elements,
+	                 "<PlayerAnimationData Name=\"gNumericPlayerAnimData\" FrameCount=\"2\" "
+	                 "Offset=\"0x%X\"/>",
+	                 playerAnimOffset);
+
+	builder.Align(8);
+	uint32_t vtxOffset = builder.AppendNumbers(5 * 8, 2);
+	AppendXmlElement(elements,
+	                 "<Array Name=\"gNumericVtxArray\" Count=\"5\" Offset=\"0x%X\">\n"
+	                 "            <Vtx/>\n        </Array>",
+	                 vtxOffset);
+
+	for (const std::string& type : numericScalarTypes)
+	{
+		uint32_t size = std::stoi(type.substr(1)) / 8;
+
+		builder.Align(8);
+		uint32_t offset = builder.AppendNumbers(12, size);
+		AppendXmlElement(elements,
+		                 "<Array Name=\"gNumeric%sArray\" Count=\"12\" Offset=\"0x%X\">\n"
+		                 "            <Scalar Type=\"%s\"/>\n        </Array>",
+		                 type.c_str(), offset, type.c_str());
+	}
+
+	// A JFIF header, scan data without markers, and the end of image marker, which doesn't end on
+	// a u64 boundary. The background still takes the whole screen buffer.
+	const uint8_t jfifHeader[] = {
+		0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 'J',  'F',  'I',  'F',  0x00,
+		0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB,
+	};
+
+	builder.Align(8);
+	uint32_t bgOffset = builder.GetOffset();
+	for (uint8_t byte : jfifHeader)
+		builder.AppendU8(byte);
+	for (uint32_t i = 0; i < 0x1F3; i++)
+		builder.AppendU8(builder.Random() % 0xFF);
+	builder.AppendU8(0xFF);
+	builder.AppendU8(0xD9);
+	builder.data.resize(bgOffset + 320 * 240 * 2);
+	AppendXmlElement(elements, "<Background Name=\"gNumericBackground\" Offset=\"0x%X\"/>",
+	                 bgOffset);
+
+	return {"numeric_arrays", std::move(builder.data), GetXml("numeric_arrays", 6, elements)};
+}
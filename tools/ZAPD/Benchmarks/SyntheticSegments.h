@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Utils/Directory.h"
+
+/**
+ * A segment made up for the benchmarks, with the XML describing its resources.
+ * The data is generated from a fixed seed, so every build extracts the same segments.
+ */
+struct SyntheticSegment
+{
+	std::string name;
+	std::vector<uint8_t> data;
+	std::string xml;
+
+	/**
+	 * Writes the segment as `<dir>/<name>` and its XML as `<dir>/<name>.xml`.
+	 */
+	void Write(const fs::path& dir) const;
+	fs::path GetXmlPath(const fs::path& dir) const;
+};
+
+class SyntheticSegments
+{
+public:
+	/**
+	 * An object shared by many actors, like `gameplay_keep`: textures of every format, palettes,
+	 * display lists drawing textured vertices and a blob.
+	 */
+	static SyntheticSegment GenerateKeep();
+
+	/**
+	 * A room of a large scene: a mesh header with many textured display lists.
+	 */
+	static SyntheticSegment GenerateRoom();
+
+	/**
+	 * A skeleton-heavy object: normal and flex skeletons with their limbs and display lists, and
+	 * animations of them.
+	 */
+	static SyntheticSegment GenerateSkeletons();
+
+	/**
+	 * Every resource whose body is an array of numbers: textures at 8 and 4-byte aligned offsets,
+	 * blobs, normal and legacy animation data, player animation data, arrays of `Vtx` and of
+	 * every integer scalar type, and a background. Each array starts with the edge cases of its
+	 * type, then has numbers of every length.
+	 * The arrays of scalars are named `gNumeric<type>Array`, e.g. `gNumericx16Array`.
+	 */
+	static SyntheticSegment GenerateNumericArrays();
+
+	// The types of the arrays of scalars of `GenerateNumericArrays`
+	static const std::vector<std::string> numericScalarTypes;
+};
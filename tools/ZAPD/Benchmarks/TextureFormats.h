@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "TextureCodec.h"
+
+/**
+ * The texture formats of the N64, for the benchmarks and checks of the texture code.
+ */
+struct TextureFormat
+{
+	TextureType type;
+	const char* name;
+	uint32_t bitsPerTexel;
+};
+
+inline constexpr TextureFormat gTextureFormats[] = {
+	{TextureType::RGBA32bpp, "RGBA32", 32},          {TextureType::RGBA16bpp, "RGBA16", 16},
+	{TextureType::Palette4bpp, "CI4", 4},            {TextureType::Palette8bpp, "CI8", 8},
+	{TextureType::Grayscale4bpp, "I4", 4},           {TextureType::Grayscale8bpp, "I8", 8},
+	{TextureType::GrayscaleAlpha4bpp, "IA4", 4},     {TextureType::GrayscaleAlpha8bpp, "IA8", 8},
+	{TextureType::GrayscaleAlpha16bpp, "IA16", 16},
+};
+
+inline size_t GetBytesPerPixel(PixelLayout layout)
+{
+	switch (layout)
+	{
+	case PixelLayout::RGB:
+		return 3;
+	case PixelLayout::RGBA:
+		return 4;
+	case PixelLayout::Index:
+		return 1;
+	}
+
+	return 4;
+}
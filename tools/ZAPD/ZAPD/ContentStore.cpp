@@ -0,0 +1,180 @@
+#include "ContentStore.h"
+
+#include <cinttypes>
+#include <random>
+
+#include "Utils/File.h"
+#include "Utils/Hash.h"
+#include "Utils/StringHelper.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#ifdef USE_BOOST_FS
+typedef boost::system::error_code fs_error_code;
+#else
+typedef std::error_code fs_error_code;
+#endif
+
+extern const char gBuildHash[];
+
+#if defined(__linux__) && defined(FICLONE)
+static bool CloneFile(const fs::path& from, const fs::path& to)
+{
+	int src = open(from.c_str(), O_RDONLY);
+	if (src < 0)
+		return false;
+
+	int dst = open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+	if (dst < 0)
+	{
+		close(src);
+		return false;
+	}
+
+	bool cloned = ioctl(dst, FICLONE, src) == 0;
+	close(dst);
+	close(src);
+
+	if (!cloned)
+		unlink(to.c_str());
+	return cloned;
+}
+#endif
+
+void ContentStore::SetPath(const fs::path& nStorePath)
+{
+	storePath = nStorePath;
+}
+
+bool ContentStore::IsEnabled() const
+{
+	return !storePath.empty();
+}
+
+bool ContentStore::SaveOutput(const fs::path& outPath, const std::function<uint64_t()>& getKey,
+                              const std::function<bool()>& write)
+{
+	if (!IsEnabled())
+		return write();
+
+	fs_error_code ec;
+	fs::path objectPath = GetObjectPath(outPath, getKey());
+
+	if (!fs::exists(objectPath, ec))
+	{
+		bool written = write();
+		AddObject(outPath, objectPath);
+		return written;
+	}
+
+	if (IsSameFile(outPath, objectPath))
+		return false;
+
+	// An output replaced with other contents must look newer than what was built from it, but the
+	// stored file is older. Touching it would make every output linked to it look modified, in
+	// the extractions of every version, so the new output gets a file of its own instead.
+	bool replaced = fs::exists(outPath, ec);
+	RemoveOutput(outPath);
+
+	if (replaced ? CloneOrCopyFile(objectPath, outPath) : LinkFile(objectPath, outPath))
+	{
+		numReused++;
+		return true;
+	}
+
+	write();
+	AddObject(outPath, objectPath);
+	return true;
+}
+
+size_t ContentStore::GetNumReused() const
+{
+	return numReused;
+}
+
+size_t ContentStore::GetNumStored() const
+{
+	return numStored;
+}
+
+fs::path ContentStore::GetObjectPath(const fs::path& outPath, uint64_t key) const
+{
+	// Outputs generated by another build of ZAPD may differ, so they are never shared
+	uint64_t objectKey = Hash::Fnv1a64(&key, sizeof(key), Hash::Fnv1a64(gBuildHash));
+	std::string name = StringHelper::Sprintf("%016" PRIX64, objectKey);
+
+	return storePath / name.substr(0, 2) / (name + outPath.extension().string());
+}
+
+void ContentStore::AddObject(const fs::path& outPath, const fs::path& objectPath)
+{
+	fs_error_code ec;
+
+	fs::create_directories(objectPath.parent_path(), ec);
+
+	// Other extractions may store the same object at the same time, so it's moved in place once
+	// complete
+	fs::path tempPath = objectPath;
+	tempPath += StringHelper::Sprintf(".%08X.tmp", std::random_device()());
+
+	if (!LinkFile(outPath, tempPath))
+		return;
+
+	fs::rename(tempPath, objectPath, ec);
+	if (ec)
+		fs::remove(tempPath, ec);
+	else
+		numStored++;
+}
+
+bool ContentStore::IsSameFile(const fs::path& outPath, const fs::path& objectPath)
+{
+	fs_error_code ec;
+
+	// Linked by a previous extraction
+	if (fs::equivalent(outPath, objectPath, ec))
+		return true;
+
+	// Or cloned or copied, if it couldn't be linked
+	if (!fs::exists(outPath, ec) || fs::file_size(outPath, ec) != fs::file_size(objectPath, ec))
+		return false;
+
+	std::vector<uint8_t> data = File::ReadAllBytes(objectPath);
+	return File::HasContents(outPath, reinterpret_cast<const char*>(data.data()), data.size(),
+	                         std::ios::binary);
+}
+
+void ContentStore::RemoveOutput(const fs::path& path)
+{
+	fs_error_code ec;
+	fs::remove(path, ec);
+}
+
+bool ContentStore::LinkFile(const fs::path& from, const fs::path& to)
+{
+	fs_error_code ec;
+
+	fs::create_hard_link(from, to, ec);
+	if (!ec)
+		return true;
+
+	return CloneOrCopyFile(from, to);
+}
+
+bool ContentStore::CloneOrCopyFile(const fs::path& from, const fs::path& to)
+{
+	fs_error_code ec;
+
+#if defined(__linux__) && defined(FICLONE)
+	if (CloneFile(from, to))
+		return true;
+#endif
+
+	fs::copy_file(from, to, ec);
+	return !ec;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "Utils/Directory.h"
+
+/**
+ * Shares the binary outputs of resources (PNGs, blobs, backgrounds) between extractions, most
+ * notably the extractions of every version of the game, which have most of their assets in common.
+ *
+ * Each output is identified by a key: the hash of everything it is generated from, which the
+ * resource computes from its raw data. The first extraction producing an output adds it to the
+ * store, and the next ones link the stored file to their output path instead of generating it
+ * again. Files are hardlinked when possible, then cloned (copy-on-write) and copied as a last
+ * resort. An output replacing a file with other contents is only cloned or copied, so it's newer
+ * than what was built from the previous file without modifying the stored one.
+ *
+ * Since an output may be a link to a stored file, outputs are always removed before being
+ * written, so the stored file is never modified. Outputs which already have the right contents
+ * are left untouched instead, so build systems don't see them as modified.
+ */
+class ContentStore
+{
+public:
+	void SetPath(const fs::path& nStorePath);
+	bool IsEnabled() const;
+
+	/**
+	 * Saves the output at `outPath`, whose contents are identified by the key `getKey` returns.
+	 * If the store already has it, it's linked to `outPath` unless `outPath` already has the same
+	 * contents. Otherwise `write` is called to write it, and the result is added to the store.
+	 * Without a store, `write` is always called and the key isn't computed.
+	 * `write` returns whether it wrote the file, which it shouldn't do if the file already has
+	 * the right contents. Returns whether `outPath` was written or linked.
+	 */
+	bool SaveOutput(const fs::path& outPath, const std::function<uint64_t()>& getKey,
+	                const std::function<bool()>& write);
+
+	size_t GetNumReused() const;
+	size_t GetNumStored() const;
+
+protected:
+	fs::path storePath;
+	std::atomic<size_t> numReused = 0;
+	std::atomic<size_t> numStored = 0;
+
+	fs::path GetObjectPath(const fs::path& outPath, uint64_t key) const;
+	void AddObject(const fs::path& outPath, const fs::path& objectPath);
+
+	/**
+	 * Whether the output at `outPath` already has the contents of the stored file at `objectPath`.
+	 */
+	static bool IsSameFile(const fs::path& outPath, const fs::path& objectPath);
+
+	/**
+	 * Removes the file at `path`, if any, so writing it can't modify a file it's linked to.
+	 */
+	static void RemoveOutput(const fs::path& path);
+
+	/**
+	 * Creates `to` with the contents of `from`, sharing its storage if the file system allows it.
+	 */
+	static bool LinkFile(const fs::path& from, const fs::path& to);
+	/**
+	 * Creates `to` with the contents of `from` as a file of its own, cloned if the file system
+	 * allows it.
+	 */
+	static bool CloneOrCopyFile(const fs::path& from, const fs::path& to);
+};
@@ -84,7 +84,7 @@ void ErrorHandler(int sig)
 				nameFound = demangled;
 			}
 
-			functionName = StringHelper::Sprintf("%s (+0x%X)", nameFound,
+			functionName = StringHelper::Sprintf("%s (+0x%tX)", nameFound,
 			                                     (char*)arr[i] - (char*)info.dli_saddr);
 			free(demangled);
 		}
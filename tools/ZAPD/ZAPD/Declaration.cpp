@@ -3,8 +3,12 @@
 #include "Globals.h"
 #include "Utils/StringHelper.h"
 
-Declaration::Declaration(offset_t nAddress, DeclarationAlignment nAlignment, size_t nSize,
-                         const std::string& nBody)
+Declaration::Declaration(std::pmr::memory_resource* memory, offset_t nAddress,
+                         DeclarationAlignment nAlignment, size_t nSize, const std::string& nBody)
+	: declType(GetResource(memory)), declName(GetResource(memory)), declBody(GetResource(memory)),
+	  defines(GetResource(memory)), includePath(GetResource(memory)),
+	  incbinPath(GetResource(memory)), arrayItemCntStr(GetResource(memory)),
+	  references(GetResource(memory)), referenceOffsets(GetResource(memory))
 {
 	address = nAddress;
 	alignment = nAlignment;
@@ -12,11 +16,12 @@ Declaration::Declaration(offset_t nAddress, DeclarationAlignment nAlignment, siz
 	declBody = nBody;
 }
 
-Declaration* Declaration::Create(offset_t declAddr, DeclarationAlignment declAlign, size_t declSize,
+Declaration* Declaration::Create(std::pmr::memory_resource* memory, offset_t declAddr,
+                                 DeclarationAlignment declAlign, size_t declSize,
                                  const std::string& declType, const std::string& declName,
                                  const std::string& declBody)
 {
-	Declaration* decl = new Declaration(declAddr, declAlign, declSize, declBody);
+	Declaration* decl = new (memory) Declaration(memory, declAddr, declAlign, declSize, declBody);
 
 	decl->declType = declType;
 	decl->declName = declName;
@@ -25,12 +30,13 @@ Declaration* Declaration::Create(offset_t declAddr, DeclarationAlignment declAli
 	return decl;
 }
 
-Declaration* Declaration::CreateArray(offset_t declAddr, DeclarationAlignment declAlign,
-                                      size_t declSize, const std::string& declType,
-                                      const std::string& declName, const std::string& declBody,
-                                      size_t declArrayItemCnt, bool isDeclExternal)
+Declaration* Declaration::CreateArray(std::pmr::memory_resource* memory, offset_t declAddr,
+                                      DeclarationAlignment declAlign, size_t declSize,
+                                      const std::string& declType, const std::string& declName,
+                                      const std::string& declBody, size_t declArrayItemCnt,
+                                      bool isDeclExternal)
 {
-	Declaration* decl = new Declaration(declAddr, declAlign, declSize, declBody);
+	Declaration* decl = new (memory) Declaration(memory, declAddr, declAlign, declSize, declBody);
 
 	decl->declName = declName;
 	decl->declType = declType;
@@ -41,12 +47,13 @@ Declaration* Declaration::CreateArray(offset_t declAddr, DeclarationAlignment de
 	return decl;
 }
 
-Declaration* Declaration::CreateArray(offset_t declAddr, DeclarationAlignment declAlign,
-                                      size_t declSize, const std::string& declType,
-                                      const std::string& declName, const std::string& declBody,
+Declaration* Declaration::CreateArray(std::pmr::memory_resource* memory, offset_t declAddr,
+                                      DeclarationAlignment declAlign, size_t declSize,
+                                      const std::string& declType, const std::string& declName,
+                                      const std::string& declBody,
                                       const std::string& declArrayItemCntStr, bool isDeclExternal)
 {
-	Declaration* decl = new Declaration(declAddr, declAlign, declSize, declBody);
+	Declaration* decl = new (memory) Declaration(memory, declAddr, declAlign, declSize, declBody);
 
 	decl->declName = declName;
 	decl->declType = declType;
@@ -57,11 +64,13 @@ Declaration* Declaration::CreateArray(offset_t declAddr, DeclarationAlignment de
 	return decl;
 }
 
-Declaration* Declaration::CreateInclude(offset_t declAddr, const std::string& includePath,
-                                        size_t declSize, const std::string& declType,
-                                        const std::string& declName, const std::string& defines)
+Declaration* Declaration::CreateInclude(std::pmr::memory_resource* memory, offset_t declAddr,
+                                        const std::string& includePath, size_t declSize,
+                                        const std::string& declType, const std::string& declName,
+                                        const std::string& defines)
 {
-	Declaration* decl = new Declaration(declAddr, DeclarationAlignment::Align4, declSize, "");
+	Declaration* decl =
+		new (memory) Declaration(memory, declAddr, DeclarationAlignment::Align4, declSize, "");
 	decl->includePath = includePath;
 	decl->declType = declType;
 	decl->declName = declName;
@@ -70,9 +79,11 @@ Declaration* Declaration::CreateInclude(offset_t declAddr, const std::string& in
 	return decl;
 }
 
-Declaration* Declaration::CreatePlaceholder(offset_t declAddr, const std::string& declName)
+Declaration* Declaration::CreatePlaceholder(std::pmr::memory_resource* memory, offset_t declAddr,
+                                            const std::string& declName)
 {
-	Declaration* decl = new Declaration(declAddr, DeclarationAlignment::Align4, 0, "");
+	Declaration* decl =
+		new (memory) Declaration(memory, declAddr, DeclarationAlignment::Align4, 0, "");
 	decl->declName = declName;
 	decl->isPlaceholder = true;
 
@@ -87,7 +98,7 @@ bool Declaration::IsStatic() const
 		return false;
 
 	case StaticConfig::Global:
-		return Globals::Instance->forceStatic;
+		return forceStatic;
 
 	case StaticConfig::On:
 		return true;
@@ -112,22 +123,22 @@ std::string Declaration::GetNormalDeclarationStr() const
 		if (includeArraySize)
 		{
 			if (arrayItemCntStr != "")
-				output += StringHelper::Sprintf("%s %s[%s];\n", declType.c_str(), declName.c_str(),
-				                                arrayItemCntStr.c_str());
+				StringHelper::AppendFormat(output, "%s %s[%s];\n", declType.c_str(),
+				                           declName.c_str(), arrayItemCntStr.c_str());
 			else
-				output += StringHelper::Sprintf("%s %s[%i] = {\n", declType.c_str(),
-				                                declName.c_str(), arrayItemCnt);
+				StringHelper::AppendFormat(output, "%s %s[%zu] = {\n", declType.c_str(),
+				                           declName.c_str(), arrayItemCnt);
 		}
 		else
 		{
-			output += StringHelper::Sprintf("%s %s[] = {\n", declType.c_str(), declName.c_str());
+			StringHelper::AppendFormat(output, "%s %s[] = {\n", declType.c_str(), declName.c_str());
 		}
 
 		output += declBody + "\n";
 	}
 	else
 	{
-		output += StringHelper::Sprintf("%s %s = { ", declType.c_str(), declName.c_str());
+		StringHelper::AppendFormat(output, "%s %s = { ", declType.c_str(), declName.c_str());
 		output += declBody;
 	}
 
@@ -155,23 +166,36 @@ std::string Declaration::GetExternalDeclarationStr() const
 	if (includeArraySize)
 	{
 		if (arrayItemCntStr != "")
-			output += StringHelper::Sprintf("%s %s[%s] = ", declType.c_str(), declName.c_str(),
-			                                arrayItemCntStr.c_str());
+			StringHelper::AppendFormat(output, "%s %s[%s] = ", declType.c_str(), declName.c_str(),
+			                           arrayItemCntStr.c_str());
 		else
-			output += StringHelper::Sprintf("%s %s[%i] = ", declType.c_str(), declName.c_str(),
-			                                arrayItemCnt);
+			StringHelper::AppendFormat(output, "%s %s[%zu] = ", declType.c_str(), declName.c_str(),
+			                           arrayItemCnt);
 	}
 	else
 	{
-		output += StringHelper::Sprintf("%s %s[] = ", declType.c_str(), declName.c_str());
+		StringHelper::AppendFormat(output, "%s %s[] = ", declType.c_str(), declName.c_str());
 	}
 
-	output += StringHelper::Sprintf("{\n#include \"%s\"\n};", includePath.c_str());
+	StringHelper::AppendFormat(output, "{\n#include \"%s\"\n};", includePath.c_str());
 	output += "\n\n";
 
 	return output;
 }
 
+std::string Declaration::GetIncbinDeclarationStr() const
+{
+	std::string output;
+
+	output += "GLOBAL_ASM(\n";
+	output += ".data\n";
+	StringHelper::AppendFormat(output, "dlabel %s\n", declName.c_str());
+	StringHelper::AppendFormat(output, ".incbin \"%s\", 0, 0x%zX\n", incbinPath.c_str(), size);
+	output += ")\n\n";
+
+	return output;
+}
+
 std::string Declaration::GetExternStr() const
 {
 	if (IsStatic() || declType == "" || isUnaccounted)
@@ -188,7 +212,7 @@ std::string Declaration::GetExternStr() const
 		}
 		else if (arrayItemCnt != 0 && (IsStatic() || forceArrayCnt))
 		{
-			return StringHelper::Sprintf("extern %s %s[%i];\n", declType.c_str(), declName.c_str(),
+			return StringHelper::Sprintf("extern %s %s[%zu];\n", declType.c_str(), declName.c_str(),
 			                             arrayItemCnt);
 		}
 		else
@@ -227,7 +251,7 @@ std::string Declaration::GetStaticForwardDeclarationStr() const
 		}
 		else
 		{
-			return StringHelper::Sprintf("static %s %s[%i];\n", declType.c_str(), declName.c_str(),
+			return StringHelper::Sprintf("static %s %s[%zu];\n", declType.c_str(), declName.c_str(),
 			                             arrayItemCnt);
 		}
 	}
@@ -4,11 +4,15 @@
 #include <string>
 #include <vector>
 
+#include "Utils/ArenaAllocated.h"
+
 // TODO: should we drop the `_t` suffix because of UNIX compliance?
 typedef uint32_t segptr_t;
 typedef uint32_t offset_t;
 
 #define SEGMENTED_NULL ((segptr_t)0)
+// For the offset of a pointer which isn't read from the data of a file
+#define NO_SOURCE_OFFSET ((offset_t)-1)
 
 enum class DeclarationAlignment
 {
@@ -28,8 +32,10 @@ enum class StaticConfig
 /// It contains at a minimum the address where the symbol would be in the binary file, alignment
 /// settings, the size of the binary data, and the C code that makes it up. Optionally it can also
 /// contain comments.
+/// Declarations are allocated from the arena of the file they belong to, and so are their strings
+/// and references.
 /// </summary>
-class Declaration
+class Declaration : public ArenaAllocated
 {
 public:
 	// Where in the binary file (segment) will this C code end up being?
@@ -42,19 +48,23 @@ public:
 	size_t size = 0;
 
 	// The C type of this declaration
-	std::string declType = "";
+	std::pmr::string declType;
 
 	// The C variable name of this declaration
-	std::string declName = "";
+	std::pmr::string declName;
 
 	// The body of the declaration containing the data.
 	// In "int j = 7;", "7" would be text.
-	std::string declBody = "";
+	std::pmr::string declBody;
 
 	// #define's to be included in the header
-	std::string defines = "";
+	std::pmr::string defines;
+
+	std::pmr::string includePath;
 
-	std::string includePath = "";
+	// Binary file holding the same data as the included file, which can be assembled into the
+	// object with `.incbin` instead (see `GetIncbinDeclarationStr`)
+	std::pmr::string incbinPath;
 
 	// Is this declaration in an external file? (ie. a gameplay_keep reference being found in
 	// another file that wishes to use its data)
@@ -69,9 +79,11 @@ public:
 	size_t arrayItemCnt = 0;
 
 	// Overrides the brackets for the arrays size with a custom string
-	std::string arrayItemCntStr = "";
+	std::pmr::string arrayItemCntStr;
 
-	std::vector<segptr_t> references;
+	std::pmr::vector<segptr_t> references;
+	// Offset in the file of the pointer of each of `references`
+	std::pmr::vector<offset_t> referenceOffsets;
 
 	// If true, this declaration represents data inside the file which we do not understand it's
 	// purpose for. It will be outputted as just a byte array.
@@ -86,10 +98,13 @@ public:
 	bool declaredInXml = false;
 
 	StaticConfig staticConf = StaticConfig::Global;
+	// Whether a `StaticConfig::Global` declaration is static, taken from the extraction options
+	bool forceStatic = false;
 
 	/// <summary>
 	/// Creates a regular declaration.
 	/// </summary>
+	/// <param name="memory">The memory resource to allocate the declaration from.</param>
 	/// <param name="declAddr">The address inside a binary file this declaration will be in when
 	/// compiled.</param> <param name="declAlign">The alignment of this declaration in the compiled
 	/// binary file.</param> <param name="declSize">The size of this declaration when it is compiled
@@ -97,13 +112,15 @@ public:
 	/// declared as.</param> <param name="declName">The C variable name this declaration will be
 	/// declared as.</param> <param name="declBody">The contents of the C variable
 	/// declaration.</param> <returns></returns>
-	static Declaration* Create(offset_t declAddr, DeclarationAlignment declAlign, size_t declSize,
+	static Declaration* Create(std::pmr::memory_resource* memory, offset_t declAddr,
+	                           DeclarationAlignment declAlign, size_t declSize,
 	                           const std::string& declType, const std::string& declName,
 	                           const std::string& declBody);
 
 	/// <summary>
 	/// Creates an array declaration.
 	/// </summary>
+	/// <param name="memory">The memory resource to allocate the declaration from.</param>
 	/// <param name="declAddr">The address inside a binary file this declaration will be in when
 	/// compiled.</param> <param name="declAlign">The alignment of this declaration in the compiled
 	/// binary file.</param> <param name="declSize">The size of this declaration when it is compiled
@@ -113,14 +130,16 @@ public:
 	/// declaration.</param> <param name="declArrayItemCnt">The number of items in the
 	/// array.</param> <param name="isDeclExternal">(Optional) Is this declaration from another
 	/// segment?</param> <returns></returns>
-	static Declaration* CreateArray(offset_t declAddr, DeclarationAlignment declAlign,
-	                                size_t declSize, const std::string& declType,
-	                                const std::string& declName, const std::string& declBody,
-	                                size_t declArrayItemCnt = 0, bool isDeclExternal = false);
+	static Declaration* CreateArray(std::pmr::memory_resource* memory, offset_t declAddr,
+	                                DeclarationAlignment declAlign, size_t declSize,
+	                                const std::string& declType, const std::string& declName,
+	                                const std::string& declBody, size_t declArrayItemCnt = 0,
+	                                bool isDeclExternal = false);
 
 	/// <summary>
 	/// Creates an array declaration who's size in the C code uses a custom string.
 	/// </summary>
+	/// <param name="memory">The memory resource to allocate the declaration from.</param>
 	/// <param name="declAddr">The address inside a binary file this declaration will be in when
 	/// compiled.</param> <param name="declAlign">The alignment of this declaration in the compiled
 	/// binary file.</param> <param name="declSize">The size of this declaration when it is compiled
@@ -130,15 +149,17 @@ public:
 	/// declaration.</param> <param name="declArrayItemCntStr">The string to be put in the C array's
 	/// size inbetween the brackets.</param> <param name="isDeclExternal">(Optional) Is this
 	/// declaration from another segment?</param> <returns></returns>
-	static Declaration* CreateArray(offset_t declAddr, DeclarationAlignment declAlign,
-	                                size_t declSize, const std::string& declType,
-	                                const std::string& declName, const std::string& declBody,
+	static Declaration* CreateArray(std::pmr::memory_resource* memory, offset_t declAddr,
+	                                DeclarationAlignment declAlign, size_t declSize,
+	                                const std::string& declType, const std::string& declName,
+	                                const std::string& declBody,
 	                                const std::string& declArrayItemCntStr,
 	                                bool isDeclExternal = false);
 
 	/// <summary>
 	/// Creates a declaration who's body uses a #include to include another file
 	/// </summary>
+	/// <param name="memory">The memory resource to allocate the declaration from.</param>
 	/// <param name="declAddr">The address inside a binary file this declaration will be in when
 	/// compiled.</param> <param name="includePath">The path to the file this declaration will be
 	/// #including.</param> <param name="declSize">The size of this declaration when it is compiled
@@ -146,17 +167,20 @@ public:
 	/// declared as.</param> <param name="declName">The C variable name this declaration will be
 	/// declared as.</param> <param name="defines">(Optional) Any #define's we want to have
 	/// outputted by this declaration.</param> <returns></returns>
-	static Declaration* CreateInclude(offset_t declAddr, const std::string& includePath,
-	                                  size_t declSize, const std::string& declType,
-	                                  const std::string& declName, const std::string& defines = "");
+	static Declaration* CreateInclude(std::pmr::memory_resource* memory, offset_t declAddr,
+	                                  const std::string& includePath, size_t declSize,
+	                                  const std::string& declType, const std::string& declName,
+	                                  const std::string& defines = "");
 
 	/// <summary>
 	/// Creates a placeholder declaration to be replaced later.
 	/// </summary>
+	/// <param name="memory">The memory resource to allocate the declaration from.</param>
 	/// <param name="declAddr">The address inside a binary file this declaration will be in when
 	/// compiled.</param> <param name="declName">The C variable name this declaration will be
 	/// declared as.</param> <returns></returns>
-	static Declaration* CreatePlaceholder(offset_t declAddr, const std::string& declName);
+	static Declaration* CreatePlaceholder(std::pmr::memory_resource* memory, offset_t declAddr,
+	                                      const std::string& declName);
 
 	bool IsStatic() const;
 
@@ -168,6 +192,12 @@ public:
 	// another file
 	std::string GetExternalDeclarationStr() const;
 
+	// Returns the declaration as an asm_processor `GLOBAL_ASM` block which `.incbin`s
+	// `incbinPath`, for when the C arrays of big binary files take too long to compile.
+	// The symbol ends up at the same place as the C array only if nothing has to be padded before
+	// it, so it is up to the caller to check that.
+	std::string GetIncbinDeclarationStr() const;
+
 	// Generates the extern for this item to be placed in header files.
 	std::string GetExternStr() const;
 
@@ -177,6 +207,6 @@ public:
 	std::string GetStaticForwardDeclarationStr() const;
 
 protected:
-	Declaration(offset_t nAddress, DeclarationAlignment nAlignment, size_t nSize,
-	            const std::string& nBody);
+	Declaration(std::pmr::memory_resource* memory, offset_t nAddress,
+	            DeclarationAlignment nAlignment, size_t nSize, const std::string& nBody);
 };
@@ -0,0 +1,527 @@
+#include "ElfObject.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#include "Utils/BEView.h"
+#include "Utils/BitConverter.h"
+#include "Utils/StringHelper.h"
+
+static constexpr uint32_t ElfHeaderSize = 0x34;
+static constexpr uint32_t SectionHeaderSize = 0x28;
+static constexpr uint32_t SymbolSize = 0x10;
+static constexpr uint32_t RelSize = 0x08;
+static constexpr uint32_t RelaSize = 0x0C;
+
+// -mips2, like the objects built by IDO
+static constexpr uint32_t ElfFlagsMips2 = 0x10000000;
+
+static void Write16(std::vector<uint8_t>& out, uint16_t value)
+{
+	out.push_back(value >> 8);
+	out.push_back(value & 0xFF);
+}
+
+static void Write32(std::vector<uint8_t>& out, uint32_t value)
+{
+	out.push_back(value >> 24);
+	out.push_back((value >> 16) & 0xFF);
+	out.push_back((value >> 8) & 0xFF);
+	out.push_back(value & 0xFF);
+}
+
+static uint32_t AddString(std::string& table, const std::string& str)
+{
+	if (str == "")
+		return 0;
+
+	uint32_t offset = table.size();
+	table += str;
+	table += '\0';
+	return offset;
+}
+
+static std::string ReadString(const std::vector<uint8_t>& table, uint32_t offset)
+{
+	if (offset >= table.size())
+		return "";
+
+	const char* str = reinterpret_cast<const char*>(table.data() + offset);
+	return std::string(str, strnlen(str, table.size() - offset));
+}
+
+ElfObject::ElfObject()
+{
+	sections.emplace_back();
+	symbols.emplace_back();
+}
+
+uint16_t ElfObject::AddSection(const std::string& name, uint32_t type, uint32_t flags,
+                               uint32_t addralign, const std::vector<uint8_t>& data)
+{
+	Section section;
+	section.name = name;
+	section.type = type;
+	section.flags = flags;
+	section.size = data.size();
+	section.addralign = addralign;
+	section.data = data;
+	sections.push_back(section);
+	return sections.size() - 1;
+}
+
+uint32_t ElfObject::AddSymbol(const Symbol& symbol)
+{
+	symbols.push_back(symbol);
+	return symbols.size() - 1;
+}
+
+std::vector<uint8_t> ElfObject::Serialize() const
+{
+	// The null symbol, then the local symbols, then the global ones
+	std::vector<uint32_t> symbolOrder = {0};
+	for (size_t i = 1; i < symbols.size(); i++)
+	{
+		if (symbols[i].bind == SymbolBindLocal)
+			symbolOrder.push_back(i);
+	}
+	uint32_t firstGlobal = symbolOrder.size();
+	for (size_t i = 1; i < symbols.size(); i++)
+	{
+		if (symbols[i].bind != SymbolBindLocal)
+			symbolOrder.push_back(i);
+	}
+
+	std::vector<uint32_t> newSymbolIndex(symbols.size());
+	for (size_t i = 0; i < symbolOrder.size(); i++)
+		newSymbolIndex[symbolOrder[i]] = i;
+
+	std::set<uint16_t> relocatedSections;
+	for (const Relocation& reloc : relocations)
+		relocatedSections.insert(reloc.sectionIndex);
+
+	std::vector<Section> allSections = sections;
+	uint32_t symTabIndex = allSections.size() + relocatedSections.size();
+
+	// Relocations are always written as `.rel`, with their addends in the relocated data
+	for (uint16_t sectionIndex : relocatedSections)
+	{
+		Section rel;
+		rel.name = ".rel" + sections.at(sectionIndex).name;
+		rel.type = SectionTypeRel;
+		rel.link = symTabIndex;
+		rel.info = sectionIndex;
+		rel.addralign = 4;
+		rel.entsize = RelSize;
+
+		for (const Relocation& reloc : relocations)
+		{
+			if (reloc.sectionIndex != sectionIndex)
+				continue;
+
+			Write32(rel.data, reloc.offset);
+			Write32(rel.data, (newSymbolIndex.at(reloc.symbolIndex) << 8) | reloc.type);
+		}
+
+		allSections.push_back(rel);
+	}
+
+	Section symTab;
+	symTab.name = ".symtab";
+	symTab.type = SectionTypeSymTab;
+	symTab.link = symTabIndex + 1;
+	symTab.info = firstGlobal;
+	symTab.addralign = 4;
+	symTab.entsize = SymbolSize;
+
+	std::string strTab(1, '\0');
+	for (uint32_t i : symbolOrder)
+	{
+		const Symbol& symbol = symbols[i];
+
+		Write32(symTab.data, AddString(strTab, symbol.name));
+		Write32(symTab.data, symbol.value);
+		Write32(symTab.data, symbol.size);
+		symTab.data.push_back((symbol.bind << 4) | symbol.type);
+		symTab.data.push_back(0);
+		Write16(symTab.data, symbol.sectionIndex);
+	}
+	allSections.push_back(symTab);
+
+	Section strTabSection;
+	strTabSection.name = ".strtab";
+	strTabSection.type = SectionTypeStrTab;
+	strTabSection.addralign = 1;
+	strTabSection.data.assign(strTab.begin(), strTab.end());
+	allSections.push_back(strTabSection);
+
+	Section shStrTabSection;
+	shStrTabSection.name = ".shstrtab";
+	shStrTabSection.type = SectionTypeStrTab;
+	shStrTabSection.addralign = 1;
+	allSections.push_back(shStrTabSection);
+
+	std::string shStrTab(1, '\0');
+	std::vector<uint32_t> nameOffsets;
+	for (const Section& section : allSections)
+		nameOffsets.push_back(AddString(shStrTab, section.name));
+	allSections.back().data.assign(shStrTab.begin(), shStrTab.end());
+
+	// Section contents follow the ELF header, then come the section headers
+	std::vector<uint8_t> out(ElfHeaderSize);
+	std::vector<uint32_t> dataOffsets(allSections.size(), 0);
+	for (size_t i = 1; i < allSections.size(); i++)
+	{
+		const Section& section = allSections[i];
+		if (section.type == SectionTypeNoBits)
+			continue;
+
+		uint32_t alignment = std::max<uint32_t>(section.addralign, 1);
+		while (out.size() % alignment != 0)
+			out.push_back(0);
+
+		dataOffsets[i] = out.size();
+		out.insert(out.end(), section.data.begin(), section.data.end());
+	}
+
+	while (out.size() % 4 != 0)
+		out.push_back(0);
+	uint32_t sectionHeadersOffset = out.size();
+
+	for (size_t i = 0; i < allSections.size(); i++)
+	{
+		const Section& section = allSections[i];
+		uint32_t size = (section.type == SectionTypeNoBits) ? section.size : section.data.size();
+
+		Write32(out, nameOffsets[i]);
+		Write32(out, section.type);
+		Write32(out, section.flags);
+		Write32(out, 0);
+		Write32(out, dataOffsets[i]);
+		Write32(out, size);
+		Write32(out, section.link);
+		Write32(out, section.info);
+		Write32(out, section.addralign);
+		Write32(out, section.entsize);
+	}
+
+	std::vector<uint8_t> header;
+	header.insert(header.end(), {0x7F, 'E', 'L', 'F', 1, 2, 1, 0});
+	header.resize(0x10, 0);
+	Write16(header, 1);  // ET_REL
+	Write16(header, 8);  // EM_MIPS
+	Write32(header, 1);  // EV_CURRENT
+	Write32(header, 0);
+	Write32(header, 0);
+	Write32(header, sectionHeadersOffset);
+	Write32(header, ElfFlagsMips2);
+	Write16(header, ElfHeaderSize);
+	Write16(header, 0);
+	Write16(header, 0);
+	Write16(header, SectionHeaderSize);
+	Write16(header, allSections.size());
+	Write16(header, allSections.size() - 1);
+	std::copy(header.begin(), header.end(), out.begin());
+
+	return out;
+}
+
+ElfObject ElfObject::Parse(const std::vector<uint8_t>& fileData)
+{
+	ByteSpan data(fileData);
+
+	if (data.size() < ElfHeaderSize || memcmp(data.data(), "\x7F" "ELF", 4) != 0 ||
+	    data[4] != 1 || data[5] != 2 || BitConverter::ToUInt16BE(data, 0x10) != 1)
+	{
+		throw std::runtime_error("not a 32-bit big-endian relocatable ELF object");
+	}
+
+	uint32_t sectionHeadersOffset = BitConverter::ToUInt32BE(data, 0x20);
+	uint16_t sectionHeaderSize = BitConverter::ToUInt16BE(data, 0x2E);
+	uint16_t numSections = BitConverter::ToUInt16BE(data, 0x30);
+	uint16_t shStrTabIndex = BitConverter::ToUInt16BE(data, 0x32);
+
+	ElfObject object;
+	object.sections.clear();
+	object.symbols.clear();
+
+	std::vector<uint32_t> nameOffsets;
+	for (uint16_t i = 0; i < numSections; i++)
+	{
+		BEView header(data, sectionHeadersOffset + i * sectionHeaderSize, SectionHeaderSize);
+		Section section;
+
+		nameOffsets.push_back(header.ReadUInt32(0x00));
+		section.type = header.ReadUInt32(0x04);
+		section.flags = header.ReadUInt32(0x08);
+		uint32_t offset = header.ReadUInt32(0x10);
+		section.size = header.ReadUInt32(0x14);
+		section.link = header.ReadUInt32(0x18);
+		section.info = header.ReadUInt32(0x1C);
+		section.addralign = header.ReadUInt32(0x20);
+		section.entsize = header.ReadUInt32(0x24);
+
+		if (section.type != SectionTypeNoBits && i != 0)
+		{
+			BEView contents(data, offset, section.size);
+			section.data.assign(contents.data(), contents.data() + contents.size());
+		}
+
+		object.sections.push_back(section);
+	}
+
+	if (shStrTabIndex < object.sections.size())
+	{
+		const std::vector<uint8_t>& shStrTab = object.sections[shStrTabIndex].data;
+		for (size_t i = 0; i < object.sections.size(); i++)
+			object.sections[i].name = ReadString(shStrTab, nameOffsets[i]);
+	}
+
+	for (uint16_t i = 0; i < object.sections.size(); i++)
+	{
+		const Section& section = object.sections[i];
+
+		if (section.type == SectionTypeSymTab && object.symbols.empty())
+		{
+			const std::vector<uint8_t>& strTab = object.sections.at(section.link).data;
+
+			for (size_t offset = 0; offset + SymbolSize <= section.data.size();
+			     offset += SymbolSize)
+			{
+				BEView entry(section.data, offset, SymbolSize);
+				Symbol symbol;
+
+				symbol.name = ReadString(strTab, entry.ReadUInt32(0x00));
+				symbol.value = entry.ReadUInt32(0x04);
+				symbol.size = entry.ReadUInt32(0x08);
+				symbol.bind = entry.ReadUInt8(0x0C) >> 4;
+				symbol.type = entry.ReadUInt8(0x0C) & 0xF;
+				symbol.sectionIndex = entry.ReadUInt16(0x0E);
+				object.symbols.push_back(symbol);
+			}
+		}
+		else if (section.type == SectionTypeRel || section.type == SectionTypeRela)
+		{
+			bool hasAddend = (section.type == SectionTypeRela);
+			uint32_t entrySize = hasAddend ? RelaSize : RelSize;
+
+			for (size_t offset = 0; offset + entrySize <= section.data.size();
+			     offset += entrySize)
+			{
+				BEView entry(section.data, offset, entrySize);
+				Relocation reloc;
+
+				reloc.sectionIndex = section.info;
+				reloc.offset = entry.ReadUInt32(0x00);
+				reloc.symbolIndex = entry.ReadUInt32(0x04) >> 8;
+				reloc.type = entry.ReadUInt32(0x04) & 0xFF;
+				reloc.hasAddend = hasAddend;
+				if (hasAddend)
+					reloc.addend = entry.ReadInt32(0x08);
+				object.relocations.push_back(reloc);
+			}
+		}
+	}
+
+	return object;
+}
+
+std::vector<std::string> ElfObject::Compare(const ElfObject& object, const ElfObject& reference)
+{
+	std::vector<std::string> differences;
+
+	std::map<std::string, const Section*> objectSections;
+	std::map<std::string, const Section*> referenceSections;
+	std::set<std::string> sectionNames;
+	for (const Section& section : object.sections)
+	{
+		if (object.IsLinkedSection(section))
+		{
+			objectSections[section.name] = &section;
+			sectionNames.insert(section.name);
+		}
+	}
+	for (const Section& section : reference.sections)
+	{
+		if (reference.IsLinkedSection(section))
+		{
+			referenceSections[section.name] = &section;
+			sectionNames.insert(section.name);
+		}
+	}
+
+	// Relocations, by section and offset
+	std::map<std::pair<std::string, uint32_t>, std::string> objectRelocs;
+	std::map<std::pair<std::string, uint32_t>, std::string> referenceRelocs;
+	for (const Relocation& reloc : object.relocations)
+	{
+		const std::string& sectionName = object.sections.at(reloc.sectionIndex).name;
+		objectRelocs[{sectionName, reloc.offset}] = object.DescribeRelocation(reloc);
+	}
+	for (const Relocation& reloc : reference.relocations)
+	{
+		const std::string& sectionName = reference.sections.at(reloc.sectionIndex).name;
+		referenceRelocs[{sectionName, reloc.offset}] = reference.DescribeRelocation(reloc);
+	}
+
+	for (const std::string& name : sectionNames)
+	{
+		auto objectIt = objectSections.find(name);
+		auto referenceIt = referenceSections.find(name);
+		uint32_t objectSize = (objectIt != objectSections.end()) ? objectIt->second->size : 0;
+		uint32_t referenceSize =
+			(referenceIt != referenceSections.end()) ? referenceIt->second->size : 0;
+
+		if (objectSize != referenceSize)
+		{
+			differences.push_back(StringHelper::Sprintf("section %s has size 0x%X, expected 0x%X",
+			                                            name.c_str(), objectSize, referenceSize));
+			continue;
+		}
+		if (objectSize == 0)
+			continue;
+
+		const Section& objectSection = *objectIt->second;
+		const Section& referenceSection = *referenceIt->second;
+		if (objectSection.type != referenceSection.type)
+		{
+			differences.push_back(
+				StringHelper::Sprintf("section %s has type %u, expected %u", name.c_str(),
+			                          objectSection.type, referenceSection.type));
+			continue;
+		}
+		if (objectSection.type == SectionTypeNoBits)
+			continue;
+
+		// Relocated words hold addends, which depend on the symbols the relocations use.
+		// Where they point to is compared below instead.
+		size_t numDiffering = 0;
+		uint32_t firstDiffering = 0;
+		for (uint32_t i = 0; i < objectSize; i++)
+		{
+			uint32_t word = i & ~3;
+			if (objectRelocs.count({name, word}) != 0 || referenceRelocs.count({name, word}) != 0)
+				continue;
+
+			if (objectSection.data[i] != referenceSection.data[i])
+			{
+				if (numDiffering == 0)
+					firstDiffering = i;
+				numDiffering++;
+			}
+		}
+
+		if (numDiffering != 0)
+		{
+			differences.push_back(
+				StringHelper::Sprintf("section %s: %zu bytes differ, starting at 0x%X",
+			                          name.c_str(), numDiffering, firstDiffering));
+		}
+	}
+
+	for (const auto& [key, description] : objectRelocs)
+	{
+		auto it = referenceRelocs.find(key);
+		if (it == referenceRelocs.end())
+		{
+			differences.push_back(StringHelper::Sprintf("unexpected relocation at %s+0x%X: %s",
+			                                            key.first.c_str(), key.second,
+			                                            description.c_str()));
+		}
+		else if (it->second != description)
+		{
+			differences.push_back(StringHelper::Sprintf(
+				"relocation at %s+0x%X is %s, expected %s", key.first.c_str(), key.second,
+				description.c_str(), it->second.c_str()));
+		}
+	}
+	for (const auto& [key, description] : referenceRelocs)
+	{
+		if (objectRelocs.count(key) == 0)
+		{
+			differences.push_back(StringHelper::Sprintf("missing relocation at %s+0x%X: %s",
+			                                            key.first.c_str(), key.second,
+			                                            description.c_str()));
+		}
+	}
+
+	// Global symbols, as "<section>+<value>"
+	std::map<std::string, std::string> objectSymbols;
+	std::map<std::string, std::string> referenceSymbols;
+	for (const Symbol& symbol : object.symbols)
+	{
+		if (symbol.bind != SymbolBindLocal && symbol.sectionIndex != SectionIndexUndefined &&
+		    symbol.sectionIndex < SectionIndexReserved)
+		{
+			objectSymbols[symbol.name] = StringHelper::Sprintf(
+				"%s+0x%X", object.sections.at(symbol.sectionIndex).name.c_str(), symbol.value);
+		}
+	}
+	for (const Symbol& symbol : reference.symbols)
+	{
+		if (symbol.bind != SymbolBindLocal && symbol.sectionIndex != SectionIndexUndefined &&
+		    symbol.sectionIndex < SectionIndexReserved)
+		{
+			referenceSymbols[symbol.name] = StringHelper::Sprintf(
+				"%s+0x%X", reference.sections.at(symbol.sectionIndex).name.c_str(), symbol.value);
+		}
+	}
+
+	for (const auto& [name, location] : objectSymbols)
+	{
+		auto it = referenceSymbols.find(name);
+		if (it == referenceSymbols.end())
+		{
+			differences.push_back(StringHelper::Sprintf("unexpected symbol %s at %s", name.c_str(),
+			                                            location.c_str()));
+		}
+		else if (it->second != location)
+		{
+			differences.push_back(StringHelper::Sprintf("symbol %s is at %s, expected %s",
+			                                            name.c_str(), location.c_str(),
+			                                            it->second.c_str()));
+		}
+	}
+	for (const auto& [name, location] : referenceSymbols)
+	{
+		if (objectSymbols.count(name) == 0)
+		{
+			differences.push_back(StringHelper::Sprintf("missing symbol %s at %s", name.c_str(),
+			                                            location.c_str()));
+		}
+	}
+
+	return differences;
+}
+
+std::string ElfObject::DescribeRelocation(const Relocation& reloc) const
+{
+	const Section& section = sections.at(reloc.sectionIndex);
+	const Symbol& symbol = symbols.at(reloc.symbolIndex);
+	uint32_t addend = reloc.addend;
+
+	if (!reloc.hasAddend && reloc.type == RelocationMips32 &&
+	    reloc.offset + 4 <= section.data.size())
+	{
+		addend = BitConverter::ToUInt32BE(section.data, reloc.offset);
+	}
+
+	std::string target = symbol.name;
+	if (symbol.sectionIndex != SectionIndexUndefined && symbol.sectionIndex < SectionIndexReserved)
+	{
+		target = sections.at(symbol.sectionIndex).name;
+		addend += symbol.value;
+	}
+
+	return StringHelper::Sprintf("type %u to %s+0x%X", reloc.type, target.c_str(), addend);
+}
+
+bool ElfObject::IsLinkedSection(const Section& section) const
+{
+	// Processor-specific sections, like `.reginfo`, are not linked with the data
+	return (section.flags & SectionFlagAlloc) &&
+	       (section.type == SectionTypeProgBits || section.type == SectionTypeNoBits);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A relocatable 32-bit big-endian MIPS ELF object, reduced to what the linker uses of a data-only
+ * asset file: its sections, its symbols and the relocations of its data.
+ *
+ * With `--emit-objects`, ZAPD writes one for every extracted file next to its C file, so the
+ * assets can be linked without compiling them. The `vobj` mode reads one back and compares it
+ * with the object the compiler built from the C file.
+ */
+class ElfObject
+{
+public:
+	static constexpr uint32_t SectionTypeProgBits = 1;
+	static constexpr uint32_t SectionTypeSymTab = 2;
+	static constexpr uint32_t SectionTypeStrTab = 3;
+	static constexpr uint32_t SectionTypeRela = 4;
+	static constexpr uint32_t SectionTypeNoBits = 8;
+	static constexpr uint32_t SectionTypeRel = 9;
+
+	static constexpr uint32_t SectionFlagWrite = 0x1;
+	static constexpr uint32_t SectionFlagAlloc = 0x2;
+
+	static constexpr uint16_t SectionIndexUndefined = 0;
+	static constexpr uint16_t SectionIndexReserved = 0xFF00;
+
+	static constexpr uint8_t SymbolBindLocal = 0;
+	static constexpr uint8_t SymbolBindGlobal = 1;
+	static constexpr uint8_t SymbolBindWeak = 2;
+	static constexpr uint8_t SymbolTypeObject = 1;
+	static constexpr uint8_t SymbolTypeSection = 3;
+
+	static constexpr uint8_t RelocationMips32 = 2;
+
+	struct Section
+	{
+		std::string name;
+		uint32_t type = 0;
+		uint32_t flags = 0;
+		uint32_t size = 0;
+		uint32_t link = 0;
+		uint32_t info = 0;
+		uint32_t addralign = 0;
+		uint32_t entsize = 0;
+		// Empty for sections without contents, like `.bss`
+		std::vector<uint8_t> data;
+	};
+
+	struct Symbol
+	{
+		std::string name;
+		uint32_t value = 0;
+		uint32_t size = 0;
+		uint8_t bind = SymbolBindLocal;
+		uint8_t type = 0;
+		uint16_t sectionIndex = SectionIndexUndefined;
+	};
+
+	struct Relocation
+	{
+		// The section whose data is relocated
+		uint16_t sectionIndex = 0;
+		uint32_t offset = 0;
+		uint32_t symbolIndex = 0;
+		uint8_t type = 0;
+		// `.rela` relocations have their addend here, `.rel` ones in the relocated data
+		bool hasAddend = false;
+		int32_t addend = 0;
+	};
+
+	// Both start with the null entry ELF requires
+	std::vector<Section> sections;
+	std::vector<Symbol> symbols;
+	std::vector<Relocation> relocations;
+
+	ElfObject();
+
+	uint16_t AddSection(const std::string& name, uint32_t type, uint32_t flags,
+	                    uint32_t addralign, const std::vector<uint8_t>& data);
+	uint32_t AddSymbol(const Symbol& symbol);
+
+	/**
+	 * Returns the contents of the object file. The symbol table, its string tables and the `.rel`
+	 * sections of the relocations are generated here, with the local symbols moved first as ELF
+	 * requires, so `sections` and `symbols` shouldn't have any of them.
+	 */
+	std::vector<uint8_t> Serialize() const;
+
+	/**
+	 * Reads an object file. Throws `std::runtime_error` if it isn't a 32-bit big-endian
+	 * relocatable ELF object.
+	 */
+	static ElfObject Parse(const std::vector<uint8_t>& fileData);
+
+	/**
+	 * Compares `object` with `reference` as far as the linker is concerned: the contents and
+	 * sizes of the sections it links, the addresses of the global symbols, and where every
+	 * relocation points to. Symbols are allowed to be local in one and section-relative in the
+	 * other, and sizes of symbols are not compared, since compilers don't agree on them.
+	 * Returns a description of every difference, which is empty if the objects are equivalent.
+	 */
+	static std::vector<std::string> Compare(const ElfObject& object, const ElfObject& reference);
+
+protected:
+	/**
+	 * A relocation as "<type> <target>+<addend>", where the target is the section of a defined
+	 * symbol or the name of an undefined one.
+	 */
+	std::string DescribeRelocation(const Relocation& reloc) const;
+	bool IsLinkedSection(const Section& section) const;
+};
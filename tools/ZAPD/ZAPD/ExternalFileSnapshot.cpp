@@ -0,0 +1,485 @@
+#include "ExternalFileSnapshot.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <random>
+
+#include "ExtractionContext.h"
+#include "Globals.h"
+#include "Utils/BinaryImage.h"
+#include "Utils/File.h"
+#include "Utils/Hash.h"
+#include "Utils/StringHelper.h"
+#include "ZSymbol.h"
+
+#ifdef USE_BOOST_FS
+typedef boost::system::error_code fs_error_code;
+#else
+typedef std::error_code fs_error_code;
+#endif
+
+extern const char gBuildHash[];
+
+// "ZSNP", read in the byte order of the machine, so snapshots from another one are ignored
+#define SNAPSHOT_MAGIC 0x5A534E50
+// Bump every time the layout or the meaning of the snapshot changes
+#define SNAPSHOT_VERSION 2
+
+// The snapshot is a header followed by the tables of entries, declarations and symbols, and the
+// string table. Every string is stored once, as an offset in the string table.
+struct SnapshotHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint32_t numEntries;
+	uint32_t numDeclarations;
+	uint32_t numSymbols;
+	uint32_t stringsSize;
+};
+
+enum SnapshotEntryKind : uint32_t
+{
+	EntryKindFile,
+	EntryKindExternalFile,
+};
+
+// The range of the file ends at the end of its baserom file, which is only known once it's opened
+#define ENTRY_FLAG_RANGE_END_IS_FILE_SIZE (1 << 0)
+
+struct SnapshotEntry
+{
+	uint32_t kind;
+	// For `ExternalFile` elements, their `XmlPath` and `OutPath`
+	uint32_t name;
+	uint32_t outName;
+	uint32_t game;
+	uint32_t flags;
+	uint32_t segment;
+	uint32_t baseAddress;
+	uint32_t rangeStart;
+	uint32_t rangeEnd;
+	uint32_t firstDeclaration;
+	uint32_t numDeclarations;
+	uint32_t firstSymbol;
+	uint32_t numSymbols;
+	// The baserom file the declarations were parsed from, which must not have changed since
+	uint32_t rawDataSize;
+	int64_t rawDataTime;
+};
+
+#define DECLARATION_FLAG_ARRAY (1 << 0)
+#define DECLARATION_FLAG_IN_XML (1 << 1)
+#define DECLARATION_FLAG_ALIGN8 (1 << 2)
+
+struct SnapshotDeclaration
+{
+	uint32_t address;
+	uint32_t size;
+	uint32_t type;
+	uint32_t name;
+	uint32_t arrayItemCnt;
+	uint32_t flags;
+};
+
+struct SnapshotSymbol
+{
+	uint32_t offset;
+	uint32_t type;
+	uint32_t name;
+	uint32_t typeSize;
+	uint32_t count;
+	uint32_t isArray;
+};
+
+// Offsets of the tables in the snapshot
+static size_t GetEntriesOffset()
+{
+	return sizeof(SnapshotHeader);
+}
+
+static size_t GetDeclarationsOffset(const SnapshotHeader& header)
+{
+	return GetEntriesOffset() + header.numEntries * sizeof(SnapshotEntry);
+}
+
+static size_t GetSymbolsOffset(const SnapshotHeader& header)
+{
+	return GetDeclarationsOffset(header) + header.numDeclarations * sizeof(SnapshotDeclaration);
+}
+
+static size_t GetStringsOffset(const SnapshotHeader& header)
+{
+	return GetSymbolsOffset(header) + header.numSymbols * sizeof(SnapshotSymbol);
+}
+
+ExternalFileSnapshot::ExternalFileSnapshot(const fs::path& nXmlFilePath,
+                                           const fs::path& nBasePath, ZGame nGame)
+	: xmlFilePath(nXmlFilePath), basePath(nBasePath), game(nGame)
+{
+	// Everything the declarations depend on, besides the baserom files, which are only known
+	// once the XML is parsed and are checked by `Load`
+	uint32_t keyHeader[] = {SNAPSHOT_VERSION, static_cast<uint32_t>(game),
+	                        Globals::Instance->useLegacyZDList};
+	std::vector<uint8_t> xmlData = File::ReadAllBytes(xmlFilePath);
+
+	key = Hash::Fnv1a64(gBuildHash);
+	key = Hash::Fnv1a64(keyHeader, sizeof(keyHeader), key);
+	key = Hash::Fnv1a64(xmlData.data(), xmlData.size(), key);
+
+	// The config files (symbol map, texture pool...), which are only compared by their size and
+	// modification time, like the baserom files
+	for (const fs::path& inputFile : Globals::Instance->cfg.inputFiles)
+	{
+		uint64_t size = 0;
+		int64_t time = 0;
+
+		File::GetSizeAndTime(inputFile, size, time);
+		key = Hash::Fnv1a64(inputFile.string(), key);
+		key = Hash::Fnv1a64(&size, sizeof(size), key);
+		key = Hash::Fnv1a64(&time, sizeof(time), key);
+	}
+
+	// Every snapshot of the XML starts with its name and a hash of its path, so XMLs with the same
+	// name in other folders keep snapshots of their own
+	fileNamePrefix =
+		StringHelper::Sprintf("%s.%08X.", xmlFilePath.stem().string().c_str(),
+		                      static_cast<uint32_t>(Hash::Fnv1a64(xmlFilePath.string())));
+	snapshotPath = Globals::Instance->externalSnapshotsPath /
+	               StringHelper::Sprintf("%s%016" PRIX64 ".snapshot", fileNamePrefix.c_str(), key);
+}
+
+ExternalFileSnapshot::~ExternalFileSnapshot() = default;
+
+bool ExternalFileSnapshot::Load()
+{
+	fs_error_code ec;
+
+	if (!fs::exists(snapshotPath, ec))
+		return false;
+
+	snapshotFile = std::make_unique<MappedFile>(snapshotPath);
+	if (!IsValid(snapshotFile->GetData()) || !AreRawDataFilesUnchanged(snapshotFile->GetData()))
+	{
+		snapshotFile.reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool ExternalFileSnapshot::AreRawDataFilesUnchanged(const ByteSpan& data) const
+{
+	const SnapshotHeader& header = *reinterpret_cast<const SnapshotHeader*>(data.data());
+	const SnapshotEntry* entries =
+		reinterpret_cast<const SnapshotEntry*>(data.data() + GetEntriesOffset());
+	const char* strings = reinterpret_cast<const char*>(data.data() + GetStringsOffset(header));
+	fs::path rawDataPath = basePath == "" ? fs::path(Directory::GetCurrentDirectory()) : basePath;
+
+	for (uint32_t i = 0; i < header.numEntries; i++)
+	{
+		const SnapshotEntry& entry = entries[i];
+		uint64_t size;
+		int64_t time;
+
+		if (entry.kind != EntryKindFile)
+			continue;
+
+		if (!File::GetSizeAndTime(rawDataPath / (strings + entry.name), size, time) ||
+		    size != entry.rawDataSize || time != entry.rawDataTime)
+			return false;
+	}
+
+	return true;
+}
+
+bool ExternalFileSnapshot::IsValid(const ByteSpan& data) const
+{
+	const SnapshotHeader* headerPtr =
+		BinaryImage::GetHeader<SnapshotHeader>(data, SNAPSHOT_MAGIC, SNAPSHOT_VERSION);
+	if (headerPtr == nullptr || headerPtr->key != key)
+		return false;
+
+	const SnapshotHeader& header = *headerPtr;
+	if (!BinaryImage::HasLayout(data, sizeof(SnapshotHeader),
+	                            {{header.numEntries, sizeof(SnapshotEntry)},
+	                             {header.numDeclarations, sizeof(SnapshotDeclaration)},
+	                             {header.numSymbols, sizeof(SnapshotSymbol)}},
+	                            header.stringsSize))
+		return false;
+
+	auto isString = [&header](uint32_t offset) { return offset < header.stringsSize; };
+
+	const SnapshotEntry* entries =
+		reinterpret_cast<const SnapshotEntry*>(data.data() + GetEntriesOffset());
+	for (uint32_t i = 0; i < header.numEntries; i++)
+	{
+		const SnapshotEntry& entry = entries[i];
+
+		if (!isString(entry.name) || !isString(entry.outName))
+			return false;
+		if (uint64_t(entry.firstDeclaration) + entry.numDeclarations > header.numDeclarations ||
+		    uint64_t(entry.firstSymbol) + entry.numSymbols > header.numSymbols)
+			return false;
+	}
+
+	const SnapshotDeclaration* declarations =
+		reinterpret_cast<const SnapshotDeclaration*>(data.data() + GetDeclarationsOffset(header));
+	for (uint32_t i = 0; i < header.numDeclarations; i++)
+	{
+		if (!isString(declarations[i].type) || !isString(declarations[i].name))
+			return false;
+	}
+
+	const SnapshotSymbol* symbols =
+		reinterpret_cast<const SnapshotSymbol*>(data.data() + GetSymbolsOffset(header));
+	for (uint32_t i = 0; i < header.numSymbols; i++)
+	{
+		if (!isString(symbols[i].type) || !isString(symbols[i].name))
+			return false;
+	}
+
+	return true;
+}
+
+bool ExternalFileSnapshot::Restore(
+	ExtractionContext& ctx, const fs::path& basePath, const fs::path& outPath,
+	const std::function<bool(const std::string& xmlPath, const std::string& outPath)>&
+		parseExternal) const
+{
+	ByteSpan data = snapshotFile->GetData();
+	const SnapshotHeader& header = *reinterpret_cast<const SnapshotHeader*>(data.data());
+	const SnapshotEntry* entries =
+		reinterpret_cast<const SnapshotEntry*>(data.data() + GetEntriesOffset());
+	const SnapshotDeclaration* declarations =
+		reinterpret_cast<const SnapshotDeclaration*>(data.data() + GetDeclarationsOffset(header));
+	const SnapshotSymbol* symbols =
+		reinterpret_cast<const SnapshotSymbol*>(data.data() + GetSymbolsOffset(header));
+	const char* strings = reinterpret_cast<const char*>(data.data() + GetStringsOffset(header));
+
+	ctx.AddInputFile(xmlFilePath);
+
+	for (uint32_t i = 0; i < header.numEntries; i++)
+	{
+		const SnapshotEntry& entry = entries[i];
+
+		if (entry.kind == EntryKindExternalFile)
+		{
+			if (!parseExternal(strings + entry.name, strings + entry.outName))
+				return false;
+			continue;
+		}
+
+		// Same as the constructor parsing the `File` element would have done
+		ZFile* file = new ZFile();
+		ctx.files.push_back(file);
+		ctx.externalFiles.push_back(file);
+
+		file->ctx = &ctx;
+		file->mode = ZFileMode::ExternalFile;
+		file->isExternalFile = true;
+		file->xmlFilePath = xmlFilePath;
+		file->basePath = basePath == "" ? fs::path(Directory::GetCurrentDirectory()) : basePath;
+		file->outputPath = outPath == "" ? fs::path(Directory::GetCurrentDirectory()) : outPath;
+		file->name = strings + entry.name;
+		file->outName = strings + entry.outName;
+		file->segment = entry.segment;
+		file->baseAddress = entry.baseAddress;
+		file->rangeStart = entry.rangeStart;
+		file->rangeEnd = entry.rangeEnd;
+
+		ctx.game = static_cast<ZGame>(entry.game);
+		ctx.AddSegment(file->segment, file);
+		file->OpenRawData();
+		if (entry.flags & ENTRY_FLAG_RANGE_END_IS_FILE_SIZE)
+			file->rangeEnd = file->rawData.size();
+
+		for (uint32_t j = 0; j < entry.numDeclarations; j++)
+		{
+			const SnapshotDeclaration& record = declarations[entry.firstDeclaration + j];
+			DeclarationAlignment alignment = (record.flags & DECLARATION_FLAG_ALIGN8) ?
+			                                     DeclarationAlignment::Align8 :
+			                                     DeclarationAlignment::Align4;
+			Declaration* decl;
+
+			if (record.flags & DECLARATION_FLAG_ARRAY)
+			{
+				decl = Declaration::CreateArray(file->GetMemoryResource(), record.address,
+				                                alignment, record.size, strings + record.type,
+				                                strings + record.name, "", record.arrayItemCnt);
+			}
+			else
+			{
+				decl = Declaration::Create(file->GetMemoryResource(), record.address, alignment,
+				                           record.size, strings + record.type,
+				                           strings + record.name, "");
+			}
+			decl->declaredInXml = (record.flags & DECLARATION_FLAG_IN_XML) != 0;
+			decl->forceStatic = ctx.forceStatic;
+
+			file->declarations[record.address] = decl;
+			file->declarationsIndex.Set(decl, record.address, decl->size);
+		}
+
+		for (uint32_t j = 0; j < entry.numSymbols; j++)
+		{
+			const SnapshotSymbol& record = symbols[entry.firstSymbol + j];
+			ZSymbol* sym = new (file) ZSymbol(file);
+
+			sym->SetName(strings + record.name);
+			sym->SetRawDataIndex(record.offset);
+			sym->SetSymbolInfo(strings + record.type, record.typeSize, record.isArray != 0,
+			                   record.count);
+			file->AddSymbolResource(record.offset, sym);
+		}
+	}
+
+	return true;
+}
+
+void ExternalFileSnapshot::AddFile(const ZFile* file)
+{
+	entries.push_back({file, "", "", file->ctx->game});
+}
+
+void ExternalFileSnapshot::AddExternalFile(const std::string& xmlPath, const std::string& outPath)
+{
+	entries.push_back({nullptr, xmlPath, outPath, game});
+}
+
+void ExternalFileSnapshot::Save() const
+{
+	BinaryImageStrings strings;
+	std::vector<SnapshotEntry> entryRecords;
+	std::vector<SnapshotDeclaration> declarationRecords;
+	std::vector<SnapshotSymbol> symbolRecords;
+
+	for (const Entry& entry : entries)
+	{
+		SnapshotEntry record = {};
+
+		if (entry.file == nullptr)
+		{
+			record.kind = EntryKindExternalFile;
+			record.name = strings.Add(entry.xmlPath);
+			record.outName = strings.Add(entry.outPath);
+			entryRecords.push_back(record);
+			continue;
+		}
+
+		const ZFile* file = entry.file;
+
+		// The rooms of a file are listed by the scenes extracted with it, which needs the
+		// resources
+		for (const ZResource* res : file->resources)
+		{
+			if (res->GetResourceType() == ZResourceType::Room)
+				return;
+		}
+
+		record.kind = EntryKindFile;
+		record.name = strings.Add(file->GetName());
+		record.outName = strings.Add(file->GetOutName());
+		record.game = static_cast<uint32_t>(entry.game);
+		record.segment = file->segment;
+		record.baseAddress = file->baseAddress;
+		record.rangeStart = file->rangeStart;
+		record.rangeEnd = file->rangeEnd;
+		if (file->rangeEnd == file->GetRawData().size())
+			record.flags |= ENTRY_FLAG_RANGE_END_IS_FILE_SIZE;
+
+		record.firstDeclaration = declarationRecords.size();
+		for (const auto& [address, decl] : file->declarations)
+		{
+			SnapshotDeclaration declRecord = {};
+
+			declRecord.address = address;
+			declRecord.size = decl->size;
+			declRecord.type = strings.Add(std::string(decl->declType));
+			declRecord.name = strings.Add(std::string(decl->declName));
+			declRecord.arrayItemCnt = decl->arrayItemCnt;
+			if (decl->isArray)
+				declRecord.flags |= DECLARATION_FLAG_ARRAY;
+			if (decl->declaredInXml)
+				declRecord.flags |= DECLARATION_FLAG_IN_XML;
+			if (decl->alignment == DeclarationAlignment::Align8)
+				declRecord.flags |= DECLARATION_FLAG_ALIGN8;
+			declarationRecords.push_back(declRecord);
+		}
+		record.numDeclarations = declarationRecords.size() - record.firstDeclaration;
+
+		record.firstSymbol = symbolRecords.size();
+		for (const auto& [offset, sym] : file->GetSymbolResources())
+		{
+			symbolRecords.push_back({offset, strings.Add(sym->GetSourceTypeName()),
+			                         strings.Add(sym->GetName()),
+			                         static_cast<uint32_t>(sym->GetTypeSize()), sym->GetCount(),
+			                         sym->IsArray()});
+		}
+		record.numSymbols = symbolRecords.size() - record.firstSymbol;
+
+		uint64_t rawDataSize;
+		if (!File::GetSizeAndTime(file->basePath / file->GetName(), rawDataSize, record.rawDataTime))
+			return;
+		record.rawDataSize = rawDataSize;
+
+		entryRecords.push_back(record);
+	}
+
+	// Never empty, so a valid snapshot always ends with a terminator
+	strings.Add("");
+
+	SnapshotHeader header = {};
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.key = key;
+	header.numEntries = entryRecords.size();
+	header.numDeclarations = declarationRecords.size();
+	header.numSymbols = symbolRecords.size();
+	header.stringsSize = strings.data.size();
+
+	std::vector<uint8_t> data(sizeof(header));
+	memcpy(data.data(), &header, sizeof(header));
+	BinaryImage::AppendRecords(data, entryRecords);
+	BinaryImage::AppendRecords(data, declarationRecords);
+	BinaryImage::AppendRecords(data, symbolRecords);
+	data.insert(data.end(), strings.data.begin(), strings.data.end());
+
+	// Other jobs may save the same snapshot at the same time, so it's moved in place once complete
+	fs_error_code ec;
+	fs::create_directories(snapshotPath.parent_path(), ec);
+
+	fs::path tempPath = snapshotPath;
+	tempPath += StringHelper::Sprintf(".%08X.tmp", std::random_device()());
+	File::WriteAllBytes(tempPath, data);
+
+	fs::rename(tempPath, snapshotPath, ec);
+	if (ec)
+	{
+		fs::remove(tempPath, ec);
+		return;
+	}
+
+	RemoveOtherSnapshots();
+}
+
+void ExternalFileSnapshot::RemoveOtherSnapshots() const
+{
+	fs_error_code ec;
+	std::vector<fs::path> otherSnapshots;
+
+	for (fs::directory_iterator it(snapshotPath.parent_path(), ec), end; !ec && it != end;
+	     it.increment(ec))
+	{
+		std::string fileName = it->path().filename().string();
+
+		// Snapshots being written by other jobs end with `.tmp`, so they're left alone
+		if (StringHelper::StartsWith(fileName, fileNamePrefix) &&
+		    StringHelper::EndsWith(fileName, ".snapshot") &&
+		    it->path().filename() != snapshotPath.filename())
+			otherSnapshots.push_back(it->path());
+	}
+
+	for (const fs::path& path : otherSnapshots)
+		fs::remove(path, ec);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Utils/MappedFile.h"
+#include "ZFile.h"
+
+class ExtractionContext;
+
+/**
+ * The files of an external XML as seen by the files referencing them: the address range of each
+ * file, with the address, size, type and name of its declarations and symbols.
+ *
+ * External XMLs (like gameplay_keep's) are only used to look up names, but parsing them creates
+ * every one of their resources, which takes longer than extracting most objects. So, with
+ * `--external-snapshots`, the files of an external XML are saved to a snapshot once parsed, and
+ * the next runs map the snapshot and create the files from it instead. Their declarations and
+ * symbols are recreated as they were parsed, but they don't have any resource.
+ *
+ * A snapshot is keyed by the contents of its XML, the game it was parsed for, the ZAPD build, the
+ * config files and the arguments which change how files are parsed, so changing any of them makes
+ * a new one. It is also ignored if the size or the modification time of a baserom file it was
+ * parsed from changed. The external XMLs it references have a snapshot of their own.
+ */
+class ExternalFileSnapshot
+{
+public:
+	ExternalFileSnapshot(const fs::path& nXmlFilePath, const fs::path& nBasePath, ZGame game);
+	~ExternalFileSnapshot();
+
+	ExternalFileSnapshot(const ExternalFileSnapshot&) = delete;
+	ExternalFileSnapshot& operator=(const ExternalFileSnapshot&) = delete;
+
+	/**
+	 * Maps the snapshot of the XML. Returns `false` if there's none, or if it isn't valid.
+	 */
+	bool Load();
+
+	/**
+	 * Adds the files of the loaded snapshot to `ctx`, as parsing the XML would have done.
+	 * `parseExternal` is called with the `XmlPath` and `OutPath` of every `ExternalFile` element
+	 * of the XML, in the same order, and its result is returned if it fails.
+	 */
+	bool Restore(
+		ExtractionContext& ctx, const fs::path& basePath, const fs::path& outPath,
+		const std::function<bool(const std::string& xmlPath, const std::string& outPath)>&
+			parseExternal) const;
+
+	/**
+	 * Records the next `File` element of the XML, once `file` has been parsed from it.
+	 */
+	void AddFile(const ZFile* file);
+	/**
+	 * Records the next `ExternalFile` element of the XML.
+	 */
+	void AddExternalFile(const std::string& xmlPath, const std::string& outPath);
+	/**
+	 * Writes the snapshot of the files recorded, and removes the snapshots of the previous versions
+	 * of the XML. Nothing is written if any of the files can't be restored from a snapshot.
+	 */
+	void Save() const;
+
+protected:
+	struct Entry
+	{
+		const ZFile* file;
+		// Only for `ExternalFile` elements
+		std::string xmlPath, outPath;
+		// The game of the job after parsing this entry, which the `Game` attribute of a file sets
+		ZGame game;
+	};
+
+	fs::path xmlFilePath;
+	fs::path basePath;  // Where the baserom files are
+	fs::path snapshotPath;
+	std::string fileNamePrefix;  // Shared by every snapshot of the XML
+	uint64_t key = 0;
+	ZGame game;
+	std::vector<Entry> entries;
+	std::unique_ptr<MappedFile> snapshotFile;
+
+	bool IsValid(const ByteSpan& data) const;
+	bool AreRawDataFilesUnchanged(const ByteSpan& data) const;
+	void RemoveOtherSnapshots() const;
+};
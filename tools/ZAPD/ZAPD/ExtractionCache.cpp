@@ -0,0 +1,257 @@
+#include "ExtractionCache.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "ExtractionContext.h"
+#include "Utils/File.h"
+#include "Utils/Hash.h"
+#include "Utils/StringHelper.h"
+#include "tinyxml2.h"
+
+// Bump every time the meaning of the manifest changes, so old manifests are ignored
+#define EXTRACTION_CACHE_VERSION 1
+
+static std::string FormatHash(uint64_t hash)
+{
+	return StringHelper::Sprintf("%016" PRIX64, hash);
+}
+
+static uint64_t ParseHash(const char* str)
+{
+	return str != nullptr ? strtoull(str, nullptr, 16) : 0;
+}
+
+ExtractionCache::ExtractionCache(const fs::path& nManifestPath) : manifestPath(nManifestPath)
+{
+}
+
+void ExtractionCache::Load()
+{
+	tinyxml2::XMLDocument doc;
+
+	if (doc.LoadFile(manifestPath.string().c_str()) != tinyxml2::XML_SUCCESS)
+		return;
+
+	tinyxml2::XMLElement* root = doc.FirstChildElement("ExtractionCache");
+	if (root == nullptr || root->IntAttribute("Version") != EXTRACTION_CACHE_VERSION)
+		return;
+
+	for (tinyxml2::XMLElement* job = root->FirstChildElement("Job"); job != nullptr;
+	     job = job->NextSiblingElement("Job"))
+	{
+		const char* id = job->Attribute("Id");
+		if (id == nullptr)
+			continue;
+
+		Entry entry;
+		entry.key = ParseHash(job->Attribute("Key"));
+
+		for (tinyxml2::XMLElement* child = job->FirstChildElement(); child != nullptr;
+		     child = child->NextSiblingElement())
+		{
+			const char* path = child->Attribute("Path");
+			if (path == nullptr)
+				continue;
+
+			if (std::string_view(child->Name()) == "Input")
+			{
+				entry.inputs.push_back({path,
+				                        static_cast<uint64_t>(child->Int64Attribute("Size")),
+				                        child->Int64Attribute("Time"),
+				                        ParseHash(child->Attribute("Hash"))});
+			}
+			else if (std::string_view(child->Name()) == "Output")
+			{
+				entry.outputs.push_back(path);
+			}
+		}
+
+		entries[id] = std::move(entry);
+	}
+}
+
+void ExtractionCache::Save() const
+{
+	tinyxml2::XMLPrinter printer;
+
+	printer.OpenElement("ExtractionCache");
+	printer.PushAttribute("Version", EXTRACTION_CACHE_VERSION);
+
+	for (const auto& [id, entry] : entries)
+	{
+		printer.OpenElement("Job");
+		printer.PushAttribute("Id", id.c_str());
+		printer.PushAttribute("Key", FormatHash(entry.key).c_str());
+
+		for (const InputFile& input : entry.inputs)
+		{
+			printer.OpenElement("Input");
+			printer.PushAttribute("Path", input.path.string().c_str());
+			printer.PushAttribute("Size", static_cast<int64_t>(input.size));
+			printer.PushAttribute("Time", input.time);
+			printer.PushAttribute("Hash", FormatHash(input.hash).c_str());
+			printer.CloseElement();
+		}
+
+		for (const fs::path& output : entry.outputs)
+		{
+			printer.OpenElement("Output");
+			printer.PushAttribute("Path", output.string().c_str());
+			printer.CloseElement();
+		}
+
+		printer.CloseElement();
+	}
+
+	printer.CloseElement();
+
+	// Write the whole manifest before replacing the old one, so an interrupted run can't leave
+	// half of it behind
+	fs::path tempPath = manifestPath;
+	tempPath += ".tmp";
+	File::WriteAllBytes(tempPath.string(), printer.CStr(), printer.CStrSize() - 1);
+	fs::rename(tempPath, manifestPath);
+}
+
+bool ExtractionCache::IsUpToDate(const std::string& jobId, const std::string& options)
+{
+	Entry entry;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto it = entries.find(jobId);
+		if (it == entries.end())
+			return false;
+		entry = it->second;
+	}
+
+	for (const fs::path& output : entry.outputs)
+	{
+		if (!fs::exists(output))
+			return false;
+	}
+
+	std::vector<InputFile> inputs;
+	inputs.reserve(entry.inputs.size());
+
+	for (const InputFile& input : entry.inputs)
+	{
+		InputFile current;
+
+		if (!HashFile(input.path, &input, current))
+			return false;
+		inputs.push_back(current);
+	}
+
+	return ComputeKey(options, inputs) == entry.key;
+}
+
+void ExtractionCache::Update(const std::string& jobId, const std::string& options,
+                             const ExtractionContext& ctx)
+{
+	std::vector<fs::path> inputPaths = ctx.inputFiles;
+	std::sort(inputPaths.begin(), inputPaths.end());
+	inputPaths.erase(std::unique(inputPaths.begin(), inputPaths.end()), inputPaths.end());
+
+	Entry entry;
+	entry.inputs.reserve(inputPaths.size());
+
+	for (const fs::path& path : inputPaths)
+	{
+		InputFile input;
+
+		if (!HashFile(path, nullptr, input))
+		{
+			// Something we depend on is gone already, so there's nothing worth remembering
+			Remove(jobId);
+			return;
+		}
+		entry.inputs.push_back(input);
+	}
+
+	entry.outputs = ctx.outputFiles;
+	std::sort(entry.outputs.begin(), entry.outputs.end());
+	entry.outputs.erase(std::unique(entry.outputs.begin(), entry.outputs.end()),
+	                    entry.outputs.end());
+
+	entry.key = ComputeKey(options, entry.inputs);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	entries[jobId] = std::move(entry);
+}
+
+void ExtractionCache::Remove(const std::string& jobId)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.erase(jobId);
+}
+
+void ExtractionCache::RestoreDependencies(const std::string& jobId, ExtractionContext& ctx)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto it = entries.find(jobId);
+	if (it == entries.end())
+		return;
+
+	ctx.inputFiles.clear();
+	for (const InputFile& input : it->second.inputs)
+		ctx.inputFiles.push_back(input.path);
+	ctx.outputFiles = it->second.outputs;
+}
+
+std::string ExtractionCache::GetJobId(const ExtractionContext& ctx)
+{
+	return ctx.inputPath.string() + " -> " + ctx.outputPath.string();
+}
+
+bool ExtractionCache::HashFile(const fs::path& path, const InputFile* previous,
+                               InputFile& result)
+{
+	uint64_t size;
+	int64_t time;
+
+	if (!File::GetSizeAndTime(path, size, time))
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto it = hashedFiles.find(path);
+		if (it != hashedFiles.end() && it->second.size == size && it->second.time == time)
+		{
+			result = it->second;
+			return true;
+		}
+	}
+
+	if (previous != nullptr && previous->size == size && previous->time == time)
+	{
+		result = *previous;
+	}
+	else
+	{
+		std::vector<uint8_t> data = File::ReadAllBytes(path);
+		result = {path, size, time, Hash::Fnv1a64(data.data(), data.size())};
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	hashedFiles[path] = result;
+	return true;
+}
+
+uint64_t ExtractionCache::ComputeKey(const std::string& options,
+                                     const std::vector<InputFile>& inputs)
+{
+	uint64_t key = Hash::Fnv1a64(options);
+
+	for (const InputFile& input : inputs)
+	{
+		key = Hash::Fnv1a64(input.path.string(), key);
+		key = Hash::Fnv1a64(&input.hash, sizeof(input.hash), key);
+	}
+
+	return key;
+}
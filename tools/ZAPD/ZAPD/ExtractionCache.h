@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Utils/Directory.h"
+
+class ExtractionContext;
+
+/**
+ * Remembers what every extraction job depended on, so extracting it again can be skipped if
+ * nothing changed since the last time.
+ *
+ * Each job is identified by its input XML and output folder. Once it has been extracted, its key
+ * is computed by hashing the options it was extracted with (which include the ZAPD build hash)
+ * and the contents of every file it read: the XML, the external XMLs, the baserom files and the
+ * config files. The key is stored in the manifest with the files the job read and wrote.
+ * A job is up to date if hashing the files it read last time gives back the same key and every
+ * file it wrote still exists.
+ *
+ * Files are only hashed again if their size or modification time changed, so checking a job
+ * which is up to date doesn't need to read anything.
+ */
+class ExtractionCache
+{
+public:
+	explicit ExtractionCache(const fs::path& nManifestPath);
+
+	/**
+	 * Reads the manifest, if it exists. An invalid manifest is ignored, extracting everything
+	 * again.
+	 */
+	void Load();
+	void Save() const;
+
+	bool IsUpToDate(const std::string& jobId, const std::string& options);
+	/**
+	 * Records the files read and written by the job extracted with `ctx`.
+	 */
+	void Update(const std::string& jobId, const std::string& options,
+	            const ExtractionContext& ctx);
+	void Remove(const std::string& jobId);
+	/**
+	 * Fills `ctx` with the files read and written by the job the last time it was extracted, so
+	 * a job which is up to date can still write its dependency file.
+	 */
+	void RestoreDependencies(const std::string& jobId, ExtractionContext& ctx);
+
+	/**
+	 * The job id of an extraction, built from its input XML and output folder.
+	 */
+	static std::string GetJobId(const ExtractionContext& ctx);
+
+protected:
+	struct InputFile
+	{
+		fs::path path;
+		uint64_t size;
+		int64_t time;
+		uint64_t hash;
+	};
+
+	struct Entry
+	{
+		uint64_t key;
+		std::vector<InputFile> inputs;
+		std::vector<fs::path> outputs;
+	};
+
+	fs::path manifestPath;
+	std::map<std::string, Entry> entries;
+	// Files hashed during this run, shared by every job reading them
+	std::map<fs::path, InputFile> hashedFiles;
+	std::mutex mutex;
+
+	/**
+	 * Hashes the file at `path`, reusing the hash of `previous` if the file wasn't modified since.
+	 * Returns `false` if the file can't be read.
+	 */
+	bool HashFile(const fs::path& path, const InputFile* previous, InputFile& result);
+	static uint64_t ComputeKey(const std::string& options, const std::vector<InputFile>& inputs);
+};
@@ -0,0 +1,331 @@
+#include "ExtractionContext.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "Globals.h"
+#include "Utils/File.h"
+#include "Utils/StringHelper.h"
+#include "WarningHandler.h"
+
+static thread_local ExtractionContext* sCurrentContext = nullptr;
+
+ExtractionContext::ExtractionContext()
+{
+	inputPath = Globals::Instance->inputPath;
+	outputPath = Globals::Instance->outputPath;
+	depFilePath = Globals::Instance->depFilePath;
+	baseAddress = Globals::Instance->baseAddress;
+	startOffset = Globals::Instance->startOffset;
+	endOffset = Globals::Instance->endOffset;
+	genSourceFile = Globals::Instance->genSourceFile;
+	forceStatic = Globals::Instance->forceStatic;
+	forceUnaccountedStatic = Globals::Instance->forceUnaccountedStatic;
+	game = ZGame::OOT_RETAIL;
+	inputFiles = Globals::Instance->cfg.inputFiles;
+}
+
+ExtractionContext::~ExtractionContext()
+{
+	for (ZFile* file : files)
+	{
+		if (file->ctx == this)
+			delete file;
+	}
+}
+
+void ExtractionContext::AddInputFile(const fs::path& path)
+{
+	inputFiles.push_back(path);
+}
+
+void ExtractionContext::AddOutputFile(const fs::path& path, bool written)
+{
+	outputFiles.push_back(path);
+
+	if (written)
+		numOutputsWritten++;
+	else
+		numOutputsUnchanged++;
+}
+
+// Escapes the characters make would otherwise interpret in a file name
+static std::string EscapeMakePath(const fs::path& path)
+{
+	std::string escaped;
+
+	for (char c : path.lexically_normal().string())
+	{
+		if (c == ' ' || c == '#')
+			escaped += '\\';
+		else if (c == '$')
+			escaped += '$';
+		escaped += c;
+	}
+
+	return escaped;
+}
+
+// The paths in `paths` without the duplicates, in the order they were added
+static std::vector<std::string> GetUniqueMakePaths(const std::vector<fs::path>& paths)
+{
+	std::vector<std::string> unique;
+	std::unordered_set<std::string> seen;
+
+	for (const fs::path& path : paths)
+	{
+		std::string escaped = EscapeMakePath(path);
+		if (seen.insert(escaped).second)
+			unique.push_back(std::move(escaped));
+	}
+
+	return unique;
+}
+
+bool ExtractionContext::WriteDepFile() const
+{
+	std::string depFile = EscapeMakePath(depFilePath);
+	std::vector<std::string> outputs = GetUniqueMakePaths(outputFiles);
+	std::vector<std::string> inputs = GetUniqueMakePaths(inputFiles);
+	std::string rules = depFile + ":";
+
+	for (const std::string& input : inputs)
+		rules += " \\\n  " + input;
+	rules += "\n";
+
+	// The empty recipe makes make check whether they changed once the depfile was remade
+	if (!outputs.empty())
+		rules += "\n" + StringHelper::Join(outputs, " \\\n") + ": " + depFile + " ;\n";
+
+	for (const std::string& input : inputs)
+		rules += "\n" + input + ":\n";
+
+	// Always written, since make compares its modification time to the inputs
+	File::WriteAllText(depFilePath, rules);
+	return File::Exists(depFilePath);
+}
+
+void ExtractionContext::AddSegment(int32_t segment, ZFile* file)
+{
+	if (std::find(segments.begin(), segments.end(), segment) == segments.end())
+		segments.push_back(segment);
+
+	segmentRefFiles[segment].push_back(file);
+	InvalidateSegmentedAddresses();
+}
+
+bool ExtractionContext::HasSegment(int32_t segment) const
+{
+	return std::find(segments.begin(), segments.end(), segment) != segments.end();
+}
+
+void ExtractionContext::InvalidateSegmentedAddresses()
+{
+	segmentedResolver.Clear();
+}
+
+bool ExtractionContext::GetSegmentedPtrName(segptr_t segAddress, ZFile* currentFile,
+                                            offset_t srcOffset, const std::string& expectedType,
+                                            std::string& declName, bool warnIfNotFound) const
+{
+	if (segAddress == SEGMENTED_NULL)
+	{
+		declName = "NULL";
+		return true;
+	}
+
+	uint32_t offset = Seg2Filespace(segAddress, currentFile->baseAddress);
+	ZSymbol* sym;
+
+	sym = currentFile->GetSymbolResource(offset);
+	if (sym != nullptr)
+	{
+		if (expectedType == "" || expectedType == sym->GetSourceTypeName())
+		{
+			declName = sym->GetName();
+			AddPointerTarget(currentFile, srcOffset, segAddress, declName, 0);
+			return true;
+		}
+	}
+	sym = currentFile->GetSymbolResource(segAddress);
+	if (sym != nullptr)
+	{
+		if (expectedType == "" || expectedType == sym->GetSourceTypeName())
+		{
+			declName = sym->GetName();
+			AddPointerTarget(currentFile, srcOffset, segAddress, declName, 0);
+			return true;
+		}
+	}
+
+	bool inCurrentFile = currentFile->IsSegmentedInFilespaceRange(segAddress);
+	if (inCurrentFile)
+	{
+		if (currentFile->GetDeclarationPtrName(segAddress, expectedType, declName))
+		{
+			AddDeclarationPointerTarget(currentFile, srcOffset, segAddress, currentFile);
+			return true;
+		}
+	}
+
+	// Other files are only searched if the address is not in the range of the current one
+	for (const auto* target : GetSegmentedResolver().Find(segAddress))
+	{
+		switch (target->kind)
+		{
+		case SegmentedAddressResolver::TargetKind::Symbol:
+			if (!inCurrentFile && target->MatchesType(expectedType))
+			{
+				declName = target->symbol->GetName();
+				AddPointerTarget(currentFile, srcOffset, segAddress, declName, 0);
+				return true;
+			}
+			break;
+
+		case SegmentedAddressResolver::TargetKind::Declaration:
+			if (!inCurrentFile &&
+			    target->file->GetDeclarationPtrName(segAddress, expectedType, declName))
+			{
+				AddDeclarationPointerTarget(currentFile, srcOffset, segAddress, target->file);
+				return true;
+			}
+			break;
+
+		case SegmentedAddressResolver::TargetKind::SymbolMap:
+			declName = "&" + target->name;
+			AddPointerTarget(currentFile, srcOffset, segAddress, target->name, 0);
+			return true;
+		}
+	}
+
+	declName = StringHelper::Sprintf("0x%08X", segAddress);
+	if (warnIfNotFound)
+	{
+		WarnHardcodedPointer(segAddress, currentFile, nullptr, -1);
+	}
+	return false;
+}
+
+bool ExtractionContext::GetSegmentedArrayIndexedName(segptr_t segAddress, size_t elementSize,
+                                                     ZFile* currentFile, offset_t srcOffset,
+                                                     const std::string& expectedType,
+                                                     std::string& declName,
+                                                     bool warnIfNotFound) const
+{
+	if (segAddress == SEGMENTED_NULL)
+	{
+		declName = "NULL";
+		return true;
+	}
+
+	if (currentFile->IsSegmentedInFilespaceRange(segAddress))
+	{
+		bool addressFound = currentFile->GetDeclarationArrayIndexedName(segAddress, elementSize,
+		                                                                expectedType, declName);
+		if (addressFound)
+		{
+			AddDeclarationPointerTarget(currentFile, srcOffset, segAddress, currentFile);
+			return true;
+		}
+	}
+	else
+	{
+		for (const auto* target : GetSegmentedResolver().Find(segAddress))
+		{
+			if (target->kind != SegmentedAddressResolver::TargetKind::Declaration)
+				continue;
+
+			bool addressFound = target->file->GetDeclarationArrayIndexedName(
+				segAddress, elementSize, expectedType, declName);
+			if (addressFound)
+			{
+				AddDeclarationPointerTarget(currentFile, srcOffset, segAddress, target->file);
+				return true;
+			}
+		}
+	}
+
+	declName = StringHelper::Sprintf("0x%08X", segAddress);
+	if (warnIfNotFound)
+	{
+		WarnHardcodedPointer(segAddress, currentFile, nullptr, -1);
+	}
+	return false;
+}
+
+void ExtractionContext::AddPointerTarget(ZFile* currentFile, offset_t srcOffset,
+                                         segptr_t segAddress, const std::string& symbolName,
+                                         uint32_t addend)
+{
+	// External files are shared by the jobs, and don't get an object file anyway. Null pointers
+	// are never relocated.
+	if (!Globals::Instance->emitObjects || currentFile->isExternalFile ||
+	    srcOffset == NO_SOURCE_OFFSET || segAddress == SEGMENTED_NULL)
+	{
+		return;
+	}
+
+	currentFile->pointerTargets.emplace(srcOffset, PointerTarget{segAddress, symbolName, addend});
+}
+
+void ExtractionContext::AddDeclarationPointerTarget(ZFile* currentFile, offset_t srcOffset,
+                                                    segptr_t segAddress, const ZFile* targetFile)
+{
+	if (!Globals::Instance->emitObjects || currentFile->isExternalFile ||
+	    srcOffset == NO_SOURCE_OFFSET)
+	{
+		return;
+	}
+
+	// Declarations may not have their final size yet, so they may not be found by range
+	offset_t address = Seg2Filespace(segAddress, targetFile->baseAddress);
+	Declaration* decl = targetFile->GetDeclaration(address);
+	if (decl == nullptr)
+		decl = targetFile->GetDeclarationRanged(address);
+	if (decl != nullptr)
+	{
+		AddPointerTarget(currentFile, srcOffset, segAddress, std::string(decl->declName),
+		                 address - decl->address);
+	}
+}
+
+void ExtractionContext::WarnHardcodedPointer(segptr_t segAddress, ZFile* currentFile,
+                                             ZResource* res, offset_t currentOffset)
+{
+	uint8_t segment = GETSEGNUM(segAddress);
+
+	if ((segment >= 2 && segment <= 6) || segment == 0x80)
+	{
+		std::string errorHeader = "A hardcoded pointer was found";
+		std::string errorBody = StringHelper::Sprintf("Pointer: 0x%08X", segAddress);
+
+		HANDLE_WARNING_RESOURCE(WarningType::HardcodedPointer, currentFile, res, currentOffset,
+		                        errorHeader, errorBody);
+	}
+	else
+	{
+		std::string errorHeader = "A general purpose hardcoded pointer was found";
+		std::string errorBody = StringHelper::Sprintf("Pointer: 0x%08X", segAddress);
+
+		HANDLE_WARNING_RESOURCE(WarningType::HardcodedGenericPointer, currentFile, res,
+		                        currentOffset, errorHeader, errorBody);
+	}
+}
+
+ExtractionContext* ExtractionContext::GetCurrent()
+{
+	return sCurrentContext;
+}
+
+void ExtractionContext::SetCurrent(ExtractionContext* ctx)
+{
+	sCurrentContext = ctx;
+}
+
+const SegmentedAddressResolver& ExtractionContext::GetSegmentedResolver() const
+{
+	if (!segmentedResolver.IsBuilt())
+		segmentedResolver.Build(segmentRefFiles, Globals::Instance->cfg.symbolMap);
+
+	return segmentedResolver;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SegmentedAddressResolver.h"
+#include "ZFile.h"
+
+/**
+ * The state of a single extraction (or source building) job: the options it was started with,
+ * the files parsed from its XML and the segments those files are loaded to.
+ *
+ * Every `ZFile` belongs to one context, which its resources reach through their parent file.
+ * The options shared by every job (the GameConfig, verbosity, exporter, ...) stay in `Globals`,
+ * which is not modified anymore once the jobs have started. This way, several jobs can be
+ * processed at the same time as long as each one of them has its own context.
+ */
+class ExtractionContext
+{
+public:
+	fs::path inputPath, outputPath, depFilePath;
+	int64_t baseAddress, startOffset, endOffset;
+	bool genSourceFile;
+	bool forceStatic;
+	bool forceUnaccountedStatic;
+	ZGame game;
+
+	std::vector<ZFile*> files;
+	std::vector<ZFile*> externalFiles;
+	std::vector<int32_t> segments;
+	std::map<int32_t, std::vector<ZFile*>> segmentRefFiles;
+
+	// Every file the output of this job depends on (XMLs, baserom files, config files, ...) and
+	// every file it wrote
+	std::vector<fs::path> inputFiles;
+	std::vector<fs::path> outputFiles;
+	// How many of the output files were written, and how many already had the right contents
+	size_t numOutputsWritten = 0;
+	size_t numOutputsUnchanged = 0;
+
+	/**
+	 * Creates a context with the options passed in the command line.
+	 */
+	ExtractionContext();
+	/**
+	 * Deletes every file created with this context. Files shared from another context (like the
+	 * external files) are left untouched.
+	 */
+	~ExtractionContext();
+
+	ExtractionContext(const ExtractionContext&) = delete;
+	ExtractionContext& operator=(const ExtractionContext&) = delete;
+
+	void AddInputFile(const fs::path& path);
+	/**
+	 * Adds an output file of this job. `written` is whether it was written, or left untouched
+	 * because it already had the right contents.
+	 */
+	void AddOutputFile(const fs::path& path, bool written);
+
+	/**
+	 * Writes the make rules of this job to `depFilePath`: the depfile itself depends on every
+	 * input file, and every output file depends on the depfile.
+	 * Outputs are only written if they change, so they can't depend on the inputs directly, or
+	 * they would stay older than them and be extracted every time. The depfile is always written
+	 * instead, which makes it the target extracting them. Like `gcc -MD -MP`, every input also
+	 * gets an empty rule, so make doesn't fail once one of them is removed.
+	 * Returns false if it couldn't be written.
+	 */
+	bool WriteDepFile() const;
+
+	void AddSegment(int32_t segment, ZFile* file);
+	bool HasSegment(int32_t segment) const;
+
+	/**
+	 * Must be called every time the symbols of a file of this context change, so the segmented
+	 * address lookups take them into account.
+	 */
+	void InvalidateSegmentedAddresses();
+
+	/**
+	 * Search in every file (and the symbol map) for the `segAddress` passed as parameter.
+	 * If the segment of `currentFile` is the same segment of `segAddress`, then that file will be
+	 * used only, otherwise, the search will be performed in every other file.
+	 * Files are searched through a table of the address ranges of every segment, which is built
+	 * the first time an address is looked up.
+	 * The name of that variable will be stored in the `declName` parameter.
+	 * `srcOffset` is the offset in `currentFile` of the pointer being resolved, so its object file
+	 * can relocate it, or `NO_SOURCE_OFFSET` if the address isn't read from a pointer of the data.
+	 * Returns `true` if the address is found. `false` otherwise,
+	 * in which case `declName` will be set to the address formatted as a pointer.
+	 */
+	bool GetSegmentedPtrName(segptr_t segAddress, ZFile* currentFile, offset_t srcOffset,
+	                         const std::string& expectedType, std::string& declName,
+	                         bool warnIfNotFound = true) const;
+
+	bool GetSegmentedArrayIndexedName(segptr_t segAddress, size_t elementSize, ZFile* currentFile,
+	                                  offset_t srcOffset, const std::string& expectedType,
+	                                  std::string& declName, bool warnIfNotFound = true) const;
+
+	/**
+	 * With `--emit-objects`, remembers that the pointer at `srcOffset` of `currentFile`, whose
+	 * value is `segAddress`, points to `symbolName` plus `addend`, so its object file can relocate
+	 * it. Pointers resolved by the functions above are already remembered.
+	 */
+	static void AddPointerTarget(ZFile* currentFile, offset_t srcOffset, segptr_t segAddress,
+	                             const std::string& symbolName, uint32_t addend);
+
+	// TODO: consider moving to another place
+	static void WarnHardcodedPointer(segptr_t segAddress, ZFile* currentFile, ZResource* res,
+	                                 offset_t currentOffset);
+
+	/**
+	 * The context of the job being processed by the calling thread, if any.
+	 * Only meant for code which can't be given a context explicitly, like the warning handler.
+	 */
+	static ExtractionContext* GetCurrent();
+	static void SetCurrent(ExtractionContext* ctx);
+
+protected:
+	// Built lazily, since the files have to be fully parsed before
+	mutable SegmentedAddressResolver segmentedResolver;
+
+	const SegmentedAddressResolver& GetSegmentedResolver() const;
+
+	static void AddDeclarationPointerTarget(ZFile* currentFile, offset_t srcOffset,
+	                                        segptr_t segAddress, const ZFile* targetFile);
+};
@@ -1,29 +1,212 @@
 #include "GameConfig.h"
 
+#include <cstring>
 #include <functional>
+#include <random>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 
-#include "Utils/Directory.h"
+#include "Utils/BinaryImage.h"
 #include "Utils/File.h"
+#include "Utils/Hash.h"
 #include "Utils/Path.h"
-#include "ZFile.h"
+#include "Utils/StringHelper.h"
 #include "tinyxml2.h"
 
-using ConfigFunc = void (GameConfig::*)(const tinyxml2::XMLElement&);
+#ifdef USE_BOOST_FS
+typedef boost::system::error_code fs_error_code;
+#else
+typedef std::error_code fs_error_code;
+#endif
 
-GameConfig::~GameConfig()
+extern const char gBuildHash[];
+
+// "ZCFG", read in the byte order of the machine, so compiled configs from another one are ignored
+#define COMPILED_CONFIG_MAGIC 0x5A434647
+// Bump every time the layout or the meaning of the compiled config changes
+#define COMPILED_CONFIG_VERSION 1
+
+// Every table of the compiled config. Lists are tables keyed by the index of each line.
+enum ConfigTableId : uint32_t
 {
-	for (auto& declPair : segmentRefFiles)
-	{
-		for (auto& file : declPair.second)
-		{
-			delete file;
-		}
-	}
+	TableSymbolMap,
+	TableTexturePool,
+	TableActorList,
+	TableObjectList,
+	TableEntranceList,
+	TableSpecialEntranceList,
+	// The `XmlPath` and `OutPath` of each `ExternalFile` element
+	TableExternalFileXmlPaths,
+	TableExternalFileOutPaths,
+
+	// EnumData, see `EnumTables`
+	TableCutsceneCmd,
+	TableMiscType,
+	TableFadeOutSeqPlayer,
+	TableTransitionType,
+	TableNaviQuestHintType,
+	TableOcarinaSongActionId,
+	TableSeqId,
+	TableTextType,
+	TableDestination,
+	TablePlayerCueId,
+	TableModifySeqType,
+	TableChooseCreditsSceneType,
+	TableDestinationType,
+	TableMotionBlurType,
+	TableTransitionGeneralType,
+	TableRumbleType,
+	TableSpawnFlag,
+	TableEndSfx,
+	TableInterpType,
+	TableRelTo,
+
+	TableCount
+};
+
+// The table of each enum of the enum data XML, by its `Key`, and the values its keys can take
+struct EnumTableInfo
+{
+	ConfigTableId table;
+	uint32_t keyMask;
+};
+
+static const std::unordered_map<std::string_view, EnumTableInfo> EnumTables = {
+	// Common
+	{"cmd", {TableCutsceneCmd, UINT16_MAX}},
+	{"miscType", {TableMiscType, UINT16_MAX}},
+	{"fadeOutSeqPlayer", {TableFadeOutSeqPlayer, UINT16_MAX}},
+	{"transitionType", {TableTransitionType, UINT16_MAX}},
+	{"naviQuestHintType", {TableNaviQuestHintType, UINT16_MAX}},
+	{"ocarinaSongActionId", {TableOcarinaSongActionId, UINT16_MAX}},
+	{"seqId", {TableSeqId, UINT16_MAX}},
+
+	// OoT
+	{"textType", {TableTextType, UINT16_MAX}},
+	{"destination", {TableDestination, UINT16_MAX}},
+	{"playerCueId", {TablePlayerCueId, UINT16_MAX}},
+
+	// MM
+	{"modifySeqType", {TableModifySeqType, UINT16_MAX}},
+	{"chooseCreditsSceneType", {TableChooseCreditsSceneType, UINT16_MAX}},
+	{"destinationType", {TableDestinationType, UINT16_MAX}},
+	{"motionBlurType", {TableMotionBlurType, UINT16_MAX}},
+	{"transitionGeneralType", {TableTransitionGeneralType, UINT16_MAX}},
+	{"rumbleType", {TableRumbleType, UINT16_MAX}},
+	{"spawnFlag", {TableSpawnFlag, UINT8_MAX}},
+	{"endSfx", {TableEndSfx, UINT8_MAX}},
+	{"csSplineInterpType", {TableInterpType, UINT8_MAX}},
+	{"csSplineRelTo", {TableRelTo, UINT16_MAX}},
+};
+
+#define COMPILED_CONFIG_FLAG_SCREEN_CONSTANTS (1 << 0)
+
+// The compiled config is a header followed by the tables of source files and entries, and the
+// string table. Every string is stored once, as an offset in the string table.
+struct CompiledConfigHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t buildHash;
+	// The config file it was compiled from
+	uint32_t configFilePath;
+	uint32_t externalXmlFolder;
+	uint32_t bgScreenWidth;
+	uint32_t bgScreenHeight;
+	uint32_t flags;
+	uint32_t numSources;
+	uint32_t numEntries;
+	uint32_t stringsSize;
+	// The entries of each table, sorted by key
+	uint32_t firstEntry[TableCount];
+	uint32_t numTableEntries[TableCount];
+};
+
+// A file the config was compiled from, in the order they were read
+struct CompiledConfigSource
+{
+	uint32_t path;
+	uint32_t padding;
+	uint64_t size;
+	int64_t time;
+};
+
+static_assert(sizeof(CompiledConfigHeader) % alignof(CompiledConfigSource) == 0,
+              "the sources must be aligned");
+
+static size_t GetSourcesOffset()
+{
+	return sizeof(CompiledConfigHeader);
+}
+
+static size_t GetEntriesOffset(const CompiledConfigHeader& header)
+{
+	return GetSourcesOffset() + header.numSources * sizeof(CompiledConfigSource);
 }
 
-void GameConfig::ReadTexturePool(const fs::path& texturePoolXmlPath)
+static size_t GetStringsOffset(const CompiledConfigHeader& header)
+{
+	return GetEntriesOffset(header) + header.numEntries * sizeof(ConfigEntry);
+}
+
+// Reads the config file and the files it references, and compiles them
+class ConfigCompiler
+{
+public:
+	explicit ConfigCompiler(const std::string& nConfigFilePath);
+
+	void ReadConfigFile();
+	std::vector<uint8_t> Compile();
+
+	void ReadTexturePool(const fs::path& texturePoolXmlPath);
+	void GenSymbolMap(const fs::path& symbolMapPath);
+	void ReadList(const tinyxml2::XMLElement& element, ConfigTableId table);
+
+	void ConfigFunc_SymbolMap(const tinyxml2::XMLElement& element);
+	void ConfigFunc_ActorList(const tinyxml2::XMLElement& element);
+	void ConfigFunc_ObjectList(const tinyxml2::XMLElement& element);
+	void ConfigFunc_EntranceList(const tinyxml2::XMLElement& element);
+	void ConfigFunc_specialEntranceList(const tinyxml2::XMLElement& element);
+	void ConfigFunc_TexturePool(const tinyxml2::XMLElement& element);
+	void ConfigFunc_BGConfig(const tinyxml2::XMLElement& element);
+	void ConfigFunc_ExternalXMLFolder(const tinyxml2::XMLElement& element);
+	void ConfigFunc_ExternalFile(const tinyxml2::XMLElement& element);
+	void ConfigFunc_EnumData(const tinyxml2::XMLElement& element);
+
+protected:
+	std::string configFilePath;
+	std::vector<fs::path> inputFiles;
+	// The entries of each table, in the order they were read
+	std::vector<ConfigEntry> tables[TableCount];
+	BinaryImageStrings strings;
+
+	uint32_t bgScreenWidth = 320, bgScreenHeight = 240;
+	bool useScreenWidthHeightConstants = true;
+	fs::path externalXmlFolder;
+
+	void AddEntry(ConfigTableId table, uint32_t key, std::string_view value);
+	void AddLine(ConfigTableId table, std::string_view line);
+};
+
+using ConfigFunc = void (ConfigCompiler::*)(const tinyxml2::XMLElement&);
+
+ConfigCompiler::ConfigCompiler(const std::string& nConfigFilePath)
+	: configFilePath(nConfigFilePath)
+{
+}
+
+void ConfigCompiler::AddEntry(ConfigTableId table, uint32_t key, std::string_view value)
+{
+	tables[table].push_back({key, strings.Add(value)});
+}
+
+void ConfigCompiler::AddLine(ConfigTableId table, std::string_view line)
+{
+	AddEntry(table, tables[table].size(), line);
+}
+
+void ConfigCompiler::ReadTexturePool(const fs::path& texturePoolXmlPath)
 {
 	tinyxml2::XMLDocument doc;
 	tinyxml2::XMLError eResult = doc.LoadFile(texturePoolXmlPath.string().c_str());
@@ -34,6 +217,8 @@ void GameConfig::ReadTexturePool(const fs::path& texturePoolXmlPath)
 		return;
 	}
 
+	inputFiles.push_back(texturePoolXmlPath);
+
 	tinyxml2::XMLNode* root = doc.FirstChild();
 
 	if (root == nullptr)
@@ -46,89 +231,78 @@ void GameConfig::ReadTexturePool(const fs::path& texturePoolXmlPath)
 		{
 			std::string crcStr = child->Attribute("CRC");
 			fs::path texPath = child->Attribute("Path");
-			std::string texName;
 
 			uint32_t crc = strtoul(crcStr.c_str(), nullptr, 16);
 
-			texturePool[crc].path = texPath;
+			AddEntry(TableTexturePool, crc, texPath.string());
 		}
 	}
 }
 
-void GameConfig::GenSymbolMap(const fs::path& symbolMapPath)
+void ConfigCompiler::GenSymbolMap(const fs::path& symbolMapPath)
 {
 	auto symbolLines = File::ReadAllLines(symbolMapPath);
+	inputFiles.push_back(symbolMapPath);
 
 	for (std::string& symbolLine : symbolLines)
 	{
 		auto split = StringHelper::Split(symbolLine, " ");
 		uint32_t addr = strtoul(split[0].c_str(), nullptr, 16);
-		std::string symbolName = split[1];
-
-		symbolMap[addr] = std::move(symbolName);
+		AddEntry(TableSymbolMap, addr, split[1]);
 	}
 }
 
-void GameConfig::ConfigFunc_SymbolMap(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ReadList(const tinyxml2::XMLElement& element, ConfigTableId table)
 {
 	std::string fileName = element.Attribute("File");
-	GenSymbolMap(Path::GetDirectoryName(configFilePath) / fileName);
+	fs::path filePath = Path::GetDirectoryName(configFilePath) / fileName;
+	std::vector<std::string> lines = File::ReadAllLines(filePath);
+	inputFiles.push_back(filePath);
+
+	for (const auto& line : lines)
+		AddLine(table, line);
 }
 
-void GameConfig::ConfigFunc_ActorList(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_SymbolMap(const tinyxml2::XMLElement& element)
 {
 	std::string fileName = element.Attribute("File");
-	std::vector<std::string> lines =
-		File::ReadAllLines(Path::GetDirectoryName(configFilePath) / fileName);
-
-	for (auto& line : lines)
-		actorList.emplace_back(std::move(line));
+	GenSymbolMap(Path::GetDirectoryName(configFilePath) / fileName);
 }
 
-void GameConfig::ConfigFunc_ObjectList(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_ActorList(const tinyxml2::XMLElement& element)
 {
-	std::string fileName = element.Attribute("File");
-	std::vector<std::string> lines =
-		File::ReadAllLines(Path::GetDirectoryName(configFilePath) / fileName);
-
-	for (auto& line : lines)
-		objectList.emplace_back(std::move(line));
+	ReadList(element, TableActorList);
 }
 
-void GameConfig::ConfigFunc_EntranceList(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_ObjectList(const tinyxml2::XMLElement& element)
 {
-	std::string fileName = element.Attribute("File");
-	std::vector<std::string> lines =
-		File::ReadAllLines(Path::GetDirectoryName(configFilePath) / fileName);
-
-	for (auto& line : lines)
-		entranceList.emplace_back(std::move(line));
+	ReadList(element, TableObjectList);
 }
 
-void GameConfig::ConfigFunc_specialEntranceList(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_EntranceList(const tinyxml2::XMLElement& element)
 {
-	std::string fileName = element.Attribute("File");
-	std::vector<std::string> lines =
-		File::ReadAllLines(Path::GetDirectoryName(configFilePath) / fileName);
+	ReadList(element, TableEntranceList);
+}
 
-	for (auto& line : lines)
-		specialEntranceList.emplace_back(std::move(line));
+void ConfigCompiler::ConfigFunc_specialEntranceList(const tinyxml2::XMLElement& element)
+{
+	ReadList(element, TableSpecialEntranceList);
 }
 
-void GameConfig::ConfigFunc_TexturePool(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_TexturePool(const tinyxml2::XMLElement& element)
 {
 	std::string fileName = element.Attribute("File");
 	ReadTexturePool(Path::GetDirectoryName(configFilePath) / fileName);
 }
 
-void GameConfig::ConfigFunc_BGConfig(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_BGConfig(const tinyxml2::XMLElement& element)
 {
 	bgScreenWidth = element.IntAttribute("ScreenWidth", 320);
 	bgScreenHeight = element.IntAttribute("ScreenHeight", 240);
 	useScreenWidthHeightConstants = element.BoolAttribute("UseScreenWidthHeightConstants", true);
 }
 
-void GameConfig::ConfigFunc_ExternalXMLFolder(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_ExternalXMLFolder(const tinyxml2::XMLElement& element)
 {
 	const char* pathValue = element.Attribute("Path");
 	if (pathValue == nullptr)
@@ -145,7 +319,7 @@ void GameConfig::ConfigFunc_ExternalXMLFolder(const tinyxml2::XMLElement& elemen
 	externalXmlFolder = pathValue;
 }
 
-void GameConfig::ConfigFunc_ExternalFile(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_ExternalFile(const tinyxml2::XMLElement& element)
 {
 	const char* xmlPathValue = element.Attribute("XmlPath");
 	if (xmlPathValue == nullptr)
@@ -162,10 +336,11 @@ void GameConfig::ConfigFunc_ExternalFile(const tinyxml2::XMLElement& element)
 		                          "\t Missing 'OutPath' attribute in `ExternalFile` element.\n"));
 	}
 
-	externalFiles.push_back(ExternalFile(fs::path(xmlPathValue), fs::path(outPathValue)));
+	AddLine(TableExternalFileXmlPaths, xmlPathValue);
+	AddLine(TableExternalFileOutPaths, outPathValue);
 }
 
-void GameConfig::ConfigFunc_EnumData(const tinyxml2::XMLElement& element)
+void ConfigCompiler::ConfigFunc_EnumData(const tinyxml2::XMLElement& element)
 {
 	std::string path = Path::GetDirectoryName(configFilePath).string();
 	path = path.append("/").append(element.Attribute("File"));
@@ -177,6 +352,8 @@ void GameConfig::ConfigFunc_EnumData(const tinyxml2::XMLElement& element)
 		throw std::runtime_error("Error: Unable to read enum data.");
 	}
 
+	inputFiles.push_back(path);
+
 	tinyxml2::XMLNode* root = doc.FirstChild();
 
 	if (root == nullptr)
@@ -185,94 +362,40 @@ void GameConfig::ConfigFunc_EnumData(const tinyxml2::XMLElement& element)
 	for (tinyxml2::XMLElement* csEnum = root->FirstChildElement(); csEnum != nullptr;
 	     csEnum = csEnum->NextSiblingElement())
 	{
+		const char* enumKey = csEnum->Attribute("Key");
+		if (enumKey == nullptr)
+			continue;
+
+		auto it = EnumTables.find(enumKey);
+		if (it == EnumTables.end())
+			continue;
+
 		for (tinyxml2::XMLElement* item = csEnum->FirstChildElement(); item != nullptr;
 		     item = item->NextSiblingElement())
 		{
-			std::string enumKey = csEnum->Attribute("Key");
 			uint16_t itemIndex = atoi(item->Attribute("Index"));
 			const char* itemID = item->Attribute("ID");
 
-			// Common
-			if (enumKey == "cmd")
-				enumData.cutsceneCmd[itemIndex] = itemID;
-
-			else if (enumKey == "miscType")
-				enumData.miscType[itemIndex] = itemID;
-
-			else if (enumKey == "textType")
-				enumData.textType[itemIndex] = itemID;
-
-			else if (enumKey == "fadeOutSeqPlayer")
-				enumData.fadeOutSeqPlayer[itemIndex] = itemID;
-
-			else if (enumKey == "transitionType")
-				enumData.transitionType[itemIndex] = itemID;
-
-			else if (enumKey == "destination")
-				enumData.destination[itemIndex] = itemID;
-
-			else if (enumKey == "naviQuestHintType")
-				enumData.naviQuestHintType[itemIndex] = itemID;
-
-			else if (enumKey == "ocarinaSongActionId")
-				enumData.ocarinaSongActionId[itemIndex] = itemID;
-
-			else if (enumKey == "seqId")
-				enumData.seqId[itemIndex] = itemID;
-
-			else if (enumKey == "playerCueId")
-				enumData.playerCueId[itemIndex] = itemID;
-
-			// MM
-			else if (enumKey == "modifySeqType")
-				enumData.modifySeqType[itemIndex] = itemID;
-
-			else if (enumKey == "chooseCreditsSceneType")
-				enumData.chooseCreditsSceneType[itemIndex] = itemID;
-
-			else if (enumKey == "destinationType")
-				enumData.destinationType[itemIndex] = itemID;
-
-			else if (enumKey == "motionBlurType")
-				enumData.motionBlurType[itemIndex] = itemID;
-
-			else if (enumKey == "transitionGeneralType")
-				enumData.transitionGeneralType[itemIndex] = itemID;
-
-			else if (enumKey == "rumbleType")
-				enumData.rumbleType[itemIndex] = itemID;
-
-			else if (enumKey == "spawnFlag")
-				enumData.spawnFlag[itemIndex] = itemID;
-
-			else if (enumKey == "endSfx")
-				enumData.endSfx[itemIndex] = itemID;
-
-			else if (enumKey == "csSplineInterpType")
-				enumData.interpType[itemIndex] = itemID;
-
-			else if (enumKey == "csSplineRelTo")
-				enumData.relTo[itemIndex] = itemID;
+			AddEntry(it->second.table, itemIndex & it->second.keyMask, itemID);
 		}
 	}
 }
 
-void GameConfig::ReadConfigFile(const fs::path& argConfigFilePath)
+void ConfigCompiler::ReadConfigFile()
 {
 	static const std::unordered_map<std::string, ConfigFunc> ConfigFuncDictionary = {
-		{"SymbolMap", &GameConfig::ConfigFunc_SymbolMap},
-		{"ActorList", &GameConfig::ConfigFunc_ActorList},
-		{"ObjectList", &GameConfig::ConfigFunc_ObjectList},
-		{"EntranceList", &GameConfig::ConfigFunc_EntranceList},
-		{"SpecialEntranceList", &GameConfig::ConfigFunc_specialEntranceList},
-		{"TexturePool", &GameConfig::ConfigFunc_TexturePool},
-		{"BGConfig", &GameConfig::ConfigFunc_BGConfig},
-		{"EnumData", &GameConfig::ConfigFunc_EnumData},
-		{"ExternalXMLFolder", &GameConfig::ConfigFunc_ExternalXMLFolder},
-		{"ExternalFile", &GameConfig::ConfigFunc_ExternalFile},
+		{"SymbolMap", &ConfigCompiler::ConfigFunc_SymbolMap},
+		{"ActorList", &ConfigCompiler::ConfigFunc_ActorList},
+		{"ObjectList", &ConfigCompiler::ConfigFunc_ObjectList},
+		{"EntranceList", &ConfigCompiler::ConfigFunc_EntranceList},
+		{"SpecialEntranceList", &ConfigCompiler::ConfigFunc_specialEntranceList},
+		{"TexturePool", &ConfigCompiler::ConfigFunc_TexturePool},
+		{"BGConfig", &ConfigCompiler::ConfigFunc_BGConfig},
+		{"EnumData", &ConfigCompiler::ConfigFunc_EnumData},
+		{"ExternalXMLFolder", &ConfigCompiler::ConfigFunc_ExternalXMLFolder},
+		{"ExternalFile", &ConfigCompiler::ConfigFunc_ExternalFile},
 	};
 
-	configFilePath = argConfigFilePath.string();
 	tinyxml2::XMLDocument doc;
 	tinyxml2::XMLError eResult = doc.LoadFile(configFilePath.c_str());
 
@@ -281,6 +404,8 @@ void GameConfig::ReadConfigFile(const fs::path& argConfigFilePath)
 		throw std::runtime_error("Error: Unable to read config file.");
 	}
 
+	inputFiles.push_back(configFilePath);
+
 	tinyxml2::XMLNode* root = doc.FirstChild();
 
 	if (root == nullptr)
@@ -299,3 +424,230 @@ void GameConfig::ReadConfigFile(const fs::path& argConfigFilePath)
 		std::invoke(it->second, *this, *child);
 	}
 }
+
+std::vector<uint8_t> ConfigCompiler::Compile()
+{
+	std::vector<CompiledConfigSource> sources;
+	std::vector<ConfigEntry> entries;
+
+	CompiledConfigHeader header = {};
+	header.magic = COMPILED_CONFIG_MAGIC;
+	header.version = COMPILED_CONFIG_VERSION;
+	header.buildHash = Hash::Fnv1a64(gBuildHash);
+	header.configFilePath = strings.Add(configFilePath);
+	header.externalXmlFolder = strings.Add(externalXmlFolder.string());
+	header.bgScreenWidth = bgScreenWidth;
+	header.bgScreenHeight = bgScreenHeight;
+	if (useScreenWidthHeightConstants)
+		header.flags |= COMPILED_CONFIG_FLAG_SCREEN_CONSTANTS;
+
+	// A source which can't be found is never up to date, so the config is compiled every time
+	for (const fs::path& inputFile : inputFiles)
+	{
+		CompiledConfigSource source = {};
+		source.path = strings.Add(inputFile.string());
+		File::GetSizeAndTime(inputFile, source.size, source.time);
+		sources.push_back(source);
+	}
+
+	for (uint32_t i = 0; i < TableCount; i++)
+	{
+		std::vector<ConfigEntry>& table = tables[i];
+		std::stable_sort(table.begin(), table.end(),
+		                 [](const ConfigEntry& a, const ConfigEntry& b) { return a.key < b.key; });
+
+		// A key read several times keeps its last value
+		header.firstEntry[i] = entries.size();
+		for (size_t j = 0; j < table.size(); j++)
+		{
+			if (j + 1 == table.size() || table[j].key != table[j + 1].key)
+				entries.push_back(table[j]);
+		}
+		header.numTableEntries[i] = entries.size() - header.firstEntry[i];
+	}
+
+	header.numSources = sources.size();
+	header.numEntries = entries.size();
+	header.stringsSize = strings.data.size();
+
+	std::vector<uint8_t> data(sizeof(header));
+	data.reserve(GetStringsOffset(header) + header.stringsSize);
+	memcpy(data.data(), &header, sizeof(header));
+	BinaryImage::AppendRecords(data, sources);
+	BinaryImage::AppendRecords(data, entries);
+	data.insert(data.end(), strings.data.begin(), strings.data.end());
+
+	return data;
+}
+
+void GameConfig::ReadConfigFile(const fs::path& argConfigFilePath,
+                                const fs::path& compiledConfigPath)
+{
+	configFilePath = argConfigFilePath.string();
+
+	if (compiledConfigPath != "" && LoadCompiledConfig(compiledConfigPath))
+		return;
+
+	ConfigCompiler compiler(configFilePath);
+	compiler.ReadConfigFile();
+
+	compiledFile.reset();
+	compiledBuffer = compiler.Compile();
+	MapCompiledConfig(compiledBuffer);
+
+	if (compiledConfigPath != "")
+		SaveCompiledConfig(compiledConfigPath);
+}
+
+bool GameConfig::LoadCompiledConfig(const fs::path& compiledConfigPath)
+{
+	fs_error_code ec;
+
+	if (!fs::exists(compiledConfigPath, ec))
+		return false;
+
+	auto file = std::make_unique<MappedFile>(compiledConfigPath);
+	if (!IsValidCompiledConfig(file->GetData()))
+		return false;
+
+	compiledFile = std::move(file);
+	compiledBuffer.clear();
+	MapCompiledConfig(compiledFile->GetData());
+	return true;
+}
+
+void GameConfig::SaveCompiledConfig(const fs::path& compiledConfigPath) const
+{
+	// Other runs may compile the same config at the same time, so it's moved in place once complete
+	fs_error_code ec;
+	fs::create_directories(compiledConfigPath.parent_path(), ec);
+
+	fs::path tempPath = compiledConfigPath;
+	tempPath += StringHelper::Sprintf(".%08X.tmp", std::random_device()());
+	File::WriteAllBytes(tempPath, compiledBuffer);
+
+	fs::rename(tempPath, compiledConfigPath, ec);
+	if (ec)
+		fs::remove(tempPath, ec);
+}
+
+bool GameConfig::IsValidCompiledConfig(const ByteSpan& data) const
+{
+	const CompiledConfigHeader* headerPtr = BinaryImage::GetHeader<CompiledConfigHeader>(
+		data, COMPILED_CONFIG_MAGIC, COMPILED_CONFIG_VERSION);
+	if (headerPtr == nullptr || headerPtr->buildHash != Hash::Fnv1a64(gBuildHash))
+		return false;
+
+	const CompiledConfigHeader& header = *headerPtr;
+	if (!BinaryImage::HasLayout(data, sizeof(CompiledConfigHeader),
+	                            {{header.numSources, sizeof(CompiledConfigSource)},
+	                             {header.numEntries, sizeof(ConfigEntry)}},
+	                            header.stringsSize))
+		return false;
+
+	auto isString = [&header](uint32_t offset) { return offset < header.stringsSize; };
+	const char* strings = reinterpret_cast<const char*>(data.data() + GetStringsOffset(header));
+
+	if (!isString(header.configFilePath) || !isString(header.externalXmlFolder) ||
+	    configFilePath != strings + header.configFilePath)
+		return false;
+
+	for (uint32_t i = 0; i < TableCount; i++)
+	{
+		if (uint64_t(header.firstEntry[i]) + header.numTableEntries[i] > header.numEntries)
+			return false;
+	}
+	if (header.numTableEntries[TableExternalFileXmlPaths] !=
+	    header.numTableEntries[TableExternalFileOutPaths])
+		return false;
+
+	const ConfigEntry* entries =
+		reinterpret_cast<const ConfigEntry*>(data.data() + GetEntriesOffset(header));
+	for (uint32_t i = 0; i < header.numEntries; i++)
+	{
+		if (!isString(entries[i].value))
+			return false;
+	}
+
+	// Any change to a source file makes the config compiled again
+	const CompiledConfigSource* sources =
+		reinterpret_cast<const CompiledConfigSource*>(data.data() + GetSourcesOffset());
+	for (uint32_t i = 0; i < header.numSources; i++)
+	{
+		uint64_t size;
+		int64_t time;
+
+		if (!isString(sources[i].path) ||
+		    !File::GetSizeAndTime(strings + sources[i].path, size, time) || size != sources[i].size ||
+		    time != sources[i].time)
+			return false;
+	}
+
+	return true;
+}
+
+void GameConfig::MapCompiledConfig(const ByteSpan& data)
+{
+	const CompiledConfigHeader& header =
+		*reinterpret_cast<const CompiledConfigHeader*>(data.data());
+	const CompiledConfigSource* sources =
+		reinterpret_cast<const CompiledConfigSource*>(data.data() + GetSourcesOffset());
+	const ConfigEntry* entries =
+		reinterpret_cast<const ConfigEntry*>(data.data() + GetEntriesOffset(header));
+	const char* strings = reinterpret_cast<const char*>(data.data() + GetStringsOffset(header));
+
+	// Points `table` to the entries of the table `id`
+	auto mapTable = [&](auto& table, ConfigTableId id) {
+		using Table = std::decay_t<decltype(table)>;
+		table = Table(entries + header.firstEntry[id], header.numTableEntries[id], strings);
+	};
+
+	inputFiles.clear();
+	for (uint32_t i = 0; i < header.numSources; i++)
+		inputFiles.push_back(strings + sources[i].path);
+
+	mapTable(symbolMap, TableSymbolMap);
+	mapTable(actorList, TableActorList);
+	mapTable(objectList, TableObjectList);
+	mapTable(entranceList, TableEntranceList);
+	mapTable(specialEntranceList, TableSpecialEntranceList);
+	mapTable(texturePool, TableTexturePool);
+
+	// Common
+	mapTable(enumData.cutsceneCmd, TableCutsceneCmd);
+	mapTable(enumData.miscType, TableMiscType);
+	mapTable(enumData.fadeOutSeqPlayer, TableFadeOutSeqPlayer);
+	mapTable(enumData.transitionType, TableTransitionType);
+	mapTable(enumData.naviQuestHintType, TableNaviQuestHintType);
+	mapTable(enumData.ocarinaSongActionId, TableOcarinaSongActionId);
+	mapTable(enumData.seqId, TableSeqId);
+
+	// OoT
+	mapTable(enumData.textType, TableTextType);
+	mapTable(enumData.destination, TableDestination);
+	mapTable(enumData.playerCueId, TablePlayerCueId);
+
+	// MM
+	mapTable(enumData.modifySeqType, TableModifySeqType);
+	mapTable(enumData.chooseCreditsSceneType, TableChooseCreditsSceneType);
+	mapTable(enumData.destinationType, TableDestinationType);
+	mapTable(enumData.motionBlurType, TableMotionBlurType);
+	mapTable(enumData.transitionGeneralType, TableTransitionGeneralType);
+	mapTable(enumData.rumbleType, TableRumbleType);
+	mapTable(enumData.spawnFlag, TableSpawnFlag);
+	mapTable(enumData.endSfx, TableEndSfx);
+	mapTable(enumData.interpType, TableInterpType);
+	mapTable(enumData.relTo, TableRelTo);
+
+	bgScreenWidth = header.bgScreenWidth;
+	bgScreenHeight = header.bgScreenHeight;
+	useScreenWidthHeightConstants = header.flags & COMPILED_CONFIG_FLAG_SCREEN_CONSTANTS;
+
+	externalXmlFolder = strings + header.externalXmlFolder;
+	externalFiles.clear();
+	ConfigList xmlPaths, outPaths;
+	mapTable(xmlPaths, TableExternalFileXmlPaths);
+	mapTable(outPaths, TableExternalFileOutPaths);
+	for (size_t i = 0; i < xmlPaths.size(); i++)
+		externalFiles.push_back(ExternalFile(fs::path(xmlPaths[i]), fs::path(outPaths[i])));
+}
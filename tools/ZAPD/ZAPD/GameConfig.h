@@ -1,16 +1,87 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
-#include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include "Utils/Directory.h"
-#include "tinyxml2.h"
+#include "Utils/MappedFile.h"
 
-struct TexturePoolEntry
+// An entry of a table of the compiled config: a key and the offset of its string
+struct ConfigEntry
 {
-	fs::path path = "";  // Path to Shared Texture
+	uint32_t key;
+	uint32_t value;
+};
+
+/**
+ * A table of the config, looked up in place in the compiled config: the string of every key,
+ * sorted by key. Keys are stored as `Key`, so looking up a wider value truncates it like a
+ * `std::map<Key, std::string>` would.
+ */
+template <typename Key>
+class ConfigTable
+{
+public:
+	ConfigTable() = default;
+	ConfigTable(const ConfigEntry* nEntries, size_t nCount, const char* nStrings)
+		: entries(nEntries), count(nCount), strings(nStrings)
+	{
+	}
+
+	// Returns the string of `key`, or `nullptr` if there's none
+	const char* Find(Key key) const
+	{
+		const ConfigEntry* last = entries + count;
+		const ConfigEntry* it = std::lower_bound(
+			entries, last, key, [](const ConfigEntry& entry, Key k) { return entry.key < k; });
+
+		if (it == last || it->key != key)
+			return nullptr;
+		return strings + it->value;
+	}
+
+	// Returns the string of `key`, or an empty string if there's none
+	const char* Get(Key key) const
+	{
+		const char* value = Find(key);
+		return value != nullptr ? value : "";
+	}
+
+	// Returns the string of `key`, throwing `std::out_of_range` if there's none
+	const char* At(Key key) const
+	{
+		const char* value = Find(key);
+		if (value == nullptr)
+			throw std::out_of_range("ConfigTable::At: missing key");
+		return value;
+	}
+
+	Key GetKey(size_t index) const { return entries[index].key; }
+	const char* GetValue(size_t index) const { return strings + entries[index].value; }
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+protected:
+	const ConfigEntry* entries = nullptr;
+	size_t count = 0;
+	const char* strings = nullptr;
+};
+
+// A list of the config (one string per line of its file), read in place in the compiled config
+class ConfigList : protected ConfigTable<uint32_t>
+{
+public:
+	using ConfigTable::ConfigTable;
+
+	const char* operator[](size_t index) const { return GetValue(index); }
+
+	using ConfigTable::empty;
+	using ConfigTable::size;
 };
 
 class ExternalFile
@@ -26,45 +97,53 @@ class EnumData
 {
 public:
 	// Common
-	std::map<uint16_t, std::string> cutsceneCmd;
-	std::map<uint16_t, std::string> miscType;
-	std::map<uint16_t, std::string> fadeOutSeqPlayer;
-	std::map<uint16_t, std::string> transitionType;
-	std::map<uint16_t, std::string> naviQuestHintType;
-	std::map<uint16_t, std::string> ocarinaSongActionId;
-	std::map<uint16_t, std::string> seqId;
+	ConfigTable<uint16_t> cutsceneCmd;
+	ConfigTable<uint16_t> miscType;
+	ConfigTable<uint16_t> fadeOutSeqPlayer;
+	ConfigTable<uint16_t> transitionType;
+	ConfigTable<uint16_t> naviQuestHintType;
+	ConfigTable<uint16_t> ocarinaSongActionId;
+	ConfigTable<uint16_t> seqId;
 
 	// OoT
-	std::map<uint16_t, std::string> textType;
-	std::map<uint16_t, std::string> destination;
-	std::map<uint16_t, std::string> playerCueId;
+	ConfigTable<uint16_t> textType;
+	ConfigTable<uint16_t> destination;
+	ConfigTable<uint16_t> playerCueId;
 
 	// MM
-	std::map<uint16_t, std::string> modifySeqType;
-	std::map<uint16_t, std::string> chooseCreditsSceneType;
-	std::map<uint16_t, std::string> destinationType;
-	std::map<uint16_t, std::string> motionBlurType;
-	std::map<uint16_t, std::string> transitionGeneralType;
-	std::map<uint16_t, std::string> rumbleType;
-	std::map<uint8_t, std::string> spawnFlag;
-	std::map<uint8_t, std::string> endSfx;
-	std::map<uint8_t, std::string> interpType;
-	std::map<uint16_t, std::string> relTo;
+	ConfigTable<uint16_t> modifySeqType;
+	ConfigTable<uint16_t> chooseCreditsSceneType;
+	ConfigTable<uint16_t> destinationType;
+	ConfigTable<uint16_t> motionBlurType;
+	ConfigTable<uint16_t> transitionGeneralType;
+	ConfigTable<uint16_t> rumbleType;
+	ConfigTable<uint8_t> spawnFlag;
+	ConfigTable<uint8_t> endSfx;
+	ConfigTable<uint8_t> interpType;
+	ConfigTable<uint16_t> relTo;
 };
 
-class ZFile;
-
+/**
+ * The config of the game, from `Config.xml` and the files it references.
+ *
+ * Those files are compiled into a single buffer: a table of sorted entries per map or list of the
+ * config, and a string table every entry points into. The tables below are looked up in place in
+ * that buffer. With `--compiled-config`, the buffer is also written to a file, which the next runs
+ * map instead of reading the config files. It records the size and modification time of every
+ * file it was compiled from, and is compiled again as soon as one of them changes.
+ */
 class GameConfig
 {
 public:
 	std::string configFilePath;
-	std::map<int32_t, std::vector<ZFile*>> segmentRefFiles;
-	std::map<uint32_t, std::string> symbolMap;
-	std::vector<std::string> actorList;
-	std::vector<std::string> objectList;
-	std::vector<std::string> entranceList;
-	std::vector<std::string> specialEntranceList;
-	std::map<uint32_t, TexturePoolEntry> texturePool;  // Key = CRC
+	// Every file read while loading the config, which every extraction depends on
+	std::vector<fs::path> inputFiles;
+	ConfigTable<uint32_t> symbolMap;
+	ConfigList actorList;
+	ConfigList objectList;
+	ConfigList entranceList;
+	ConfigList specialEntranceList;
+	ConfigTable<uint32_t> texturePool;  // Key = CRC, value = path of the shared texture
 	EnumData enumData;
 
 	// ZBackground
@@ -77,21 +156,21 @@ public:
 	std::vector<ExternalFile> externalFiles;
 
 	GameConfig() = default;
-	~GameConfig();
-
-	void ReadTexturePool(const fs::path& texturePoolXmlPath);
-	void GenSymbolMap(const fs::path& symbolMapPath);
-
-	void ConfigFunc_SymbolMap(const tinyxml2::XMLElement& element);
-	void ConfigFunc_ActorList(const tinyxml2::XMLElement& element);
-	void ConfigFunc_ObjectList(const tinyxml2::XMLElement& element);
-	void ConfigFunc_EntranceList(const tinyxml2::XMLElement& element);
-	void ConfigFunc_specialEntranceList(const tinyxml2::XMLElement& element);
-	void ConfigFunc_TexturePool(const tinyxml2::XMLElement& element);
-	void ConfigFunc_BGConfig(const tinyxml2::XMLElement& element);
-	void ConfigFunc_ExternalXMLFolder(const tinyxml2::XMLElement& element);
-	void ConfigFunc_ExternalFile(const tinyxml2::XMLElement& element);
-	void ConfigFunc_EnumData(const tinyxml2::XMLElement& element);
-
-	void ReadConfigFile(const fs::path& configFilePath);
+
+	/**
+	 * Loads the config from `configFilePath`. If `compiledConfigPath` isn't empty, it's mapped
+	 * from there, or compiled and written there if it's missing or outdated.
+	 */
+	void ReadConfigFile(const fs::path& configFilePath, const fs::path& compiledConfigPath = "");
+
+protected:
+	// The compiled config, either mapped from its file or just compiled
+	std::unique_ptr<MappedFile> compiledFile;
+	std::vector<uint8_t> compiledBuffer;
+
+	bool LoadCompiledConfig(const fs::path& compiledConfigPath);
+	void SaveCompiledConfig(const fs::path& compiledConfigPath) const;
+	// Points the tables to `data`, which must have been checked by `IsValidCompiledConfig`
+	void MapCompiledConfig(const ByteSpan& data);
+	bool IsValidCompiledConfig(const ByteSpan& data) const;
 };
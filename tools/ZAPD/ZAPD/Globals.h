@@ -3,7 +3,9 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "ContentStore.h"
 #include "GameConfig.h"
+#include "ImageBackend.h"
 #include "ZFile.h"
 #include "ExporterSet.h"
 
@@ -35,25 +37,32 @@ public:
 	bool testMode;  // Enables certain experimental features
 	bool outputCrc = false;
 	bool profile;  // Measure performance of certain operations
+	fs::path profileTracePath;  // Chrome trace of the profiled operations
 	bool useLegacyZDList;
 	VerbosityLevel verbosity;  // ZAPD outputs additional information
 	ZFileMode fileMode;
 	fs::path baseRomPath, inputPath, outputPath, sourceOutputPath, cfgPath;
+	fs::path inputListPath;  // Extract every XML listed in this file, one job per line
+	fs::path extractionCachePath;  // Skip the XMLs which didn't change since they were extracted
+	fs::path depFilePath;  // Make rule listing the files an extraction read and wrote
+	fs::path externalSnapshotsPath;  // Snapshots of the external XMLs, mapped instead of parsed
+	fs::path compiledConfigPath;  // Compiled config, mapped instead of reading the config files
+	fs::path referencePath;  // Object compiled from the extracted C file, compared by `vobj`
+	ContentStore contentStore;  // Binary outputs shared between extractions
 	TextureType texType;
 	CsFloatType floatType = CsFloatType::FloatOnly;
+	PngEncodeProfile pngProfile;  // How extracted textures are compressed
 	int64_t baseAddress = -1;
 	int64_t startOffset = -1;
 	int64_t endOffset = -1;
-	ZGame game;
 	GameConfig cfg;
 	bool verboseUnaccounted = false;
 	bool gccCompat = false;
 	bool forceStatic = false;
 	bool forceUnaccountedStatic = false;
-
-	std::vector<ZFile*> files;
-	std::vector<ZFile*> externalFiles;
-	std::vector<int32_t> segments;
+	bool useIncbin = false;  // Assemble textures and blobs from their binary files with `.incbin`
+	bool emitObjects = false;  // Write an ELF object next to every extracted source file
+	uint32_t numThreads = 0;  // Worker threads for batch modes, 0 uses every available core
 
 	std::string currentExporter;
 	static std::map<std::string, ExporterSet*>& GetExporterMap();
@@ -62,29 +71,6 @@ public:
 	Globals();
 	~Globals();
 
-	void AddSegment(int32_t segment, ZFile* file);
-	bool HasSegment(int32_t segment);
-
 	ZResourceExporter* GetExporter(ZResourceType resType);
 	ExporterSet* GetExporterSet();
-
-	/**
-	 * Search in every file (and the symbol map) for the `segAddress` passed as parameter.
-	 * If the segment of `currentFile` is the same segment of `segAddress`, then that file will be
-	 * used only, otherwise, the search will be performed in every other file.
-	 * The name of that variable will be stored in the `declName` parameter.
-	 * Returns `true` if the address is found. `false` otherwise,
-	 * in which case `declName` will be set to the address formatted as a pointer.
-	 */
-	bool GetSegmentedPtrName(segptr_t segAddress, ZFile* currentFile,
-	                         const std::string& expectedType, std::string& declName,
-	                         bool warnIfNotFound = true);
-
-	bool GetSegmentedArrayIndexedName(segptr_t segAddress, size_t elementSize, ZFile* currentFile,
-	                                  const std::string& expectedType, std::string& declName,
-	                                  bool warnIfNotFound = true);
-
-	// TODO: consider moving to another place
-	void WarnHardcodedPointer(segptr_t segAddress, ZFile* currentFile, ZResource* res,
-	                          offset_t currentOffset);
 };
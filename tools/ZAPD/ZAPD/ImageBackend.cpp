@@ -2,12 +2,36 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+#include <new>
 #include <png.h>
 #include <stdexcept>
+#include <zlib.h>
 
+#include "Utils/File.h"
+#include "Utils/Profiler.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 
+/* PngEncodeProfile */
+
+bool PngEncodeProfile::FromName(const std::string& name, PngEncodeProfile& profile)
+{
+	if (name == "default")
+		profile = {};
+	else if (name == "fast")
+		profile = {1, Z_RLE, PNG_FILTER_NONE};
+	else
+		return false;
+
+	return true;
+}
+
+const char* PngEncodeProfile::GetNames()
+{
+	return "default, fast";
+}
+
 /* ImageBackend */
 
 ImageBackend::~ImageBackend()
@@ -89,6 +113,10 @@ void ImageBackend::ReadPng(const char* filename)
 	{
 		// png_set_palette_to_rgb(png);
 		isColorIndexed = true;
+
+		// One index per byte
+		if (bitDepth < 8)
+			png_set_packing(png);
 	}
 
 	// PNG_COLOR_TYPE_GRAY_ALPHA is always 8 or 16bit depth.
@@ -109,14 +137,14 @@ void ImageBackend::ReadPng(const char* filename)
 
 	png_read_update_info(png, info);
 
+	// Describe the rows as the transformations above left them
+	colorType = png_get_color_type(png, info);
+	bitDepth = png_get_bit_depth(png, info);
+
 	size_t rowBytes = png_get_rowbytes(png, info);
-	pixelMatrix = (uint8_t**)malloc(sizeof(uint8_t*) * height);
-	for (size_t y = 0; y < height; y++)
-	{
-		pixelMatrix[y] = (uint8_t*)malloc(rowBytes);
-	}
+	AllocateImageData(rowBytes);
 
-	png_read_image(png, pixelMatrix);
+	png_read_image(png, rowPointers.data());
 
 #ifdef TEXTURE_DEBUG
 	printf("rowBytes: %zu\n", rowBytes);
@@ -129,7 +157,7 @@ void ImageBackend::ReadPng(const char* filename)
 		{
 			for (size_t z = 0; z < bytePerPixel; z++)
 			{
-				printf("%02X ", pixelMatrix[y][x * bytePerPixel + z]);
+				printf("%02X ", rowPointers[y][x * bytePerPixel + z]);
 			}
 			printf(" ");
 		}
@@ -150,17 +178,22 @@ void ImageBackend::ReadPng(const fs::path& filename)
 	ReadPng(filename.c_str());
 }
 
-void ImageBackend::WritePng(const char* filename)
+static void WritePngToBuffer(png_structp png, png_bytep data, size_t length)
+{
+	auto* buffer = static_cast<std::vector<uint8_t>*>(png_get_io_ptr(png));
+	buffer->insert(buffer->end(), data, data + length);
+}
+
+static void FlushPngBuffer([[maybe_unused]] png_structp png)
+{
+}
+
+std::vector<uint8_t> ImageBackend::EncodePng(const PngEncodeProfile& profile)
 {
 	assert(hasImageData);
 
-	FILE* fp = fopen(filename, "wb");
-	if (fp == nullptr)
-	{
-		std::string errorHeader =
-			StringHelper::Sprintf("could not open file '%s' in write mode", filename);
-		HANDLE_ERROR(WarningType::InvalidPNG, errorHeader, "");
-	}
+	std::vector<uint8_t> buffer;
+	buffer.reserve(height * rowSize / 2 + 1024);
 
 	png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
 	if (png == nullptr)
@@ -180,7 +213,14 @@ void ImageBackend::WritePng(const char* filename)
 		HANDLE_ERROR(WarningType::InvalidPNG, "setjmp(png_jmpbuf(png))", "");
 	}
 
-	png_init_io(png, fp);
+	png_set_write_fn(png, &buffer, WritePngToBuffer, FlushPngBuffer);
+
+	if (profile.compressionLevel >= 0)
+		png_set_compression_level(png, profile.compressionLevel);
+	if (profile.compressionStrategy >= 0)
+		png_set_compression_strategy(png, profile.compressionStrategy);
+	if (profile.filters >= 0)
+		png_set_filter(png, PNG_FILTER_TYPE_BASE, profile.filters);
 
 	png_set_IHDR(png, info, width, height,
 	             bitDepth,   // 8,
@@ -219,26 +259,53 @@ void ImageBackend::WritePng(const char* filename)
 	{
 		for (size_t x = 0; x < width * bytePerPixel; x++)
 		{
-			printf("%02X ", pixelMatrix[y][x]);
+			printf("%02X ", rowPointers[y][x]);
 		}
 		printf("\n");
 	}
 	printf("\n");
 #endif
 
-	png_write_image(png, pixelMatrix);
+	png_write_image(png, rowPointers.data());
 	png_write_end(png, nullptr);
 
-	fclose(fp);
-
 	png_destroy_write_struct(&png, &info);
+
+	return buffer;
 }
 
-void ImageBackend::WritePng(const fs::path& filename)
+bool ImageBackend::WritePng(const char* filename, const PngEncodeProfile& profile)
+{
+	// The whole file is encoded in memory, then written at once
+	std::vector<uint8_t> buffer = EncodePng(profile);
+
+	if (File::HasContents(filename, reinterpret_cast<const char*>(buffer.data()), buffer.size(),
+	                      std::ios::binary))
+		return false;
+
+	// It may be linked to another file, which must not be modified
+	std::error_code ec;
+	fs::remove(filename, ec);
+
+	ProfileScope scope("WriteFile", nullptr, filename);
+	FILE* fp = fopen(filename, "wb");
+	if (fp == nullptr)
+	{
+		std::string errorHeader =
+			StringHelper::Sprintf("could not open file '%s' in write mode", filename);
+		HANDLE_ERROR(WarningType::InvalidPNG, errorHeader, "");
+	}
+
+	fwrite(buffer.data(), 1, buffer.size(), fp);
+	fclose(fp);
+	return true;
+}
+
+bool ImageBackend::WritePng(const fs::path& filename, const PngEncodeProfile& profile)
 {
 	// Note: The .string() is necessary for MSVC, due to the implementation of std::filesystem
 	// differing from GCC. Do not remove!
-	WritePng(filename.string().c_str());
+	return WritePng(filename.string().c_str(), profile);
 }
 
 void ImageBackend::SetTextureData(const std::vector<std::vector<RGBAPixel>>& texData,
@@ -254,18 +321,17 @@ void ImageBackend::SetTextureData(const std::vector<std::vector<RGBAPixel>>& tex
 
 	size_t bytePerPixel = GetBytesPerPixel();
 
-	pixelMatrix = static_cast<uint8_t**>(malloc(sizeof(uint8_t*) * height));
+	AllocateImageData(width * bytePerPixel);
 	for (size_t y = 0; y < height; y++)
 	{
-		pixelMatrix[y] = static_cast<uint8_t*>(malloc(sizeof(uint8_t*) * width * bytePerPixel));
 		for (size_t x = 0; x < width; x++)
 		{
-			pixelMatrix[y][x * bytePerPixel + 0] = texData.at(y).at(x).r;
-			pixelMatrix[y][x * bytePerPixel + 1] = texData.at(y).at(x).g;
-			pixelMatrix[y][x * bytePerPixel + 2] = texData.at(y).at(x).b;
+			rowPointers[y][x * bytePerPixel + 0] = texData.at(y).at(x).r;
+			rowPointers[y][x * bytePerPixel + 1] = texData.at(y).at(x).g;
+			rowPointers[y][x * bytePerPixel + 2] = texData.at(y).at(x).b;
 
 			if (colorType == PNG_COLOR_TYPE_RGBA)
-				pixelMatrix[y][x * bytePerPixel + 3] = texData.at(y).at(x).a;
+				rowPointers[y][x * bytePerPixel + 3] = texData.at(y).at(x).a;
 		}
 	}
 	hasImageData = true;
@@ -284,11 +350,8 @@ void ImageBackend::InitEmptyRGBImage(uint32_t nWidth, uint32_t nHeight, bool alp
 
 	size_t bytePerPixel = GetBytesPerPixel();
 
-	pixelMatrix = static_cast<uint8_t**>(malloc(sizeof(uint8_t*) * height));
-	for (size_t y = 0; y < height; y++)
-	{
-		pixelMatrix[y] = static_cast<uint8_t*>(calloc(width * bytePerPixel, sizeof(uint8_t*)));
-	}
+	AllocateImageData(width * bytePerPixel);
+	memset(pixels, 0, height * rowSize);
 
 	hasImageData = true;
 }
@@ -304,11 +367,8 @@ void ImageBackend::InitEmptyPaletteImage(uint32_t nWidth, uint32_t nHeight)
 
 	size_t bytePerPixel = GetBytesPerPixel();
 
-	pixelMatrix = (uint8_t**)malloc(sizeof(uint8_t*) * height);
-	for (size_t y = 0; y < height; y++)
-	{
-		pixelMatrix[y] = static_cast<uint8_t*>(calloc(width * bytePerPixel, sizeof(uint8_t*)));
-	}
+	AllocateImageData(width * bytePerPixel);
+	memset(pixels, 0, height * rowSize);
 	colorPalette = calloc(paletteSize, sizeof(png_color));
 	alphaPalette = static_cast<uint8_t*>(calloc(paletteSize, sizeof(uint8_t)));
 
@@ -324,11 +384,11 @@ RGBAPixel ImageBackend::GetPixel(size_t y, size_t x) const
 
 	RGBAPixel pixel;
 	size_t bytePerPixel = GetBytesPerPixel();
-	pixel.r = pixelMatrix[y][x * bytePerPixel + 0];
-	pixel.g = pixelMatrix[y][x * bytePerPixel + 1];
-	pixel.b = pixelMatrix[y][x * bytePerPixel + 2];
+	pixel.r = rowPointers[y][x * bytePerPixel + 0];
+	pixel.g = rowPointers[y][x * bytePerPixel + 1];
+	pixel.b = rowPointers[y][x * bytePerPixel + 2];
 	if (colorType == PNG_COLOR_TYPE_RGBA)
-		pixel.a = pixelMatrix[y][x * bytePerPixel + 3];
+		pixel.a = rowPointers[y][x * bytePerPixel + 3];
 	return pixel;
 }
 
@@ -338,7 +398,42 @@ uint8_t ImageBackend::GetIndexedPixel(size_t y, size_t x) const
 	assert(x < width);
 	assert(isColorIndexed);
 
-	return pixelMatrix[y][x];
+	return rowPointers[y][x];
+}
+
+uint8_t* ImageBackend::GetPixels()
+{
+	assert(hasImageData);
+
+	return pixels;
+}
+
+const uint8_t* ImageBackend::GetPixels() const
+{
+	assert(hasImageData);
+
+	return pixels;
+}
+
+uint8_t* ImageBackend::GetRow(size_t y)
+{
+	assert(hasImageData);
+	assert(y < height);
+
+	return rowPointers[y];
+}
+
+const uint8_t* ImageBackend::GetRow(size_t y) const
+{
+	assert(hasImageData);
+	assert(y < height);
+
+	return rowPointers[y];
+}
+
+size_t ImageBackend::GetRowSize() const
+{
+	return rowSize;
 }
 
 void ImageBackend::SetRGBPixel(size_t y, size_t x, uint8_t nR, uint8_t nG, uint8_t nB, uint8_t nA)
@@ -348,11 +443,11 @@ void ImageBackend::SetRGBPixel(size_t y, size_t x, uint8_t nR, uint8_t nG, uint8
 	assert(x < width);
 
 	size_t bytePerPixel = GetBytesPerPixel();
-	pixelMatrix[y][x * bytePerPixel + 0] = nR;
-	pixelMatrix[y][x * bytePerPixel + 1] = nG;
-	pixelMatrix[y][x * bytePerPixel + 2] = nB;
+	rowPointers[y][x * bytePerPixel + 0] = nR;
+	rowPointers[y][x * bytePerPixel + 1] = nG;
+	rowPointers[y][x * bytePerPixel + 2] = nB;
 	if (colorType == PNG_COLOR_TYPE_RGBA)
-		pixelMatrix[y][x * bytePerPixel + 3] = nA;
+		rowPointers[y][x * bytePerPixel + 3] = nA;
 }
 
 void ImageBackend::SetGrayscalePixel(size_t y, size_t x, uint8_t grayscale, uint8_t alpha)
@@ -362,11 +457,11 @@ void ImageBackend::SetGrayscalePixel(size_t y, size_t x, uint8_t grayscale, uint
 	assert(x < width);
 
 	size_t bytePerPixel = GetBytesPerPixel();
-	pixelMatrix[y][x * bytePerPixel + 0] = grayscale;
-	pixelMatrix[y][x * bytePerPixel + 1] = grayscale;
-	pixelMatrix[y][x * bytePerPixel + 2] = grayscale;
+	rowPointers[y][x * bytePerPixel + 0] = grayscale;
+	rowPointers[y][x * bytePerPixel + 1] = grayscale;
+	rowPointers[y][x * bytePerPixel + 2] = grayscale;
 	if (colorType == PNG_COLOR_TYPE_RGBA)
-		pixelMatrix[y][x * bytePerPixel + 3] = alpha;
+		rowPointers[y][x * bytePerPixel + 3] = alpha;
 }
 
 void ImageBackend::SetIndexedPixel(size_t y, size_t x, uint8_t index, uint8_t grayscale)
@@ -376,7 +471,7 @@ void ImageBackend::SetIndexedPixel(size_t y, size_t x, uint8_t index, uint8_t gr
 	assert(x < width);
 
 	size_t bytePerPixel = GetBytesPerPixel();
-	pixelMatrix[y][x * bytePerPixel + 0] = index;
+	rowPointers[y][x * bytePerPixel + 0] = index;
 
 	assert(index < paletteSize);
 	png_color* pal = static_cast<png_color*>(colorPalette);
@@ -398,33 +493,45 @@ void ImageBackend::SetPaletteIndex(size_t index, uint8_t nR, uint8_t nG, uint8_t
 	alphaPalette[index] = nA;
 }
 
-void ImageBackend::SetPalette(const ImageBackend& pal, uint32_t offset)
+std::vector<RGBAPixel> ImageBackend::GetPaletteColors() const
 {
-	assert(isColorIndexed);
-	size_t bytePerPixel = pal.GetBytesPerPixel();
+	std::vector<RGBAPixel> colors;
+	size_t bytePerPixel = GetBytesPerPixel();
 
-	for (size_t y = 0; y < pal.height; y++)
+	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < pal.width; x++)
+		for (size_t x = 0; x < width; x++)
 		{
-			size_t index = y * pal.width + x;
+			size_t index = y * width + x;
 			if (index >= paletteSize)
 			{
 				/*
 				 * Some TLUTs are bigger than 256 colors.
 				 * For those cases, we will only take the first 256
-				 * to colorize this CI texture.
+				 * to colorize a CI texture.
 				 */
-				return;
+				return colors;
 			}
 
-			uint8_t r = pal.pixelMatrix[y][x * bytePerPixel + 0];
-			uint8_t g = pal.pixelMatrix[y][x * bytePerPixel + 1];
-			uint8_t b = pal.pixelMatrix[y][x * bytePerPixel + 2];
-			uint8_t a = pal.pixelMatrix[y][x * bytePerPixel + 3];
-			SetPaletteIndex(index + offset, r, g, b, a);
+			const uint8_t* pixel = &rowPointers[y][x * bytePerPixel];
+			RGBAPixel color;
+			color.SetRGBA(pixel[0], pixel[1], pixel[2], pixel[3]);
+			colors.push_back(color);
 		}
 	}
+
+	return colors;
+}
+
+void ImageBackend::SetPalette(const std::vector<RGBAPixel>& colors, uint32_t offset)
+{
+	assert(isColorIndexed);
+
+	for (size_t index = 0; index < colors.size(); index++)
+	{
+		const RGBAPixel& color = colors[index];
+		SetPaletteIndex(index + offset, color.r, color.g, color.b, color.a);
+	}
 }
 
 uint32_t ImageBackend::GetWidth() const
@@ -447,6 +554,24 @@ uint8_t ImageBackend::GetBitDepth() const
 	return bitDepth;
 }
 
+PixelLayout ImageBackend::GetPixelLayout() const
+{
+	switch (colorType)
+	{
+	case PNG_COLOR_TYPE_RGBA:
+		return PixelLayout::RGBA;
+
+	case PNG_COLOR_TYPE_RGB:
+		return PixelLayout::RGB;
+
+	case PNG_COLOR_TYPE_PALETTE:
+		return PixelLayout::Index;
+
+	default:
+		HANDLE_ERROR(WarningType::InvalidPNG, "invalid color type", "");
+	}
+}
+
 double ImageBackend::GetBytesPerPixel() const
 {
 	switch (colorType)
@@ -465,14 +590,27 @@ double ImageBackend::GetBytesPerPixel() const
 	}
 }
 
+void ImageBackend::AllocateImageData(size_t nRowSize)
+{
+	rowSize = nRowSize;
+	// One block for the whole image, so there's a single allocation and codecs can go through it
+	// in one go
+	pixels = static_cast<uint8_t*>(
+		operator new[](height * rowSize, std::align_val_t(pixelAlignment)));
+
+	rowPointers.resize(height);
+	for (size_t y = 0; y < height; y++)
+		rowPointers[y] = pixels + y * rowSize;
+}
+
 void ImageBackend::FreeImageData()
 {
-	if (hasImageData)
+	if (pixels != nullptr)
 	{
-		for (size_t y = 0; y < height; y++)
-			free(pixelMatrix[y]);
-		free(pixelMatrix);
-		pixelMatrix = nullptr;
+		operator delete[](pixels, std::align_val_t(pixelAlignment));
+		pixels = nullptr;
+		rowPointers.clear();
+		rowSize = 0;
 	}
 
 	if (isColorIndexed)
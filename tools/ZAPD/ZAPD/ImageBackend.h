@@ -1,10 +1,41 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "Utils/Directory.h"
 
+/**
+ * How the pixels of an `ImageBackend` row are stored.
+ */
+enum class PixelLayout
+{
+	RGB,    // 3 bytes per pixel
+	RGBA,   // 4 bytes per pixel
+	Index,  // 1 byte per pixel, an index into the palette
+};
+
+/**
+ * How `WritePng` compresses PNG files. Every profile stores the same pixels, they only trade file
+ * size for encoding speed. -1 leaves a setting to libpng's default.
+ */
+struct PngEncodeProfile
+{
+	int compressionLevel = -1;     // zlib level, 0 to 9
+	int compressionStrategy = -1;  // Z_DEFAULT_STRATEGY, Z_FILTERED, Z_RLE...
+	int filters = -1;              // PNG_FILTER_* flags libpng chooses the filter of each row from
+
+	/**
+	 * Returns the profile named `name` in `profile`, or false if there's none:
+	 * - `default`: libpng's defaults, the PNGs ZAPD has always written.
+	 * - `fast`: about twice as quick to encode. Meant for PNGs which are only read back by
+	 *   `btex`, like those of a CI extraction.
+	 */
+	static bool FromName(const std::string& name, PngEncodeProfile& profile);
+	static const char* GetNames();
+};
+
 class RGBAPixel
 {
 public:
@@ -27,8 +58,16 @@ public:
 
 	void ReadPng(const char* filename);
 	void ReadPng(const fs::path& filename);
-	void WritePng(const char* filename);
-	void WritePng(const fs::path& filename);
+	/**
+	 * Encodes the image as a PNG file. The file is only written if its contents change, in which
+	 * case `true` is returned.
+	 */
+	bool WritePng(const char* filename, const PngEncodeProfile& profile = {});
+	bool WritePng(const fs::path& filename, const PngEncodeProfile& profile = {});
+	/**
+	 * Returns the PNG file `WritePng` would write.
+	 */
+	std::vector<uint8_t> EncodePng(const PngEncodeProfile& profile = {});
 
 	void SetTextureData(const std::vector<std::vector<RGBAPixel>>& texData, uint32_t nWidth,
 	                    uint32_t nHeight, uint8_t nColorType, uint8_t nBitDepth);
@@ -38,21 +77,41 @@ public:
 	RGBAPixel GetPixel(size_t y, size_t x) const;
 	uint8_t GetIndexedPixel(size_t y, size_t x) const;
 
+	/**
+	 * Returns the pixels of the image, stored as `GetPixelLayout` says, row after row with no
+	 * padding in between. The image can then be read or written in place, as a whole or by rows.
+	 */
+	uint8_t* GetPixels();
+	const uint8_t* GetPixels() const;
+	uint8_t* GetRow(size_t y);
+	const uint8_t* GetRow(size_t y) const;
+	size_t GetRowSize() const;
+
 	void SetRGBPixel(size_t y, size_t x, uint8_t nR, uint8_t nG, uint8_t nB, uint8_t nA = 0);
 	void SetGrayscalePixel(size_t y, size_t x, uint8_t grayscale, uint8_t alpha = 0);
 
 	void SetIndexedPixel(size_t y, size_t x, uint8_t index, uint8_t grayscale);
 	void SetIndexedPixel(size_t y, size_t x, uint8_t index, RGBAPixel pixel);
 	void SetPaletteIndex(size_t index, uint8_t nR, uint8_t nG, uint8_t nB, uint8_t nA);
-	void SetPalette(const ImageBackend& pal, uint32_t offset = 0);
+	/**
+	 * Returns the colors of a TLUT image, as `SetPalette` expects them.
+	 */
+	std::vector<RGBAPixel> GetPaletteColors() const;
+	void SetPalette(const std::vector<RGBAPixel>& colors, uint32_t offset = 0);
 
 	uint32_t GetWidth() const;
 	uint32_t GetHeight() const;
 	uint8_t GetColorType() const;
 	uint8_t GetBitDepth() const;
+	PixelLayout GetPixelLayout() const;
 
 protected:
-	uint8_t** pixelMatrix = nullptr;  // height * [width * bytePerPixel]
+	static constexpr size_t pixelAlignment = 64;
+
+	uint8_t* pixels = nullptr;  // height * rowSize, aligned to `pixelAlignment`
+	size_t rowSize = 0;
+	// Start of each row of `pixels`, for libpng to read and write them
+	std::vector<uint8_t*> rowPointers;
 
 	void* colorPalette = nullptr;
 	uint8_t* alphaPalette = nullptr;
@@ -68,5 +127,6 @@ protected:
 
 	double GetBytesPerPixel() const;
 
+	void AllocateImageData(size_t nRowSize);
 	void FreeImageData();
 };
@@ -1,7 +1,13 @@
+#include "ElfObject.h"
+#include "ExtractionCache.h"
+#include "ExtractionContext.h"
+#include "ExternalFileSnapshot.h"
 #include "Globals.h"
 #include "Utils/Directory.h"
 #include "Utils/File.h"
+#include "Utils/Parallel.h"
 #include "Utils/Path.h"
+#include "Utils/Profiler.h"
 #include "WarningHandler.h"
 #include "ZAnimation.h"
 #include "ZBackground.h"
@@ -12,8 +18,15 @@
 #include <functional>
 #include "CrashHandler.h"
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <unordered_set>
 #include "tinyxml2.h"
 
 using ArgFunc = void (*)(int&, char**);
@@ -40,29 +53,53 @@ void Arg_CsFloatMode(int& i, char* argv[]);
 void Arg_BaseAddress(int& i, char* argv[]);
 void Arg_StartOffset(int& i, char* argv[]);
 void Arg_EndOffset(int& i, char* argv[]);
+void Arg_SetNumThreads(int& i, char* argv[]);
+void Arg_SetInputListPath(int& i, char* argv[]);
+void Arg_SetExtractionCachePath(int& i, char* argv[]);
+void Arg_SetContentStorePath(int& i, char* argv[]);
+void Arg_SetPngProfile(int& i, char* argv[]);
+void Arg_SetProfileTracePath(int& i, char* argv[]);
+void Arg_SetDepFilePath(int& i, char* argv[]);
+void Arg_EnableIncbin(int& i, char* argv[]);
+void Arg_EnableObjectEmission(int& i, char* argv[]);
+void Arg_SetReferencePath(int& i, char* argv[]);
+void Arg_SetExternalSnapshotsPath(int& i, char* argv[]);
+void Arg_SetCompiledConfigPath(int& i, char* argv[]);
 
 int main(int argc, char* argv[]);
 
-bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path& outPath,
-		   ZFileMode fileMode);
+bool Parse(ExtractionContext& ctx, const fs::path& xmlFilePath, const fs::path& basePath,
+		   const fs::path& outPath, ZFileMode fileMode);
+bool ParseExternal(ExtractionContext& ctx, const fs::path& xmlFilePath, const fs::path& basePath,
+				   const fs::path& outPath);
 
 void ParseArgs(int& argc, char* argv[]);
 
 void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType, const fs::path& outPath);
 void BuildAssetBackground(const fs::path& imageFilePath, const fs::path& outPath);
 void BuildAssetBlob(const fs::path& blobFilePath, const fs::path& outPath);
+int BuildAssetBatch(const fs::path& manifestFilePath);
+int VerifyObject(const fs::path& objectPath, const fs::path& referencePath);
 ZFileMode ParseFileMode(const std::string& buildMode, ExporterSet* exporterSet);
 int HandleExtract(ZFileMode fileMode, ExporterSet* exporterSet);
+bool ExtractXml(ExtractionContext& ctx, ZFileMode fileMode);
+int ExtractInputList(ZFileMode fileMode);
+std::string GetExtractionCacheOptions(int argc, char* argv[]);
+void ReportProfile();
 
 extern const char gBuildHash[];
 
+// The build hash and the arguments every job is extracted with, see `GetExtractionCacheOptions`
+static std::string sExtractionCacheOptions;
+
 int main(int argc, char* argv[])
 {
 	int returnCode = 0;
 
 	if (argc < 2)
 	{
-		printf("ZAPD.out (%s) [mode (btex/bovl/bsf/bblb/bmdlintr/bamnintr/e)] ...\n", gBuildHash);
+		printf("ZAPD.out (%s) [mode (btex/bovl/bsf/bblb/bbatch/vobj/bmdlintr/bamnintr/e)] ...\n",
+		       gBuildHash);
 		return 1;
 	}
 
@@ -89,6 +126,16 @@ int main(int argc, char* argv[])
 
 	ParseArgs(argc, argv);
 
+	// Read once every argument is known, since `--compiled-config` may come after `-rconf`
+	if (Globals::Instance->cfgPath != "")
+	{
+		Globals::Instance->cfg.ReadConfigFile(Globals::Instance->cfgPath,
+		                                      Globals::Instance->compiledConfigPath);
+	}
+
+	if (Globals::Instance->extractionCachePath != "")
+		sExtractionCacheOptions = GetExtractionCacheOptions(argc, argv);
+
 	// Parse File Mode
 	ExporterSet* exporterSet = Globals::Instance->GetExporterSet();
 	std::string buildMode = argv[1];
@@ -123,14 +170,43 @@ int main(int argc, char* argv[])
 		BuildAssetBackground(Globals::Instance->inputPath, Globals::Instance->outputPath);
 	else if (fileMode == ZFileMode::BuildBlob)
 		BuildAssetBlob(Globals::Instance->inputPath, Globals::Instance->outputPath);
+	else if (fileMode == ZFileMode::BuildBatch)
+		returnCode = BuildAssetBatch(Globals::Instance->inputPath);
+	else if (fileMode == ZFileMode::VerifyObject)
+		returnCode = VerifyObject(Globals::Instance->inputPath, Globals::Instance->referencePath);
+
+	if (Globals::Instance->profile)
+		ReportProfile();
 
 	delete g;
 	return returnCode;
 }
 
-bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path& outPath,
-		   ZFileMode fileMode)
+bool Parse(ExtractionContext& ctx, const fs::path& xmlFilePath, const fs::path& basePath,
+		   const fs::path& outPath, ZFileMode fileMode)
 {
+	// The files of external XMLs are only used to look up names, which their snapshot already has
+	std::unique_ptr<ExternalFileSnapshot> snapshot;
+	if (fileMode == ZFileMode::ExternalFile && Globals::Instance->externalSnapshotsPath != "")
+	{
+		snapshot = std::make_unique<ExternalFileSnapshot>(xmlFilePath, basePath, ctx.game);
+		if (snapshot->Load())
+		{
+			return snapshot->Restore(
+				ctx, basePath, outPath,
+				[&](const std::string& externalXmlPath, const std::string& externalOutPath) {
+					fs::path externalXmlFilePath =
+						Globals::Instance->cfg.externalXmlFolder / fs::path(externalXmlPath);
+
+					if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+						printf("Parsing external file: '%s'\n", externalXmlFilePath.c_str());
+
+					return ParseExternal(ctx, externalXmlFilePath, basePath,
+					                     fs::path(externalOutPath));
+				});
+		}
+	}
+
 	tinyxml2::XMLDocument doc;
 	tinyxml2::XMLError eResult = doc.LoadFile(xmlFilePath.string().c_str());
 
@@ -142,6 +218,8 @@ bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path
 		return false;
 	}
 
+	ctx.AddInputFile(xmlFilePath);
+
 	tinyxml2::XMLNode* root = doc.FirstChild();
 
 	if (root == nullptr)
@@ -157,12 +235,14 @@ bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path
 	{
 		if (std::string_view(child->Name()) == "File")
 		{
-			ZFile* file = new ZFile(fileMode, child, basePath, outPath, "", xmlFilePath);
-			Globals::Instance->files.push_back(file);
+			ZFile* file = new ZFile(&ctx, fileMode, child, basePath, outPath, "", xmlFilePath);
+			ctx.files.push_back(file);
 			if (fileMode == ZFileMode::ExternalFile)
 			{
-				Globals::Instance->externalFiles.push_back(file);
+				ctx.externalFiles.push_back(file);
 				file->isExternalFile = true;
+				if (snapshot != nullptr)
+					snapshot->AddFile(file);
 			}
 		}
 		else if (std::string(child->Name()) == "ExternalFile")
@@ -188,13 +268,16 @@ bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path
 				Globals::Instance->cfg.externalXmlFolder / fs::path(xmlPathValue);
 			fs::path externalOutFilePath = fs::path(outPathValue);
 
+			if (snapshot != nullptr)
+				snapshot->AddExternalFile(xmlPathValue, outPathValue);
+
 			if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
 			{
 				printf("Parsing external file: '%s'\n", externalXmlFilePath.c_str());
 			}
 
 			// Recursion. What can go wrong?
-			Parse(externalXmlFilePath, basePath, externalOutFilePath, ZFileMode::ExternalFile);
+			ParseExternal(ctx, externalXmlFilePath, basePath, externalOutFilePath);
 		}
 		else
 		{
@@ -213,7 +296,7 @@ bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path
 		if (exporterSet != nullptr && exporterSet->beginXMLFunc != nullptr)
 			exporterSet->beginXMLFunc();
 
-		for (ZFile* file : Globals::Instance->files)
+		for (ZFile* file : ctx.files)
 		{
 			if (fileMode == ZFileMode::BuildSourceFile)
 				file->BuildSourceFile();
@@ -224,44 +307,129 @@ bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path
 		if (exporterSet != nullptr && exporterSet->endXMLFunc != nullptr)
 			exporterSet->endXMLFunc();
 	}
+	else if (snapshot != nullptr)
+	{
+		snapshot->Save();
+	}
 
 	return true;
 }
 
-void ParseArgs(int& argc, char* argv[])
+// When extracting an input list, each external XML is only parsed once, into a context of its
+// own, and its files are shared by every job which references it.
+static bool sExternalXmlCacheEnabled = false;
+static std::map<std::tuple<fs::path, fs::path, ZGame>, std::unique_ptr<ExtractionContext>>
+	sExternalXmlCache;
+// Recursive since an external XML can reference other external XMLs
+static std::recursive_mutex sExternalXmlCacheMutex;
+
+bool ParseExternal(ExtractionContext& ctx, const fs::path& xmlFilePath, const fs::path& basePath,
+				   const fs::path& outPath)
 {
-	static const std::unordered_map<std::string, ArgFunc> ArgFuncDictionary = {
-		{"-o", &Arg_SetOutputPath},
-		{"--outputpath", &Arg_SetOutputPath},
-		{"-i", &Arg_SetInputPath},
-		{"--inputpath", &Arg_SetInputPath},
-		{"-b", &Arg_SetBaseromPath},
-		{"--baserompath", &Arg_SetBaseromPath},
-		{"-osf", &Arg_SetSourceOutputPath},
-		{"-gsf", &Arg_GenerateSourceFile},
-		{"-tm", &Arg_TestMode},
-		{"-ulzdl", &Arg_LegacyDList},
-		{"-profile", &Arg_EnableProfiling},
-		{"-uer", &Arg_UseExternalResources},
-		{"-tt", &Arg_SetTextureType},
-		{"-rconf", &Arg_ReadConfigFile},
-		{"-eh", &Arg_EnableErrorHandler},
-		{"-v", &Arg_SetVerbosity},
-		{"-vu", &Arg_VerboseUnaccounted},
-		{"--verbose-unaccounted", &Arg_VerboseUnaccounted},
-		{"-se", &Arg_SetExporter},
-		{"--set-exporter", &Arg_SetExporter},
-		{"--gcc-compat", &Arg_EnableGCCCompat},
-		{"-s", &Arg_ForceStatic},
-		{"--static", &Arg_ForceStatic},
-		{"-us", &Arg_ForceUnaccountedStatic},
-		{"--unaccounted-static", &Arg_ForceUnaccountedStatic},
-		{"--cs-float", &Arg_CsFloatMode},
-		{"--base-address", &Arg_BaseAddress},
-		{"--start-offset", &Arg_StartOffset},
-		{"--end-offset", &Arg_EndOffset},
-	};
+	if (!sExternalXmlCacheEnabled)
+		return Parse(ctx, xmlFilePath, basePath, outPath, ZFileMode::ExternalFile);
+
+	std::lock_guard<std::recursive_mutex> lock(sExternalXmlCacheMutex);
+	auto key = std::make_tuple(xmlFilePath, outPath, ctx.game);
+	auto it = sExternalXmlCache.find(key);
+
+	if (it == sExternalXmlCache.end())
+	{
+		auto externalCtx = std::make_unique<ExtractionContext>();
+		externalCtx->game = ctx.game;
+
+		if (!Parse(*externalCtx, xmlFilePath, basePath, outPath, ZFileMode::ExternalFile))
+			return false;
 
+		it = sExternalXmlCache.emplace(key, std::move(externalCtx)).first;
+	}
+
+	// Register the files the same way parsing the XML in this context would have done
+	const ExtractionContext& externalCtx = *it->second;
+	for (ZFile* file : externalCtx.files)
+	{
+		ctx.AddSegment(file->segment, file);
+		ctx.files.push_back(file);
+		ctx.externalFiles.push_back(file);
+	}
+	ctx.inputFiles.insert(ctx.inputFiles.end(), externalCtx.inputFiles.begin(),
+	                      externalCtx.inputFiles.end());
+
+	ctx.game = externalCtx.game;
+	return true;
+}
+
+static const std::unordered_map<std::string, ArgFunc> ArgFuncDictionary = {
+	{"-o", &Arg_SetOutputPath},
+	{"--outputpath", &Arg_SetOutputPath},
+	{"-i", &Arg_SetInputPath},
+	{"--inputpath", &Arg_SetInputPath},
+	{"-b", &Arg_SetBaseromPath},
+	{"--baserompath", &Arg_SetBaseromPath},
+	{"-osf", &Arg_SetSourceOutputPath},
+	{"-gsf", &Arg_GenerateSourceFile},
+	{"-tm", &Arg_TestMode},
+	{"-ulzdl", &Arg_LegacyDList},
+	{"-profile", &Arg_EnableProfiling},
+	{"-uer", &Arg_UseExternalResources},
+	{"-tt", &Arg_SetTextureType},
+	{"-rconf", &Arg_ReadConfigFile},
+	{"-eh", &Arg_EnableErrorHandler},
+	{"-v", &Arg_SetVerbosity},
+	{"-vu", &Arg_VerboseUnaccounted},
+	{"--verbose-unaccounted", &Arg_VerboseUnaccounted},
+	{"-se", &Arg_SetExporter},
+	{"--set-exporter", &Arg_SetExporter},
+	{"--gcc-compat", &Arg_EnableGCCCompat},
+	{"-s", &Arg_ForceStatic},
+	{"--static", &Arg_ForceStatic},
+	{"-us", &Arg_ForceUnaccountedStatic},
+	{"--unaccounted-static", &Arg_ForceUnaccountedStatic},
+	{"--cs-float", &Arg_CsFloatMode},
+	{"--base-address", &Arg_BaseAddress},
+	{"--start-offset", &Arg_StartOffset},
+	{"--end-offset", &Arg_EndOffset},
+	{"-j", &Arg_SetNumThreads},
+	{"--jobs", &Arg_SetNumThreads},
+	{"-il", &Arg_SetInputListPath},
+	{"--input-list", &Arg_SetInputListPath},
+	{"-ec", &Arg_SetExtractionCachePath},
+	{"--extraction-cache", &Arg_SetExtractionCachePath},
+	{"-cs", &Arg_SetContentStorePath},
+	{"--content-store", &Arg_SetContentStorePath},
+	{"--png-profile", &Arg_SetPngProfile},
+	{"--profile-trace", &Arg_SetProfileTracePath},
+	{"-M", &Arg_SetDepFilePath},
+	{"--depfile", &Arg_SetDepFilePath},
+	{"--incbin", &Arg_EnableIncbin},
+	{"--emit-objects", &Arg_EnableObjectEmission},
+	{"--reference", &Arg_SetReferencePath},
+	{"-xs", &Arg_SetExternalSnapshotsPath},
+	{"--external-snapshots", &Arg_SetExternalSnapshotsPath},
+	{"--compiled-config", &Arg_SetCompiledConfigPath},
+};
+
+// Arguments which can be set per job in an input list, and whether they take a value
+static const std::unordered_map<std::string, bool> JobArgDictionary = {
+	{"-i", true},
+	{"--inputpath", true},
+	{"-o", true},
+	{"--outputpath", true},
+	{"-osf", true},
+	{"-gsf", true},
+	{"-s", false},
+	{"--static", false},
+	{"-us", false},
+	{"--unaccounted-static", false},
+	{"--base-address", true},
+	{"--start-offset", true},
+	{"--end-offset", true},
+	{"-M", true},
+	{"--depfile", true},
+};
+
+void ParseArgs(int& argc, char* argv[])
+{
 	for (int32_t i = 2; i < argc; i++)
 	{
 		std::string arg = argv[i];
@@ -283,6 +451,40 @@ void ParseArgs(int& argc, char* argv[])
 	}
 }
 
+/**
+ * Joins the build hash and every argument which can change the extracted files, so changing any
+ * of them makes the extraction cache extract everything again.
+ */
+std::string GetExtractionCacheOptions(int argc, char* argv[])
+{
+	// Arguments which don't change what is extracted. All of them take a value.
+	static const std::unordered_set<std::string_view> ignoredArgs = {
+		"-j",       "--jobs",          "-il", "--input-list", "-ec", "--extraction-cache",
+		"-cs",      "--content-store", "-profile", "--profile-trace",
+		"-xs",      "--external-snapshots", "--compiled-config", "-v",
+	};
+
+	std::string options = gBuildHash;
+
+	for (int32_t i = 1; i < argc; i++)
+	{
+		if (ignoredArgs.find(argv[i]) != ignoredArgs.end())
+		{
+			i++;
+			continue;
+		}
+
+		// Warning args only change what is printed, and none of them takes a separate value
+		if (argv[i][0] == '-' && argv[i][1] == 'W' && argv[i][2] != '\0')
+			continue;
+
+		options += '\n';
+		options += argv[i];
+	}
+
+	return options;
+}
+
 ZFileMode ParseFileMode(const std::string& buildMode, ExporterSet* exporterSet)
 {
 	ZFileMode fileMode = ZFileMode::Invalid;
@@ -295,6 +497,10 @@ ZFileMode ParseFileMode(const std::string& buildMode, ExporterSet* exporterSet)
 		fileMode = ZFileMode::BuildSourceFile;
 	else if (buildMode == "bblb")
 		fileMode = ZFileMode::BuildBlob;
+	else if (buildMode == "bbatch")
+		fileMode = ZFileMode::BuildBatch;
+	else if (buildMode == "vobj")
+		fileMode = ZFileMode::VerifyObject;
 	else if (buildMode == "e")
 		fileMode = ZFileMode::Extract;
 	else if (exporterSet != nullptr && exporterSet->parseFileModeFunc != nullptr)
@@ -346,6 +552,9 @@ void Arg_LegacyDList(int& i, char* argv[])
 void Arg_EnableProfiling(int& i, char* argv[])
 {
 	Globals::Instance->profile = std::string_view(argv[++i]) == "1";
+
+	if (Globals::Instance->profile)
+		Profiler::Enable();
 }
 
 void Arg_UseExternalResources(int& i, char* argv[])
@@ -362,7 +571,7 @@ void Arg_SetTextureType(int& i, char* argv[])
 
 void Arg_ReadConfigFile(int& i, char* argv[])
 {
-	Globals::Instance->cfg.ReadConfigFile(argv[++i]);
+	Globals::Instance->cfgPath = argv[++i];
 }
 
 void Arg_EnableErrorHandler([[maybe_unused]] int& i, [[maybe_unused]] char* argv[])
@@ -456,6 +665,136 @@ void Arg_EndOffset(int& i, char* argv[])
 	Globals::Instance->endOffset = ParseU32Hex(argv[++i]);
 }
 
+void Arg_SetNumThreads(int& i, char* argv[])
+{
+	Globals::Instance->numThreads = std::stoul(argv[++i]);
+}
+
+void Arg_SetInputListPath(int& i, char* argv[])
+{
+	Globals::Instance->inputListPath = argv[++i];
+}
+
+void Arg_SetExtractionCachePath(int& i, char* argv[])
+{
+	Globals::Instance->extractionCachePath = argv[++i];
+}
+
+void Arg_SetContentStorePath(int& i, char* argv[])
+{
+	Globals::Instance->contentStore.SetPath(argv[++i]);
+}
+
+void Arg_SetProfileTracePath(int& i, char* argv[])
+{
+	Globals::Instance->profileTracePath = argv[++i];
+	Globals::Instance->profile = true;
+	Profiler::Enable();
+}
+
+void Arg_SetDepFilePath(int& i, char* argv[])
+{
+	Globals::Instance->depFilePath = argv[++i];
+}
+
+void Arg_EnableIncbin([[maybe_unused]] int& i, [[maybe_unused]] char* argv[])
+{
+	Globals::Instance->useIncbin = true;
+}
+
+void Arg_EnableObjectEmission([[maybe_unused]] int& i, [[maybe_unused]] char* argv[])
+{
+	Globals::Instance->emitObjects = true;
+}
+
+void Arg_SetReferencePath(int& i, char* argv[])
+{
+	Globals::Instance->referencePath = argv[++i];
+}
+
+void Arg_SetExternalSnapshotsPath(int& i, char* argv[])
+{
+	Globals::Instance->externalSnapshotsPath = argv[++i];
+}
+
+void Arg_SetCompiledConfigPath(int& i, char* argv[])
+{
+	Globals::Instance->compiledConfigPath = argv[++i];
+}
+
+void Arg_SetPngProfile(int& i, char* argv[])
+{
+	i++;
+	if (!PngEncodeProfile::FromName(argv[i], Globals::Instance->pngProfile))
+	{
+		HANDLE_ERROR(WarningType::Always, "invalid PNG profile",
+		             StringHelper::Sprintf("Got '%s', expected one of: %s.", argv[i],
+		                                   PngEncodeProfile::GetNames()));
+	}
+}
+
+/**
+ * Loads the extraction cache passed with `-ec`, if any. Returns `nullptr` if there's none, or if
+ * it can't be used in this mode.
+ */
+static std::unique_ptr<ExtractionCache> LoadExtractionCache(ZFileMode fileMode)
+{
+	// Building source files reads files which are not tracked by the cache
+	if (Globals::Instance->extractionCachePath == "" || fileMode != ZFileMode::Extract)
+		return nullptr;
+
+	auto cache = std::make_unique<ExtractionCache>(Globals::Instance->extractionCachePath);
+	cache->Load();
+	return cache;
+}
+
+// Prints the summary of `-profile`, and writes its trace if `--profile-trace` was passed
+void ReportProfile()
+{
+	Profiler::PrintSummary("ParseRawData", "ExtractXml");
+
+	const fs::path& tracePath = Globals::Instance->profileTracePath;
+
+	if (tracePath != "")
+	{
+		if (Profiler::WriteTrace(tracePath))
+			printf("Profile trace written to '%s'\n", tracePath.c_str());
+		else
+			fprintf(stderr, "Error: could not write the profile trace to '%s'\n",
+			        tracePath.c_str());
+	}
+}
+
+static void PrintOutputStats(size_t numWritten, size_t numUnchanged)
+{
+	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+		printf("Outputs: %zu written, %zu unchanged\n", numWritten, numUnchanged);
+}
+
+static void PrintContentStoreStats()
+{
+	const ContentStore& store = Globals::Instance->contentStore;
+
+	if (store.IsEnabled() && Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+		printf("Content store: %zu outputs reused, %zu stored\n", store.GetNumReused(),
+		       store.GetNumStored());
+}
+
+/**
+ * Writes the depfile of a job skipped by the extraction cache from the files it used last time.
+ * It must be written even if nothing changed, or make would find it older than the inputs and run
+ * the extraction again every time.
+ */
+static bool WriteCachedDepFile(ExtractionCache& cache, const std::string& jobId,
+                               ExtractionContext& ctx)
+{
+	if (ctx.depFilePath == "")
+		return true;
+
+	cache.RestoreDependencies(jobId, ctx);
+	return ctx.WriteDepFile();
+}
+
 int HandleExtract(ZFileMode fileMode, ExporterSet* exporterSet)
 {
 	bool procFileModeSuccess = false;
@@ -465,32 +804,300 @@ int HandleExtract(ZFileMode fileMode, ExporterSet* exporterSet)
 
 	if (!procFileModeSuccess)
 	{
-		bool parseSuccessful;
+		if (Globals::Instance->inputListPath != "")
+			return ExtractInputList(fileMode);
 
-		for (auto& extFile : Globals::Instance->cfg.externalFiles)
-		{
-			fs::path externalXmlFilePath =
-				Globals::Instance->cfg.externalXmlFolder / extFile.xmlPath;
+		ExtractionContext ctx;
+		std::unique_ptr<ExtractionCache> cache = LoadExtractionCache(fileMode);
+		std::string jobId = ExtractionCache::GetJobId(ctx);
 
+		if (cache != nullptr && cache->IsUpToDate(jobId, sExtractionCacheOptions))
+		{
 			if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
-				printf("Parsing external file from config: '%s'\n", externalXmlFilePath.c_str());
+				printf("'%s' is up to date\n", ctx.inputPath.c_str());
 
-			parseSuccessful = Parse(externalXmlFilePath, Globals::Instance->baseRomPath,
-									extFile.outPath, ZFileMode::ExternalFile);
-
-			if (!parseSuccessful)
+			if (!WriteCachedDepFile(*cache, jobId, ctx))
+			{
+				fprintf(stderr, "Error: could not write the dependency file '%s'\n",
+				        ctx.depFilePath.c_str());
 				return 1;
+			}
+			return 0;
 		}
 
-		parseSuccessful = Parse(Globals::Instance->inputPath, Globals::Instance->baseRomPath,
-								Globals::Instance->outputPath, fileMode);
-		if (!parseSuccessful)
+		ExtractionContext::SetCurrent(&ctx);
+
+		bool success = ExtractXml(ctx, fileMode);
+		ExtractionContext::SetCurrent(nullptr);
+
+		if (success && ctx.depFilePath != "" && !ctx.WriteDepFile())
+		{
+			fprintf(stderr, "Error: could not write the dependency file '%s'\n",
+			        ctx.depFilePath.c_str());
+			success = false;
+		}
+
+		PrintOutputStats(ctx.numOutputsWritten, ctx.numOutputsUnchanged);
+		PrintContentStoreStats();
+
+		if (cache != nullptr)
+		{
+			if (success)
+				cache->Update(jobId, sExtractionCacheOptions, ctx);
+			else
+				cache->Remove(jobId);
+			cache->Save();
+		}
+
+		if (!success)
 			return 1;
 	}
 
 	return 0;
 }
 
+bool ExtractXml(ExtractionContext& ctx, ZFileMode fileMode)
+{
+	for (auto& extFile : Globals::Instance->cfg.externalFiles)
+	{
+		fs::path externalXmlFilePath = Globals::Instance->cfg.externalXmlFolder / extFile.xmlPath;
+
+		if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+			printf("Parsing external file from config: '%s'\n", externalXmlFilePath.c_str());
+
+		if (!ParseExternal(ctx, externalXmlFilePath, Globals::Instance->baseRomPath,
+		                   extFile.outPath))
+			return false;
+	}
+
+	ProfileScope scope("ExtractXml", nullptr, ctx.inputPath);
+
+	return Parse(ctx, ctx.inputPath, Globals::Instance->baseRomPath, ctx.outputPath, fileMode);
+}
+
+struct ExtractJob
+{
+	size_t lineNum;
+	std::vector<std::string> args;
+	std::unique_ptr<ExtractionContext> ctx;
+	// Only used with an extraction cache
+	std::string cacheJobId, cacheOptions;
+};
+
+// The options an input list job can change, restored to their command line values between jobs
+struct ExtractJobOptions
+{
+	fs::path inputPath, outputPath, sourceOutputPath, depFilePath;
+	bool genSourceFile, forceStatic, forceUnaccountedStatic;
+	int64_t baseAddress, startOffset, endOffset;
+};
+
+static ExtractJobOptions SaveExtractJobOptions()
+{
+	Globals* g = Globals::Instance;
+
+	return {g->inputPath,     g->outputPath,  g->sourceOutputPath,       g->depFilePath,
+	        g->genSourceFile, g->forceStatic, g->forceUnaccountedStatic, g->baseAddress,
+	        g->startOffset,   g->endOffset};
+}
+
+static void RestoreExtractJobOptions(const ExtractJobOptions& options)
+{
+	Globals* g = Globals::Instance;
+
+	g->inputPath = options.inputPath;
+	g->outputPath = options.outputPath;
+	g->sourceOutputPath = options.sourceOutputPath;
+	g->depFilePath = options.depFilePath;
+	g->genSourceFile = options.genSourceFile;
+	g->forceStatic = options.forceStatic;
+	g->forceUnaccountedStatic = options.forceUnaccountedStatic;
+	g->baseAddress = options.baseAddress;
+	g->startOffset = options.startOffset;
+	g->endOffset = options.endOffset;
+}
+
+/**
+ * Extracts every job listed in the input list file. Each non-empty line which doesn't start with
+ * `#` holds the per-XML arguments of a job (`-i`, `-o`, `-osf`, `--base-address`, ...), which are
+ * applied on top of the ones passed in the command line.
+ * Every job gets its own ExtractionContext, so they are extracted in parallel using `-j` worker
+ * threads. The config and the external XMLs are only loaded once and shared by every job.
+ * With an extraction cache (`-ec`), the jobs which are up to date are not extracted again.
+ * A failing job doesn't stop the others from being extracted; every failure is reported at the
+ * end. Returns 1 if any job failed, 0 otherwise.
+ */
+int ExtractInputList(ZFileMode fileMode)
+{
+	const fs::path& inputListPath = Globals::Instance->inputListPath;
+
+	if (!File::Exists(inputListPath))
+	{
+		fprintf(stderr, "Error: input list '%s' does not exist\n", inputListPath.c_str());
+		return 1;
+	}
+
+	std::vector<ExtractJob> jobs;
+	std::vector<std::pair<size_t, std::string>> failures;  // input list line, error message
+	std::mutex failuresMutex;
+	std::vector<std::string> lines = File::ReadAllLines(inputListPath);
+
+	for (size_t lineNum = 1; lineNum <= lines.size(); lineNum++)
+	{
+		std::istringstream line(lines[lineNum - 1]);
+		ExtractJob job = {lineNum, {}, nullptr, "", ""};
+		std::string error;
+
+		for (std::string arg; line >> arg;)
+			job.args.push_back(arg);
+
+		if (job.args.empty() || job.args[0][0] == '#')
+			continue;
+
+		for (size_t i = 0; i < job.args.size() && error.empty(); i++)
+		{
+			auto it = JobArgDictionary.find(job.args[i]);
+
+			if (it == JobArgDictionary.end())
+				error = StringHelper::Sprintf("argument '%s' can't be used in an input list",
+				                              job.args[i].c_str());
+			else if (it->second && ++i >= job.args.size())
+				error = StringHelper::Sprintf("missing value for argument '%s'",
+				                              job.args[i - 1].c_str());
+		}
+
+		if (error.empty())
+			jobs.push_back(std::move(job));
+		else
+			failures.emplace_back(lineNum, error);
+	}
+
+	// The lines which are not valid jobs don't count as extracted
+	size_t numInvalidLines = failures.size();
+
+	// The arguments are parsed into Globals, so every context is created before any job starts
+	ExtractJobOptions defaultOptions = SaveExtractJobOptions();
+
+	for (ExtractJob& job : jobs)
+	{
+		RestoreExtractJobOptions(defaultOptions);
+
+		std::vector<char*> argv;
+		for (std::string& arg : job.args)
+			argv.push_back(arg.data());
+
+		for (int i = 0; i < static_cast<int>(argv.size()); i++)
+			std::invoke(ArgFuncDictionary.at(argv[i]), i, argv.data());
+
+		job.ctx = std::make_unique<ExtractionContext>();
+	}
+
+	RestoreExtractJobOptions(defaultOptions);
+
+	// Drop the jobs whose inputs didn't change since they were extracted
+	std::unique_ptr<ExtractionCache> cache = LoadExtractionCache(fileMode);
+	size_t numUpToDate = 0;
+
+	if (cache != nullptr)
+	{
+		std::vector<ExtractJob> outdatedJobs;
+
+		for (ExtractJob& job : jobs)
+		{
+			job.cacheJobId = ExtractionCache::GetJobId(*job.ctx);
+			job.cacheOptions = sExtractionCacheOptions;
+			for (const std::string& arg : job.args)
+				job.cacheOptions += "\n" + arg;
+
+			// A job whose depfile can't be written is extracted again, which reports the error
+			if (cache->IsUpToDate(job.cacheJobId, job.cacheOptions) &&
+			    WriteCachedDepFile(*cache, job.cacheJobId, *job.ctx))
+				numUpToDate++;
+			else
+				outdatedJobs.push_back(std::move(job));
+		}
+
+		jobs = std::move(outdatedJobs);
+	}
+
+	sExternalXmlCacheEnabled = true;
+	std::atomic<size_t> numOutputsWritten = 0;
+	std::atomic<size_t> numOutputsUnchanged = 0;
+
+	Parallel::For(jobs.size(), Globals::Instance->numThreads, [&](size_t index) {
+		ExtractJob& job = jobs[index];
+		ExtractionContext& ctx = *job.ctx;
+		std::string error;
+
+		if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+			printf("Extracting '%s'\n", ctx.inputPath.c_str());
+
+		ExtractionContext::SetCurrent(&ctx);
+
+		try
+		{
+			if (!ExtractXml(ctx, fileMode))
+				error = StringHelper::Sprintf("failed to extract '%s'", ctx.inputPath.c_str());
+		}
+		catch (const std::exception& e)
+		{
+			error = StringHelper::Sprintf("'%s': %s", ctx.inputPath.c_str(), e.what());
+		}
+
+		ExtractionContext::SetCurrent(nullptr);
+
+		if (error.empty() && ctx.depFilePath != "" && !ctx.WriteDepFile())
+			error = StringHelper::Sprintf("could not write the dependency file '%s'",
+			                              ctx.depFilePath.c_str());
+
+		if (cache != nullptr)
+		{
+			if (error.empty())
+				cache->Update(job.cacheJobId, job.cacheOptions, ctx);
+			else
+				cache->Remove(job.cacheJobId);
+		}
+
+		numOutputsWritten += ctx.numOutputsWritten;
+		numOutputsUnchanged += ctx.numOutputsUnchanged;
+		job.ctx.reset();
+
+		if (!error.empty())
+		{
+			std::lock_guard<std::mutex> lock(failuresMutex);
+			failures.emplace_back(job.lineNum, error);
+		}
+	});
+
+	// Every job is done, so nothing references the shared external files anymore
+	sExternalXmlCache.clear();
+	sExternalXmlCacheEnabled = false;
+
+	if (cache != nullptr)
+		cache->Save();
+
+	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+		printf("Extracted %zu XMLs, %zu failed, %zu up to date\n",
+		       jobs.size() - (failures.size() - numInvalidLines), failures.size(),
+		       numUpToDate);
+	PrintOutputStats(numOutputsWritten, numOutputsUnchanged);
+	PrintContentStoreStats();
+
+	if (failures.empty())
+		return 0;
+
+	std::sort(failures.begin(), failures.end());
+	for (const auto& [lineNum, message] : failures)
+		fprintf(stderr, "Error: %s:%zu: %s\n", inputListPath.c_str(), lineNum, message.c_str());
+	fprintf(stderr, "%zu of the jobs listed in '%s' could not be extracted\n", failures.size(),
+	        inputListPath.c_str());
+
+	return 1;
+}
+
+// The outputs of the build modes are make targets: unlike extraction outputs, they're written even
+// if their contents don't change, so they end up newer than their prerequisites.
+
 void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType, const fs::path& outPath)
 {
 	std::string name = outPath.stem().string();
@@ -506,9 +1113,16 @@ void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType, const f
 	if (File::Exists(cfgPath))
 		name = File::ReadAllText(cfgPath);
 
+	// A `.bin` output is the raw data of the texture, to be assembled with `.incbin`
+	if (outPath.extension() == ".bin")
+	{
+		File::WriteAllBytes(outPath, tex.GetRawTextureData());
+		return;
+	}
+
 	std::string src = tex.GetBodySourceCode();
 
-	File::WriteAllText(outPath.string(), src);
+	File::WriteAllText(outPath, src);
 }
 
 void BuildAssetBackground(const fs::path& imageFilePath, const fs::path& outPath)
@@ -516,7 +1130,7 @@ void BuildAssetBackground(const fs::path& imageFilePath, const fs::path& outPath
 	ZBackground background(nullptr);
 	background.ParseBinaryFile(imageFilePath.string(), false);
 
-	File::WriteAllText(outPath.string(), background.GetBodySourceCode());
+	File::WriteAllText(outPath, background.GetBodySourceCode());
 }
 
 void BuildAssetBlob(const fs::path& blobFilePath, const fs::path& outPath)
@@ -524,9 +1138,159 @@ void BuildAssetBlob(const fs::path& blobFilePath, const fs::path& outPath)
 	ZBlob* blob = ZBlob::FromFile(blobFilePath.string());
 	std::string name = outPath.stem().string();  // filename without extension
 
+	if (outPath.extension() == ".bin")
+	{
+		File::WriteAllBytes(outPath, blob->GetBlobData());
+		delete blob;
+		return;
+	}
+
 	std::string src = blob->GetBodySourceCode();
 
-	File::WriteAllText(outPath.string(), src);
+	File::WriteAllText(outPath, src);
 
 	delete blob;
 }
+
+struct BatchItem
+{
+	size_t lineNum;
+	fs::path inputPath;
+	std::string type;
+	fs::path outputPath;
+};
+
+/**
+ * Runs every btex/bblb/bren conversion listed in a manifest file, using a pool of worker threads.
+ * Each non-empty line of the manifest which doesn't start with `#` has the form
+ * `<input> <type> <output>`, where `type` is either a texture format (`rgba16`, `ci4`, ...),
+ * `blob` or `background`.
+ * A failing item doesn't stop the others from being processed; every failure is reported at the
+ * end. Returns 1 if any item failed, 0 otherwise.
+ */
+int BuildAssetBatch(const fs::path& manifestFilePath)
+{
+	if (!File::Exists(manifestFilePath))
+	{
+		fprintf(stderr, "Error: batch manifest '%s' does not exist\n", manifestFilePath.c_str());
+		return 1;
+	}
+
+	std::vector<BatchItem> items;
+	std::vector<std::pair<size_t, std::string>> failures;  // manifest line, error message
+	std::vector<std::string> lines = File::ReadAllLines(manifestFilePath);
+
+	for (size_t lineNum = 1; lineNum <= lines.size(); lineNum++)
+	{
+		std::istringstream line(lines[lineNum - 1]);
+		std::string input, type, output, extra;
+
+		if (!(line >> input) || input[0] == '#')
+			continue;
+
+		if (!(line >> type >> output) || (line >> extra))
+		{
+			failures.emplace_back(lineNum, "expected '<input> <type> <output>'");
+			continue;
+		}
+
+		items.push_back({lineNum, input, type, output});
+	}
+
+	std::mutex failuresMutex;
+
+	Parallel::For(items.size(), Globals::Instance->numThreads, [&](size_t i) {
+		const BatchItem& item = items[i];
+		std::string error;
+
+		try
+		{
+			if (!File::Exists(item.inputPath))
+				error = "input file does not exist";
+			else if (item.type == "blob")
+				BuildAssetBlob(item.inputPath, item.outputPath);
+			else if (item.type == "background")
+				BuildAssetBackground(item.inputPath, item.outputPath);
+			else
+			{
+				TextureType texType = ZTexture::GetTextureTypeFromString(item.type);
+
+				if (texType == TextureType::Error)
+					error = StringHelper::Sprintf("unknown type '%s'", item.type.c_str());
+				else
+					BuildAssetTexture(item.inputPath, texType, item.outputPath);
+			}
+		}
+		catch (const std::exception& e)
+		{
+			error = e.what();
+		}
+
+		if (!error.empty())
+		{
+			std::lock_guard<std::mutex> lock(failuresMutex);
+			failures.emplace_back(item.lineNum, StringHelper::Sprintf("'%s': %s",
+			                                                          item.inputPath.c_str(),
+			                                                          error.c_str()));
+		}
+	});
+
+	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+		printf("Processed %zu batch items, %zu failed\n", items.size(), failures.size());
+
+	if (failures.empty())
+		return 0;
+
+	std::sort(failures.begin(), failures.end());
+	for (const auto& [lineNum, message] : failures)
+		fprintf(stderr, "Error: %s:%zu: %s\n", manifestFilePath.c_str(), lineNum, message.c_str());
+	fprintf(stderr, "%zu of the items listed in '%s' could not be built\n", failures.size(),
+	        manifestFilePath.c_str());
+
+	return 1;
+}
+
+/**
+ * Compares an object file written with `--emit-objects` with the object compiled from the
+ * extracted C file. Returns 0 if the linker would see no difference between them.
+ */
+int VerifyObject(const fs::path& objectPath, const fs::path& referencePath)
+{
+	for (const fs::path& path : {objectPath, referencePath})
+	{
+		if (!File::Exists(path))
+		{
+			fprintf(stderr, "Error: object file '%s' does not exist\n", path.c_str());
+			return 1;
+		}
+	}
+
+	std::vector<std::string> differences;
+
+	try
+	{
+		ElfObject object = ElfObject::Parse(File::ReadAllBytes(objectPath));
+		ElfObject reference = ElfObject::Parse(File::ReadAllBytes(referencePath));
+		differences = ElfObject::Compare(object, reference);
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "Error: could not compare '%s' with '%s': %s\n", objectPath.c_str(),
+		        referencePath.c_str(), e.what());
+		return 1;
+	}
+
+	if (differences.empty())
+	{
+		if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+			printf("'%s' matches '%s'\n", objectPath.c_str(), referencePath.c_str());
+		return 0;
+	}
+
+	for (const std::string& difference : differences)
+		fprintf(stderr, "%s: %s\n", objectPath.c_str(), difference.c_str());
+	fprintf(stderr, "%zu differences between '%s' and '%s'\n", differences.size(),
+	        objectPath.c_str(), referencePath.c_str());
+
+	return 1;
+}
@@ -33,18 +33,18 @@ const std::unordered_map<CutsceneMM_CommandType, CsCommandListDescriptor> csComm
 };
 
 CutsceneMMSubCommandEntry_GenericCmd::CutsceneMMSubCommandEntry_GenericCmd(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex, CutsceneMM_CommandType cmdId)
+	ByteSpan rawData, offset_t rawDataIndex, CutsceneMM_CommandType cmdId)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex), commandId(cmdId)
 {
 }
 
 std::string CutsceneMMSubCommandEntry_GenericCmd::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 	const auto& element = csCommandsDescMM.find(commandId);
 	std::string entryFmt = "CS_UNK_DATA(0x%02X, %i, %i, %i)";
 	std::string type = "";
-	bool isIndexInSeqId = enumData->seqId.find(base - 1) != enumData->seqId.end();
+	bool isIndexInSeqId = enumData->seqId.Find(base - 1) != nullptr;
 
 	if (element != csCommandsDescMM.end())
 	{
@@ -53,33 +53,33 @@ std::string CutsceneMMSubCommandEntry_GenericCmd::GetBodySourceCode() const
 	}
 
 	if (commandId == CutsceneMM_CommandType::CS_CMD_MISC &&
-	    enumData->miscType.find(base) != enumData->miscType.end())
-		type = enumData->miscType[base];
+	    enumData->miscType.Find(base) != nullptr)
+		type = enumData->miscType.Get(base);
 
 	else if (commandId == CutsceneMM_CommandType::CS_CMD_TRANSITION &&
-	         enumData->transitionType.find(base) != enumData->transitionType.end())
-		type = enumData->transitionType[base];
+	         enumData->transitionType.Find(base) != nullptr)
+		type = enumData->transitionType.Get(base);
 
 	else if (commandId == CutsceneMM_CommandType::CS_CMD_MOTION_BLUR &&
-	         enumData->motionBlurType.find(base) != enumData->motionBlurType.end())
-		type = enumData->motionBlurType[base];
+	         enumData->motionBlurType.Find(base) != nullptr)
+		type = enumData->motionBlurType.Get(base);
 
 	else if (commandId == CutsceneMM_CommandType::CS_CMD_MODIFY_SEQ &&
-	         enumData->modifySeqType.find(base) != enumData->modifySeqType.end())
-		type = enumData->modifySeqType[base];
+	         enumData->modifySeqType.Find(base) != nullptr)
+		type = enumData->modifySeqType.Get(base);
 
 	else if (commandId == CutsceneMM_CommandType::CS_CMD_DESTINATION &&
-	         enumData->destinationType.find(base) != enumData->destinationType.end())
-		type = enumData->destinationType[base];
+	         enumData->destinationType.Find(base) != nullptr)
+		type = enumData->destinationType.Get(base);
 
 	else if (commandId == CutsceneMM_CommandType::CS_CMD_CHOOSE_CREDITS_SCENES &&
-	         enumData->chooseCreditsSceneType.find(base) != enumData->chooseCreditsSceneType.end())
-		type = enumData->chooseCreditsSceneType[base];
+	         enumData->chooseCreditsSceneType.Find(base) != nullptr)
+		type = enumData->chooseCreditsSceneType.Get(base);
 
 	else if ((commandId == CutsceneMM_CommandType::CS_CMD_START_SEQ ||
 	          commandId == CutsceneMM_CommandType::CS_CMD_STOP_SEQ) &&
 	         isIndexInSeqId)
-		type = enumData->seqId[base - 1];
+		type = enumData->seqId.Get(base - 1);
 
 	else if (commandId == CutsceneMM_CommandType::CS_CMD_GIVE_TATL)
 		type = base ? "true" : "false";
@@ -97,8 +97,7 @@ std::string CutsceneMMSubCommandEntry_GenericCmd::GetBodySourceCode() const
 	return StringHelper::Sprintf(entryFmt.c_str(), base, startFrame, endFrame, pad);
 }
 
-CutsceneMMCommand_GenericCmd::CutsceneMMCommand_GenericCmd(const std::vector<uint8_t>& rawData,
-                                                           offset_t rawDataIndex,
+CutsceneMMCommand_GenericCmd::CutsceneMMCommand_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
                                                            CutsceneMM_CommandType cmdId)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -130,7 +129,7 @@ std::string CutsceneMMCommand_GenericCmd::GetCommandMacro() const
 /**** CAMERA ****/
 
 CutsceneSubCommandEntry_SplineCamPoint::CutsceneSubCommandEntry_SplineCamPoint(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	interpType = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0);
@@ -148,8 +147,8 @@ std::string CutsceneSubCommandEntry_SplineCamPoint::GetBodySourceCode() const
 	const auto relToMap = &Globals::Instance->cfg.enumData.relTo;
 
 	return StringHelper::Sprintf("CS_CAM_POINT(%s, 0x%02X, 0x%04X, 0x%04X, 0x%04X, 0x%04X, %s)",
-	                             interpTypeMap->at(interpType).c_str(), weight, duration, posX,
-	                             posY, posZ, relToMap->at(relTo).c_str());
+	                             interpTypeMap->At(interpType), weight, duration, posX, posY,
+	                             posZ, relToMap->At(relTo));
 }
 
 size_t CutsceneSubCommandEntry_SplineCamPoint::GetRawSize() const
@@ -158,7 +157,7 @@ size_t CutsceneSubCommandEntry_SplineCamPoint::GetRawSize() const
 }
 
 CutsceneSubCommandEntry_SplineMiscPoint::CutsceneSubCommandEntry_SplineMiscPoint(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	unused0 = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0);
@@ -179,7 +178,7 @@ size_t CutsceneSubCommandEntry_SplineMiscPoint::GetRawSize() const
 }
 
 CutsceneSubCommandEntry_SplineHeader::CutsceneSubCommandEntry_SplineHeader(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	numEntries = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0);
@@ -200,7 +199,7 @@ size_t CutsceneSubCommandEntry_SplineHeader::GetRawSize() const
 }
 
 CutsceneSubCommandEntry_SplineFooter::CutsceneSubCommandEntry_SplineFooter(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	uint16_t firstHalfWord = BitConverter::ToUInt16BE(rawData, rawDataIndex);
@@ -225,8 +224,7 @@ size_t CutsceneSubCommandEntry_SplineFooter::GetRawSize() const
 	return 0x04;
 }
 
-CutsceneMMCommand_Spline::CutsceneMMCommand_Spline(const std::vector<uint8_t>& rawData,
-                                                   offset_t rawDataIndex)
+CutsceneMMCommand_Spline::CutsceneMMCommand_Spline(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	numHeaders = 0;
@@ -289,7 +287,7 @@ size_t CutsceneMMCommand_Spline::GetCommandSize() const
 /**** TRANSITION GENERAL ****/
 
 CutsceneSubCommandEntry_TransitionGeneral::CutsceneSubCommandEntry_TransitionGeneral(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	unk_06 = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x06);
@@ -302,11 +300,11 @@ CutsceneSubCommandEntry_TransitionGeneral::CutsceneSubCommandEntry_TransitionGen
 
 std::string CutsceneSubCommandEntry_TransitionGeneral::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
-	if (enumData->transitionGeneralType.find(base) != enumData->transitionGeneralType.end())
+	if (enumData->transitionGeneralType.Find(base) != nullptr)
 		return StringHelper::Sprintf("CS_TRANSITION_GENERAL(%s, %i, %i, %i, %i, %i)",
-		                             enumData->transitionGeneralType[base].c_str(), startFrame,
+		                             enumData->transitionGeneralType.Get(base), startFrame,
 		                             endFrame, unk_06, unk_07, unk_08);
 
 	return StringHelper::Sprintf("CS_TRANSITION_GENERAL(0x%02X, %i, %i, %i, %i, %i)", base,
@@ -319,7 +317,7 @@ size_t CutsceneSubCommandEntry_TransitionGeneral::GetRawSize() const
 }
 
 CutsceneMMCommand_TransitionGeneral::CutsceneMMCommand_TransitionGeneral(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -339,7 +337,7 @@ std::string CutsceneMMCommand_TransitionGeneral::GetCommandMacro() const
 }
 
 CutsceneSubCommandEntry_FadeOutSeq::CutsceneSubCommandEntry_FadeOutSeq(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	unk_08 = BitConverter::ToUInt32BE(rawData, rawDataIndex + 8);
@@ -349,11 +347,11 @@ CutsceneSubCommandEntry_FadeOutSeq::CutsceneSubCommandEntry_FadeOutSeq(
 
 std::string CutsceneSubCommandEntry_FadeOutSeq::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
-	if (enumData->fadeOutSeqPlayer.find(base) != enumData->fadeOutSeqPlayer.end())
+	if (enumData->fadeOutSeqPlayer.Find(base) != nullptr)
 		return StringHelper::Sprintf("CS_FADE_OUT_SEQ(%s, %i, %i)",
-		                             enumData->fadeOutSeqPlayer[base].c_str(), startFrame,
+		                             enumData->fadeOutSeqPlayer.Get(base), startFrame,
 		                             endFrame);
 
 	return StringHelper::Sprintf("CS_FADE_OUT_SEQ(%i, %i, %i)", base, startFrame, endFrame);
@@ -364,8 +362,7 @@ size_t CutsceneSubCommandEntry_FadeOutSeq::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneMMCommand_FadeOutSeq::CutsceneMMCommand_FadeOutSeq(const std::vector<uint8_t>& rawData,
-                                                           offset_t rawDataIndex)
+CutsceneMMCommand_FadeOutSeq::CutsceneMMCommand_FadeOutSeq(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -387,13 +384,13 @@ std::string CutsceneMMCommand_FadeOutSeq::GetCommandMacro() const
 /**** NON IMPLEMENTED ****/
 
 CutsceneSubCommandEntry_NonImplemented::CutsceneSubCommandEntry_NonImplemented(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 }
 
 CutsceneMMCommand_NonImplemented::CutsceneMMCommand_NonImplemented(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -410,7 +407,7 @@ CutsceneMMCommand_NonImplemented::CutsceneMMCommand_NonImplemented(
 /**** RUMBLE ****/
 
 CutsceneMMSubCommandEntry_Rumble::CutsceneMMSubCommandEntry_Rumble(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	intensity = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x06);
@@ -420,11 +417,11 @@ CutsceneMMSubCommandEntry_Rumble::CutsceneMMSubCommandEntry_Rumble(
 
 std::string CutsceneMMSubCommandEntry_Rumble::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
-	if (enumData->rumbleType.find(base) != enumData->rumbleType.end())
+	if (enumData->rumbleType.Find(base) != nullptr)
 		return StringHelper::Sprintf("CS_RUMBLE(%s, %i, %i, 0x%02X, 0x%02X, 0x%02X)",
-		                             enumData->rumbleType[base].c_str(), startFrame, endFrame,
+		                             enumData->rumbleType.Get(base), startFrame, endFrame,
 		                             intensity, decayTimer, decayStep);
 
 	return StringHelper::Sprintf("CS_RUMBLE(0x%04X, %i, %i, 0x%02X, 0x%02X, 0x%02X)", base,
@@ -436,8 +433,7 @@ size_t CutsceneMMSubCommandEntry_Rumble::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneMMCommand_Rumble::CutsceneMMCommand_Rumble(const std::vector<uint8_t>& rawData,
-                                                   offset_t rawDataIndex)
+CutsceneMMCommand_Rumble::CutsceneMMCommand_Rumble(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -458,7 +454,7 @@ std::string CutsceneMMCommand_Rumble::GetCommandMacro() const
 
 /**** TEXT ****/
 
-CutsceneMMSubCommandEntry_Text::CutsceneMMSubCommandEntry_Text(const std::vector<uint8_t>& rawData,
+CutsceneMMSubCommandEntry_Text::CutsceneMMSubCommandEntry_Text(ByteSpan rawData,
                                                                offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
@@ -469,7 +465,7 @@ CutsceneMMSubCommandEntry_Text::CutsceneMMSubCommandEntry_Text(const std::vector
 
 std::string CutsceneMMSubCommandEntry_Text::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
 	if (type == 0xFFFF)
 	{
@@ -477,10 +473,10 @@ std::string CutsceneMMSubCommandEntry_Text::GetBodySourceCode() const
 	}
 
 	if (type == 2 &&
-	    enumData->ocarinaSongActionId.find(base) != enumData->ocarinaSongActionId.end())
+	    enumData->ocarinaSongActionId.Find(base) != nullptr)
 	{
 		return StringHelper::Sprintf("CS_TEXT_OCARINA_ACTION(%s, %i, %i, 0x%X)",
-		                             enumData->ocarinaSongActionId[base].c_str(), startFrame,
+		                             enumData->ocarinaSongActionId.Get(base), startFrame,
 		                             endFrame, textId1);
 	}
 
@@ -515,8 +511,7 @@ size_t CutsceneMMSubCommandEntry_Text::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneMMCommand_Text::CutsceneMMCommand_Text(const std::vector<uint8_t>& rawData,
-                                               offset_t rawDataIndex)
+CutsceneMMCommand_Text::CutsceneMMCommand_Text(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -538,7 +533,7 @@ std::string CutsceneMMCommand_Text::GetCommandMacro() const
 /**** ACTOR CUE ****/
 
 CutsceneMMSubCommandEntry_ActorCue::CutsceneMMSubCommandEntry_ActorCue(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	rotX = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x6);
@@ -557,7 +552,7 @@ CutsceneMMSubCommandEntry_ActorCue::CutsceneMMSubCommandEntry_ActorCue(
 
 std::string CutsceneMMSubCommandEntry_ActorCue::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 	std::string normalXStr =
 		ZCutscene::GetCsEncodedFloat(normalX, Globals::Instance->floatType, true);
 	std::string normalYStr =
@@ -569,7 +564,7 @@ std::string CutsceneMMSubCommandEntry_ActorCue::GetBodySourceCode() const
 	{
 		return StringHelper::Sprintf("CS_PLAYER_CUE(%s, %i, %i, 0x%04X, 0x%04X, 0x%04X, %i, %i, "
 		                             "%i, %i, %i, %i, %s, %s, %s)",
-		                             enumData->playerCueId[base].c_str(), startFrame, endFrame,
+		                             enumData->playerCueId.Get(base), startFrame, endFrame,
 		                             rotX, rotY, rotZ, startPosX, startPosY, startPosZ, endPosX,
 		                             endPosY, endPosZ, normalXStr.c_str(), normalYStr.c_str(),
 		                             normalZStr.c_str());
@@ -589,8 +584,7 @@ size_t CutsceneMMSubCommandEntry_ActorCue::GetRawSize() const
 	return 0x30;
 }
 
-CutsceneMMCommand_ActorCue::CutsceneMMCommand_ActorCue(const std::vector<uint8_t>& rawData,
-                                                       offset_t rawDataIndex)
+CutsceneMMCommand_ActorCue::CutsceneMMCommand_ActorCue(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -606,17 +600,17 @@ CutsceneMMCommand_ActorCue::CutsceneMMCommand_ActorCue(const std::vector<uint8_t
 
 std::string CutsceneMMCommand_ActorCue::GetCommandMacro() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
 	if (static_cast<CutsceneMM_CommandType>(commandID) == CutsceneMM_CommandType::CS_CMD_PLAYER_CUE)
 	{
 		return StringHelper::Sprintf("CS_PLAYER_CUE_LIST(%i)", numEntries);
 	}
 
-	if (enumData->cutsceneCmd.find(commandID) != enumData->cutsceneCmd.end())
+	if (enumData->cutsceneCmd.Find(commandID) != nullptr)
 	{
 		return StringHelper::Sprintf("CS_ACTOR_CUE_LIST(%s, %i)",
-		                             enumData->cutsceneCmd[commandID].c_str(), numEntries);
+		                             enumData->cutsceneCmd.Get(commandID), numEntries);
 	}
 	return StringHelper::Sprintf("CS_ACTOR_CUE_LIST(0x%03X, %i)", commandID, numEntries);
 }
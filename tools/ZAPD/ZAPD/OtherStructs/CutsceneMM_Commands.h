@@ -249,7 +249,7 @@ class CutsceneMMSubCommandEntry_GenericCmd : public CutsceneSubCommandEntry
 public:
 	CutsceneMM_CommandType commandId;
 
-	CutsceneMMSubCommandEntry_GenericCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+	CutsceneMMSubCommandEntry_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
 	                                     CutsceneMM_CommandType cmdId);
 
 	std::string GetBodySourceCode() const override;
@@ -258,7 +258,7 @@ public:
 class CutsceneMMCommand_GenericCmd : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_GenericCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+	CutsceneMMCommand_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
 	                             CutsceneMM_CommandType cmdId);
 
 	std::string GetCommandMacro() const override;
@@ -282,8 +282,7 @@ public:
 	uint16_t posZ;
 	uint16_t relTo;
 
-	CutsceneSubCommandEntry_SplineCamPoint(const std::vector<uint8_t>& rawData,
-	                                       offset_t rawDataIndex);
+	CutsceneSubCommandEntry_SplineCamPoint(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -298,8 +297,7 @@ public:
 	uint16_t fov;
 	uint16_t unused1;
 
-	CutsceneSubCommandEntry_SplineMiscPoint(const std::vector<uint8_t>& rawData,
-	                                        offset_t rawDataIndex);
+	CutsceneSubCommandEntry_SplineMiscPoint(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -309,8 +307,7 @@ public:
 class CutsceneSubCommandEntry_SplineFooter : public CutsceneSubCommandEntry
 {
 public:
-	CutsceneSubCommandEntry_SplineFooter(const std::vector<uint8_t>& rawData,
-	                                     offset_t rawDataIndex);
+	CutsceneSubCommandEntry_SplineFooter(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -324,8 +321,7 @@ public:
 	uint16_t unused0;
 	uint16_t unused1;
 	uint16_t duration;
-	CutsceneSubCommandEntry_SplineHeader(const std::vector<uint8_t>& rawData,
-	                                     offset_t rawDataIndex);
+	CutsceneSubCommandEntry_SplineHeader(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -337,7 +333,7 @@ class CutsceneMMCommand_Spline : public CutsceneCommand
 public:
 	uint32_t numHeaders;
 	uint32_t totalCommands;
-	CutsceneMMCommand_Spline(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_Spline(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 	size_t GetCommandSize() const override;
@@ -355,8 +351,7 @@ public:
 	uint8_t unk_0A;
 	uint8_t unk_0B;
 
-	CutsceneSubCommandEntry_TransitionGeneral(const std::vector<uint8_t>& rawData,
-	                                          offset_t rawDataIndex);
+	CutsceneSubCommandEntry_TransitionGeneral(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -366,7 +361,7 @@ public:
 class CutsceneMMCommand_TransitionGeneral : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_TransitionGeneral(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_TransitionGeneral(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -378,7 +373,7 @@ class CutsceneSubCommandEntry_FadeOutSeq : public CutsceneSubCommandEntry
 public:
 	uint32_t unk_08;
 
-	CutsceneSubCommandEntry_FadeOutSeq(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_FadeOutSeq(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -388,7 +383,7 @@ public:
 class CutsceneMMCommand_FadeOutSeq : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_FadeOutSeq(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_FadeOutSeq(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -398,14 +393,13 @@ public:
 class CutsceneSubCommandEntry_NonImplemented : public CutsceneSubCommandEntry
 {
 public:
-	CutsceneSubCommandEntry_NonImplemented(const std::vector<uint8_t>& rawData,
-	                                       offset_t rawDataIndex);
+	CutsceneSubCommandEntry_NonImplemented(ByteSpan rawData, offset_t rawDataIndex);
 };
 
 class CutsceneMMCommand_NonImplemented : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_NonImplemented(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_NonImplemented(ByteSpan rawData, offset_t rawDataIndex);
 };
 
 /**** RUMBLE ****/
@@ -417,7 +411,7 @@ public:
 	uint8_t decayTimer;
 	uint8_t decayStep;
 
-	CutsceneMMSubCommandEntry_Rumble(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMSubCommandEntry_Rumble(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -427,7 +421,7 @@ public:
 class CutsceneMMCommand_Rumble : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_Rumble(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_Rumble(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -441,7 +435,7 @@ public:
 	uint16_t textId1;
 	uint16_t textId2;
 
-	CutsceneMMSubCommandEntry_Text(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMSubCommandEntry_Text(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -451,7 +445,7 @@ public:
 class CutsceneMMCommand_Text : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_Text(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_Text(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -466,7 +460,7 @@ public:
 	int32_t endPosX, endPosY, endPosZ;
 	float normalX, normalY, normalZ;
 
-	CutsceneMMSubCommandEntry_ActorCue(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMSubCommandEntry_ActorCue(ByteSpan rawData, offset_t rawDataIndex);
 	std::string GetBodySourceCode() const override;
 
 	size_t GetRawSize() const override;
@@ -475,7 +469,7 @@ public:
 class CutsceneMMCommand_ActorCue : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_ActorCue(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_ActorCue(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -25,7 +25,7 @@ const std::unordered_map<CutsceneOoT_CommandType, CsCommandListDescriptor> csCom
 };
 
 CutsceneOoTSubCommandEntry_GenericCmd::CutsceneOoTSubCommandEntry_GenericCmd(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex, CutsceneOoT_CommandType cmdId)
+	ByteSpan rawData, offset_t rawDataIndex, CutsceneOoT_CommandType cmdId)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex), commandId(cmdId)
 {
 	word0 = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x0);
@@ -45,27 +45,26 @@ CutsceneOoTSubCommandEntry_GenericCmd::CutsceneOoTSubCommandEntry_GenericCmd(
 
 std::string CutsceneOoTSubCommandEntry_GenericCmd::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 	const auto& element = csCommandsDesc.find(commandId);
 
 	if (element != csCommandsDesc.end())
 	{
-		bool isIndexInMisc = enumData->miscType.find(base) != enumData->miscType.end();
-		bool isIndexInFade =
-			enumData->fadeOutSeqPlayer.find(base) != enumData->fadeOutSeqPlayer.end();
-		bool isIndexInSeqId = enumData->seqId.find(base - 1) != enumData->seqId.end();
+		bool isIndexInMisc = enumData->miscType.Find(base) != nullptr;
+		bool isIndexInFade = enumData->fadeOutSeqPlayer.Find(base) != nullptr;
+		bool isIndexInSeqId = enumData->seqId.Find(base - 1) != nullptr;
 		std::string entryFmt = element->second.cmdMacro;
 		std::string firstArg;
 		entryFmt += element->second.args;
 
 		if (commandId == CutsceneOoT_CommandType::CS_CMD_MISC && isIndexInMisc)
-			firstArg = enumData->miscType[base];
+			firstArg = enumData->miscType.Get(base);
 		else if (commandId == CutsceneOoT_CommandType::CS_CMD_FADE_OUT_SEQ && isIndexInFade)
-			firstArg = enumData->fadeOutSeqPlayer[base];
+			firstArg = enumData->fadeOutSeqPlayer.Get(base);
 		else if (commandId == CutsceneOoT_CommandType::CS_CMD_START_SEQ && isIndexInSeqId)
-			firstArg = enumData->seqId[base - 1];
+			firstArg = enumData->seqId.Get(base - 1);
 		else if (commandId == CutsceneOoT_CommandType::CS_CMD_STOP_SEQ && isIndexInSeqId)
-			firstArg = enumData->seqId[base - 1];
+			firstArg = enumData->seqId.Get(base - 1);
 		else
 		{
 			return StringHelper::Sprintf(entryFmt.c_str(), base - 1, startFrame, endFrame, pad,
@@ -87,7 +86,7 @@ size_t CutsceneOoTSubCommandEntry_GenericCmd::GetRawSize() const
 	return 0x30;
 }
 
-CutsceneOoTCommand_GenericCmd::CutsceneOoTCommand_GenericCmd(const std::vector<uint8_t>& rawData,
+CutsceneOoTCommand_GenericCmd::CutsceneOoTCommand_GenericCmd(ByteSpan rawData,
                                                              offset_t rawDataIndex,
                                                              CutsceneOoT_CommandType cmdId)
 	: CutsceneCommand(rawData, rawDataIndex)
@@ -119,7 +118,7 @@ std::string CutsceneOoTCommand_GenericCmd::GetCommandMacro() const
 
 /**** CAMERA ****/
 
-CutsceneOoTCommand_CameraPoint::CutsceneOoTCommand_CameraPoint(const std::vector<uint8_t>& rawData,
+CutsceneOoTCommand_CameraPoint::CutsceneOoTCommand_CameraPoint(ByteSpan rawData,
                                                                offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
@@ -154,7 +153,7 @@ size_t CutsceneOoTCommand_CameraPoint::GetRawSize() const
 }
 
 CutsceneOoTCommand_GenericCameraCmd::CutsceneOoTCommand_GenericCameraCmd(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	base = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0);
@@ -201,7 +200,7 @@ std::string CutsceneOoTCommand_GenericCameraCmd::GetCommandMacro() const
 		listStr = "CS_CAM_EYE_SPLINE";
 	}
 
-	result += StringHelper::Sprintf("%s(%i, %i)", listStr, startFrame, endFrame);
+	StringHelper::AppendFormat(result, "%s(%i, %i)", listStr, startFrame, endFrame);
 
 	return result;
 }
@@ -214,7 +213,7 @@ size_t CutsceneOoTCommand_GenericCameraCmd::GetCommandSize() const
 /**** RUMBLE ****/
 
 CutsceneOoTSubCommandEntry_Rumble::CutsceneOoTSubCommandEntry_Rumble(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	sourceStrength = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x06);
@@ -237,8 +236,7 @@ size_t CutsceneOoTSubCommandEntry_Rumble::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneOoTCommand_Rumble::CutsceneOoTCommand_Rumble(const std::vector<uint8_t>& rawData,
-                                                     offset_t rawDataIndex)
+CutsceneOoTCommand_Rumble::CutsceneOoTCommand_Rumble(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -260,7 +258,7 @@ std::string CutsceneOoTCommand_Rumble::GetCommandMacro() const
 /**** TEXT ****/
 
 CutsceneOoTSubCommandEntry_Text::CutsceneOoTSubCommandEntry_Text(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	type = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x6);
@@ -270,24 +268,24 @@ CutsceneOoTSubCommandEntry_Text::CutsceneOoTSubCommandEntry_Text(
 
 std::string CutsceneOoTSubCommandEntry_Text::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
 	if (type == 0xFFFF)
 	{
 		return StringHelper::Sprintf("CS_TEXT_NONE(%i, %i)", startFrame, endFrame);
 	}
 	if (type == 2 &&
-	    enumData->ocarinaSongActionId.find(base) != enumData->ocarinaSongActionId.end())
+	    enumData->ocarinaSongActionId.Find(base) != nullptr)
 	{
 		return StringHelper::Sprintf("CS_TEXT_OCARINA_ACTION(%s, %i, %i, 0x%X)",
-		                             enumData->ocarinaSongActionId[base].c_str(), startFrame,
+		                             enumData->ocarinaSongActionId.Get(base), startFrame,
 		                             endFrame, textId1);
 	}
 
-	if (enumData->textType.find(type) != enumData->textType.end())
+	if (enumData->textType.Find(type) != nullptr)
 	{
 		return StringHelper::Sprintf("CS_TEXT(0x%X, %i, %i, %s, 0x%X, 0x%X)", base, startFrame,
-		                             endFrame, enumData->textType[type].c_str(), textId1, textId2);
+		                             endFrame, enumData->textType.Get(type), textId1, textId2);
 	}
 
 	return StringHelper::Sprintf("CS_TEXT(0x%X, %i, %i, %i, 0x%X, 0x%X)", base, startFrame,
@@ -299,8 +297,7 @@ size_t CutsceneOoTSubCommandEntry_Text::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneOoTCommand_Text::CutsceneOoTCommand_Text(const std::vector<uint8_t>& rawData,
-                                                 offset_t rawDataIndex)
+CutsceneOoTCommand_Text::CutsceneOoTCommand_Text(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -322,7 +319,7 @@ std::string CutsceneOoTCommand_Text::GetCommandMacro() const
 /**** ACTOR CUE ****/
 
 CutsceneOoTSubCommandEntry_ActorCue::CutsceneOoTSubCommandEntry_ActorCue(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	rotX = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x6);
@@ -340,7 +337,7 @@ CutsceneOoTSubCommandEntry_ActorCue::CutsceneOoTSubCommandEntry_ActorCue(
 }
 std::string CutsceneOoTSubCommandEntry_ActorCue::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
 	std::string normalXStr =
 		ZCutscene::GetCsEncodedFloat(normalX, Globals::Instance->floatType, true);
@@ -354,7 +351,7 @@ std::string CutsceneOoTSubCommandEntry_ActorCue::GetBodySourceCode() const
 	{
 		return StringHelper::Sprintf("CS_PLAYER_CUE(%s, %i, %i, 0x%04X, 0x%04X, 0x%04X, %i, %i, "
 		                             "%i, %i, %i, %i, %s, %s, %s)",
-		                             enumData->playerCueId[base].c_str(), startFrame, endFrame,
+		                             enumData->playerCueId.Get(base), startFrame, endFrame,
 		                             rotX, rotY, rotZ, startPosX, startPosY, startPosZ, endPosX,
 		                             endPosY, endPosZ, normalXStr.c_str(), normalYStr.c_str(),
 		                             normalZStr.c_str());
@@ -374,8 +371,7 @@ size_t CutsceneOoTSubCommandEntry_ActorCue::GetRawSize() const
 	return 0x30;
 }
 
-CutsceneOoTCommand_ActorCue::CutsceneOoTCommand_ActorCue(const std::vector<uint8_t>& rawData,
-                                                         offset_t rawDataIndex)
+CutsceneOoTCommand_ActorCue::CutsceneOoTCommand_ActorCue(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
@@ -391,26 +387,26 @@ CutsceneOoTCommand_ActorCue::CutsceneOoTCommand_ActorCue(const std::vector<uint8
 
 std::string CutsceneOoTCommand_ActorCue::GetCommandMacro() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
 	if (static_cast<CutsceneOoT_CommandType>(commandID) ==
 	    CutsceneOoT_CommandType::CS_CMD_PLAYER_CUE)
 	{
-		return StringHelper::Sprintf("CS_PLAYER_CUE_LIST(%i)", entries.size());
+		return StringHelper::Sprintf("CS_PLAYER_CUE_LIST(%zu)", entries.size());
 	}
 
-	if (enumData->cutsceneCmd.find(commandID) != enumData->cutsceneCmd.end())
+	if (enumData->cutsceneCmd.Find(commandID) != nullptr)
 	{
-		return StringHelper::Sprintf("CS_ACTOR_CUE_LIST(%s, %i)",
-		                             enumData->cutsceneCmd[commandID].c_str(), entries.size());
+		return StringHelper::Sprintf("CS_ACTOR_CUE_LIST(%s, %zu)",
+		                             enumData->cutsceneCmd.Get(commandID), entries.size());
 	}
 
-	return StringHelper::Sprintf("CS_ACTOR_CUE_LIST(0x%04X, %i)", commandID, entries.size());
+	return StringHelper::Sprintf("CS_ACTOR_CUE_LIST(0x%04X, %zu)", commandID, entries.size());
 }
 
 /**** DESTINATION ****/
 
-CutsceneOoTCommand_Destination::CutsceneOoTCommand_Destination(const std::vector<uint8_t>& rawData,
+CutsceneOoTCommand_Destination::CutsceneOoTCommand_Destination(ByteSpan rawData,
                                                                offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -422,17 +418,18 @@ CutsceneOoTCommand_Destination::CutsceneOoTCommand_Destination(const std::vector
 	unknown = BitConverter::ToUInt16BE(rawData, rawDataIndex + 6);  // endFrame duplicate
 }
 
-std::string CutsceneOoTCommand_Destination::GenerateSourceCode() const
+void CutsceneOoTCommand_Destination::GenerateSourceCode(std::string& output) const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
-	if (enumData->destination.find(base) != enumData->destination.end())
+	if (enumData->destination.Find(base) != nullptr)
 	{
-		return StringHelper::Sprintf("CS_DESTINATION(%s, %i, %i),\n",
-		                             enumData->destination[base].c_str(), startFrame, endFrame);
+		StringHelper::AppendFormat(output, "CS_DESTINATION(%s, %i, %i),\n",
+		                           enumData->destination.Get(base), startFrame, endFrame);
+		return;
 	}
 
-	return StringHelper::Sprintf("CS_DESTINATION(%i, %i, %i),\n", base, startFrame, endFrame);
+	StringHelper::AppendFormat(output, "CS_DESTINATION(%i, %i, %i),\n", base, startFrame, endFrame);
 }
 
 size_t CutsceneOoTCommand_Destination::GetCommandSize() const
@@ -442,7 +439,7 @@ size_t CutsceneOoTCommand_Destination::GetCommandSize() const
 
 /**** TRANSITION ****/
 
-CutsceneOoTCommand_Transition::CutsceneOoTCommand_Transition(const std::vector<uint8_t>& rawData,
+CutsceneOoTCommand_Transition::CutsceneOoTCommand_Transition(ByteSpan rawData,
                                                              offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -453,17 +450,18 @@ CutsceneOoTCommand_Transition::CutsceneOoTCommand_Transition(const std::vector<u
 	endFrame = BitConverter::ToUInt16BE(rawData, rawDataIndex + 4);
 }
 
-std::string CutsceneOoTCommand_Transition::GenerateSourceCode() const
+void CutsceneOoTCommand_Transition::GenerateSourceCode(std::string& output) const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
-	if (enumData->transitionType.find(base) != enumData->transitionType.end())
+	if (enumData->transitionType.Find(base) != nullptr)
 	{
-		return StringHelper::Sprintf("CS_TRANSITION(%s, %i, %i),\n",
-		                             enumData->transitionType[base].c_str(), startFrame, endFrame);
+		StringHelper::AppendFormat(output, "CS_TRANSITION(%s, %i, %i),\n",
+		                           enumData->transitionType.Get(base), startFrame, endFrame);
+		return;
 	}
 
-	return StringHelper::Sprintf("CS_TRANSITION(%i, %i, %i),\n", base, startFrame, endFrame);
+	StringHelper::AppendFormat(output, "CS_TRANSITION(%i, %i, %i),\n", base, startFrame, endFrame);
 }
 
 size_t CutsceneOoTCommand_Transition::GetCommandSize() const
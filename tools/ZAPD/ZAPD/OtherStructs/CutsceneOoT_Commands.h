@@ -157,8 +157,8 @@ public:
 	uint32_t unused9 = 0;
 	uint32_t unused10 = 0;
 
-	CutsceneOoTSubCommandEntry_GenericCmd(const std::vector<uint8_t>& rawData,
-	                                      offset_t rawDataIndex, CutsceneOoT_CommandType cmdId);
+	CutsceneOoTSubCommandEntry_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
+	                                      CutsceneOoT_CommandType cmdId);
 
 	std::string GetBodySourceCode() const override;
 
@@ -168,7 +168,7 @@ public:
 class CutsceneOoTCommand_GenericCmd : public CutsceneCommand
 {
 public:
-	CutsceneOoTCommand_GenericCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+	CutsceneOoTCommand_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
 	                              CutsceneOoT_CommandType cmdId);
 
 	std::string GetCommandMacro() const override;
@@ -186,7 +186,7 @@ public:
 	int16_t posX, posY, posZ;
 	int16_t unused;
 
-	CutsceneOoTCommand_CameraPoint(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTCommand_CameraPoint(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -201,7 +201,7 @@ public:
 	uint16_t endFrame;
 	uint16_t unused;
 
-	CutsceneOoTCommand_GenericCameraCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTCommand_GenericCameraCmd(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 
@@ -217,9 +217,9 @@ public:
 	uint16_t startFrame;
 	uint16_t endFrame;
 
-	CutsceneOoTCommand_Transition(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTCommand_Transition(ByteSpan rawData, offset_t rawDataIndex);
 
-	std::string GenerateSourceCode() const override;
+	void GenerateSourceCode(std::string& output) const override;
 	size_t GetCommandSize() const override;
 };
 
@@ -234,7 +234,7 @@ public:
 	uint8_t unk_09;
 	uint8_t unk_0A;
 
-	CutsceneOoTSubCommandEntry_Rumble(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTSubCommandEntry_Rumble(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -244,7 +244,7 @@ public:
 class CutsceneOoTCommand_Rumble : public CutsceneCommand
 {
 public:
-	CutsceneOoTCommand_Rumble(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTCommand_Rumble(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -258,7 +258,7 @@ public:
 	uint16_t textId1;
 	uint16_t textId2;
 
-	CutsceneOoTSubCommandEntry_Text(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTSubCommandEntry_Text(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -268,7 +268,7 @@ public:
 class CutsceneOoTCommand_Text : public CutsceneCommand
 {
 public:
-	CutsceneOoTCommand_Text(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTCommand_Text(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -283,7 +283,7 @@ public:
 	int32_t endPosX, endPosY, endPosZ;
 	float normalX, normalY, normalZ;
 
-	CutsceneOoTSubCommandEntry_ActorCue(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTSubCommandEntry_ActorCue(ByteSpan rawData, offset_t rawDataIndex);
 	std::string GetBodySourceCode() const override;
 
 	size_t GetRawSize() const override;
@@ -292,7 +292,7 @@ public:
 class CutsceneOoTCommand_ActorCue : public CutsceneCommand
 {
 public:
-	CutsceneOoTCommand_ActorCue(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTCommand_ActorCue(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -307,8 +307,8 @@ public:
 	uint16_t endFrame;
 	uint16_t unknown;
 
-	CutsceneOoTCommand_Destination(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneOoTCommand_Destination(ByteSpan rawData, offset_t rawDataIndex);
 
-	std::string GenerateSourceCode() const override;
+	void GenerateSourceCode(std::string& output) const override;
 	size_t GetCommandSize() const override;
 };
@@ -4,8 +4,7 @@
 
 /* CutsceneSubCommandEntry */
 
-CutsceneSubCommandEntry::CutsceneSubCommandEntry(const std::vector<uint8_t>& rawData,
-                                                 offset_t rawDataIndex)
+CutsceneSubCommandEntry::CutsceneSubCommandEntry(ByteSpan rawData, offset_t rawDataIndex)
 {
 	base = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0);
 	startFrame = BitConverter::ToUInt16BE(rawData, rawDataIndex + 2);
@@ -26,7 +25,7 @@ size_t CutsceneSubCommandEntry::GetRawSize() const
 
 /* CutsceneCommand */
 
-CutsceneCommand::CutsceneCommand(const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+CutsceneCommand::CutsceneCommand(ByteSpan rawData, offset_t rawDataIndex)
 {
 	numEntries = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0);
 }
@@ -44,21 +43,17 @@ std::string CutsceneCommand::GetCommandMacro() const
 	return StringHelper::Sprintf("CMD_W(0x%08X), CMD_W(0x%08X)", commandID, numEntries);
 }
 
-std::string CutsceneCommand::GenerateSourceCode() const
+void CutsceneCommand::GenerateSourceCode(std::string& output) const
 {
-	std::string result;
-
-	result += GetCommandMacro();
-	result += ",\n";
+	output += GetCommandMacro();
+	output += ",\n";
 
 	for (auto& entry : entries)
 	{
-		result += "        ";
-		result += entry->GetBodySourceCode();
-		result += ",\n";
+		output += "        ";
+		output += entry->GetBodySourceCode();
+		output += ",\n";
 	}
-
-	return result;
 }
 
 size_t CutsceneCommand::GetCommandSize() const
@@ -88,7 +83,7 @@ void CutsceneCommand::SetCommandID(uint32_t nCommandID)
 /*** TIME ****/
 
 CutsceneSubCommandEntry_SetTime::CutsceneSubCommandEntry_SetTime(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	hour = BitConverter::ToUInt8BE(rawData, rawDataIndex + 6);
@@ -107,8 +102,7 @@ size_t CutsceneSubCommandEntry_SetTime::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneCommand_Time::CutsceneCommand_Time(const std::vector<uint8_t>& rawData,
-                                           offset_t rawDataIndex)
+CutsceneCommand_Time::CutsceneCommand_Time(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
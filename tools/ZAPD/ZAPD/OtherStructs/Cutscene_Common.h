@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "Declaration.h"
+#include "Utils/ByteSpan.h"
 
 typedef struct CsCommandListDescriptor
 {
@@ -21,7 +22,7 @@ public:
 
 	uint32_t commandID;
 
-	CutsceneSubCommandEntry(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry(ByteSpan rawData, offset_t rawDataIndex);
 	virtual ~CutsceneSubCommandEntry() = default;
 
 	virtual std::string GetBodySourceCode() const;
@@ -38,11 +39,12 @@ public:
 	uint32_t numEntries;
 	std::vector<CutsceneSubCommandEntry*> entries;
 
-	CutsceneCommand(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand(ByteSpan rawData, offset_t rawDataIndex);
 	virtual ~CutsceneCommand();
 
 	virtual std::string GetCommandMacro() const;
-	virtual std::string GenerateSourceCode() const;
+	// Appends the macros of the command and its entries to `output`
+	virtual void GenerateSourceCode(std::string& output) const;
 	virtual size_t GetCommandSize() const;
 
 	virtual void SetCommandID(uint32_t nCommandID);
@@ -56,7 +58,7 @@ public:
 	uint8_t hour;
 	uint8_t minute;
 
-	CutsceneSubCommandEntry_SetTime(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_SetTime(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -66,7 +68,7 @@ public:
 class CutsceneCommand_Time : public CutsceneCommand
 {
 public:
-	CutsceneCommand_Time(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand_Time(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -1,5 +1,6 @@
 #include "SkinLimbStructs.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -203,9 +204,10 @@ std::string SkinLimbModif::GetBodySourceCode() const
 {
 	std::string skinVertices_Str;
 	std::string unk_C_Str;
-	Globals::Instance->GetSegmentedPtrName(skinVertices, parent, "SkinVertex", skinVertices_Str);
-	Globals::Instance->GetSegmentedPtrName(limbTransformations, parent, "SkinTransformation",
-	                                       unk_C_Str);
+	parent->ctx->GetSegmentedPtrName(skinVertices, parent, rawDataIndex + 0x08, "SkinVertex",
+	                                 skinVertices_Str);
+	parent->ctx->GetSegmentedPtrName(limbTransformations, parent, rawDataIndex + 0x0C,
+	                                 "SkinTransformation", unk_C_Str);
 
 	std::string entryStr = StringHelper::Sprintf("\n\t\tARRAY_COUNTU(%s), ARRAY_COUNTU(%s),\n",
 	                                             skinVertices_Str.c_str(), unk_C_Str.c_str());
@@ -307,8 +309,8 @@ void SkinAnimatedLimbData::DeclareReferences(const std::string& prefix)
 
 		int32_t dlistLength = ZDisplayList::GetDListLength(
 			parent->GetRawData(), dlist_Offset,
-			Globals::Instance->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
-		ZDisplayList* dlist_data = new ZDisplayList(parent);
+			parent->ctx->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
+		ZDisplayList* dlist_data = new (parent) ZDisplayList(parent);
 		dlist_data->ExtractFromBinary(dlist_Offset, dlistLength);
 
 		std::string dListStr =
@@ -324,9 +326,9 @@ std::string SkinAnimatedLimbData::GetBodySourceCode() const
 {
 	std::string limbModifications_Str;
 	std::string dlist_Str;
-	Globals::Instance->GetSegmentedPtrName(limbModifications, parent, "SkinLimbModif",
-	                                       limbModifications_Str);
-	Globals::Instance->GetSegmentedPtrName(dlist, parent, "Gfx", dlist_Str);
+	parent->ctx->GetSegmentedPtrName(limbModifications, parent, rawDataIndex + 0x04,
+	                                 "SkinLimbModif", limbModifications_Str);
+	parent->ctx->GetSegmentedPtrName(dlist, parent, rawDataIndex + 0x08, "Gfx", dlist_Str);
 
 	std::string entryStr = "\n";
 	entryStr += StringHelper::Sprintf("\t%i, ARRAY_COUNTU(%s),\n", totalVtxCount,
@@ -1,60 +1,152 @@
 #include "OutputFormatter.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+// Formatted code is written to the file in chunks of about this size
+constexpr size_t FileBufferSize = 0x10000;
+
+constexpr uint64_t RepeatByte(uint8_t c)
+{
+	return 0x0101010101010101ULL * c;
+}
+
+// Nonzero if any byte of `v` is less than `n`, for `n <= 128`
+constexpr uint64_t HasByteLess(uint64_t v, uint8_t n)
+{
+	return (v - RepeatByte(n)) & ~v & RepeatByte(0x80);
+}
+
+constexpr uint64_t SpecialMask =
+	(1ULL << ' ') | (1ULL << '\t') | (1ULL << '\n') | (1ULL << '(') | (1ULL << ')');
+
+// Whitespace and parentheses, the only characters that aren't just appended to the current word
+bool IsSpecial(char c)
+{
+	uint8_t u = static_cast<uint8_t>(c);
+	return u <= ')' && ((SpecialMask >> u) & 1) != 0;
+}
+}  // namespace
+
+void OutputFormatter::Reserve(size_t size)
+{
+	if (len + size > str.size())
+		str.resize(std::max(len + size, 2 * str.size()));
+}
+
 void OutputFormatter::Flush()
 {
 	if (col > lineLimit)
 	{
-		str.append(1, '\n');
-		str.append(currentIndent, ' ');
+		size_t wordSize = len - wordStart;
+		uint32_t newCol = currentIndent + wordSize;
 
-		uint32_t newCol = currentIndent + (wordP - word);
+		// Move the word to the next line instead of after the whitespace
+		Reserve(currentIndent + 1);
+		char* data = &str[0];
+		memmove(data + spaceStart + currentIndent + 1, data + wordStart, wordSize);
+		data[spaceStart] = '\n';
+		memset(data + spaceStart + 1, ' ', currentIndent);
+		len = spaceStart + currentIndent + 1 + wordSize;
 
 		for (uint32_t i = 0; i < wordNests; i++)
 			nestIndent[nest - i] -= col - newCol;
 
 		col = newCol;
 	}
-	else
+
+	spaceStart = len;
+	wordStart = len;
+	wordNests = 0;
+
+	if (file != nullptr && len >= FileBufferSize)
+		FlushFile();
+}
+
+void OutputFormatter::FlushFile()
+{
+	if (len != 0 && fwrite(str.data(), 1, len, file) != len)
+		fileError = true;
+
+	if (!fileChanged && len != 0)
 	{
-		str.append(space, spaceP - space);
+		oldChunk.resize(len);
+		if (fread(&oldChunk[0], 1, len, oldFile) != len || memcmp(&oldChunk[0], &str[0], len) != 0)
+			fileChanged = true;
 	}
-	spaceP = space;
 
-	str.append(word, wordP - word);
-	wordP = word;
-	wordNests = 0;
+	len = 0;
+	spaceStart = 0;
+	wordStart = 0;
 }
 
 int OutputFormatter::Write(const char* buf, int count)
 {
-	for (int i = 0; i < count; i++)
+	const char* p = buf;
+	const char* end = buf + count;
+
+	// A tab is the only character that can take more than a byte
+	Reserve(count * tabSize);
+	char* out = &str[len];
+
+	while (p < end)
 	{
-		char c = buf[i];
+		// Fast path: the characters up to the next whitespace or parenthesis only extend the word.
+		// They are all above ')', so any 8 bytes that are too can be copied at once.
+		const char* runStart = p;
+
+		while (end - p >= 8)
+		{
+			uint64_t v;
+			memcpy(&v, p, sizeof(v));
+			if (HasByteLess(v, ')' + 1) != 0)
+				break;
+
+			memcpy(out, &v, sizeof(v));
+			out += 8;
+			p += 8;
+		}
+
+		while (p < end && !IsSpecial(*p))
+			*out++ = *p++;
+
+		col += p - runStart;
+		if (p == end)
+			break;
+
+		char c = *p++;
 
 		if (c == ' ' || c == '\t' || c == '\n')
 		{
-			if (wordP - word != 0)
+			len = out - str.data();
+			if (len != wordStart)
 			{
 				Flush();
+				Reserve((end - p + 1) * tabSize);
+				out = &str[len];
 			}
 
 			if (c == '\n')
 			{
 				col = 0;
-				*spaceP++ = c;
+				*out++ = c;
 			}
 			else if (c == '\t')
 			{
 				int n = tabSize - (col % tabSize);
 				col += n;
 				for (int j = 0; j < n; j++)
-					*spaceP++ = ' ';
+					*out++ = ' ';
 			}
 			else
 			{
 				col++;
-				*spaceP++ = c;
+				*out++ = c;
 			}
+			wordStart = out - str.data();
 
 			currentIndent = nestIndent[nest];
 		}
@@ -68,7 +160,7 @@ int OutputFormatter::Write(const char* buf, int count)
 				nestIndent[nest] = col;
 				wordNests++;
 			}
-			else if (c == ')')
+			else
 			{
 				if (nest > 0)
 					nest--;
@@ -76,10 +168,11 @@ int OutputFormatter::Write(const char* buf, int count)
 					wordNests--;
 			}
 
-			*wordP++ = c;
+			*out++ = c;
 		}
 	}
 
+	len = out - str.data();
 	return count;
 }
 
@@ -88,7 +181,7 @@ int OutputFormatter::Write(const std::string& buf)
 	return Write(buf.data(), buf.size());
 }
 
-OutputFormatter* OutputFormatter::Instance;
+thread_local OutputFormatter* OutputFormatter::Instance;
 
 int OutputFormatter::WriteStatic(const char* buf, int count)
 {
@@ -103,13 +196,93 @@ int (*OutputFormatter::StaticWriter())(const char* buf, int count)
 
 OutputFormatter::OutputFormatter(uint32_t tabSize, uint32_t indentation, uint32_t lineLimit)
 	: tabSize{tabSize}, lineLimit{lineLimit}, col{0}, nest{0}, nestIndent{indentation},
-	  currentIndent{indentation}, wordNests(0), wordP{word}, spaceP{space}
+	  currentIndent{indentation}, wordNests(0)
+{
+}
+
+OutputFormatter::OutputFormatter(const fs::path& outPath, uint32_t tabSize, uint32_t indentation,
+                                 uint32_t lineLimit)
+	: OutputFormatter(tabSize, indentation, lineLimit)
+{
+	filePath = outPath;
+	tempPath = outPath;
+	tempPath += ".tmp";
+
+	// Text mode, like `File::WriteAllText`
+	file = fopen(tempPath.string().c_str(), "w");
+	if (file == nullptr)
+		return;
+
+	// Buffered here already
+	setvbuf(file, nullptr, _IONBF, 0);
+	str.resize(2 * FileBufferSize);
+
+	oldFile = fopen(outPath.string().c_str(), "r");
+	if (oldFile != nullptr)
+		setvbuf(oldFile, nullptr, _IONBF, 0);
+	else
+		fileChanged = true;
+}
+
+OutputFormatter::~OutputFormatter()
 {
+	if (oldFile != nullptr)
+		fclose(oldFile);
+
+	if (file != nullptr)
+	{
+		std::error_code ec;
+		fclose(file);
+		fs::remove(tempPath, ec);
+	}
 }
 
 std::string OutputFormatter::GetOutput()
 {
+	assert(filePath.empty());
+
 	Flush();
+	str.resize(len);
+	len = 0;
+	spaceStart = 0;
+	wordStart = 0;
 
 	return std::move(str);
 }
+
+bool OutputFormatter::Close()
+{
+	if (file == nullptr)
+		return false;
+
+	Flush();
+	FlushFile();
+
+	if (fclose(file) != 0)
+		fileError = true;
+	file = nullptr;
+
+	if (oldFile != nullptr)
+	{
+		// The old file may be longer
+		if (!fileChanged && fgetc(oldFile) != EOF)
+			fileChanged = true;
+
+		fclose(oldFile);
+		oldFile = nullptr;
+	}
+
+	std::error_code ec;
+
+	if (!fileError && fileChanged)
+	{
+		fs::rename(tempPath, filePath, ec);
+		if (ec)
+			fileError = true;
+	}
+
+	if (fileError || !fileChanged)
+		fs::remove(tempPath, ec);
+
+	return !fileError;
+}
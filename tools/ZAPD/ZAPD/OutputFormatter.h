@@ -1,10 +1,18 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
+#include <cstdio>
 #include <string>
-#include <vector>
 
+#include "Utils/Directory.h"
+
+/**
+ * Wraps C code at `lineLimit` columns, indenting the continuation lines to the innermost open
+ * parenthesis. The code can be written in pieces of any size.
+ *
+ * The formatted code is either kept in memory until `GetOutput`, or streamed to a file through a
+ * fixed-size buffer until `Close`.
+ */
 class OutputFormatter
 {
 private:
@@ -17,25 +25,71 @@ private:
 	uint32_t currentIndent;
 	uint32_t wordNests;
 
-	char word[128];
-	char space[128];
-	char* wordP;
-	char* spaceP;
-
+	// The formatted code, or the part of it not written to `file` yet, in the first `len` bytes
+	// of `str`. It ends with the whitespace at `spaceStart` and the word at `wordStart` being
+	// formatted, which are only final once the word ends and whether it fits in the line is known.
 	std::string str;
+	size_t len = 0;
+	size_t spaceStart = 0;
+	size_t wordStart = 0;
 
+	// The code is streamed to `tempPath`, which only replaces `filePath` once complete, and only
+	// if it's not what `filePath` already contained. Until they differ, the old contents are read
+	// from `oldFile` and compared to the new ones chunk by chunk.
+	fs::path filePath;
+	fs::path tempPath;
+	FILE* file = nullptr;
+	FILE* oldFile = nullptr;
+	std::string oldChunk;
+	bool fileError = false;
+	bool fileChanged = false;
+
+	void Reserve(size_t size);
 	void Flush();
+	void FlushFile();
 
-	static OutputFormatter* Instance;
+	// Per thread, since libgfxd output callbacks can't carry any user data
+	static thread_local OutputFormatter* Instance;
 	static int WriteStatic(const char* buf, int count);
 
 public:
 	OutputFormatter(uint32_t tabSize = 4, uint32_t indentation = 4, uint32_t lineLimit = 120);
 
+	/**
+	 * Streams the formatted code to `outPath`. The file is only replaced once `Close` is called,
+	 * and only if its contents changed, so its modification time doesn't change otherwise. If the
+	 * formatter is destroyed before `Close` is called, the file is left as it was.
+	 */
+	explicit OutputFormatter(const fs::path& outPath, uint32_t tabSize = 4,
+	                         uint32_t indentation = 4, uint32_t lineLimit = 120);
+	~OutputFormatter();
+
+	OutputFormatter(const OutputFormatter&) = delete;
+	OutputFormatter& operator=(const OutputFormatter&) = delete;
+
 	int (*StaticWriter())(const char* buf, int count);  // Must be `int` due to libgfxd
 
 	int Write(const char* buf, int count);
 	int Write(const std::string& buf);
 
+	/**
+	 * Returns the formatted code, when it isn't streamed to a file.
+	 */
 	std::string GetOutput();
+
+	/**
+	 * Whether the file given to the constructor could be opened.
+	 */
+	bool IsOpen() const { return file != nullptr; }
+
+	/**
+	 * Writes the rest of the formatted code to the file and closes it. Returns false if the file
+	 * couldn't be opened or a write failed.
+	 */
+	bool Close();
+
+	/**
+	 * Whether `Close` replaced the file, which it doesn't if it already had the formatted code.
+	 */
+	bool HasChanged() const { return fileChanged; }
 };
@@ -0,0 +1,182 @@
+#include "SegmentedAddressResolver.h"
+
+#include <algorithm>
+
+#include "ZFile.h"
+#include "ZSymbol.h"
+
+// Every segment covers 16 MiB of the address space
+#define SEGMENT_SIZE 0x01000000
+
+// Checks of a single file, in the order they are done
+#define ORDER_SYMBOL_OFFSET 0
+#define ORDER_SYMBOL_ADDRESS 1
+#define ORDER_DECLARATION 2
+
+bool SegmentedAddressResolver::Target::MatchesType(const std::string& expectedType) const
+{
+	return expectedType == "" || expectedType == name;
+}
+
+SegmentedAddressResolver::TargetList::TargetList(const Target* const* nFirst,
+                                                 const Target* const* nLast)
+	: first(nFirst), last(nLast)
+{
+}
+
+void SegmentedAddressResolver::Build(const std::map<int32_t, std::vector<ZFile*>>& segmentRefFiles,
+                                     const ConfigTable<uint32_t>& symbolMap)
+{
+	Clear();
+
+	std::vector<Item> items;
+
+	for (const auto& segmentFiles : segmentRefFiles)
+	{
+		uint32_t segment = segmentFiles.first;
+		uint64_t segmentStart = static_cast<uint64_t>(segment) << 24;
+		const std::vector<ZFile*>& files = segmentFiles.second;
+
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			ZFile* file = files[i];
+			uint64_t fileOrder = static_cast<uint64_t>(i) << 2;
+
+			// Offsets of files loaded to virtual addresses are relative to their BaseAddress
+			// (see `Seg2Filespace`)
+			uint64_t addressBias = 0;
+			if (segment == 0x80)
+				addressBias = GETSEGOFFSET(file->baseAddress);
+
+			for (const auto& symbolRes : file->GetSymbolResources())
+			{
+				uint32_t symbolOffset = symbolRes.first;
+				ZSymbol* symbol = symbolRes.second;
+
+				// The symbol may be found by its offset in the file...
+				if (addressBias + symbolOffset < SEGMENT_SIZE)
+				{
+					uint64_t address = segmentStart + addressBias + symbolOffset;
+					AddTarget(items, address, address + 1,
+					          {TargetKind::Symbol, file, symbol, symbol->GetSourceTypeName(),
+					           fileOrder | ORDER_SYMBOL_OFFSET});
+				}
+				// ...or by its segmented address, if it was declared with one
+				if (GETSEGNUM(symbolOffset) == segment)
+				{
+					AddTarget(items, symbolOffset, static_cast<uint64_t>(symbolOffset) + 1,
+					          {TargetKind::Symbol, file, symbol, symbol->GetSourceTypeName(),
+					           fileOrder | ORDER_SYMBOL_ADDRESS});
+				}
+			}
+
+			// Same range `ZFile::IsSegmentedInFilespaceRange` accepts
+			uint64_t rangeStart = addressBias + file->rangeStart;
+			uint64_t rangeEnd = addressBias + std::min<uint64_t>(file->rangeEnd,
+			                                                     file->GetRawData().size());
+			rangeEnd = std::min<uint64_t>(rangeEnd, SEGMENT_SIZE);
+			if (rangeStart < rangeEnd)
+			{
+				AddTarget(items, segmentStart + rangeStart, segmentStart + rangeEnd,
+				          {TargetKind::Declaration, file, nullptr, "",
+				           fileOrder | ORDER_DECLARATION});
+			}
+		}
+	}
+
+	// The symbol map is only checked after every file has been searched
+	uint64_t symbolMapOrder = UINT64_MAX;
+	for (size_t i = 0; i < symbolMap.size(); i++)
+	{
+		uint32_t address = symbolMap.GetKey(i);
+		AddTarget(items, address, static_cast<uint64_t>(address) + 1,
+		          {TargetKind::SymbolMap, nullptr, nullptr, symbolMap.GetValue(i), symbolMapOrder});
+	}
+
+	// Split the address space at the start and end of every item, so each interval is covered
+	// by the same set of items
+	std::vector<uint64_t> boundaries;
+	boundaries.reserve(items.size() * 2);
+	for (const Item& item : items)
+	{
+		boundaries.push_back(item.start);
+		boundaries.push_back(item.end);
+	}
+	std::sort(boundaries.begin(), boundaries.end());
+	boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+	std::sort(items.begin(), items.end(),
+	          [](const Item& a, const Item& b) { return a.start < b.start; });
+
+	std::vector<const Target*> active;
+	std::vector<uint64_t> activeEnds;
+	size_t nextItem = 0;
+
+	for (size_t i = 0; i + 1 < boundaries.size(); i++)
+	{
+		uint64_t start = boundaries[i];
+
+		for (size_t j = 0; j < active.size();)
+		{
+			if (activeEnds[j] <= start)
+			{
+				active.erase(active.begin() + j);
+				activeEnds.erase(activeEnds.begin() + j);
+			}
+			else
+				j++;
+		}
+
+		while (nextItem < items.size() && items[nextItem].start == start)
+		{
+			active.push_back(&targets[items[nextItem].target]);
+			activeEnds.push_back(items[nextItem].end);
+			nextItem++;
+		}
+
+		if (active.empty())
+			continue;
+
+		Interval interval = {start, boundaries[i + 1], intervalTargets.size(), active.size()};
+		intervalTargets.insert(intervalTargets.end(), active.begin(), active.end());
+		std::stable_sort(intervalTargets.begin() + interval.firstTarget, intervalTargets.end(),
+		                 [](const Target* a, const Target* b) { return a->order < b->order; });
+		intervals.push_back(interval);
+	}
+
+	built = true;
+}
+
+void SegmentedAddressResolver::Clear()
+{
+	built = false;
+	targets.clear();
+	intervals.clear();
+	intervalTargets.clear();
+}
+
+bool SegmentedAddressResolver::IsBuilt() const
+{
+	return built;
+}
+
+SegmentedAddressResolver::TargetList SegmentedAddressResolver::Find(segptr_t segAddress) const
+{
+	auto it = std::upper_bound(
+		intervals.begin(), intervals.end(), segAddress,
+		[](segptr_t address, const Interval& interval) { return address < interval.start; });
+
+	if (it == intervals.begin() || segAddress >= (it - 1)->end)
+		return TargetList(nullptr, nullptr);
+
+	const Interval& interval = *(it - 1);
+	const Target* const* first = intervalTargets.data() + interval.firstTarget;
+	return TargetList(first, first + interval.numTargets);
+}
+
+void SegmentedAddressResolver::AddTarget(std::vector<Item>& items, uint64_t start, uint64_t end,
+                                         Target target)
+{
+	items.push_back({start, end, targets.size()});
+	targets.push_back(std::move(target));
+}
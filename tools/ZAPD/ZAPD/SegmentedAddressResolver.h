@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Declaration.h"
+#include "GameConfig.h"
+
+class ZFile;
+class ZSymbol;
+
+/**
+ * Knows every file, symbol and symbol map entry a segmented address can refer to, in the order
+ * `ExtractionContext::GetSegmentedPtrName` has to try them.
+ *
+ * Each segment is split in disjoint address intervals, and each interval keeps the list of
+ * targets covering it. Since the segment number is the top byte of the address, the intervals of
+ * every segment are stored in a single sorted table, so resolving an address is a single binary
+ * search.
+ *
+ * The table only depends on the files loaded to each segment, their symbols and the symbol map,
+ * so it is built once and only needs to be rebuilt if one of those changes. Declarations are added
+ * all the time during extraction, so they are still looked up in the target file itself.
+ */
+class SegmentedAddressResolver
+{
+public:
+	enum class TargetKind
+	{
+		// A symbol of `file`
+		Symbol,
+		// The address is in the range of `file`, and it may have a declaration there
+		Declaration,
+		// An entry of the symbol map
+		SymbolMap,
+	};
+
+	struct Target
+	{
+		TargetKind kind;
+		ZFile* file;
+		ZSymbol* symbol;
+		// The type of `symbol` or the name of the symbol map entry
+		std::string name;
+		// Position in which `GetSegmentedPtrName` would have tried this target
+		uint64_t order;
+
+		bool MatchesType(const std::string& expectedType) const;
+	};
+
+	class TargetList
+	{
+	public:
+		TargetList(const Target* const* nFirst, const Target* const* nLast);
+
+		const Target* const* begin() const { return first; }
+		const Target* const* end() const { return last; }
+
+	private:
+		const Target* const* first;
+		const Target* const* last;
+	};
+
+	/**
+	 * Rebuilds the table from the files loaded to each segment (in the order they were added) and
+	 * the symbol map.
+	 */
+	void Build(const std::map<int32_t, std::vector<ZFile*>>& segmentRefFiles,
+	           const ConfigTable<uint32_t>& symbolMap);
+	void Clear();
+	bool IsBuilt() const;
+
+	/**
+	 * Returns the targets covering `segAddress`, sorted in the order they should be tried.
+	 */
+	TargetList Find(segptr_t segAddress) const;
+
+private:
+	struct Interval
+	{
+		uint64_t start;
+		uint64_t end;
+		size_t firstTarget;
+		size_t numTargets;
+	};
+
+	struct Item
+	{
+		uint64_t start;
+		uint64_t end;
+		size_t target;
+	};
+
+	bool built = false;
+	std::vector<Target> targets;
+	std::vector<Interval> intervals;
+	// The targets of every interval, one interval after the other
+	std::vector<const Target*> intervalTargets;
+
+	void AddTarget(std::vector<Item>& items, uint64_t start, uint64_t end, Target target);
+};
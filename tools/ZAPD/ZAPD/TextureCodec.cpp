@@ -0,0 +1,863 @@
+#include "TextureCodec.h"
+
+#include <cassert>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_CODEC_SSE2
+#include <emmintrin.h>
+
+// The AVX2 kernels are built for that target on their own, and only run if the CPU has it
+#if defined(__GNUC__) || defined(__clang__)
+#define TEXTURE_CODEC_AVX2
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#endif
+
+namespace
+{
+/**
+ * Converts the first texels of a row, and returns how many it converted. The scalar kernels
+ * convert all of them, the SIMD ones stop before the last incomplete block.
+ */
+using RowKernel = size_t (*)(const uint8_t* src, uint8_t* dst, size_t count);
+
+struct RowKernels
+{
+	size_t srcBits;  // per texel/pixel
+	size_t dstBits;
+	RowKernel scalar;
+	RowKernel sse2 = nullptr;
+	RowKernel avx2 = nullptr;
+};
+
+TextureCodec::InstructionSet DetectInstructionSet()
+{
+#ifdef TEXTURE_CODEC_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		return TextureCodec::InstructionSet::AVX2;
+#endif
+#ifdef TEXTURE_CODEC_SSE2
+	return TextureCodec::InstructionSet::SSE2;
+#else
+	return TextureCodec::InstructionSet::Scalar;
+#endif
+}
+
+const TextureCodec::InstructionSet sSupportedInstructionSet = DetectInstructionSet();
+TextureCodec::InstructionSet sInstructionSet = sSupportedInstructionSet;
+
+void RunKernels(const RowKernels& kernels, const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t done = 0;
+
+	assert(count * kernels.srcBits % 8 == 0 && count * kernels.dstBits % 8 == 0);
+
+	if (kernels.avx2 != nullptr && sInstructionSet >= TextureCodec::InstructionSet::AVX2)
+		done = kernels.avx2(src, dst, count);
+	else if (kernels.sse2 != nullptr && sInstructionSet >= TextureCodec::InstructionSet::SSE2)
+		done = kernels.sse2(src, dst, count);
+
+	kernels.scalar(src + done * kernels.srcBits / 8, dst + done * kernels.dstBits / 8,
+	               count - done);
+}
+
+/* Scalar decoders */
+
+size_t CopyRGBA32(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	memcpy(dst, src, count * 4);
+	return count;
+}
+
+size_t CopyIndex8(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	memcpy(dst, src, count);
+	return count;
+}
+
+size_t DecodeRGBA16(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, src += 2, dst += 4)
+	{
+		uint16_t data = (src[0] << 8) | src[1];
+		uint8_t r = (data & 0xF800) >> 11;
+		uint8_t g = (data & 0x07C0) >> 6;
+		uint8_t b = (data & 0x003E) >> 1;
+
+		dst[0] = (r << 3) | (r >> 2);
+		dst[1] = (g << 3) | (g >> 2);
+		dst[2] = (b << 3) | (b >> 2);
+		dst[3] = (data & 0x01) * 255;
+	}
+	return count;
+}
+
+// Unlike the other formats, the low bits of the 4-bit intensities are left at 0
+size_t DecodeI4(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, dst += 3)
+		memset(dst, (i % 2 == 0) ? (src[i / 2] & 0xF0) : (src[i / 2] << 4), 3);
+	return count;
+}
+
+size_t DecodeI8(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, dst += 3)
+		memset(dst, src[i], 3);
+	return count;
+}
+
+size_t DecodeIA4(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, dst += 4)
+	{
+		uint8_t data = (i % 2 == 0) ? (src[i / 2] >> 4) : (src[i / 2] & 0x0F);
+		uint8_t intensity = data & 0b1110;
+
+		intensity = (intensity << 4) | (intensity << 1) | (intensity >> 2);
+		memset(dst, intensity, 3);
+		dst[3] = (data & 0x01) ? 255 : 0;
+	}
+	return count;
+}
+
+size_t DecodeIA8(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, dst += 4)
+	{
+		uint8_t intensity = src[i] >> 4;
+		uint8_t alpha = src[i] & 0x0F;
+
+		memset(dst, (intensity << 4) | intensity, 3);
+		dst[3] = (alpha << 4) | alpha;
+	}
+	return count;
+}
+
+size_t DecodeIA16(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, src += 2, dst += 4)
+	{
+		memset(dst, src[0], 3);
+		dst[3] = src[1];
+	}
+	return count;
+}
+
+size_t DecodeCI4(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		dst[i] = (i % 2 == 0) ? (src[i / 2] >> 4) : (src[i / 2] & 0x0F);
+	return count;
+}
+
+/* Scalar encoders, reading RGB or RGBA pixels (`bytesPerPixel` 3 or 4) */
+
+template <size_t bytesPerPixel>
+uint8_t GetAlpha(const uint8_t* pixel)
+{
+	return bytesPerPixel == 4 ? pixel[3] : 0;
+}
+
+template <size_t bytesPerPixel>
+size_t EncodeRGBA16(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, src += bytesPerPixel, dst += 2)
+	{
+		uint8_t alphaBit = GetAlpha<bytesPerPixel>(src) != 0;
+		uint16_t data = ((src[0] >> 3) << 11) | ((src[1] >> 3) << 6) | ((src[2] >> 3) << 1) |
+		                alphaBit;
+
+		dst[0] = data >> 8;
+		dst[1] = data & 0xFF;
+	}
+	return count;
+}
+
+template <size_t bytesPerPixel>
+size_t EncodeRGBA32(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, src += bytesPerPixel, dst += 4)
+	{
+		memcpy(dst, src, 3);
+		dst[3] = GetAlpha<bytesPerPixel>(src);
+	}
+	return count;
+}
+
+template <size_t bytesPerPixel>
+size_t EncodeI4(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i + 1 < count; i += 2, src += 2 * bytesPerPixel)
+		dst[i / 2] = (src[0] & 0xF0) | (src[bytesPerPixel] >> 4);
+	return count;
+}
+
+template <size_t bytesPerPixel>
+size_t EncodeI8(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, src += bytesPerPixel)
+		dst[i] = src[0];
+	return count;
+}
+
+template <size_t bytesPerPixel>
+uint8_t EncodeIA4Texel(const uint8_t* pixel)
+{
+	return ((pixel[0] >> 5) << 1) | (GetAlpha<bytesPerPixel>(pixel) != 0);
+}
+
+template <size_t bytesPerPixel>
+size_t EncodeIA4(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i + 1 < count; i += 2, src += 2 * bytesPerPixel)
+	{
+		dst[i / 2] = (EncodeIA4Texel<bytesPerPixel>(src) << 4) |
+		             EncodeIA4Texel<bytesPerPixel>(src + bytesPerPixel);
+	}
+	return count;
+}
+
+template <size_t bytesPerPixel>
+size_t EncodeIA8(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, src += bytesPerPixel)
+		dst[i] = (src[0] & 0xF0) | (GetAlpha<bytesPerPixel>(src) >> 4);
+	return count;
+}
+
+template <size_t bytesPerPixel>
+size_t EncodeIA16(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++, src += bytesPerPixel, dst += 2)
+	{
+		dst[0] = src[0];
+		dst[1] = GetAlpha<bytesPerPixel>(src);
+	}
+	return count;
+}
+
+size_t EncodeCI4(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i + 1 < count; i += 2)
+		dst[i / 2] = (src[i] << 4) | src[i + 1];
+	return count;
+}
+
+#ifdef TEXTURE_CODEC_SSE2
+/* SSE2 kernels */
+
+__m128i Load128(const uint8_t* src)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+void Store128(uint8_t* dst, __m128i value)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value);
+}
+
+// Splits 16 bytes into their 32 nibbles, high nibble first
+void SplitNibbles_SSE2(__m128i bytes, __m128i& first, __m128i& second)
+{
+	const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+	__m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibbles);
+	__m128i low = _mm_and_si128(bytes, lowNibbles);
+
+	first = _mm_unpacklo_epi8(high, low);
+	second = _mm_unpackhi_epi8(high, low);
+}
+
+// Writes 16 pixels as RGBA, from their intensity and alpha
+void StoreIntensityAlpha_SSE2(uint8_t* dst, __m128i intensity, __m128i alpha)
+{
+	__m128i iiLow = _mm_unpacklo_epi8(intensity, intensity);
+	__m128i iiHigh = _mm_unpackhi_epi8(intensity, intensity);
+	__m128i iaLow = _mm_unpacklo_epi8(intensity, alpha);
+	__m128i iaHigh = _mm_unpackhi_epi8(intensity, alpha);
+
+	Store128(dst + 0, _mm_unpacklo_epi16(iiLow, iaLow));
+	Store128(dst + 16, _mm_unpackhi_epi16(iiLow, iaLow));
+	Store128(dst + 32, _mm_unpacklo_epi16(iiHigh, iaHigh));
+	Store128(dst + 48, _mm_unpackhi_epi16(iiHigh, iaHigh));
+}
+
+// Packs 8 32-bit lanes holding 16-bit values, without the signed saturation of `packs`
+__m128i Pack32To16_SSE2(__m128i first, __m128i second)
+{
+	first = _mm_srai_epi32(_mm_slli_epi32(first, 16), 16);
+	second = _mm_srai_epi32(_mm_slli_epi32(second, 16), 16);
+	return _mm_packs_epi32(first, second);
+}
+
+// Packs 16 32-bit lanes holding 8-bit values
+__m128i Pack32To8_SSE2(__m128i v0, __m128i v1, __m128i v2, __m128i v3)
+{
+	return _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+}
+
+// Swaps the bytes of each 16-bit lane
+__m128i ByteSwap16_SSE2(__m128i value)
+{
+	return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+}
+
+// Puts each pair of bytes in a byte, as the high and low nibbles. The high nibble is the low 4
+// bits of the first byte, the low nibble is the whole second byte
+__m128i JoinNibbles_SSE2(__m128i pairs)
+{
+	__m128i joined = _mm_or_si128(_mm_slli_epi16(pairs, 4), _mm_srli_epi16(pairs, 8));
+	return _mm_and_si128(joined, _mm_set1_epi16(0x00FF));
+}
+
+size_t DecodeRGBA16_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i mask5 = _mm_set1_epi16(0x1F);
+	const __m128i one = _mm_set1_epi16(1);
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i data = ByteSwap16_SSE2(Load128(src + i * 2));
+		__m128i r = _mm_srli_epi16(data, 11);
+		__m128i g = _mm_and_si128(_mm_srli_epi16(data, 6), mask5);
+		__m128i b = _mm_and_si128(_mm_srli_epi16(data, 1), mask5);
+		__m128i a = _mm_sub_epi16(_mm_setzero_si128(), _mm_and_si128(data, one));
+
+		r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+		g = _mm_or_si128(_mm_slli_epi16(g, 3), _mm_srli_epi16(g, 2));
+		b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+
+		__m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+		__m128i ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));
+
+		Store128(dst + i * 4, _mm_unpacklo_epi16(rg, ba));
+		Store128(dst + i * 4 + 16, _mm_unpackhi_epi16(rg, ba));
+	}
+	return i;
+}
+
+size_t DecodeIA4_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i intensityBits = _mm_set1_epi8(0b1110);
+	const __m128i alphaBit = _mm_set1_epi8(1);
+	const __m128i twoBits = _mm_set1_epi8(0b11);
+	size_t i = 0;
+
+	for (; i + 32 <= count; i += 32)
+	{
+		__m128i texels[2];
+		SplitNibbles_SSE2(Load128(src + i / 2), texels[0], texels[1]);
+
+		for (size_t half = 0; half < 2; half++)
+		{
+			__m128i intensity = _mm_and_si128(texels[half], intensityBits);
+			__m128i alpha = _mm_cmpeq_epi8(_mm_and_si128(texels[half], alphaBit), alphaBit);
+
+			intensity = _mm_or_si128(
+				_mm_or_si128(_mm_slli_epi16(intensity, 4), _mm_slli_epi16(intensity, 1)),
+				_mm_and_si128(_mm_srli_epi16(intensity, 2), twoBits));
+			StoreIntensityAlpha_SSE2(dst + (i + half * 16) * 4, intensity, alpha);
+		}
+	}
+	return i;
+}
+
+size_t DecodeIA8_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i data = Load128(src + i);
+		__m128i intensity = _mm_and_si128(_mm_srli_epi16(data, 4), lowNibbles);
+		__m128i alpha = _mm_and_si128(data, lowNibbles);
+
+		intensity = _mm_or_si128(intensity, _mm_slli_epi16(intensity, 4));
+		alpha = _mm_or_si128(alpha, _mm_slli_epi16(alpha, 4));
+		StoreIntensityAlpha_SSE2(dst + i * 4, intensity, alpha);
+	}
+	return i;
+}
+
+size_t DecodeIA16_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i data = Load128(src + i * 2);
+		__m128i intensity = _mm_and_si128(data, lowBytes);
+
+		intensity = _mm_or_si128(intensity, _mm_slli_epi16(intensity, 8));
+		Store128(dst + i * 4, _mm_unpacklo_epi16(intensity, data));
+		Store128(dst + i * 4 + 16, _mm_unpackhi_epi16(intensity, data));
+	}
+	return i;
+}
+
+size_t DecodeCI4_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 32 <= count; i += 32)
+	{
+		__m128i first, second;
+		SplitNibbles_SSE2(Load128(src + i / 2), first, second);
+
+		Store128(dst + i, first);
+		Store128(dst + i + 16, second);
+	}
+	return i;
+}
+
+// 4 RGBA pixels to their RGBA16 value, in the low half of each 32-bit lane
+__m128i EncodeRGBA16Texels_SSE2(__m128i pixels)
+{
+	const __m128i mask5 = _mm_set1_epi32(0x1F);
+	__m128i r = _mm_and_si128(_mm_srli_epi32(pixels, 3), mask5);
+	__m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 11), mask5);
+	__m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 19), mask5);
+	__m128i transparent = _mm_cmpeq_epi32(_mm_srli_epi32(pixels, 24), _mm_setzero_si128());
+	__m128i a = _mm_andnot_si128(transparent, _mm_set1_epi32(1));
+
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 11), _mm_slli_epi32(g, 6)),
+	                    _mm_or_si128(_mm_slli_epi32(b, 1), a));
+}
+
+size_t EncodeRGBA16_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i first = EncodeRGBA16Texels_SSE2(Load128(src + i * 4));
+		__m128i second = EncodeRGBA16Texels_SSE2(Load128(src + i * 4 + 16));
+
+		Store128(dst + i * 2, ByteSwap16_SSE2(Pack32To16_SSE2(first, second)));
+	}
+	return i;
+}
+
+// Intensity of 16 RGBA pixels (their red channel), one per byte
+__m128i LoadIntensity_SSE2(const uint8_t* src)
+{
+	const __m128i lowBytes = _mm_set1_epi32(0xFF);
+
+	return Pack32To8_SSE2(
+		_mm_and_si128(Load128(src + 0), lowBytes), _mm_and_si128(Load128(src + 16), lowBytes),
+		_mm_and_si128(Load128(src + 32), lowBytes), _mm_and_si128(Load128(src + 48), lowBytes));
+}
+
+size_t EncodeI4_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+	{
+		// Pairs of pixels, the first in the low byte
+		__m128i pairs = LoadIntensity_SSE2(src + i * 4);
+		__m128i high = _mm_and_si128(pairs, _mm_set1_epi16(0xF0));
+		__m128i low = _mm_srli_epi16(pairs, 12);
+
+		__m128i texels = _mm_or_si128(high, low);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i / 2),
+		                 _mm_packus_epi16(texels, texels));
+	}
+	return i;
+}
+
+size_t EncodeI8_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+		Store128(dst + i, LoadIntensity_SSE2(src + i * 4));
+	return i;
+}
+
+size_t EncodeIA4_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i intensityBits = _mm_set1_epi32(0b1110);
+	const __m128i one = _mm_set1_epi32(1);
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i nibbles[4];
+
+		for (size_t j = 0; j < 4; j++)
+		{
+			__m128i pixels = Load128(src + (i + j * 4) * 4);
+			__m128i intensity = _mm_and_si128(_mm_srli_epi32(pixels, 4), intensityBits);
+			__m128i transparent =
+				_mm_cmpeq_epi32(_mm_srli_epi32(pixels, 24), _mm_setzero_si128());
+
+			nibbles[j] = _mm_or_si128(intensity, _mm_andnot_si128(transparent, one));
+		}
+
+		__m128i texels = JoinNibbles_SSE2(
+			Pack32To8_SSE2(nibbles[0], nibbles[1], nibbles[2], nibbles[3]));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i / 2),
+		                 _mm_packus_epi16(texels, texels));
+	}
+	return i;
+}
+
+size_t EncodeIA8_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i highNibble = _mm_set1_epi32(0xF0);
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i texels[4];
+
+		for (size_t j = 0; j < 4; j++)
+		{
+			__m128i pixels = Load128(src + (i + j * 4) * 4);
+			texels[j] = _mm_or_si128(_mm_and_si128(pixels, highNibble),
+			                         _mm_srli_epi32(pixels, 28));
+		}
+
+		Store128(dst + i, Pack32To8_SSE2(texels[0], texels[1], texels[2], texels[3]));
+	}
+	return i;
+}
+
+size_t EncodeIA16_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i lowBytes = _mm_set1_epi32(0xFF);
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i texels[2];
+
+		for (size_t j = 0; j < 2; j++)
+		{
+			__m128i pixels = Load128(src + (i + j * 4) * 4);
+			texels[j] = _mm_or_si128(_mm_and_si128(pixels, lowBytes),
+			                         _mm_slli_epi32(_mm_srli_epi32(pixels, 24), 8));
+		}
+
+		Store128(dst + i * 2, Pack32To16_SSE2(texels[0], texels[1]));
+	}
+	return i;
+}
+
+size_t EncodeCI4_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 32 <= count; i += 32)
+	{
+		__m128i first = JoinNibbles_SSE2(Load128(src + i));
+		__m128i second = JoinNibbles_SSE2(Load128(src + i + 16));
+
+		Store128(dst + i / 2, _mm_packus_epi16(first, second));
+	}
+	return i;
+}
+#endif
+
+#ifdef TEXTURE_CODEC_AVX2
+/* AVX2 kernels, for the most common format and those SSE2 has no shuffle for */
+
+TARGET_AVX2 __m256i Load256(const uint8_t* src)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+}
+
+TARGET_AVX2 void Store256(uint8_t* dst, __m256i value)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), value);
+}
+
+TARGET_AVX2 __m256i Expand5To8_AVX2(__m256i value)
+{
+	return _mm256_or_si256(_mm256_slli_epi16(value, 3), _mm256_srli_epi16(value, 2));
+}
+
+TARGET_AVX2 size_t DecodeRGBA16_AVX2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m256i mask5 = _mm256_set1_epi16(0x1F);
+	const __m256i one = _mm256_set1_epi16(1);
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m256i data = Load256(src + i * 2);
+		data = _mm256_or_si256(_mm256_slli_epi16(data, 8), _mm256_srli_epi16(data, 8));
+
+		__m256i r = Expand5To8_AVX2(_mm256_srli_epi16(data, 11));
+		__m256i g = Expand5To8_AVX2(_mm256_and_si256(_mm256_srli_epi16(data, 6), mask5));
+		__m256i b = Expand5To8_AVX2(_mm256_and_si256(_mm256_srli_epi16(data, 1), mask5));
+		__m256i a = _mm256_sub_epi16(_mm256_setzero_si256(), _mm256_and_si256(data, one));
+
+		__m256i rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+		__m256i ba = _mm256_or_si256(b, _mm256_slli_epi16(a, 8));
+
+		// Texels 0-3 and 8-11, then 4-7 and 12-15
+		__m256i low = _mm256_unpacklo_epi16(rg, ba);
+		__m256i high = _mm256_unpackhi_epi16(rg, ba);
+
+		Store256(dst + i * 4, _mm256_permute2x128_si256(low, high, 0x20));
+		Store256(dst + i * 4 + 32, _mm256_permute2x128_si256(low, high, 0x31));
+	}
+	return i;
+}
+
+// Writes 16 pixels as RGB, from their intensity
+TARGET_AVX2 void StoreIntensityRGB_AVX2(uint8_t* dst, __m128i intensity)
+{
+	const __m128i shuffle0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+	const __m128i shuffle1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+	const __m128i shuffle2 =
+		_mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 0), _mm_shuffle_epi8(intensity, shuffle0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_shuffle_epi8(intensity, shuffle1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_shuffle_epi8(intensity, shuffle2));
+}
+
+TARGET_AVX2 size_t DecodeI4_AVX2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	const __m128i highNibbles = _mm_set1_epi8(static_cast<char>(0xF0));
+	size_t i = 0;
+
+	for (; i + 32 <= count; i += 32)
+	{
+		__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i / 2));
+		__m128i high = _mm_and_si128(data, highNibbles);
+		__m128i low = _mm_and_si128(_mm_slli_epi16(data, 4), highNibbles);
+
+		StoreIntensityRGB_AVX2(dst + i * 3, _mm_unpacklo_epi8(high, low));
+		StoreIntensityRGB_AVX2(dst + i * 3 + 48, _mm_unpackhi_epi8(high, low));
+	}
+	return i;
+}
+
+TARGET_AVX2 size_t DecodeI8_AVX2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		StoreIntensityRGB_AVX2(dst + i * 3, data);
+	}
+	return i;
+}
+
+TARGET_AVX2 __m256i EncodeRGBA16Texels_AVX2(__m256i pixels)
+{
+	const __m256i mask5 = _mm256_set1_epi32(0x1F);
+	__m256i r = _mm256_and_si256(_mm256_srli_epi32(pixels, 3), mask5);
+	__m256i g = _mm256_and_si256(_mm256_srli_epi32(pixels, 11), mask5);
+	__m256i b = _mm256_and_si256(_mm256_srli_epi32(pixels, 19), mask5);
+	__m256i transparent =
+		_mm256_cmpeq_epi32(_mm256_srli_epi32(pixels, 24), _mm256_setzero_si256());
+	__m256i a = _mm256_andnot_si256(transparent, _mm256_set1_epi32(1));
+	__m256i texels = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(r, 11),
+	                                                 _mm256_slli_epi32(g, 6)),
+	                                 _mm256_or_si256(_mm256_slli_epi32(b, 1), a));
+
+	// Sign extended, so `packs` doesn't saturate them
+	return _mm256_srai_epi32(_mm256_slli_epi32(texels, 16), 16);
+}
+
+TARGET_AVX2 size_t EncodeRGBA16_AVX2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m256i first = EncodeRGBA16Texels_AVX2(Load256(src + i * 4));
+		__m256i second = EncodeRGBA16Texels_AVX2(Load256(src + i * 4 + 32));
+
+		// `packs` interleaves the 128-bit lanes of its operands, put them back in order
+		__m256i texels = _mm256_permute4x64_epi64(_mm256_packs_epi32(first, second), 0xD8);
+		texels = _mm256_or_si256(_mm256_slli_epi16(texels, 8), _mm256_srli_epi16(texels, 8));
+		Store256(dst + i * 2, texels);
+	}
+	return i;
+}
+#endif
+
+#if defined(TEXTURE_CODEC_AVX2)
+#define KERNELS(scalar, sse2, avx2) scalar, sse2, avx2
+#elif defined(TEXTURE_CODEC_SSE2)
+#define KERNELS(scalar, sse2, avx2) scalar, sse2, nullptr
+#else
+#define KERNELS(scalar, sse2, avx2) scalar, nullptr, nullptr
+#endif
+
+RowKernels GetDecoder(TextureType format)
+{
+	switch (format)
+	{
+	case TextureType::RGBA16bpp:
+		return {16, 32, KERNELS(DecodeRGBA16, DecodeRGBA16_SSE2, DecodeRGBA16_AVX2)};
+	case TextureType::RGBA32bpp:
+		return {32, 32, KERNELS(CopyRGBA32, nullptr, nullptr)};
+	case TextureType::Grayscale4bpp:
+		return {4, 24, KERNELS(DecodeI4, nullptr, DecodeI4_AVX2)};
+	case TextureType::Grayscale8bpp:
+		return {8, 24, KERNELS(DecodeI8, nullptr, DecodeI8_AVX2)};
+	case TextureType::GrayscaleAlpha4bpp:
+		return {4, 32, KERNELS(DecodeIA4, DecodeIA4_SSE2, nullptr)};
+	case TextureType::GrayscaleAlpha8bpp:
+		return {8, 32, KERNELS(DecodeIA8, DecodeIA8_SSE2, nullptr)};
+	case TextureType::GrayscaleAlpha16bpp:
+		return {16, 32, KERNELS(DecodeIA16, DecodeIA16_SSE2, nullptr)};
+	case TextureType::Palette4bpp:
+		return {4, 8, KERNELS(DecodeCI4, DecodeCI4_SSE2, nullptr)};
+	case TextureType::Palette8bpp:
+		return {8, 8, KERNELS(CopyIndex8, nullptr, nullptr)};
+	case TextureType::Error:
+		break;
+	}
+
+	assert(!"Invalid texture format");
+	return {0, 0, nullptr};
+}
+
+template <size_t bytesPerPixel>
+RowKernels GetEncoder(TextureType format)
+{
+	// The SIMD kernels only read RGBA pixels
+	constexpr bool rgba = bytesPerPixel == 4;
+	constexpr size_t srcBits = bytesPerPixel * 8;
+
+	switch (format)
+	{
+	case TextureType::RGBA16bpp:
+		if constexpr (rgba)
+			return {srcBits, 16,
+			        KERNELS(EncodeRGBA16<4>, EncodeRGBA16_SSE2, EncodeRGBA16_AVX2)};
+		return {srcBits, 16, EncodeRGBA16<bytesPerPixel>};
+	case TextureType::RGBA32bpp:
+		if constexpr (rgba)
+			return {srcBits, 32, CopyRGBA32};
+		return {srcBits, 32, EncodeRGBA32<bytesPerPixel>};
+	case TextureType::Grayscale4bpp:
+		if constexpr (rgba)
+			return {srcBits, 4, KERNELS(EncodeI4<4>, EncodeI4_SSE2, nullptr)};
+		return {srcBits, 4, EncodeI4<bytesPerPixel>};
+	case TextureType::Grayscale8bpp:
+		if constexpr (rgba)
+			return {srcBits, 8, KERNELS(EncodeI8<4>, EncodeI8_SSE2, nullptr)};
+		return {srcBits, 8, EncodeI8<bytesPerPixel>};
+	case TextureType::GrayscaleAlpha4bpp:
+		if constexpr (rgba)
+			return {srcBits, 4, KERNELS(EncodeIA4<4>, EncodeIA4_SSE2, nullptr)};
+		return {srcBits, 4, EncodeIA4<bytesPerPixel>};
+	case TextureType::GrayscaleAlpha8bpp:
+		if constexpr (rgba)
+			return {srcBits, 8, KERNELS(EncodeIA8<4>, EncodeIA8_SSE2, nullptr)};
+		return {srcBits, 8, EncodeIA8<bytesPerPixel>};
+	case TextureType::GrayscaleAlpha16bpp:
+		if constexpr (rgba)
+			return {srcBits, 16, KERNELS(EncodeIA16<4>, EncodeIA16_SSE2, nullptr)};
+		return {srcBits, 16, EncodeIA16<bytesPerPixel>};
+	default:
+		break;
+	}
+
+	assert(!"Invalid texture format");
+	return {0, 0, nullptr};
+}
+
+RowKernels GetIndexEncoder(TextureType format)
+{
+	switch (format)
+	{
+	case TextureType::Palette4bpp:
+		return {8, 4, KERNELS(EncodeCI4, EncodeCI4_SSE2, nullptr)};
+	case TextureType::Palette8bpp:
+		return {8, 8, KERNELS(CopyIndex8, nullptr, nullptr)};
+	default:
+		break;
+	}
+
+	assert(!"Invalid texture format");
+	return {0, 0, nullptr};
+}
+}  // namespace
+
+PixelLayout TextureCodec::GetDecodedLayout(TextureType format)
+{
+	switch (format)
+	{
+	case TextureType::Grayscale4bpp:
+	case TextureType::Grayscale8bpp:
+		return PixelLayout::RGB;
+
+	case TextureType::Palette4bpp:
+	case TextureType::Palette8bpp:
+		return PixelLayout::Index;
+
+	default:
+		return PixelLayout::RGBA;
+	}
+}
+
+void TextureCodec::DecodeRow(TextureType format, const uint8_t* src, uint8_t* dst, size_t count)
+{
+	RunKernels(GetDecoder(format), src, dst, count);
+}
+
+void TextureCodec::EncodeRow(TextureType format, PixelLayout srcLayout, const uint8_t* src,
+                             uint8_t* dst, size_t count)
+{
+	switch (srcLayout)
+	{
+	case PixelLayout::RGB:
+		RunKernels(GetEncoder<3>(format), src, dst, count);
+		break;
+
+	case PixelLayout::RGBA:
+		RunKernels(GetEncoder<4>(format), src, dst, count);
+		break;
+
+	case PixelLayout::Index:
+		RunKernels(GetIndexEncoder(format), src, dst, count);
+		break;
+	}
+}
+
+TextureCodec::InstructionSet TextureCodec::GetInstructionSet()
+{
+	return sInstructionSet;
+}
+
+void TextureCodec::SetInstructionSet(InstructionSet set)
+{
+	if (IsSupported(set))
+		sInstructionSet = set;
+}
+
+bool TextureCodec::IsSupported(InstructionSet set)
+{
+	return set <= sSupportedInstructionSet;
+}
+
+const char* TextureCodec::GetInstructionSetName(InstructionSet set)
+{
+	switch (set)
+	{
+	case InstructionSet::Scalar:
+		return "scalar";
+	case InstructionSet::SSE2:
+		return "SSE2";
+	case InstructionSet::AVX2:
+		return "AVX2";
+	}
+
+	return "unknown";
+}
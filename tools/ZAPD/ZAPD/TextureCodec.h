@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ImageBackend.h"
+
+enum class TextureType
+{
+	Error,
+	RGBA32bpp,
+	RGBA16bpp,
+	Palette4bpp,
+	Palette8bpp,
+	Grayscale4bpp,
+	Grayscale8bpp,
+	GrayscaleAlpha4bpp,
+	GrayscaleAlpha8bpp,
+	GrayscaleAlpha16bpp,
+};
+
+/**
+ * Converts rows of texels between the N64 texture formats and the pixel layouts of `ImageBackend`.
+ *
+ * Rows are converted by SSE2 or AVX2 kernels when the CPU has them, and by plain loops otherwise
+ * and for the few texels left at the end of a row. Every kernel produces the same bytes.
+ */
+class TextureCodec
+{
+public:
+	enum class InstructionSet
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+	};
+
+	/**
+	 * Returns the layout `DecodeRow` writes the texels of `format` in: RGBA, RGB for the
+	 * grayscale formats without alpha, palette indices for the CI formats.
+	 */
+	static PixelLayout GetDecodedLayout(TextureType format);
+
+	/**
+	 * Decodes `count` texels of `format` from `src` to `dst`, in the layout `GetDecodedLayout`
+	 * returns. `count` must be even for the 4-bit formats.
+	 */
+	static void DecodeRow(TextureType format, const uint8_t* src, uint8_t* dst, size_t count);
+
+	/**
+	 * Encodes `count` pixels stored as `srcLayout` at `src` to texels of `format` at `dst`.
+	 * Pixels are taken as transparent if `srcLayout` is RGB. `srcLayout` must be Index for the CI
+	 * formats, and only for them. `count` must be even for the 4-bit formats.
+	 */
+	static void EncodeRow(TextureType format, PixelLayout srcLayout, const uint8_t* src,
+	                      uint8_t* dst, size_t count);
+
+	static InstructionSet GetInstructionSet();
+	/**
+	 * Restricts the kernels to those of `set`, to compare or benchmark them. Sets the CPU doesn't
+	 * support are ignored.
+	 */
+	static void SetInstructionSet(InstructionSet set);
+	static bool IsSupported(InstructionSet set);
+	static const char* GetInstructionSetName(InstructionSet set);
+};
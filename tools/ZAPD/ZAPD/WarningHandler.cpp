@@ -58,6 +58,7 @@
 #include "WarningHandler.h"
 
 #include <cassert>
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/StringHelper.h"
 
@@ -217,8 +218,12 @@ void WarningHandler::FunctionPreamble(const char* filename, int32_t line, const
  *  Print the information about the file(s) being processed (XML for extraction, png etc. for building)
  */
 void WarningHandler::ProcessedFilePreamble() {
-    if (Globals::Instance->inputPath != "") {
-        fprintf(stderr, "When processing file %s: ", Globals::Instance->inputPath.c_str());
+    // Several XMLs may be extracted at the same time, so prefer the one of the current job
+    const ExtractionContext* ctx = ExtractionContext::GetCurrent();
+    const fs::path& inputPath = (ctx != nullptr) ? ctx->inputPath : Globals::Instance->inputPath;
+
+    if (inputPath != "") {
+        fprintf(stderr, "When processing file %s: ", inputPath.c_str());
     }
 }
 
@@ -1,7 +1,9 @@
 #include "ZActorList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
+#include "Utils/Profiler.h"
 #include "WarningHandler.h"
 #include "ZFile.h"
 #include "ZRoom/ZNames.h"
@@ -22,6 +24,7 @@ void ZActorList::ExtractFromBinary(uint32_t nRawDataIndex, uint8_t nNumActors)
 	if (parent->GetMode() == ZFileMode::ExternalFile)
 		return;
 
+	ProfileScope scope("ParseRawData", GetResourceTypeName(GetResourceType()), name);
 	ParseRawData();
 }
 
@@ -49,12 +52,12 @@ void ZActorList::ParseRawData()
 
 	for (size_t i = 0; i < numActors; i++)
 	{
-		ActorSpawnEntry entry(parent->GetRawData(), currentPtr);
+		ActorSpawnEntry entry(parent->GetRawData(), currentPtr, parent->ctx->game);
 
 		currentPtr += entry.GetRawDataSize();
 		actors.push_back(entry);
 
-		size_t actorNameLength = ZNames::GetActorName(entry.GetActorId()).size();
+		size_t actorNameLength = ZNames::GetActorName(entry.GetActorId(), parent->ctx->game).size();
 		if (actorNameLength > largestlength)
 			largestlength = actorNameLength;
 	}
@@ -120,7 +123,7 @@ size_t ZActorList::GetActorListArraySize() const
 	// Doing an else-if here so we only do the loop when the game is SW97.
 	// Actor 0x22 is removed from SW97, so we need to ensure that we don't increment the actor count
 	// for it.
-	if (Globals::Instance->game == ZGame::OOT_SW97)
+	if (parent->ctx->game == ZGame::OOT_SW97)
 	{
 		actorCount = 0;
 
@@ -138,16 +141,18 @@ size_t ZActorList::GetActorListArraySize() const
 
 /* ActorSpawnEntry */
 
-ActorSpawnEntry::ActorSpawnEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+ActorSpawnEntry::ActorSpawnEntry(ByteSpan rawData, uint32_t rawDataIndex, ZGame nGame)
 {
-	actorNum = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
-	posX = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-	posY = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
-	posZ = BitConverter::ToInt16BE(rawData, rawDataIndex + 6);
-	rotX = BitConverter::ToUInt16BE(rawData, rawDataIndex + 8);
-	rotY = BitConverter::ToUInt16BE(rawData, rawDataIndex + 10);
-	rotZ = BitConverter::ToUInt16BE(rawData, rawDataIndex + 12);
-	params = BitConverter::ToInt16BE(rawData, rawDataIndex + 14);
+	game = nGame;
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
+	actorNum = view.ReadInt16(0);
+	posX = view.ReadInt16(2);
+	posY = view.ReadInt16(4);
+	posZ = view.ReadInt16(6);
+	rotX = view.ReadUInt16(8);
+	rotY = view.ReadUInt16(10);
+	rotZ = view.ReadUInt16(12);
+	params = view.ReadInt16(14);
 }
 
 std::string ActorSpawnEntry::GetBodySourceCode() const
@@ -155,11 +160,11 @@ std::string ActorSpawnEntry::GetBodySourceCode() const
 	std::string body;
 
 	std::string actorNameFmt = StringHelper::Sprintf("%%-%zus ", largestActorName + 1);
-	body =
-		StringHelper::Sprintf(actorNameFmt.c_str(), (ZNames::GetActorName(actorNum) + ",").c_str());
+	body = StringHelper::Sprintf(actorNameFmt.c_str(),
+	                             (ZNames::GetActorName(actorNum, game) + ",").c_str());
 
 	body += StringHelper::Sprintf("{ %6i, %6i, %6i }, ", posX, posY, posZ);
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (game == ZGame::MM_RETAIL)
 		body += StringHelper::Sprintf("{ SPAWN_ROT_FLAGS(%#5hX, 0x%04X)"
 		                              ", SPAWN_ROT_FLAGS(%#5hX, 0x%04X)"
 		                              ", SPAWN_ROT_FLAGS(%#5hX, 0x%04X) }, ",
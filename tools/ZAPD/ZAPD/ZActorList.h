@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ZFile.h"
 #include "ZResource.h"
 
 class ActorSpawnEntry
@@ -14,8 +15,9 @@ public:
 	uint16_t rotZ;
 	uint16_t params;
 	size_t largestActorName = 16;
+	ZGame game;
 
-	ActorSpawnEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	ActorSpawnEntry(ByteSpan rawData, uint32_t rawDataIndex, ZGame nGame);
 
 	std::string GetBodySourceCode() const;
 
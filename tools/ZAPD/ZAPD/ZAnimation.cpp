@@ -2,9 +2,11 @@
 
 #include <utility>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/File.h"
+#include "Utils/NumericEmitter.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 #include "ZFile.h"
@@ -23,7 +25,7 @@ void ZAnimation::ParseRawData()
 {
 	ZResource::ParseRawData();
 
-	frameCount = BitConverter::ToInt16BE(parent->GetRawData(), rawDataIndex + 0);
+	frameCount = BEView(parent->GetRawData(), rawDataIndex, 2).ReadInt16(0);
 }
 
 ZResourceType ZAnimation::GetResourceType() const
@@ -52,33 +54,28 @@ void ZNormalAnimation::ParseRawData()
 	ZAnimation::ParseRawData();
 
 	auto& data = parent->GetRawData();
+	BEView view(data, rawDataIndex, GetRawDataSize());
 
-	rotationValuesSeg = BitConverter::ToInt32BE(data, rawDataIndex + 4);
-	rotationIndicesSeg = BitConverter::ToInt32BE(data, rawDataIndex + 8);
-	limit = BitConverter::ToInt16BE(data, rawDataIndex + 12);
+	rotationValuesSeg = view.ReadInt32(4);
+	rotationIndicesSeg = view.ReadInt32(8);
+	limit = view.ReadInt16(12);
 
 	rotationValuesOffset = Seg2Filespace(rotationValuesSeg, parent->baseAddress);
 	rotationIndicesOffset = Seg2Filespace(rotationIndicesSeg, parent->baseAddress);
 
-	uint32_t currentPtr = rotationValuesOffset;
-
 	// Read the Rotation Values
-	for (uint32_t i = 0; i < ((rotationIndicesOffset - rotationValuesOffset) / 2); i++)
-	{
-		rotationValues.push_back(BitConverter::ToInt16BE(data, currentPtr));
-		currentPtr += 2;
-	}
+	uint32_t valueCount = (rotationIndicesOffset - rotationValuesOffset) / 2;
+	BEView valuesView(data, rotationValuesOffset, valueCount * 2);
+	rotationValues = valuesView.ReadArray<uint16_t>(0, valueCount);
 
-	currentPtr = rotationIndicesOffset;
+	// Read the Rotation Indices, a Vec3s[]
+	uint32_t indexCount = (rawDataIndex - rotationIndicesOffset) / 6;
+	BEView indicesView(data, rotationIndicesOffset, indexCount * 6);
+	std::vector<uint16_t> indices = indicesView.ReadArray<uint16_t>(0, indexCount * 3);
 
-	// Read the Rotation Indices
-	for (uint32_t i = 0; i < ((rawDataIndex - rotationIndicesOffset) / 6); i++)
-	{
-		rotationIndices.push_back(RotationIndex(BitConverter::ToInt16BE(data, currentPtr),
-		                                        BitConverter::ToInt16BE(data, currentPtr + 2),
-		                                        BitConverter::ToInt16BE(data, currentPtr + 4)));
-		currentPtr += 6;
-	}
+	rotationIndices.reserve(indexCount);
+	for (uint32_t i = 0; i < indexCount; i++)
+		rotationIndices.emplace_back(indices[i * 3 + 0], indices[i * 3 + 1], indices[i * 3 + 2]);
 }
 
 void ZNormalAnimation::DeclareReferences(const std::string& prefix)
@@ -93,16 +90,12 @@ void ZNormalAnimation::DeclareReferences(const std::string& prefix)
 
 	std::string indicesStr = "";
 	std::string valuesStr = "    ";
-	const uint8_t lineLength = 14;
-	const uint8_t offset = 0;
-
-	for (size_t i = 0; i < rotationValues.size(); i++)
-	{
-		valuesStr += StringHelper::Sprintf("0x%04X, ", rotationValues[i]);
+	NumericArrayLayout valuesLayout;
 
-		if ((i - offset + 1) % lineLength == 0)
-			valuesStr += "\n    ";
-	}
+	valuesLayout.width = 4;
+	valuesLayout.perLine = 14;
+	valuesLayout.lineEnd = "\n    ";
+	NumericEmitter(valuesStr).Array(rotationValues.data(), rotationValues.size(), valuesLayout);
 
 	parent->AddDeclarationArray(rotationValuesOffset, DeclarationAlignment::Align4,
 	                            rotationValues.size() * 2, "s16",
@@ -127,10 +120,11 @@ void ZNormalAnimation::DeclareReferences(const std::string& prefix)
 std::string ZNormalAnimation::GetBodySourceCode() const
 {
 	std::string frameDataName;
-	Globals::Instance->GetSegmentedPtrName(rotationValuesSeg, parent, "s16", frameDataName);
+	parent->ctx->GetSegmentedPtrName(rotationValuesSeg, parent, rawDataIndex + 4, "s16",
+	                                 frameDataName);
 	std::string jointIndicesName;
-	Globals::Instance->GetSegmentedPtrName(rotationIndicesSeg, parent, "JointIndex",
-	                                       jointIndicesName);
+	parent->ctx->GetSegmentedPtrName(rotationIndicesSeg, parent, rawDataIndex + 8, "JointIndex",
+	                                 jointIndicesName);
 
 	std::string headerStr =
 		StringHelper::Sprintf("\n\t{ %i }, %s,\n", frameCount, frameDataName.c_str());
@@ -153,7 +147,7 @@ size_t ZLinkAnimation::GetRawDataSize() const
 
 std::string ZLinkAnimation::GetSourceTypeName() const
 {
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 		return "PlayerAnimationHeader";
 	else
 		return "LinkAnimationHeader";
@@ -163,33 +157,32 @@ void ZLinkAnimation::ParseRawData()
 {
 	ZAnimation::ParseRawData();
 
-	const auto& rawData = parent->GetRawData();
-	segmentAddress = BitConverter::ToInt32BE(rawData, rawDataIndex + 4);
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
+	segmentAddress = view.ReadInt32(4);
 }
 
 std::string ZLinkAnimation::GetBodySourceCode() const
 {
 	std::string segSymbol;
-	Globals::Instance->GetSegmentedPtrName(segmentAddress, parent, "", segSymbol);
+	parent->ctx->GetSegmentedPtrName(segmentAddress, parent, rawDataIndex + 4, "", segSymbol);
 
 	return StringHelper::Sprintf("\n\t{ %i }, %s\n", frameCount, segSymbol.c_str());
 }
 
 /* ZCurveAnimation */
 
-CurveInterpKnot::CurveInterpKnot(ZFile* parent, const std::vector<uint8_t>& rawData,
-                                 uint32_t fileOffset)
+CurveInterpKnot::CurveInterpKnot(ZFile* parent, ByteSpan rawData, uint32_t fileOffset)
 	: parent(parent)
 {
-	unk_00 = BitConverter::ToUInt16BE(rawData, fileOffset + 0);
-	unk_02 = BitConverter::ToUInt16BE(rawData, fileOffset + 2);
-	unk_04 = BitConverter::ToInt16BE(rawData, fileOffset + 4);
-	unk_06 = BitConverter::ToInt16BE(rawData, fileOffset + 6);
-	unk_08 = BitConverter::ToFloatBE(rawData, fileOffset + 8);
+	BEView view(rawData, fileOffset, GetRawDataSize());
+	unk_00 = view.ReadUInt16(0);
+	unk_02 = view.ReadUInt16(2);
+	unk_04 = view.ReadInt16(4);
+	unk_06 = view.ReadInt16(6);
+	unk_08 = view.ReadFloat(8);
 }
 
-CurveInterpKnot::CurveInterpKnot(ZFile* parent, const std::vector<uint8_t>& rawData,
-                                 uint32_t fileOffset, size_t index)
+CurveInterpKnot::CurveInterpKnot(ZFile* parent, ByteSpan rawData, uint32_t fileOffset, size_t index)
 	: CurveInterpKnot(parent, rawData, fileOffset + index * GetRawDataSize())
 {
 }
@@ -234,29 +227,30 @@ void ZCurveAnimation::ParseRawData()
 	ZAnimation::ParseRawData();
 
 	const auto& rawData = parent->GetRawData();
-	refIndex = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0);
-	transformData = BitConverter::ToUInt32BE(rawData, rawDataIndex + 4);
-	copyValues = BitConverter::ToUInt32BE(rawData, rawDataIndex + 8);
-	unk_0C = BitConverter::ToInt16BE(rawData, rawDataIndex + 12);
-	unk_10 = BitConverter::ToInt16BE(rawData, rawDataIndex + 14);
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
+	refIndex = view.ReadUInt32(0);
+	transformData = view.ReadUInt32(4);
+	copyValues = view.ReadUInt32(8);
+	unk_0C = view.ReadInt16(12);
+	unk_10 = view.ReadInt16(14);
 
 	uint32_t limbCountAddress = Seg2Filespace(skelOffset, parent->baseAddress) + 4;
-	limbCount = BitConverter::ToUInt8BE(rawData, limbCountAddress);
+	limbCount = BEView(rawData, limbCountAddress, 1).ReadUInt8(0);
 
 	size_t transformDataSize = 0;
 	size_t copyValuesSize = 0;
 	if (refIndex != 0)
 	{
 		uint32_t refIndexOffset = Seg2Filespace(refIndex, parent->baseAddress);
-		for (size_t i = 0; i < 3 * 3 * limbCount; i++)
+		BEView refIndexView(rawData, refIndexOffset, 3 * 3 * limbCount);
+		refIndexArr = refIndexView.ReadArray<uint8_t>(0, 3 * 3 * limbCount);
+
+		for (uint8_t ref : refIndexArr)
 		{
-			uint8_t ref = BitConverter::ToUInt8BE(rawData, refIndexOffset + i);
 			if (ref == 0)
 				copyValuesSize++;
 			else
 				transformDataSize += ref;
-
-			refIndexArr.emplace_back(ref);
 		}
 	}
 
@@ -272,8 +266,8 @@ void ZCurveAnimation::ParseRawData()
 	{
 		uint32_t copyValuesOffset = Seg2Filespace(copyValues, parent->baseAddress);
 
-		for (size_t i = 0; i < copyValuesSize; i++)
-			copyValuesArr.emplace_back(BitConverter::ToInt16BE(rawData, copyValuesOffset + i * 2));
+		BEView copyValuesView(rawData, copyValuesOffset, copyValuesSize * 2);
+		copyValuesArr = copyValuesView.ReadArray<int16_t>(0, copyValuesSize);
 	}
 }
 
@@ -287,12 +281,12 @@ void ZCurveAnimation::DeclareReferences(const std::string& prefix)
 
 		std::string entryStr = "    ";
 		uint16_t arrayItemCnt = refIndexArr.size();
+		NumericArrayLayout layout;
 
-		size_t i = 0;
-		for (auto& child : refIndexArr)
-		{
-			entryStr += StringHelper::Sprintf("0x%02X, %s", child, (i++ % 8 == 7) ? "\n    " : "");
-		}
+		layout.width = 2;
+		layout.perLine = 8;
+		layout.lineEnd = "\n    ";
+		NumericEmitter(entryStr).Array(refIndexArr.data(), refIndexArr.size(), layout);
 
 		Declaration* decl = parent->GetDeclaration(refIndexOffset);
 		if (decl == nullptr)
@@ -346,12 +340,13 @@ void ZCurveAnimation::DeclareReferences(const std::string& prefix)
 
 		std::string entryStr = "    ";
 		uint16_t arrayItemCnt = copyValuesArr.size();
+		NumericArrayLayout layout;
 
-		size_t i = 0;
-		for (auto& child : copyValuesArr)
-		{
-			entryStr += StringHelper::Sprintf("% 6i, %s", child, (i++ % 8 == 7) ? "\n    " : "");
-		}
+		layout.format = NumericArrayLayout::Format::Decimal;
+		layout.width = 6;
+		layout.perLine = 8;
+		layout.lineEnd = "\n    ";
+		NumericEmitter(entryStr).Array(copyValuesArr.data(), copyValuesArr.size(), layout);
 
 		Declaration* decl = parent->GetDeclaration(copyValuesOffset);
 		if (decl == nullptr)
@@ -370,12 +365,12 @@ void ZCurveAnimation::DeclareReferences(const std::string& prefix)
 std::string ZCurveAnimation::GetBodySourceCode() const
 {
 	std::string refIndexStr;
-	Globals::Instance->GetSegmentedPtrName(refIndex, parent, "u8", refIndexStr);
+	parent->ctx->GetSegmentedPtrName(refIndex, parent, rawDataIndex, "u8", refIndexStr);
 	std::string transformDataStr;
-	Globals::Instance->GetSegmentedPtrName(transformData, parent, "CurveInterpKnot",
-	                                       transformDataStr);
+	parent->ctx->GetSegmentedPtrName(transformData, parent, rawDataIndex + 4, "CurveInterpKnot",
+	                                 transformDataStr);
 	std::string copyValuesStr;
-	Globals::Instance->GetSegmentedPtrName(copyValues, parent, "s16", copyValuesStr);
+	parent->ctx->GetSegmentedPtrName(copyValues, parent, rawDataIndex + 8, "s16", copyValuesStr);
 
 	return StringHelper::Sprintf("\n\t%s,\n\t%s,\n\t%s,\n\t%i, %i\n", refIndexStr.c_str(),
 	                             transformDataStr.c_str(), copyValuesStr.c_str(), unk_0C, unk_10);
@@ -407,23 +402,21 @@ void ZLegacyAnimation::ParseRawData()
 	ZAnimation::ParseRawData();
 
 	const auto& rawData = parent->GetRawData();
-	limbCount = BitConverter::ToInt16BE(rawData, rawDataIndex + 0x02);
-	frameData = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x04);
-	jointKey = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x08);
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
+	limbCount = view.ReadInt16(0x02);
+	frameData = view.ReadUInt32(0x04);
+	jointKey = view.ReadUInt32(0x08);
 
 	if (GETSEGNUM(frameData) == parent->segment && GETSEGNUM(jointKey) == parent->segment)
 	{
 		uint32_t frameDataOffset = Seg2Filespace(frameData, parent->baseAddress);
 		uint32_t jointKeyOffset = Seg2Filespace(jointKey, parent->baseAddress);
 
-		uint32_t ptr = frameDataOffset;
-		for (size_t i = 0; i < (jointKeyOffset - frameDataOffset) / 2; i++)
-		{
-			frameDataArray.push_back(BitConverter::ToUInt16BE(rawData, ptr));
-			ptr += 2;
-		}
+		uint32_t frameDataCount = (jointKeyOffset - frameDataOffset) / 2;
+		BEView frameDataView(rawData, frameDataOffset, frameDataCount * 2);
+		frameDataArray = frameDataView.ReadArray<uint16_t>(0, frameDataCount);
 
-		ptr = jointKeyOffset;
+		uint32_t ptr = jointKeyOffset;
 		for (int32_t i = 0; i < limbCount + 1; i++)
 		{
 			LegacyJointKey key(parent);
@@ -449,14 +442,14 @@ void ZLegacyAnimation::DeclareReferences(const std::string& prefix)
 		if (GETSEGNUM(frameData) == parent->segment && !parent->HasDeclaration(frameDataOffset))
 		{
 			std::string frameDataBody = "\t";
+			NumericArrayLayout layout;
 
-			for (size_t i = 0; i < frameDataArray.size(); i++)
-			{
-				frameDataBody += StringHelper::Sprintf("0x%04X, ", frameDataArray[i]);
-
-				if (i % 8 == 7 && i + 1 < frameDataArray.size())
-					frameDataBody += "\n\t";
-			}
+			layout.width = 4;
+			layout.perLine = 8;
+			layout.lineEnd = "\n\t";
+			layout.endLastLine = false;
+			NumericEmitter(frameDataBody)
+				.Array(frameDataArray.data(), frameDataArray.size(), layout);
 
 			std::string frameDataName = StringHelper::Sprintf("%sFrameData", varPrefix.c_str());
 			parent->AddDeclarationArray(frameDataOffset, DeclarationAlignment::Align4,
@@ -497,8 +490,9 @@ std::string ZLegacyAnimation::GetBodySourceCode() const
 
 	std::string frameDataName;
 	std::string jointKeyName;
-	Globals::Instance->GetSegmentedPtrName(frameData, parent, "s16", frameDataName);
-	Globals::Instance->GetSegmentedPtrName(jointKey, parent, "LegacyJointKey", jointKeyName);
+	parent->ctx->GetSegmentedPtrName(frameData, parent, rawDataIndex + 4, "s16", frameDataName);
+	parent->ctx->GetSegmentedPtrName(jointKey, parent, rawDataIndex + 8, "LegacyJointKey",
+	                                 jointKeyName);
 
 	body += StringHelper::Sprintf("\t%i, %i,\n", frameCount, limbCount);
 	body += StringHelper::Sprintf("\t%s,\n", frameDataName.c_str());
@@ -525,13 +519,13 @@ void LegacyJointKey::ParseRawData()
 {
 	ZResource::ParseRawData();
 
-	const auto& rawData = parent->GetRawData();
-	xMax = BitConverter::ToInt16BE(rawData, rawDataIndex + 0x00);
-	x = BitConverter::ToInt16BE(rawData, rawDataIndex + 0x02);
-	yMax = BitConverter::ToInt16BE(rawData, rawDataIndex + 0x04);
-	y = BitConverter::ToInt16BE(rawData, rawDataIndex + 0x06);
-	zMax = BitConverter::ToInt16BE(rawData, rawDataIndex + 0x08);
-	z = BitConverter::ToInt16BE(rawData, rawDataIndex + 0x0A);
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
+	xMax = view.ReadInt16(0x00);
+	x = view.ReadInt16(0x02);
+	yMax = view.ReadInt16(0x04);
+	y = view.ReadInt16(0x06);
+	zMax = view.ReadInt16(0x08);
+	z = view.ReadInt16(0x0A);
 }
 
 std::string LegacyJointKey::GetBodySourceCode() const
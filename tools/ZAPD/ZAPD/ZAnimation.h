@@ -85,9 +85,8 @@ protected:
 
 public:
 	CurveInterpKnot() = default;
-	CurveInterpKnot(ZFile* parent, const std::vector<uint8_t>& rawData, uint32_t fileOffset);
-	CurveInterpKnot(ZFile* parent, const std::vector<uint8_t>& rawData, uint32_t fileOffset,
-	                size_t index);
+	CurveInterpKnot(ZFile* parent, ByteSpan rawData, uint32_t fileOffset);
+	CurveInterpKnot(ZFile* parent, ByteSpan rawData, uint32_t fileOffset, size_t index);
 
 	[[nodiscard]] std::string GetBody(const std::string& prefix) const;
 
@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
@@ -74,7 +75,7 @@ Declaration* ZArray::DeclareVar(const std::string& prefix, const std::string& bo
 	Declaration* decl;
 	if (res->IsExternalResource())
 	{
-		auto filepath = Globals::Instance->outputPath / name;
+		auto filepath = parent->ctx->outputPath / name;
 		std::string includePath = StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(),
 		                                                res->GetExternalExtension().c_str());
 		decl = parent->AddDeclarationIncludeArray(rawDataIndex, includePath, GetRawDataSize(),
@@ -1,8 +1,11 @@
 #include "ZBackground.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/File.h"
+#include "Utils/Hash.h"
+#include "Utils/NumericEmitter.h"
 #include "Utils/Path.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
@@ -125,7 +128,7 @@ Declaration* ZBackground::DeclareVar(const std::string& prefix,
 	if (auxOutName == "")
 		auxOutName = GetDefaultName(prefix);
 
-	auto filepath = Globals::Instance->outputPath / fs::path(auxOutName).stem();
+	auto filepath = parent->ctx->outputPath / fs::path(auxOutName).stem();
 
 	std::string incStr =
 		StringHelper::Sprintf("%s.%s.inc.c", filepath.c_str(), GetExternalExtension().c_str());
@@ -156,20 +159,21 @@ std::string ZBackground::GetExternalExtension() const
 void ZBackground::Save(const fs::path& outFolder)
 {
 	fs::path filepath = outFolder / (outName + "." + GetExternalExtension());
-	File::WriteAllBytes(filepath.string(), data);
+	bool written = Globals::Instance->contentStore.SaveOutput(
+		filepath, [this]() { return Hash::Fnv1a64(data.data(), data.size()); },
+		[&]() { return File::WriteAllBytesIfChanged(filepath, data); });
+	parent->ctx->AddOutputFile(filepath, written);
 }
 
 std::string ZBackground::GetBodySourceCode() const
 {
 	std::string bodyStr = "    ";
+	NumericArrayLayout layout;
 
-	for (size_t i = 0; i < data.size() / 8; ++i)
-	{
-		bodyStr += StringHelper::Sprintf("0x%016llX, ", BitConverter::ToUInt64BE(data, i * 8));
-
-		if (i % 8 == 7)
-			bodyStr += "\n    ";
-	}
+	layout.width = 16;
+	layout.perLine = 8;
+	layout.lineEnd = "\n    ";
+	NumericEmitter(bodyStr).ArrayBE<uint64_t>(data, layout);
 
 	bodyStr += "\n";
 
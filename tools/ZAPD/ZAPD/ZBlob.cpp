@@ -1,8 +1,11 @@
 #include "ZBlob.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/File.h"
+#include "Utils/Hash.h"
+#include "Utils/NumericEmitter.h"
 #include "Utils/Path.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
@@ -16,7 +19,7 @@ ZBlob::ZBlob(ZFile* nParent) : ZResource(nParent)
 
 ZBlob* ZBlob::FromFile(const std::string& filePath)
 {
-	ZBlob* blob = new ZBlob(nullptr);
+	ZBlob* blob = new (nullptr) ZBlob(nullptr);
 	blob->name = StringHelper::Split(Path::GetFileNameWithoutExtension(filePath), ".")[0];
 	blob->blobData = File::ReadAllBytes(filePath);
 
@@ -51,29 +54,31 @@ Declaration* ZBlob::DeclareVar(const std::string& prefix,
 	std::string path = Path::GetFileNameWithoutExtension(auxOutName);
 
 	std::string assetOutDir =
-		(Globals::Instance->outputPath / Path::GetFileNameWithoutExtension(GetOutName())).string();
+		(parent->ctx->outputPath / Path::GetFileNameWithoutExtension(GetOutName())).string();
 
 	std::string incStr =
 		StringHelper::Sprintf("%s.%s.inc.c", assetOutDir.c_str(), GetExternalExtension().c_str());
 
-	return parent->AddDeclarationIncludeArray(rawDataIndex, incStr, GetRawDataSize(),
-	                                          GetSourceTypeName(), auxName, blobData.size());
+	Declaration* decl = parent->AddDeclarationIncludeArray(
+		rawDataIndex, incStr, GetRawDataSize(), GetSourceTypeName(), auxName, blobData.size());
+	decl->incbinPath = StringHelper::Replace(std::string(decl->includePath), ".inc.c", "");
+
+	return decl;
+}
+
+const std::vector<uint8_t>& ZBlob::GetBlobData() const
+{
+	return blobData;
 }
 
 std::string ZBlob::GetBodySourceCode() const
 {
 	std::string sourceOutput;
+	NumericArrayLayout layout;
 
-	for (size_t i = 0; i < blobData.size(); i += 1)
-	{
-		if (i % 16 == 0)
-			sourceOutput += "\t";
-
-		sourceOutput += StringHelper::Sprintf("0x%02X, ", blobData[i]);
-
-		if (i % 16 == 15)
-			sourceOutput += "\n";
-	}
+	layout.width = 2;
+	layout.lineStart = "\t";
+	NumericEmitter(sourceOutput).Array(blobData.data(), blobData.size(), layout);
 
 	// Ensure there's always a trailing line feed to prevent dumb warnings.
 	// Please don't remove this line, unless you somehow made a way to prevent
@@ -85,7 +90,11 @@ std::string ZBlob::GetBodySourceCode() const
 
 void ZBlob::Save(const fs::path& outFolder)
 {
-	File::WriteAllBytes((outFolder / (name + ".bin")).string(), blobData);
+	fs::path filepath = outFolder / (name + ".bin");
+	bool written = Globals::Instance->contentStore.SaveOutput(
+		filepath, [this]() { return Hash::Fnv1a64(blobData.data(), blobData.size()); },
+		[&]() { return File::WriteAllBytesIfChanged(filepath, blobData); });
+	parent->ctx->AddOutputFile(filepath, written);
 }
 
 bool ZBlob::IsExternalResource() const
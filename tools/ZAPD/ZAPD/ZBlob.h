@@ -15,6 +15,7 @@ public:
 
 	Declaration* DeclareVar(const std::string& prefix, const std::string& bodyStr) override;
 	std::string GetBodySourceCode() const override;
+	const std::vector<uint8_t>& GetBlobData() const;
 
 	void Save(const fs::path& outFolder) override;
 
@@ -1,5 +1,6 @@
 #include "ZCKeyFrame.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -88,7 +89,7 @@ void ZKeyFrameSkel::ParseRawData()
 	dListCount = BitConverter::ToUInt8BE(rawData, rawDataIndex + 1);
 	limbsPtr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 4);
 
-	limbList = std::make_unique<ZKeyFrameLimbList>(parent, limbCount, limbType);
+	limbList.reset(new (parent) ZKeyFrameLimbList(parent, limbCount, limbType));
 	limbList->SetRawDataIndex(GETSEGOFFSET(limbsPtr));
 	limbList->ParseRawData();
 }
@@ -115,9 +116,11 @@ std::string ZKeyFrameSkel::GetBodySourceCode() const
 	std::string limbStr;
 
 	if (limbType == ZKeyframeSkelType::Normal)
-		Globals::Instance->GetSegmentedPtrName(limbsPtr, parent, "KeyFrameStandardLimb", limbStr);
+		parent->ctx->GetSegmentedPtrName(limbsPtr, parent, rawDataIndex + 4, "KeyFrameStandardLimb",
+		                                 limbStr);
 	else
-		Globals::Instance->GetSegmentedPtrName(limbsPtr, parent, "KeyFrameFlexLimb", limbStr);
+		parent->ctx->GetSegmentedPtrName(limbsPtr, parent, rawDataIndex + 4, "KeyFrameFlexLimb",
+		                                 limbStr);
 
 	return StringHelper::Sprintf("\n\t0x%02X, 0x%02X, %s\n", limbCount, dListCount,
 	                             limbStr.c_str());
@@ -215,9 +218,9 @@ void ZKeyFrameLimbList::ParseRawData()
 	{
 		ZKeyFrameLimb* limb;
 		if (limbType == ZKeyframeSkelType::Flex)
-			limb = new ZKeyFrameFlexLimb(parent);
+			limb = new (parent) ZKeyFrameFlexLimb(parent);
 		else
-			limb = new ZKeyFrameStandardLimb(parent);
+			limb = new (parent) ZKeyFrameStandardLimb(parent);
 
 		limb->SetRawDataIndex(rawDataIndex + (offset_t)(i * limb->GetRawDataSize()));
 		limb->ParseRawData();
@@ -240,7 +243,7 @@ std::string ZKeyFrameStandardLimb::GetBodySourceCode() const
 	std::string declaration;
 	std::string dlString;
 
-	Globals::Instance->GetSegmentedArrayIndexedName(dlist, 8, parent, "Gfx", dlString);
+	parent->ctx->GetSegmentedArrayIndexedName(dlist, 8, parent, rawDataIndex, "Gfx", dlString);
 
 	declaration +=
 		StringHelper::Sprintf("%s, 0x%02X, 0x%02X, { 0x%04X, 0x%04X, 0x%04X},", dlString.c_str(),
@@ -254,7 +257,7 @@ std::string ZKeyFrameFlexLimb::GetBodySourceCode() const
 
 	std::string dlString;
 
-	Globals::Instance->GetSegmentedArrayIndexedName(dlist, 8, parent, "Gfx", dlString);
+	parent->ctx->GetSegmentedArrayIndexedName(dlist, 8, parent, rawDataIndex, "Gfx", dlString);
 
 	declaration += StringHelper::Sprintf("%s, 0x%02X, 0x%02X, 0x%02X", dlString.c_str(),
 	                                     numChildren, flags, callbackIndex);
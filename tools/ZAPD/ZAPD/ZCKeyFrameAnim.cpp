@@ -1,5 +1,6 @@
 #include "ZCkeyFrameAnim.h"
 #include "ZCKeyFrame.h"
+#include "ExtractionContext.h"
 #include "Globals.h"
 
 #include "Utils/BitConverter.h"
@@ -179,10 +180,11 @@ std::string ZKeyFrameAnim::GetBodySourceCode() const
 	std::string kfNumsStr;
 	std::string presetValuesStr;
 
-	Globals::Instance->GetSegmentedPtrName(bitFlagsAddr, parent, "", bitFlagsStr);
-	Globals::Instance->GetSegmentedPtrName(keyFramesAddr, parent, "", keyFrameStr);
-	Globals::Instance->GetSegmentedPtrName(kfNumsAddr, parent, "", kfNumsStr);
-	Globals::Instance->GetSegmentedPtrName(presentValuesAddr, parent, "", presetValuesStr);
+	parent->ctx->GetSegmentedPtrName(bitFlagsAddr, parent, rawDataIndex + 0x0, "", bitFlagsStr);
+	parent->ctx->GetSegmentedPtrName(keyFramesAddr, parent, rawDataIndex + 0x4, "", keyFrameStr);
+	parent->ctx->GetSegmentedPtrName(kfNumsAddr, parent, rawDataIndex + 0x8, "", kfNumsStr);
+	parent->ctx->GetSegmentedPtrName(presentValuesAddr, parent, rawDataIndex + 0xC, "",
+	                                 presetValuesStr);
 
 	return StringHelper::Sprintf("\n\t%s, %s, %s, %s, 0x%04X, 0x%04X\n", bitFlagsStr.c_str(),
 	                             keyFrameStr.c_str(), kfNumsStr.c_str(), presetValuesStr.c_str(),
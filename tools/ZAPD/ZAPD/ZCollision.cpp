@@ -5,8 +5,9 @@
 #include <cstdint>
 #include <string>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 
 REGISTER_ZFILENODE(Collision, ZCollisionHeader);
@@ -23,25 +24,26 @@ ZCollisionHeader::~ZCollisionHeader()
 void ZCollisionHeader::ParseRawData()
 {
 	const auto& rawData = parent->GetRawData();
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
 
-	absMinX = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
-	absMinY = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-	absMinZ = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
+	absMinX = view.ReadInt16(0);
+	absMinY = view.ReadInt16(2);
+	absMinZ = view.ReadInt16(4);
 
-	absMaxX = BitConverter::ToInt16BE(rawData, rawDataIndex + 6);
-	absMaxY = BitConverter::ToInt16BE(rawData, rawDataIndex + 8);
-	absMaxZ = BitConverter::ToInt16BE(rawData, rawDataIndex + 10);
+	absMaxX = view.ReadInt16(6);
+	absMaxY = view.ReadInt16(8);
+	absMaxZ = view.ReadInt16(10);
 
-	numVerts = BitConverter::ToUInt16BE(rawData, rawDataIndex + 12);
-	vtxAddress = BitConverter::ToInt32BE(rawData, rawDataIndex + 16);
+	numVerts = view.ReadUInt16(12);
+	vtxAddress = view.ReadInt32(16);
 
-	numPolygons = BitConverter::ToUInt16BE(rawData, rawDataIndex + 20);
-	polyAddress = BitConverter::ToInt32BE(rawData, rawDataIndex + 24);
-	polyTypeDefAddress = BitConverter::ToInt32BE(rawData, rawDataIndex + 28);
-	camDataAddress = BitConverter::ToInt32BE(rawData, rawDataIndex + 32);
+	numPolygons = view.ReadUInt16(20);
+	polyAddress = view.ReadInt32(24);
+	polyTypeDefAddress = view.ReadInt32(28);
+	camDataAddress = view.ReadInt32(32);
 
-	numWaterBoxes = BitConverter::ToUInt16BE(rawData, rawDataIndex + 36);
-	waterBoxAddress = BitConverter::ToInt32BE(rawData, rawDataIndex + 40);
+	numWaterBoxes = view.ReadUInt16(36);
+	waterBoxAddress = view.ReadInt32(40);
 
 	vtxSegmentOffset = Seg2Filespace(vtxAddress, parent->baseAddress);
 	polySegmentOffset = Seg2Filespace(polyAddress, parent->baseAddress);
@@ -144,7 +146,7 @@ void ZCollisionHeader::ParseRawData()
 		ZWaterbox waterbox(parent);
 
 		waterbox.SetRawDataIndex(waterBoxSegmentOffset +
-		                         (i * (Globals::Instance->game == ZGame::OOT_SW97 ? 12 : 16)));
+		                         (i * (parent->ctx->game == ZGame::OOT_SW97 ? 12 : 16)));
 		waterbox.ParseRawData();
 		waterBoxes.emplace_back(waterbox);
 	}
@@ -239,7 +241,7 @@ std::string ZCollisionHeader::GetBodySourceCode() const
 	declaration += StringHelper::Sprintf("\t{ %i, %i, %i },\n", absMaxX, absMaxY, absMaxZ);
 
 	std::string vtxName;
-	Globals::Instance->GetSegmentedPtrName(vtxAddress, parent, "Vec3s", vtxName);
+	parent->ctx->GetSegmentedPtrName(vtxAddress, parent, rawDataIndex + 16, "Vec3s", vtxName);
 
 	if (numVerts > 0)
 		declaration +=
@@ -248,7 +250,8 @@ std::string ZCollisionHeader::GetBodySourceCode() const
 		declaration += StringHelper::Sprintf("\t%i, %s,\n", numVerts, vtxName.c_str());
 
 	std::string polyName;
-	Globals::Instance->GetSegmentedPtrName(polyAddress, parent, "CollisionPoly", polyName);
+	parent->ctx->GetSegmentedPtrName(polyAddress, parent, rawDataIndex + 24, "CollisionPoly",
+	                                 polyName);
 
 	if (numPolygons > 0)
 		declaration +=
@@ -257,15 +260,18 @@ std::string ZCollisionHeader::GetBodySourceCode() const
 		declaration += StringHelper::Sprintf("\t%i, %s,\n", numPolygons, polyName.c_str());
 
 	std::string surfaceName;
-	Globals::Instance->GetSegmentedPtrName(polyTypeDefAddress, parent, "SurfaceType", surfaceName);
+	parent->ctx->GetSegmentedPtrName(polyTypeDefAddress, parent, rawDataIndex + 28, "SurfaceType",
+	                                 surfaceName);
 	declaration += StringHelper::Sprintf("\t%s,\n", surfaceName.c_str());
 
 	std::string camName;
-	Globals::Instance->GetSegmentedPtrName(camDataAddress, parent, "BgCamInfo", camName);
+	parent->ctx->GetSegmentedPtrName(camDataAddress, parent, rawDataIndex + 32, "BgCamInfo",
+	                                 camName);
 	declaration += StringHelper::Sprintf("\t%s,\n", camName.c_str());
 
 	std::string waterBoxName;
-	Globals::Instance->GetSegmentedPtrName(waterBoxAddress, parent, "WaterBox", waterBoxName);
+	parent->ctx->GetSegmentedPtrName(waterBoxAddress, parent, rawDataIndex + 40, "WaterBox",
+	                                 waterBoxName);
 
 	if (numWaterBoxes > 0)
 		declaration += StringHelper::Sprintf("\tARRAY_COUNT(%s), %s\n", waterBoxName.c_str(),
@@ -297,7 +303,7 @@ size_t ZCollisionHeader::GetRawDataSize() const
 }
 
 CameraDataList::CameraDataList(ZFile* parent, const std::string& prefix,
-                               const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+                               ByteSpan rawData, offset_t rawDataIndex,
                                offset_t upperCameraBoundary)
 {
 	std::string declaration;
@@ -314,12 +320,11 @@ CameraDataList::CameraDataList(ZFile* parent, const std::string& prefix,
 	for (size_t i = 0; i < numElements; i++)
 	{
 		CameraDataEntry entry;
+		BEView view(rawData, rawDataIndex + (entries.size() * 8), 8);
 
-		entry.cameraSType =
-			BitConverter::ToInt16BE(rawData, rawDataIndex + (entries.size() * 8) + 0);
-		entry.numData = BitConverter::ToInt16BE(rawData, rawDataIndex + (entries.size() * 8) + 2);
-		entry.cameraPosDataSeg =
-			BitConverter::ToInt32BE(rawData, rawDataIndex + (entries.size() * 8) + 4);
+		entry.cameraSType = view.ReadInt16(0);
+		entry.numData = view.ReadInt16(2);
+		entry.cameraPosDataSeg = view.ReadInt32(4);
 
 		if (entry.cameraPosDataSeg != 0 && GETSEGNUM(entry.cameraPosDataSeg) != SEGMENT_SCENE)
 		{
@@ -363,7 +368,7 @@ CameraDataList::CameraDataList(ZFile* parent, const std::string& prefix,
 
 		declaration +=
 			StringHelper::Sprintf("    { 0x%04X, %i, %s },", entries[i].cameraSType,
-		                          entries[i].numData, camSegLine, rawDataIndex + (i * 8));
+		                          entries[i].numData, camSegLine);
 
 		if (i < entries.size() - 1)
 			declaration += "\n";
@@ -371,7 +376,7 @@ CameraDataList::CameraDataList(ZFile* parent, const std::string& prefix,
 
 	parent->AddDeclarationArray(
 		rawDataIndex, DeclarationAlignment::Align4, entries.size() * 8, "BgCamInfo",
-		StringHelper::Sprintf("%sCamDataList", prefix.c_str(), rawDataIndex), entries.size(),
+		StringHelper::Sprintf("%sCamDataList", prefix.c_str()), entries.size(),
 		declaration);
 
 	if (!isSharpOcarina)
@@ -381,11 +386,15 @@ CameraDataList::CameraDataList(ZFile* parent, const std::string& prefix,
 
 	if (numDataTotal > 0)
 	{
+		// Vec3s[], decoded at once
+		BEView view(rawData, cameraPosDataOffset, numDataTotal * 6);
+		std::vector<int16_t> coords = view.ReadArray<int16_t>(0, numDataTotal * 3);
+
 		declaration.clear();
 		cameraPositionData.reserve(numDataTotal);
 		for (uint32_t i = 0; i < numDataTotal; i++)
 		{
-			CameraPositionData data = CameraPositionData(rawData, cameraPosDataOffset + (i * 6));
+			CameraPositionData data(coords[i * 3 + 0], coords[i * 3 + 1], coords[i * 3 + 2]);
 
 			declaration += StringHelper::Sprintf("\t{ %6i, %6i, %6i },", data.x, data.y, data.z);
 			cameraPositionData.emplace_back(data);
@@ -405,9 +414,6 @@ CameraDataList::~CameraDataList()
 {
 }
 
-CameraPositionData::CameraPositionData(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+CameraPositionData::CameraPositionData(int16_t nX, int16_t nY, int16_t nZ) : x(nX), y(nY), z(nZ)
 {
-	x = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
-	y = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-	z = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
 }
@@ -13,7 +13,7 @@ class CameraPositionData
 public:
 	int16_t x, y, z;
 
-	CameraPositionData(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	CameraPositionData(int16_t nX, int16_t nY, int16_t nZ);
 };
 
 class CameraDataEntry
@@ -30,7 +30,7 @@ public:
 	std::vector<CameraDataEntry> entries;
 	std::vector<CameraPositionData> cameraPositionData;
 
-	CameraDataList(ZFile* parent, const std::string& prefix, const std::vector<uint8_t>& rawData,
+	CameraDataList(ZFile* parent, const std::string& prefix, ByteSpan rawData,
 	               offset_t rawDataIndex, offset_t upperCameraBoundary);
 	~CameraDataList();
 };
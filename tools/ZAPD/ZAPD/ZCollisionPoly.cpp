@@ -1,7 +1,7 @@
 #include "ZCollisionPoly.h"
 
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 
 REGISTER_ZFILENODE(CollisionPoly, ZCollisionPoly);
@@ -16,18 +16,18 @@ ZCollisionPoly::~ZCollisionPoly()
 
 void ZCollisionPoly::ParseRawData()
 {
-	const auto& rawData = parent->GetRawData();
-	type = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0);
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
+	type = view.ReadUInt16(0);
 
-	vtxA = BitConverter::ToUInt16BE(rawData, rawDataIndex + 2);
-	vtxB = BitConverter::ToUInt16BE(rawData, rawDataIndex + 4);
-	vtxC = BitConverter::ToUInt16BE(rawData, rawDataIndex + 6);
+	vtxA = view.ReadUInt16(2);
+	vtxB = view.ReadUInt16(4);
+	vtxC = view.ReadUInt16(6);
 
-	normX = BitConverter::ToUInt16BE(rawData, rawDataIndex + 8);
-	normY = BitConverter::ToUInt16BE(rawData, rawDataIndex + 10);
-	normZ = BitConverter::ToUInt16BE(rawData, rawDataIndex + 12);
+	normX = view.ReadUInt16(8);
+	normY = view.ReadUInt16(10);
+	normZ = view.ReadUInt16(12);
 
-	dist = BitConverter::ToUInt16BE(rawData, rawDataIndex + 14);
+	dist = view.ReadUInt16(14);
 }
 
 void ZCollisionPoly::DeclareReferences(const std::string& prefix)
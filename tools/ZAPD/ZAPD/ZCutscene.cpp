@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -24,15 +25,16 @@ std::string ZCutscene::GetBodySourceCode() const
 {
 	std::string output = "";
 
-	output += StringHelper::Sprintf("    CS_HEADER(%i, %i),\n", numCommands, endFrame);
+	StringHelper::AppendFormat(output, "    CS_HEADER(%i, %i),\n", numCommands, endFrame);
 
 	for (size_t i = 0; i < commands.size(); i++)
 	{
 		CutsceneCommand* cmd = commands[i];
-		output += "    " + cmd->GenerateSourceCode();
+		output += "    ";
+		cmd->GenerateSourceCode(output);
 	}
 
-	output += StringHelper::Sprintf("    CS_END_OF_SCRIPT(),");
+	output += "    CS_END_OF_SCRIPT(),";
 
 	return output;
 }
@@ -52,7 +54,7 @@ size_t ZCutscene::GetRawDataSize() const
 	}
 
 	// End
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 	{
 		size += 4;
 	}
@@ -92,7 +94,7 @@ void ZCutscene::ParseRawData()
 
 		CutsceneCommand* cmd = nullptr;
 
-		if (Globals::Instance->game == ZGame::MM_RETAIL)
+		if (parent->ctx->game == ZGame::MM_RETAIL)
 		{
 			cmd = GetCommandMM(id, currentPtr);
 		}
@@ -267,7 +269,8 @@ CutsceneCommand* ZCutscene::GetCommandOoT(uint32_t id, offset_t currentPtr) cons
 
 	default:
 		std::string errorHeader =
-			StringHelper::Sprintf("Warning: Invalid cutscene command ID: '0x%04X'", cmdID);
+			StringHelper::Sprintf("Warning: Invalid cutscene command ID: '0x%04X'",
+		                          static_cast<uint32_t>(cmdID));
 		return new CutsceneOoTCommand_GenericCmd(rawData, currentPtr, cmdID);
 	}
 
@@ -342,7 +345,8 @@ CutsceneCommand* ZCutscene::GetCommandMM(uint32_t id, offset_t currentPtr) const
 
 	default:
 		std::string errorHeader =
-			StringHelper::Sprintf("Warning: Invalid cutscene command ID: '0x%04X'", cmdID);
+			StringHelper::Sprintf("Warning: Invalid cutscene command ID: '0x%04X'",
+		                          static_cast<uint32_t>(cmdID));
 		return new CutsceneMMCommand_GenericCmd(rawData, currentPtr, cmdID);
 	}
 
@@ -6,11 +6,13 @@
 #include <cinttypes>
 #include <cmath>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "OutputFormatter.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/File.h"
 #include "Utils/Path.h"
+#include "Utils/Profiler.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 #include "gfxd.h"
@@ -27,7 +29,7 @@ ZDisplayList::ZDisplayList(ZFile* nParent) : ZResource(nParent)
 	lastTexSizTest = F3DZEXTexSizes::G_IM_SIZ_16b;
 	lastTexLoaded = false;
 	lastTexIsPalette = false;
-	dListType = Globals::Instance->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX;
+	dListType = parent->ctx->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX;
 	RegisterOptionalAttribute("Ucode");
 }
 
@@ -47,7 +49,7 @@ void ZDisplayList::ExtractWithXML(tinyxml2::XMLElement* reader, uint32_t nRawDat
 	// TODO add error handling here
 	bool ucodeSet = registeredAttributes.at("Ucode").wasSet;
 	std::string ucodeValue = registeredAttributes.at("Ucode").value;
-	if ((Globals::Instance->game == ZGame::OOT_SW97) || (ucodeValue == "f3dex"))
+	if ((parent->ctx->game == ZGame::OOT_SW97) || (ucodeValue == "f3dex"))
 	{
 		dListType = DListType::F3DEX;
 	}
@@ -68,6 +70,8 @@ void ZDisplayList::ExtractWithXML(tinyxml2::XMLElement* reader, uint32_t nRawDat
 		int32_t rawDataSize =
 			ZDisplayList::GetDListLength(parent->GetRawData(), rawDataIndex, dListType);
 		numInstructions = rawDataSize / 8;
+
+		ProfileScope scope("ParseRawData", GetResourceTypeName(GetResourceType()), name);
 		ParseRawData();
 	}
 
@@ -85,21 +89,14 @@ void ZDisplayList::ExtractFromBinary(uint32_t nRawDataIndex, int32_t rawDataSize
 	if (parent->GetMode() == ZFileMode::ExternalFile)
 		return;
 
+	ProfileScope scope("ParseRawData", GetResourceTypeName(GetResourceType()), name);
 	ParseRawData();
 }
 
 void ZDisplayList::ParseRawData()
 {
-	const auto& rawData = parent->GetRawData();
-	instructions.reserve(numInstructions);
-	uint32_t ptr = rawDataIndex;
-
-	instructions.reserve(numInstructions);
-	for (size_t i = 0; i < numInstructions; i++)
-	{
-		instructions.push_back(BitConverter::ToUInt64BE(rawData, ptr));
-		ptr += 8;
-	}
+	BEView view(parent->GetRawData(), rawDataIndex, numInstructions * 8);
+	instructions = view.ReadArray<uint64_t>(0, numInstructions);
 }
 
 Declaration* ZDisplayList::DeclareVar([[maybe_unused]] const std::string& prefix,
@@ -291,7 +288,7 @@ void ZDisplayList::ParseF3DZEX(F3DZEXOpcode opcode, uint64_t data, int32_t i,
 			sprintf(line, "gsSPBranchLessZraw(%sDlist0x%06X, 0x%02X, 0x%02X),", prefix.c_str(),
 			        h & 0x00FFFFFF, (a / 5) | (b / 2), z);
 
-			ZDisplayList* nList = new ZDisplayList(parent);
+			ZDisplayList* nList = new (parent) ZDisplayList(parent);
 			nList->ExtractFromBinary(
 				h & 0x00FFFFFF, GetDListLength(parent->GetRawData(), h & 0x00FFFFFF, dListType));
 			nList->SetName(nList->GetDefaultName(prefix));
@@ -441,8 +438,7 @@ void ZDisplayList::ParseF3DEX(F3DEXOpcode opcode, uint64_t data, const std::stri
 	}
 }
 
-int32_t ZDisplayList::GetDListLength(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex,
-                                     DListType dListType)
+int32_t ZDisplayList::GetDListLength(ByteSpan rawData, uint32_t rawDataIndex, DListType dListType)
 {
 	uint8_t endDLOpcode;
 	uint8_t branchListOpcode;
@@ -483,6 +479,11 @@ int32_t ZDisplayList::GetDListLength(const std::vector<uint8_t>& rawData, uint32
 	}
 }
 
+offset_t ZDisplayList::GetCommandPointerOffset() const
+{
+	return rawDataIndex + currentCommand * sizeof(uint64_t) + 4;
+}
+
 bool ZDisplayList::SequenceCheck(std::vector<F3DZEXOpcode> sequence, int32_t startIndex)
 {
 	bool success = true;
@@ -553,7 +554,8 @@ int32_t ZDisplayList::OptimizationCheck_LoadTextureBlock(int32_t startIndex, std
 
 			lastTexSeg = segmentNumber;
 
-			Globals::Instance->GetSegmentedPtrName(data & 0xFFFFFFFF, parent, "", texStr);
+			parent->ctx->GetSegmentedPtrName(data & 0xFFFFFFFF, parent, GetCommandPointerOffset(),
+			                                 "", texStr);
 		}
 
 		// gsDPSetTile
@@ -705,7 +707,7 @@ void ZDisplayList::Opcode_G_DL(uint64_t data, const std::string& prefix, char* l
 
 	if (pp != 0)
 	{
-		if (!Globals::Instance->HasSegment(segNum))
+		if (!parent->ctx->HasSegment(segNum))
 			sprintf(line, "gsSPBranchList(0x%08" PRIX64 "),", data & 0xFFFFFFFF);
 		else if (dListDecl != nullptr)
 			sprintf(line, "gsSPBranchList(%s),", dListDecl->declName.c_str());
@@ -715,7 +717,7 @@ void ZDisplayList::Opcode_G_DL(uint64_t data, const std::string& prefix, char* l
 	}
 	else
 	{
-		if (!Globals::Instance->HasSegment(segNum))
+		if (!parent->ctx->HasSegment(segNum))
 			sprintf(line, "gsSPDisplayList(0x%08" PRIX64 "),", data & 0xFFFFFFFF);
 		else if (dListDecl != nullptr)
 			sprintf(line, "gsSPDisplayList(%s),", dListDecl->declName.c_str());
@@ -726,7 +728,7 @@ void ZDisplayList::Opcode_G_DL(uint64_t data, const std::string& prefix, char* l
 
 	// if (segNum == 8 || segNum == 9 || segNum == 10 || segNum == 11 || segNum == 12 || segNum ==
 	// 13) // Used for runtime-generated display lists
-	if (!Globals::Instance->HasSegment(segNum))
+	if (!parent->ctx->HasSegment(segNum))
 	{
 		if (pp != 0)
 			sprintf(line, "gsSPBranchList(0x%08" PRIX64 "),", data & 0xFFFFFFFF);
@@ -735,7 +737,7 @@ void ZDisplayList::Opcode_G_DL(uint64_t data, const std::string& prefix, char* l
 	}
 	else
 	{
-		ZDisplayList* nList = new ZDisplayList(parent);
+		ZDisplayList* nList = new (parent) ZDisplayList(parent);
 		nList->ExtractFromBinary(GETSEGOFFSET(data), GetDListLength(parent->GetRawData(),
 		                                                            GETSEGOFFSET(data), dListType));
 		nList->SetName(nList->GetDefaultName(prefix));
@@ -804,9 +806,10 @@ void ZDisplayList::Opcode_G_MTX(uint64_t data, char* line)
 		pp = (data & 0x000000FF00000000) >> 32;
 
 	std::string matrixRef;
+	const char* matrixName = Globals::Instance->cfg.symbolMap.Find(mm);
 
-	if (Globals::Instance->cfg.symbolMap.find(mm) != Globals::Instance->cfg.symbolMap.end())
-		matrixRef = StringHelper::Sprintf("&%s", Globals::Instance->cfg.symbolMap[mm].c_str());
+	if (matrixName != nullptr)
+		matrixRef = StringHelper::Sprintf("&%s", matrixName);
 	else
 		matrixRef = StringHelper::Sprintf("0x%08X", mm);
 
@@ -847,15 +850,17 @@ void ZDisplayList::Opcode_G_VTX(uint64_t data, char* line)
 	}
 
 	// Hack: Don't extract vertices from a unknown segment.
-	if (!Globals::Instance->HasSegment(GETSEGNUM(data)))
+	if (!parent->ctx->HasSegment(GETSEGNUM(data)))
 	{
 		segptr_t segmented = data & 0xFFFFFFFF;
 		references.push_back(segmented);
+		referenceOffsets.push_back(GetCommandPointerOffset());
 		parent->AddDeclaration(segmented, DeclarationAlignment::Align8, 16, "Vtx",
 		                       StringHelper::Sprintf("0x%08X", segmented), "");
 		return;
 	}
 	references.push_back(data);
+	referenceOffsets.push_back(GetCommandPointerOffset());
 
 	{
 		uint32_t currentPtr = Seg2Filespace(data, parent->baseAddress);
@@ -885,19 +890,7 @@ void ZDisplayList::Opcode_G_VTX(uint64_t data, char* line)
 
 		if (nn > 0)
 		{
-			std::vector<ZVtx> vtxList;
-			vtxList.reserve(nn);
-
-			for (int32_t i = 0; i < nn; i++)
-			{
-				ZVtx vtx(parent);
-				vtx.ExtractFromFile(currentPtr);
-				vtxList.push_back(vtx);
-
-				currentPtr += 16;
-			}
-
-			vertices[vtxAddr] = vtxList;
+			vertices[vtxAddr] = ZVtx::ExtractArray(parent, currentPtr, nn);
 		}
 	}
 }
@@ -951,7 +944,7 @@ void ZDisplayList::Opcode_G_SETTIMG(uint64_t data, const std::string& prefix, ch
 
 		if (parent != nullptr)
 		{
-			if (Globals::Instance->HasSegment(segmentNumber))
+			if (parent->ctx->HasSegment(segmentNumber))
 				texDecl = parent->GetDeclaration(texAddress);
 			else
 				texDecl = parent->GetDeclaration(data);
@@ -959,7 +952,7 @@ void ZDisplayList::Opcode_G_SETTIMG(uint64_t data, const std::string& prefix, ch
 
 		if (texDecl != nullptr)
 			sprintf(texStr, "%s", texDecl->declName.c_str());
-		else if (data != 0 && Globals::Instance->HasSegment(segmentNumber))
+		else if (data != 0 && parent->ctx->HasSegment(segmentNumber))
 			sprintf(texStr, "%sTex_%06X", prefix.c_str(), texAddress);
 		else
 		{
@@ -972,7 +965,7 @@ void ZDisplayList::Opcode_G_SETTIMG(uint64_t data, const std::string& prefix, ch
 	else
 	{
 		std::string texName;
-		Globals::Instance->GetSegmentedPtrName(data, parent, "", texName);
+		parent->ctx->GetSegmentedPtrName(data, parent, GetCommandPointerOffset(), "", texName);
 		sprintf(line, "gsDPSetTextureImage(%s, %s, %i, %s),", fmtTbl[fmt], sizTbl[siz], www + 1,
 		        texName.c_str());
 	}
@@ -1547,6 +1540,9 @@ void ZDisplayList::Opcode_G_ENDDL([[maybe_unused]] const std::string& prefix, ch
 static int32_t GfxdCallback_FormatSingleEntry()
 {
 	ZDisplayList* self = static_cast<ZDisplayList*>(gfxd_udata_get());
+	// The commands of a macro are output together, and only the first one has a pointer
+	self->currentCommand = gfxd_macro_offset() / sizeof(uint64_t);
+
 	gfxd_puts("\t");
 	gfxd_macro_dflt();
 	gfxd_puts(",");
@@ -1630,18 +1626,7 @@ static int32_t GfxdCallback_Vtx(uint32_t seg, int32_t count)
 
 		if (count > 0)
 		{
-			std::vector<ZVtx> vtxList;
-			vtxList.reserve(count);
-
-			uint32_t currentPtr = vtxOffset;
-			for (int32_t i = 0; i < count; i++)
-			{
-				ZVtx vtx(self->parent);
-				vtx.ExtractFromFile(currentPtr);
-
-				vtxList.push_back(vtx);
-				currentPtr += 16;
-			}
+			std::vector<ZVtx> vtxList = ZVtx::ExtractArray(self->parent, vtxOffset, count);
 
 			bool keyAlreadyOccupied = self->vertices.find(vtxOffset) != self->vertices.end();
 
@@ -1649,11 +1634,12 @@ static int32_t GfxdCallback_Vtx(uint32_t seg, int32_t count)
 			// if the new one is bigger.
 			if (!keyAlreadyOccupied ||
 			    (keyAlreadyOccupied && vtxList.size() > self->vertices[vtxOffset].size()))
-				self->vertices[vtxOffset] = vtxList;
+				self->vertices[vtxOffset] = std::move(vtxList);
 		}
 	}
 
 	self->references.push_back(seg);
+	self->referenceOffsets.push_back(self->GetCommandPointerOffset());
 	gfxd_puts("@r");
 
 	return 1;
@@ -1677,7 +1663,8 @@ static int32_t GfxdCallback_Texture(segptr_t seg, int32_t fmt, int32_t siz, int3
 	self->TextureGenCheck();
 
 	std::string texName;
-	Globals::Instance->GetSegmentedPtrName(seg, self->parent, "", texName);
+	self->parent->ctx->GetSegmentedPtrName(seg, self->parent, self->GetCommandPointerOffset(), "",
+	                                       texName);
 
 	gfxd_puts(texName.c_str());
 
@@ -1701,7 +1688,8 @@ static int32_t GfxdCallback_Palette(uint32_t seg, [[maybe_unused]] int32_t idx,
 	self->TextureGenCheck();
 
 	std::string palName;
-	Globals::Instance->GetSegmentedPtrName(seg, self->parent, "", palName);
+	self->parent->ctx->GetSegmentedPtrName(seg, self->parent, self->GetCommandPointerOffset(), "",
+	                                       palName);
 
 	gfxd_puts(palName.c_str());
 
@@ -1715,14 +1703,14 @@ static int32_t GfxdCallback_DisplayList(uint32_t seg)
 	uint32_t dListSegNum = GETSEGNUM(seg);
 
 	std::string dListName = "";
-	bool addressFound =
-		Globals::Instance->GetSegmentedPtrName(seg, self->parent, "Gfx", dListName, false);
+	bool addressFound = self->parent->ctx->GetSegmentedPtrName(
+		seg, self->parent, self->GetCommandPointerOffset(), "Gfx", dListName, false);
 
 	if (!addressFound)
 	{
 		if (self->parent->segment == dListSegNum)
 		{
-			ZDisplayList* newDList = new ZDisplayList(self->parent);
+			ZDisplayList* newDList = new (self->parent) ZDisplayList(self->parent);
 			newDList->ExtractFromBinary(
 				dListOffset,
 				self->GetDListLength(self->parent->GetRawData(), dListOffset, self->dListType));
@@ -1732,7 +1720,7 @@ static int32_t GfxdCallback_DisplayList(uint32_t seg)
 		}
 		else
 		{
-			Globals::Instance->WarnHardcodedPointer(seg, self->parent, self,
+			ExtractionContext::WarnHardcodedPointer(seg, self->parent, self,
 			                                        self->GetRawDataIndex());
 		}
 	}
@@ -1747,8 +1735,8 @@ static int32_t GfxdCallback_Matrix(uint32_t seg)
 	std::string mtxName;
 	ZDisplayList* self = static_cast<ZDisplayList*>(gfxd_udata_get());
 
-	bool addressFound =
-		Globals::Instance->GetSegmentedPtrName(seg, self->parent, "Mtx", mtxName, false);
+	bool addressFound = self->parent->ctx->GetSegmentedPtrName(
+		seg, self->parent, self->GetCommandPointerOffset(), "Mtx", mtxName, false);
 
 	if (!addressFound)
 	{
@@ -1770,7 +1758,7 @@ static int32_t GfxdCallback_Matrix(uint32_t seg)
 		}
 		else
 		{
-			Globals::Instance->WarnHardcodedPointer(seg, self->parent, self,
+			ExtractionContext::WarnHardcodedPointer(seg, self->parent, self,
 			                                        self->GetRawDataIndex());
 		}
 	}
@@ -1787,33 +1775,15 @@ void ZDisplayList::DeclareReferences(const std::string& prefix)
 	if (Globals::Instance->useLegacyZDList)
 		sourceOutput += ProcessLegacy(prefix);
 	else
+	{
+		ProfileScope scope("ProcessGfxDis", "DisplayList", name);
 		sourceOutput += ProcessGfxDis(prefix);
+	}
 
 	// Iterate through our vertex lists, connect intersecting lists.
 	if (vertices.size() > 0)
 	{
-		std::vector<std::pair<uint32_t, std::vector<ZVtx>>> verticesSorted(vertices.begin(),
-		                                                                   vertices.end());
-
-		for (size_t i = 0; i < verticesSorted.size() - 1; i++)
-		{
-			size_t vtxSize = vertices[verticesSorted[i].first].size() * 16;
-
-			if ((verticesSorted[i].first + vtxSize) > verticesSorted[i + 1].first)
-			{
-				int32_t intersectAmt =
-					(verticesSorted[i].first + vtxSize) - verticesSorted[i + 1].first;
-				int32_t intersectIndex = intersectAmt / 16;
-
-				for (size_t j = intersectIndex; j < verticesSorted[i + 1].second.size(); j++)
-					vertices[verticesSorted[i].first].push_back(verticesSorted[i + 1].second[j]);
-
-				vertices.erase(verticesSorted[i + 1].first);
-				verticesSorted.erase(verticesSorted.begin() + i + 1);
-
-				i--;
-			}
-		}
+		MergeVertexLists(false);
 
 		// Generate Vertex Declarations
 		for (auto& item : vertices)
@@ -1823,7 +1793,7 @@ void ZDisplayList::DeclareReferences(const std::string& prefix)
 			offset_t curAddr = item.first;
 			auto& firstVtx = item.second.at(0);
 
-			for (auto vtx : item.second)
+			for (const auto& vtx : item.second)
 				declaration += StringHelper::Sprintf("\t%s,\n", vtx.GetBodySourceCode().c_str());
 
 			Declaration* decl = parent->AddDeclarationArray(
@@ -1835,34 +1805,13 @@ void ZDisplayList::DeclareReferences(const std::string& prefix)
 	}
 
 	Declaration* decl = DeclareVar("", sourceOutput);
-	decl->references = references;
+	decl->references.assign(references.begin(), references.end());
+	decl->referenceOffsets.assign(referenceOffsets.begin(), referenceOffsets.end());
 
 	// Iterate through our vertex lists, connect intersecting lists.
 	if (vertices.size() > 0)
 	{
-		std::vector<std::pair<uint32_t, std::vector<ZVtx>>> verticesSorted(vertices.begin(),
-		                                                                   vertices.end());
-
-		for (size_t i = 0; i < verticesSorted.size() - 1; i++)
-		{
-			// int32_t vtxSize = verticesSorted[i].second.size() * 16;
-			size_t vtxSize = vertices[verticesSorted[i].first].size() * 16;
-
-			if ((verticesSorted[i].first + vtxSize) > verticesSorted[i + 1].first)
-			{
-				int32_t intersectAmt =
-					(verticesSorted[i].first + vtxSize) - verticesSorted[i + 1].first;
-				int32_t intersectIndex = intersectAmt / 16;
-
-				for (size_t j = intersectIndex; j < verticesSorted[i + 1].second.size(); j++)
-					vertices[verticesSorted[i].first].push_back(verticesSorted[i + 1].second[j]);
-
-				vertices.erase(verticesSorted[i + 1].first);
-				verticesSorted.erase(verticesSorted.begin() + i + 1);
-
-				i--;
-			}
-		}
+		MergeVertexLists(false);
 
 		// Generate Vertex Declarations
 		std::vector<int32_t> vtxKeys;
@@ -1895,7 +1844,7 @@ void ZDisplayList::DeclareReferences(const std::string& prefix)
 				else
 					vtxName = StringHelper::Sprintf("%sVtx_%06X", prefix.c_str(), vtxKeys[i]);
 
-				auto filepath = Globals::Instance->outputPath / vtxName;
+				auto filepath = parent->ctx->outputPath / vtxName;
 				std::string incStr =
 					StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(), "vtx");
 
@@ -1917,6 +1866,7 @@ std::string ZDisplayList::ProcessLegacy(const std::string& prefix)
 		uint8_t opcode = (uint8_t)(instructions[i] >> 56);
 		uint64_t data = instructions[i];
 		sourceOutput += "    ";
+		currentCommand = i;
 
 		auto start = std::chrono::steady_clock::now();
 
@@ -1988,35 +1938,33 @@ std::string ZDisplayList::ProcessGfxDis([[maybe_unused]] const std::string& pref
 
 void ZDisplayList::MergeConnectingVertexLists()
 {
-	if (vertices.size() > 0)
-	{
-		std::vector<std::pair<uint32_t, std::vector<ZVtx>>> vertexKeys(vertices.begin(),
-		                                                               vertices.end());
-		std::pair<uint32_t, std::vector<ZVtx>> lastItem = vertexKeys.at(0);
-
-		for (size_t i = 1; i < vertexKeys.size(); i++)
-		{
-			std::pair<uint32_t, std::vector<ZVtx>> curItem = vertexKeys[i];
-
-			size_t lastItemEnd = lastItem.first + (lastItem.second.size() * 16);
-			bool lastItemIntersects = lastItemEnd >= curItem.first;
+	MergeVertexLists(true);
+}
 
-			if (lastItemIntersects)
-			{
-				int intersectedVtxStart = (lastItemEnd - curItem.first) / 16;
+void ZDisplayList::MergeVertexLists(bool mergeAdjacent)
+{
+	if (vertices.empty())
+		return;
 
-				for (size_t j = intersectedVtxStart; j < curItem.second.size(); j++)
-					vertices[lastItem.first].push_back(curItem.second[j]);
+	auto last = vertices.begin();
+	for (auto cur = std::next(last); cur != vertices.end();)
+	{
+		size_t lastEnd = last->first + last->second.size() * 16;
+		bool intersects = mergeAdjacent ? lastEnd >= cur->first : lastEnd > cur->first;
 
-				vertices.erase(curItem.first);
-				vertexKeys.erase(vertexKeys.begin() + i);
+		if (intersects)
+		{
+			size_t intersectIndex = (lastEnd - cur->first) / 16;
 
-				lastItem.second = vertices[lastItem.first];
+			for (size_t j = intersectIndex; j < cur->second.size(); j++)
+				last->second.push_back(std::move(cur->second[j]));
 
-				i--;
-			}
-			else
-				lastItem = curItem;
+			cur = vertices.erase(cur);
+		}
+		else
+		{
+			last = cur;
+			++cur;
 		}
 	}
 }
@@ -2048,7 +1996,7 @@ bool ZDisplayList::TextureGenCheck(int32_t texWidth, int32_t texHeight, uint32_t
 		       texWidth, texHeight, texIsPalette, texAddr);
 
 	if ((texSeg != 0 || texAddr != 0) && texWidth > 0 && texHeight > 0 && texLoaded &&
-	    Globals::Instance->HasSegment(segmentNumber))
+	    self->parent->ctx->HasSegment(segmentNumber))
 	{
 		ZFile* auxParent = nullptr;
 		if (segmentNumber == self->parent->segment)
@@ -2059,7 +2007,7 @@ bool ZDisplayList::TextureGenCheck(int32_t texWidth, int32_t texHeight, uint32_t
 		{
 			// Try to find a non-external file (i.e., one we are actually extracting)
 			// which has the same segment number we are looking for.
-			for (auto& otherFile : Globals::Instance->cfg.segmentRefFiles[segmentNumber])
+			for (auto& otherFile : self->parent->ctx->segmentRefFiles.at(segmentNumber))
 			{
 				if (!otherFile->isExternalFile)
 				{
@@ -2081,7 +2029,7 @@ bool ZDisplayList::TextureGenCheck(int32_t texWidth, int32_t texHeight, uint32_t
 				tex->isPalette = texIsPalette;
 			else
 			{
-				tex = new ZTexture(auxParent);
+				tex = new (auxParent) ZTexture(auxParent);
 				tex->ExtractFromBinary(texAddr, texWidth, texHeight,
 				                       TexFormatToTexType(texFmt, texSiz), texIsPalette);
 				auxParent->AddTextureResource(texAddr, tex);
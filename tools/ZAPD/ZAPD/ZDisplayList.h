@@ -341,8 +341,12 @@ public:
 	ZTexture* lastTlut = nullptr;
 
 	std::vector<segptr_t> references;
+	std::vector<offset_t> referenceOffsets;
 	std::vector<ZMtx> mtxList;
 
+	// The command whose source is being generated
+	size_t currentCommand = 0;
+
 	ZDisplayList(ZFile* nParent);
 	~ZDisplayList();
 
@@ -358,8 +362,9 @@ public:
 	static bool TextureGenCheck(int32_t texWidth, int32_t texHeight, uint32_t texAddr,
 	                            uint32_t texSeg, F3DZEXTexFormats texFmt, F3DZEXTexSizes texSiz,
 	                            bool texLoaded, bool texIsPalette, ZDisplayList* self);
-	static int32_t GetDListLength(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex,
-	                              DListType dListType);
+	static int32_t GetDListLength(ByteSpan rawData, uint32_t rawDataIndex, DListType dListType);
+	// The offset in the file of the pointer of `currentCommand`, which is always its second word
+	offset_t GetCommandPointerOffset() const;
 
 	size_t GetRawDataSize() const override;
 	DeclarationAlignment GetDeclarationAlignment() const override;
@@ -369,6 +374,9 @@ public:
 
 	// Combines vertex lists from the vertices map which touch or intersect
 	void MergeConnectingVertexLists();
+	// Appends each vertex list to the previous one if they intersect, or also if they just touch
+	// when `mergeAdjacent` is set. The merged vertices are moved, not copied.
+	void MergeVertexLists(bool mergeAdjacent);
 
 	bool IsExternalResource() const override;
 	std::string GetExternalExtension() const override;
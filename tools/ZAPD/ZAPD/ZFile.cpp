@@ -5,6 +5,8 @@
 #include <string_view>
 #include <unordered_set>
 
+#include "ElfObject.h"
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "OutputFormatter.h"
 #include "Utils/BinaryWriter.h"
@@ -12,7 +14,9 @@
 #include "Utils/Directory.h"
 #include "Utils/File.h"
 #include "Utils/MemoryStream.h"
+#include "Utils/NumericEmitter.h"
 #include "Utils/Path.h"
+#include "Utils/Profiler.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 #include "ZAnimation.h"
@@ -36,7 +40,6 @@ ZFile::ZFile()
 {
 	resources = std::vector<ZResource*>();
 	basePath = "";
-	declarations = std::map<uint32_t, Declaration*>();
 	defines = "";
 	baseAddress = 0;
 	rangeStart = 0x000000000;
@@ -50,10 +53,12 @@ ZFile::ZFile(const fs::path& nOutPath, const std::string& nName) : ZFile()
 	outputPath = nOutPath;
 }
 
-ZFile::ZFile(ZFileMode nMode, tinyxml2::XMLElement* reader, const fs::path& nBasePath,
-             const fs::path& nOutPath, const std::string& filename, const fs::path& nXmlFilePath)
+ZFile::ZFile(ExtractionContext* nCtx, ZFileMode nMode, tinyxml2::XMLElement* reader,
+             const fs::path& nBasePath, const fs::path& nOutPath, const std::string& filename,
+             const fs::path& nXmlFilePath)
 	: ZFile()
 {
+	ctx = nCtx;
 	xmlFilePath = nXmlFilePath;
 	if (nBasePath == "")
 		basePath = Directory::GetCurrentDirectory();
@@ -74,12 +79,11 @@ ZFile::ZFile(ZFileMode nMode, tinyxml2::XMLElement* reader, const fs::path& nBas
 
 ZFile::~ZFile()
 {
+	// The declarations are released with the arena, like everything they hold. The resources
+	// still own memory of the heap, so they are destroyed one by one.
 	for (ZResource* res : resources)
 		delete res;
 
-	for (auto d : declarations)
-		delete d.second;
-
 	for (auto sym : symbolResources)
 		delete sym.second;
 }
@@ -93,22 +97,23 @@ void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 	else
 		name = filename;
 
+	ProfileScope scope("ParseXML", nullptr, name);
+
 	outName = name;
 	const char* outNameXml = reader->Attribute("OutName");
 	if (outNameXml != nullptr)
 		outName = outNameXml;
 
-	// TODO: This should be a variable on the ZFile, but it is a large change in order to force all
-	// ZResource types to have a parent ZFile.
+	// The game is shared by every file of the job, so it is stored in the context.
 	const char* gameStr = reader->Attribute("Game");
 	if (reader->Attribute("Game") != nullptr)
 	{
 		if (std::string_view(gameStr) == "MM")
-			Globals::Instance->game = ZGame::MM_RETAIL;
+			ctx->game = ZGame::MM_RETAIL;
 		else if (std::string_view(gameStr) == "SW97" || std::string_view(gameStr) == "OOTSW97")
-			Globals::Instance->game = ZGame::OOT_SW97;
+			ctx->game = ZGame::OOT_SW97;
 		else if (std::string_view(gameStr) == "OOT")
-			Globals::Instance->game = ZGame::OOT_RETAIL;
+			ctx->game = ZGame::OOT_RETAIL;
 		else
 		{
 			std::string errorHeader =
@@ -120,8 +125,8 @@ void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 	if (reader->Attribute("BaseAddress") != nullptr)
 		baseAddress = StringHelper::StrToL(reader->Attribute("BaseAddress"), 16);
 
-	if (mode == ZFileMode::Extract && Globals::Instance->baseAddress != -1)
-		baseAddress = Globals::Instance->baseAddress;
+	if (mode == ZFileMode::Extract && ctx->baseAddress != -1)
+		baseAddress = ctx->baseAddress;
 
 	if (reader->Attribute("RangeStart") != nullptr)
 		rangeStart = StringHelper::StrToL(reader->Attribute("RangeStart"), 16);
@@ -170,7 +175,7 @@ void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 			}
 		}
 	}
-	Globals::Instance->AddSegment(segment, this);
+	ctx->AddSegment(segment, this);
 
 	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
 	{
@@ -192,17 +197,7 @@ void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 
 	if (mode == ZFileMode::Extract || mode == ZFileMode::ExternalFile)
 	{
-		if (!File::Exists((basePath / name).string()))
-		{
-			std::string errorHeader = StringHelper::Sprintf("binary file '%s' does not exist.",
-			                                                (basePath / name).c_str());
-			HANDLE_ERROR_PROCESS(WarningType::Always, errorHeader, "");
-		}
-
-		rawData = File::ReadAllBytes((basePath / name).string());
-		if (mode == ZFileMode::Extract && Globals::Instance->startOffset != -1 && Globals::Instance->endOffset != -1)
-			rawData = std::vector<uint8_t>(rawData.begin() + Globals::Instance->startOffset,
-			                               rawData.begin() + Globals::Instance->endOffset);
+		OpenRawData();
 
 		if (reader->Attribute("RangeEnd") == nullptr)
 			rangeEnd = rawData.size();
@@ -311,11 +306,32 @@ void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 	}
 }
 
+void ZFile::OpenRawData()
+{
+	if (!File::Exists((basePath / name).string()))
+	{
+		std::string errorHeader = StringHelper::Sprintf("binary file '%s' does not exist.",
+		                                                (basePath / name).c_str());
+		HANDLE_ERROR_PROCESS(WarningType::Always, errorHeader, "");
+	}
+
+	// Mapping the file only reads the parts which are used, which for external files is
+	// usually very little of it
+	rawDataFile = std::make_unique<MappedFile>(basePath / name);
+	rawData = rawDataFile->GetData();
+	ctx->AddInputFile(basePath / name);
+	if (mode == ZFileMode::Extract && ctx->startOffset != -1 && ctx->endOffset != -1)
+		rawData = rawData.subspan(ctx->startOffset, ctx->endOffset - ctx->startOffset);
+}
+
 void ZFile::DeclareResourceSubReferences()
 {
 	for (size_t i = 0; i < resources.size(); i++)
 	{
-		resources.at(i)->DeclareReferences(name);
+		ZResource* res = resources.at(i);
+		ProfileScope scope("DeclareReferences",
+		                   ZResource::GetResourceTypeName(res->GetResourceType()), res->GetName());
+		res->DeclareReferences(name);
 	}
 }
 
@@ -330,6 +346,11 @@ void ZFile::BuildSourceFile()
 	GenerateSourceFiles();
 }
 
+std::pmr::memory_resource* ZFile::GetMemoryResource()
+{
+	return &arena;
+}
+
 std::string ZFile::GetName() const
 {
 	return name;
@@ -350,7 +371,7 @@ const fs::path& ZFile::GetXmlFilePath() const
 	return xmlFilePath;
 }
 
-const std::vector<uint8_t>& ZFile::GetRawData() const
+const ByteSpan& ZFile::GetRawData() const
 {
 	return rawData;
 }
@@ -366,12 +387,20 @@ void ZFile::ExtractResources()
 	if (!Directory::Exists(GetSourceOutputFolderPath()))
 		Directory::CreateDirectory(GetSourceOutputFolderPath().string());
 
-	for (size_t i = 0; i < resources.size(); i++)
-		resources[i]->ParseRawDataLate();
-	for (size_t i = 0; i < resources.size(); i++)
-		resources[i]->DeclareReferencesLate(name);
+	for (ZResource* res : resources)
+	{
+		ProfileScope scope("ParseRawDataLate",
+		                   ZResource::GetResourceTypeName(res->GetResourceType()), res->GetName());
+		res->ParseRawDataLate();
+	}
+	for (ZResource* res : resources)
+	{
+		ProfileScope scope("DeclareReferencesLate",
+		                   ZResource::GetResourceTypeName(res->GetResourceType()), res->GetName());
+		res->DeclareReferencesLate(name);
+	}
 
-	if (Globals::Instance->genSourceFile)
+	if (ctx->genSourceFile)
 		GenerateSourceFiles();
 
 	auto memStreamFile = std::shared_ptr<MemoryStream>(new MemoryStream());
@@ -390,14 +419,16 @@ void ZFile::ExtractResources()
 		if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
 			printf("Saving resource %s\n", res->GetName().c_str());
 
+		ProfileScope scope("Save", ZResource::GetResourceTypeName(res->GetResourceType()),
+		                   res->GetName());
 		res->Save(outputPath);
 
 		// Check if we have an exporter "registered" for this resource type
 		ZResourceExporter* exporter = Globals::Instance->GetExporter(res->GetResourceType());
 		if (exporter != nullptr)
 		{
-			// exporter->Save(res, Globals::Instance->outputPath.string(), &writerFile);
-			exporter->Save(res, Globals::Instance->outputPath.string(), &writerRes);
+			// exporter->Save(res, ctx->outputPath.string(), &writerFile);
+			exporter->Save(res, ctx->outputPath.string(), &writerRes);
 		}
 
 		if (exporterSet != nullptr && exporterSet->resSaveFunc != nullptr)
@@ -406,10 +437,10 @@ void ZFile::ExtractResources()
 
 	if (memStreamFile->GetLength() > 0)
 	{
-		File::WriteAllBytes(StringHelper::Sprintf("%s%s.bin",
-		                                          Globals::Instance->outputPath.string().c_str(),
-		                                          GetName().c_str()),
-		                    memStreamFile->ToVector());
+		std::string binPath =
+			StringHelper::Sprintf("%s%s.bin", ctx->outputPath.string().c_str(), GetName().c_str());
+		bool written = File::WriteAllBytesIfChanged(binPath, memStreamFile->ToVector());
+		ctx->AddOutputFile(binPath, written);
 	}
 
 	writerFile.Close();
@@ -459,7 +490,8 @@ Declaration* ZFile::AddDeclaration(offset_t address, DeclarationAlignment alignm
 	Declaration* decl = GetDeclaration(address);
 	if (decl == nullptr)
 	{
-		decl = Declaration::Create(address, alignment, size, varType, varName, body);
+		decl = Declaration::Create(&arena, address, alignment, size, varType, varName, body);
+		decl->forceStatic = ctx->forceStatic;
 		declarations[address] = decl;
 	}
 	else
@@ -471,6 +503,7 @@ Declaration* ZFile::AddDeclaration(offset_t address, DeclarationAlignment alignm
 		decl->declBody = body;
 	}
 
+	declarationsIndex.Set(decl, address, decl->size);
 	return decl;
 }
 
@@ -486,8 +519,9 @@ Declaration* ZFile::AddDeclarationArray(offset_t address, DeclarationAlignment a
 	Declaration* decl = GetDeclaration(address);
 	if (decl == nullptr)
 	{
-		decl = Declaration::CreateArray(address, alignment, size, varType, varName, body,
+		decl = Declaration::CreateArray(&arena, address, alignment, size, varType, varName, body,
 		                                arrayItemCnt);
+		decl->forceStatic = ctx->forceStatic;
 
 		declarations[address] = decl;
 	}
@@ -504,6 +538,7 @@ Declaration* ZFile::AddDeclarationArray(offset_t address, DeclarationAlignment a
 		decl->declBody = body;
 	}
 
+	declarationsIndex.Set(decl, address, decl->size);
 	return decl;
 }
 
@@ -519,8 +554,9 @@ Declaration* ZFile::AddDeclarationArray(offset_t address, DeclarationAlignment a
 	Declaration* decl = GetDeclaration(address);
 	if (decl == nullptr)
 	{
-		decl = Declaration::CreateArray(address, alignment, size, varType, varName, body,
+		decl = Declaration::CreateArray(&arena, address, alignment, size, varType, varName, body,
 		                                arrayItemCntStr);
+		decl->forceStatic = ctx->forceStatic;
 
 		declarations[address] = decl;
 	}
@@ -534,6 +570,8 @@ Declaration* ZFile::AddDeclarationArray(offset_t address, DeclarationAlignment a
 		decl->arrayItemCntStr = arrayItemCntStr;
 		decl->declBody = body;
 	}
+
+	declarationsIndex.Set(decl, address, decl->size);
 	return decl;
 }
 
@@ -546,7 +584,8 @@ Declaration* ZFile::AddDeclarationPlaceholder(offset_t address, const std::strin
 	Declaration* decl;
 	if (declarations.find(address) == declarations.end())
 	{
-		decl = Declaration::CreatePlaceholder(address, varName);
+		decl = Declaration::CreatePlaceholder(&arena, address, varName);
+		decl->forceStatic = ctx->forceStatic;
 		declarations[address] = decl;
 	}
 	else
@@ -566,7 +605,8 @@ Declaration* ZFile::AddDeclarationInclude(offset_t address, const std::string& i
 	Declaration* decl = GetDeclaration(address);
 	if (decl == nullptr)
 	{
-		decl = Declaration::CreateInclude(address, includePath, size, varType, varName);
+		decl = Declaration::CreateInclude(&arena, address, includePath, size, varType, varName);
+		decl->forceStatic = ctx->forceStatic;
 		declarations[address] = decl;
 	}
 	else
@@ -576,6 +616,8 @@ Declaration* ZFile::AddDeclarationInclude(offset_t address, const std::string& i
 		decl->declType = varType;
 		decl->declName = varName;
 	}
+
+	declarationsIndex.Set(decl, address, decl->size);
 	return decl;
 }
 
@@ -601,7 +643,8 @@ Declaration* ZFile::AddDeclarationIncludeArray(offset_t address, std::string& in
 	Declaration* decl = GetDeclaration(address);
 	if (decl == nullptr)
 	{
-		decl = Declaration::CreateInclude(address, includePath, size, varType, varName);
+		decl = Declaration::CreateInclude(&arena, address, includePath, size, varType, varName);
+		decl->forceStatic = ctx->forceStatic;
 
 		decl->isArray = true;
 		decl->arrayItemCnt = arrayItemCnt;
@@ -617,6 +660,8 @@ Declaration* ZFile::AddDeclarationIncludeArray(offset_t address, std::string& in
 		decl->isArray = true;
 		decl->arrayItemCnt = arrayItemCnt;
 	}
+
+	declarationsIndex.Set(decl, address, decl->size);
 	return decl;
 }
 
@@ -643,7 +688,9 @@ Declaration* ZFile::AddDeclarationIncludeArray(offset_t address, std::string& in
 	Declaration* decl = GetDeclaration(address);
 	if (decl == nullptr)
 	{
-		decl = Declaration::CreateInclude(address, includePath, size, varType, varName, defines);
+		decl = Declaration::CreateInclude(&arena, address, includePath, size, varType, varName,
+		                                  defines);
+		decl->forceStatic = ctx->forceStatic;
 
 		decl->isArray = true;
 		decl->arrayItemCnt = arrayItemCnt;
@@ -660,6 +707,8 @@ Declaration* ZFile::AddDeclarationIncludeArray(offset_t address, std::string& in
 		decl->isArray = true;
 		decl->arrayItemCnt = arrayItemCnt;
 	}
+
+	declarationsIndex.Set(decl, address, decl->size);
 	return decl;
 }
 
@@ -707,7 +756,8 @@ bool ZFile::GetDeclarationPtrName(segptr_t segAddress, const std::string& expect
 
 	if (expectedType != "" && expectedType != "void*")
 	{
-		if (expectedType != decl->declType && "static " + expectedType != decl->declType)
+		std::string_view declType = decl->declType;
+		if (expectedType != declType && "static " + expectedType != declType)
 		{
 			declName = StringHelper::Sprintf("0x%08X", segAddress);
 			return false;
@@ -741,7 +791,8 @@ bool ZFile::GetDeclarationArrayIndexedName(segptr_t segAddress, size_t elementSi
 
 	if (expectedType != "" && expectedType != "void*")
 	{
-		if (expectedType != decl->declType && "static " + expectedType != decl->declType)
+		std::string_view declType = decl->declType;
+		if (expectedType != declType && "static " + expectedType != declType)
 		{
 			declName = StringHelper::Sprintf("0x%08X", segAddress);
 			return false;
@@ -767,21 +818,16 @@ bool ZFile::GetDeclarationArrayIndexedName(segptr_t segAddress, size_t elementSi
 
 Declaration* ZFile::GetDeclaration(offset_t address) const
 {
-	if (declarations.find(address) != declarations.end())
-		return declarations.at(address);
+	auto decl = declarations.find(address);
+	if (decl != declarations.end())
+		return decl->second;
 
 	return nullptr;
 }
 
 Declaration* ZFile::GetDeclarationRanged(offset_t address) const
 {
-	for (const auto decl : declarations)
-	{
-		if (address >= decl.first && address < decl.first + decl.second->size)
-			return decl.second;
-	}
-
-	return nullptr;
+	return declarationsIndex.Find(address);
 }
 
 bool ZFile::HasDeclaration(offset_t address)
@@ -806,6 +852,7 @@ size_t ZFile::GetDeclarationSizeFromNeighbor(uint32_t declarationAddress)
 
 void ZFile::GenerateSourceFiles()
 {
+	ProfileScope scope("GenerateSourceFiles", nullptr, name);
 	std::string sourceOutput;
 
 	sourceOutput += "#include \"ultra64.h\"\n";
@@ -838,27 +885,56 @@ void ZFile::GenerateSourceFiles()
 	for (size_t i = 0; i < resources.size(); i++)
 	{
 		ZResource* res = resources.at(i);
+		ProfileScope resScope("GetSourceOutputCode",
+		                      ZResource::GetResourceTypeName(res->GetResourceType()),
+		                      res->GetName());
 		res->GetSourceOutputCode(name);
 	}
 
-	sourceOutput += ProcessDeclarations();
-
 	fs::path outPath = GetSourceOutputFolderPath() / outName.stem().concat(".c");
 
 	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
 		printf("Writing C file: %s\n", outPath.c_str());
 
-	OutputFormatter formatter;
+	// The declarations are formatted and written as they are generated, instead of building the
+	// whole file in memory first
+	OutputFormatter formatter(outPath);
 	formatter.Write(sourceOutput);
+	ProcessDeclarations(formatter);
+
+	if (!formatter.Close())
+	{
+		HANDLE_ERROR_PROCESS(WarningType::Always,
+		                     StringHelper::Sprintf("could not write '%s'", outPath.c_str()), "");
+	}
+	bool sourceChanged = formatter.HasChanged();
 
-	File::WriteAllText(outPath, formatter.GetOutput());
+	if (Globals::Instance->emitObjects)
+	{
+		fs::path objectPath = fs::path(outPath).replace_extension(".o");
+		bool hadObject = File::Exists(objectPath);
+
+		// Without an object, the C file is compiled instead. If the object of a previous
+		// extraction was removed, the C file must be newer than what was built from that object.
+		if (!GenerateObjectFile(objectPath) && hadObject && !sourceChanged)
+		{
+			File::Touch(outPath);
+			sourceChanged = true;
+		}
+	}
+	ctx->AddOutputFile(outPath, sourceChanged);
 
 	GenerateSourceHeaderFiles();
 }
 
 void ZFile::GenerateSourceHeaderFiles()
 {
-	OutputFormatter formatter;
+	fs::path headerFilename = GetSourceOutputFolderPath() / outName.stem().concat(".h");
+
+	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+		printf("Writing H file: %s\n", headerFilename.c_str());
+
+	OutputFormatter formatter(headerFilename);
 
 	std::string guard = StringHelper::ToUpper(outName.stem().string());
 
@@ -879,16 +955,17 @@ void ZFile::GenerateSourceHeaderFiles()
 		formatter.Write(sym.second->GetSourceOutputHeader(""));
 	}
 
-	formatter.Write(ProcessExterns());
+	ProcessExterns(formatter);
 
 	formatter.Write("#endif\n");
 
-	fs::path headerFilename = GetSourceOutputFolderPath() / outName.stem().concat(".h");
-
-	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
-		printf("Writing H file: %s\n", headerFilename.c_str());
-
-	File::WriteAllText(headerFilename, formatter.GetOutput());
+	if (!formatter.Close())
+	{
+		HANDLE_ERROR_PROCESS(
+			WarningType::Always,
+			StringHelper::Sprintf("could not write '%s'", headerFilename.c_str()), "");
+	}
+	ctx->AddOutputFile(headerFilename, formatter.HasChanged());
 }
 
 std::string ZFile::GetHeaderInclude() const
@@ -913,7 +990,7 @@ std::string ZFile::GetExternalFileHeaderInclude() const
 {
 	std::string externalFilesIncludes = "";
 
-	for (ZFile* externalFile : Globals::Instance->files)
+	for (ZFile* externalFile : ctx->files)
 	{
 		if (externalFile != this)
 		{
@@ -923,8 +1000,8 @@ std::string ZFile::GetExternalFileHeaderInclude() const
 			else
 				outputFolderPath /= externalFile->outName.stem();
 
-			externalFilesIncludes +=
-				StringHelper::Sprintf("#include \"%s.h\"\n", outputFolderPath.string().c_str());
+			StringHelper::AppendFormat(externalFilesIncludes, "#include \"%s.h\"\n",
+			                           outputFolderPath.string().c_str());
 		}
 	}
 
@@ -970,7 +1047,15 @@ ZTexture* ZFile::GetTextureResource(uint32_t offset) const
 
 void ZFile::AddSymbolResource(uint32_t offset, ZSymbol* sym)
 {
+	// A symbol replaced by another one mustn't be found by range anymore either
+	auto previous = symbolResources.find(offset);
+	if (previous != symbolResources.end() && previous->second != sym)
+		symbolResourcesIndex.Remove(previous->second);
+
 	symbolResources[offset] = sym;
+	symbolResourcesIndex.Set(sym, offset, sym->GetRawDataSize());
+	if (ctx != nullptr)
+		ctx->InvalidateSegmentedAddresses();
 }
 
 ZSymbol* ZFile::GetSymbolResource(uint32_t offset) const
@@ -984,13 +1069,12 @@ ZSymbol* ZFile::GetSymbolResource(uint32_t offset) const
 
 ZSymbol* ZFile::GetSymbolResourceRanged(uint32_t offset) const
 {
-	for (const auto decl : symbolResources)
-	{
-		if (offset >= decl.first && offset < decl.first + decl.second->GetRawDataSize())
-			return decl.second;
-	}
+	return symbolResourcesIndex.Find(offset);
+}
 
-	return nullptr;
+const std::map<uint32_t, ZSymbol*>& ZFile::GetSymbolResources() const
+{
+	return symbolResources;
 }
 
 fs::path ZFile::GetSourceOutputFolderPath() const
@@ -1028,12 +1112,12 @@ void ZFile::RegisterNode(std::string nodeName, ZResourceFactoryFunc* nodeFunc)
 	(*nodeMap)[nodeName] = nodeFunc;
 }
 
-std::string ZFile::ProcessDeclarations()
+void ZFile::ProcessDeclarations(OutputFormatter& output)
 {
-	std::string output;
+	ProfileScope scope("ProcessDeclarations", nullptr, name);
 
 	if (declarations.size() == 0)
-		return output;
+		return;
 
 	defines += ProcessTextureIntersections(name);
 
@@ -1056,18 +1140,30 @@ std::string ZFile::ProcessDeclarations()
 	// First, handle the prototypes (static only for now)
 	for (std::pair<uint32_t, Declaration*> item : declarations)
 	{
-		output += item.second->GetStaticForwardDeclarationStr();
+		output.Write(item.second->GetStaticForwardDeclarationStr());
 	}
 
-	output += "\n";
+	output.Write("\n");
 
 	// Next, output the actual declarations
+	// Where the data section of the compiled file starts, and where the data written so far ends
+	offset_t dataStart = 0;
+	offset_t lastDataEnd = 0;
+	bool hasData = false;
+
 	for (const auto& item : declarations)
 	{
 		if (!IsOffsetInFileRange(item.first))
 			continue;
 
-		if (item.second->includePath != "")
+		if (!hasData)
+			dataStart = lastDataEnd = item.first;
+
+		if (CanUseIncbin(item.second, item.first - dataStart, lastDataEnd))
+		{
+			output.Write(item.second->GetIncbinDeclarationStr());
+		}
+		else if (item.second->includePath != "")
 		{
 			if (item.second->isExternal)
 			{
@@ -1080,20 +1176,194 @@ std::string ZFile::ProcessDeclarations()
 					extType = "vtx";
 
 				auto filepath = outputPath / item.second->declName;
-				File::WriteAllText(
-					StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(), extType.c_str()),
-					item.second->declBody);
+				std::string incPath =
+					StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(), extType.c_str());
+				bool written = File::WriteAllTextIfChanged(incPath, item.second->declBody);
+				ctx->AddOutputFile(incPath, written);
 			}
 
-			output += item.second->GetExternalDeclarationStr();
+			output.Write(item.second->GetExternalDeclarationStr());
 		}
 		else if (item.second->declType != "")
 		{
-			output += item.second->GetNormalDeclarationStr();
+			output.Write(item.second->GetNormalDeclarationStr());
+		}
+		else
+			continue;
+
+		hasData = true;
+		lastDataEnd = item.first + item.second->size;
+	}
+}
+
+bool ZFile::CanUseIncbin(const Declaration* decl, offset_t sectionOffset,
+                         offset_t lastDataEnd) const
+{
+	if (!Globals::Instance->useIncbin || decl->incbinPath == "" || decl->IsStatic())
+		return false;
+
+	// asm_processor reserves the space of the `GLOBAL_ASM` block with a char array, which is only
+	// 4-aligned. If the C array would have been padded, the data would end up somewhere else.
+	size_t alignment = (decl->declType == "u64") ? 8 : 4;
+
+	return decl->address == lastDataEnd && sectionOffset % alignment == 0;
+}
+
+// An object which couldn't be written must not stay from a previous extraction, or it would be
+// linked instead of compiling the C file
+static void RemoveObjectFile(const fs::path& outPath)
+{
+#ifdef USE_BOOST_FS
+	boost::system::error_code ec;
+#else
+	std::error_code ec;
+#endif
+
+	fs::remove(outPath, ec);
+}
+
+bool ZFile::GenerateObjectFile(const fs::path& outPath)
+{
+	ProfileScope scope("GenerateObjectFile", nullptr, name);
+
+	// The data section has the declarations in the order the C file has them, which is only the
+	// data of the file if they are contiguous
+	std::vector<Declaration*> dataDecls;
+	std::vector<uint8_t> data;
+	offset_t dataStart = 0;
+
+	for (const auto& [address, decl] : declarations)
+	{
+		if (!IsOffsetInFileRange(address) || (decl->includePath == "" && decl->declType == ""))
+			continue;
+
+		if (dataDecls.empty())
+			dataStart = address;
+
+		// The compiler pads 8-aligned declarations, like `HandleUnaccountedAddress` expects
+		offset_t dataEnd = dataStart + data.size();
+		if (decl->alignment == DeclarationAlignment::Align8 && (address - dataStart) % 8 == 0 &&
+		    address == dataEnd + 4 && BitConverter::ToUInt32BE(rawData, dataEnd) == 0)
+		{
+			data.insert(data.end(), 4, 0);
+		}
+
+		if (address != dataStart + data.size() || address + decl->size > rawData.size())
+		{
+			RemoveObjectFile(outPath);
+			HANDLE_WARNING_RESOURCE(
+				WarningType::NotImplemented, this, nullptr, address,
+				StringHelper::Sprintf("can't write the object file '%s'", outPath.c_str()),
+				"The declarations of the file don't cover its data contiguously.");
+			return false;
+		}
+
+		dataDecls.push_back(decl);
+		data.insert(data.end(), rawData.begin() + address,
+		            rawData.begin() + address + decl->size);
+	}
+
+	ElfObject object;
+	uint16_t dataIndex = object.AddSection(
+		".data", ElfObject::SectionTypeProgBits,
+		ElfObject::SectionFlagWrite | ElfObject::SectionFlagAlloc, 16, {});
+
+	ElfObject::Symbol sectionSymbol;
+	sectionSymbol.type = ElfObject::SymbolTypeSection;
+	sectionSymbol.sectionIndex = dataIndex;
+	uint32_t sectionSymbolIndex = object.AddSymbol(sectionSymbol);
+
+	// Static declarations are relocated relative to the section, like compilers do
+	std::map<std::string, uint32_t> globalSymbols;
+	std::map<std::string, offset_t> localOffsets;
+
+	for (Declaration* decl : dataDecls)
+	{
+		ElfObject::Symbol symbol;
+		symbol.name = decl->declName;
+		symbol.value = decl->address - dataStart;
+		symbol.size = decl->size;
+		symbol.bind = decl->IsStatic() ? ElfObject::SymbolBindLocal : ElfObject::SymbolBindGlobal;
+		symbol.type = ElfObject::SymbolTypeObject;
+		symbol.sectionIndex = dataIndex;
+
+		uint32_t symbolIndex = object.AddSymbol(symbol);
+		if (decl->IsStatic())
+			localOffsets[std::string(decl->declName)] = symbol.value;
+		else
+			globalSymbols[std::string(decl->declName)] = symbolIndex;
+	}
+
+	// Only the pointers resolved while generating the source file are relocated, since any other
+	// word could have the same value. Their data is checked in case a pointer wasn't read from the
+	// offset it was resolved for.
+	offset_t dataEnd = dataStart + data.size();
+	for (auto targetIt = pointerTargets.lower_bound(dataStart);
+	     targetIt != pointerTargets.end() && targetIt->first + 4 <= dataEnd; targetIt++)
+	{
+		offset_t address = targetIt->first;
+		const PointerTarget& target = targetIt->second;
+		if (address % 4 != 0 || BitConverter::ToUInt32BE(rawData, address) != target.value)
+			continue;
+
+		uint32_t symbolIndex;
+		uint32_t addend = target.addend;
+
+		auto localIt = localOffsets.find(target.symbolName);
+		if (localIt != localOffsets.end())
+		{
+			symbolIndex = sectionSymbolIndex;
+			addend += localIt->second;
+		}
+		else
+		{
+			auto globalIt = globalSymbols.find(target.symbolName);
+			if (globalIt == globalSymbols.end())
+			{
+				ElfObject::Symbol symbol;
+				symbol.name = target.symbolName;
+				symbol.bind = ElfObject::SymbolBindGlobal;
+				symbol.type = ElfObject::SymbolTypeObject;
+				globalIt = globalSymbols.emplace(target.symbolName, object.AddSymbol(symbol)).first;
+			}
+			symbolIndex = globalIt->second;
 		}
+
+		// `.rel` relocations keep their addend in place of the pointer
+		offset_t sectionOffset = address - dataStart;
+		data[sectionOffset + 0] = addend >> 24;
+		data[sectionOffset + 1] = (addend >> 16) & 0xFF;
+		data[sectionOffset + 2] = (addend >> 8) & 0xFF;
+		data[sectionOffset + 3] = addend & 0xFF;
+
+		ElfObject::Relocation reloc;
+		reloc.sectionIndex = dataIndex;
+		reloc.offset = sectionOffset;
+		reloc.symbolIndex = symbolIndex;
+		reloc.type = ElfObject::RelocationMips32;
+		object.relocations.push_back(reloc);
+	}
+
+	// IDO pads the section to its alignment, which the linker would do anyway
+	data.resize(ALIGN16(data.size()), 0);
+	object.sections[dataIndex].data = data;
+	object.sections[dataIndex].size = data.size();
+
+	std::vector<uint8_t> objectData = object.Serialize();
+	bool written = File::WriteAllBytesIfChanged(outPath, objectData);
+
+	uint64_t size;
+	int64_t time;
+	if (!File::GetSizeAndTime(outPath, size, time) || size != objectData.size())
+	{
+		RemoveObjectFile(outPath);
+		HANDLE_WARNING_PROCESS(WarningType::Always,
+		                       StringHelper::Sprintf("could not write '%s'", outPath.c_str()), "");
+		return false;
 	}
 
-	return output;
+	ctx->AddOutputFile(outPath, written);
+	return true;
 }
 
 void ZFile::MergeNeighboringDeclarations()
@@ -1125,6 +1395,9 @@ void ZFile::MergeNeighboringDeclarations()
 							lastItem.second->size += curItem.second->size;
 							lastItem.second->arrayItemCnt += curItem.second->arrayItemCnt;
 							lastItem.second->declBody += "\n" + curItem.second->declBody;
+							declarationsIndex.Set(lastItem.second, lastItem.first,
+							                      lastItem.second->size);
+							declarationsIndex.Remove(curItem.second);
 							declarations.erase(curItem.first);
 							declarationKeys.erase(declarationKeys.begin() + i);
 							delete curItem.second;
@@ -1155,8 +1428,8 @@ void ZFile::ProcessDeclarationText(Declaration* decl)
 		if (c == '@' && c2 == 'r')
 		{
 			std::string vtxName;
-			Globals::Instance->GetSegmentedArrayIndexedName(decl->references[refIndex], 0x10, this,
-			                                                "Vtx", vtxName);
+			ctx->GetSegmentedArrayIndexedName(decl->references[refIndex], 0x10, this,
+			                                  decl->referenceOffsets[refIndex], "Vtx", vtxName);
 			decl->declBody.replace(i, 2, vtxName);
 
 			refIndex++;
@@ -1167,9 +1440,8 @@ void ZFile::ProcessDeclarationText(Declaration* decl)
 	}
 }
 
-std::string ZFile::ProcessExterns()
+void ZFile::ProcessExterns(OutputFormatter& output)
 {
-	std::string output = "";
 	bool hadDefines = true;  // Previous declaration included defines.
 
 	for (const auto& item : declarations)
@@ -1183,21 +1455,19 @@ std::string ZFile::ProcessExterns()
 		// Add a newline above if previous has no defines and this one does.
 		if (!hadDefines && (itemDefines.length() > 0))
 		{
-			output.push_back('\n');
+			output.Write("\n");
 		}
-		output += item.second->GetExternStr();
-		output += itemDefines;
+		output.Write(item.second->GetExternStr());
+		output.Write(itemDefines);
 
 		// Newline below if this one has defines.
 		if ((hadDefines = (itemDefines.length() > 0)))
 		{
-			output.push_back('\n');
+			output.Write("\n");
 		}
 	}
 
-	output += defines;
-
-	return output;
+	output.Write(defines);
 }
 
 std::string ZFile::ProcessTextureIntersections([[maybe_unused]] const std::string& prefix)
@@ -1229,7 +1499,9 @@ std::string ZFile::ProcessTextureIntersections([[maybe_unused]] const std::strin
 			{
 				// Shrink palette so it doesn't overlap
 				currentTex->SetDimensions(offsetDiff / currentTex->GetPixelMultiplyer(), 1);
-				declarations.at(currentOffset)->size = currentTex->GetRawDataSize();
+				Declaration* decl = declarations.at(currentOffset);
+				decl->size = currentTex->GetRawDataSize();
+				declarationsIndex.Set(decl, currentOffset, decl->size);
 				currentTex->DeclareVar(GetName(), "");
 			}
 			else
@@ -1244,9 +1516,10 @@ std::string ZFile::ProcessTextureIntersections([[maybe_unused]] const std::strin
 				else
 					texNextName = nextDecl->declName;
 
-				defines += StringHelper::Sprintf("#define %s ((u32)%s + 0x%06X)\n",
-				                                 texNextName.c_str(), texName.c_str(), offsetDiff);
+				StringHelper::AppendFormat(defines, "#define %s ((u32)%s + 0x%06X)\n",
+				                           texNextName.c_str(), texName.c_str(), offsetDiff);
 
+				declarationsIndex.Remove(declarations[nextOffset]);
 				delete declarations[nextOffset];
 				declarations.erase(nextOffset);
 				texturesResources.erase(nextOffset);
@@ -1337,7 +1610,7 @@ bool ZFile::HandleUnaccountedAddress(offset_t currentAddress, offset_t lastAddr,
 			throw std::runtime_error(StringHelper::Sprintf(
 				"ZFile::ProcessDeclarations(): Fatal error while processing XML '%s'.\n"
 				"\t Offset '0x%X' is outside of the limits of file '%s', which has a size of "
-				"'0x%X'.\n"
+				"'0x%zX'.\n"
 				"\t Aborting...",
 				xmlFilePath.c_str(), currentAddress, name.c_str(), rawData.size()));
 		}
@@ -1365,31 +1638,28 @@ bool ZFile::HandleUnaccountedAddress(offset_t currentAddress, offset_t lastAddr,
 			}
 		}
 
-		for (int i = 0; i < diff; i++)
+		if (diff > 0)
 		{
-			uint8_t val = rawData.at(unaccountedAddress + i);
-			src += StringHelper::Sprintf("0x%02X, ", val);
-			if (val != 0x00)
-			{
-				nonZeroUnaccounted = true;
-			}
+			ByteSpan unaccountedData = rawData.subspan(unaccountedAddress, diff);
+			NumericArrayLayout layout;
+
+			nonZeroUnaccounted = std::any_of(unaccountedData.begin(), unaccountedData.end(),
+			                                 [](uint8_t val) { return val != 0x00; });
 
+			layout.width = 2;
+			layout.endLastLine = false;
 			if (Globals::Instance->verboseUnaccounted)
 			{
-				if ((i % 4 == 3))
-				{
-					src += StringHelper::Sprintf(" // 0x%06X", unaccountedAddress + i - 3);
-					if (i != (diff - 1))
-					{
-						src += "\n\t";
-					}
-				}
+				layout.perLine = 4;
+				layout.lineEnd = "\n\t";
+				layout.offsetComments = true;
+				layout.baseOffset = unaccountedAddress;
 			}
 			else
 			{
-				if ((i % 16 == 15) && (i != (diff - 1)))
-					src += "\n    ";
+				layout.lineEnd = "\n    ";
 			}
+			NumericEmitter(src).Array(unaccountedData.data(), unaccountedData.size(), layout);
 		}
 
 		if (declarations.find(unaccountedAddress) == declarations.end() && diff > 0)
@@ -1412,7 +1682,7 @@ bool ZFile::HandleUnaccountedAddress(offset_t currentAddress, offset_t lastAddr,
 				diff, src);
 
 			decl->isUnaccounted = true;
-			if (Globals::Instance->forceUnaccountedStatic)
+			if (ctx->forceUnaccountedStatic)
 				decl->staticConf = StaticConfig::On;
 
 			if (nonZeroUnaccounted)
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
+#include "Utils/AddressIntervalIndex.h"
+#include "Utils/MappedFile.h"
 #include "ZSymbol.h"
 #include "ZTexture.h"
 #include "tinyxml2.h"
@@ -14,6 +19,8 @@ enum class ZFileMode
 	BuildBlob,
 	BuildSourceFile,
 	BuildBackground,
+	BuildBatch,
+	VerifyObject,
 	Extract,
 	ExternalFile,
 	Invalid,
@@ -27,10 +34,31 @@ enum class ZGame
 	MM_RETAIL
 };
 
+class ExtractionContext;
+class OutputFormatter;
+
+// What a pointer resolved while generating the source of a file points to
+struct PointerTarget
+{
+	segptr_t value;
+	std::string symbolName;
+	uint32_t addend;
+};
+
 class ZFile
 {
+	// Creates the files of an external XML from their snapshot, without parsing it
+	friend class ExternalFileSnapshot;
+
+private:
+	// Holds the declarations and resources of this file, and the nodes of `declarations`. It is
+	// declared first so it is destroyed last, once everything allocated from it is gone.
+	std::pmr::monotonic_buffer_resource arena;
+
 public:
-	std::map<offset_t, Declaration*> declarations;
+	// The job this file was created for
+	ExtractionContext* ctx = nullptr;
+	std::pmr::map<offset_t, Declaration*> declarations{&arena};
 	std::vector<ZResource*> resources;
 	std::string defines;
 
@@ -40,17 +68,29 @@ public:
 	bool isExternalFile = false;
 	// Whether to make defines for texture dimensions, and possibly more in future
 	bool makeDefines = false;
+	// The target of every pointer resolved while generating the source of this file, by the
+	// offset of the pointer, for the relocations of its object file. Only filled with
+	// `--emit-objects`.
+	std::map<offset_t, PointerTarget> pointerTargets;
 
 	ZFile(const fs::path& nOutPath, const std::string& nName);
-	ZFile(ZFileMode nMode, tinyxml2::XMLElement* reader, const fs::path& nBasePath,
-	      const fs::path& nOutPath, const std::string& filename, const fs::path& nXmlFilePath);
+	ZFile(ExtractionContext* nCtx, ZFileMode nMode, tinyxml2::XMLElement* reader,
+	      const fs::path& nBasePath, const fs::path& nOutPath, const std::string& filename,
+	      const fs::path& nXmlFilePath);
 	~ZFile();
 
+	/**
+	 * The arena of this file, which the resources and declarations of this file are allocated
+	 * from. Its memory is released all at once when the file is destroyed, without destroying the
+	 * declarations, whose strings and references are allocated from it too.
+	 */
+	std::pmr::memory_resource* GetMemoryResource();
+
 	std::string GetName() const;
 	std::string GetOutName() const;
 	ZFileMode GetMode() const;
 	const fs::path& GetXmlFilePath() const;
-	const std::vector<uint8_t>& GetRawData() const;
+	const ByteSpan& GetRawData() const;
 	void ExtractResources();
 	void BuildSourceFile();
 	void AddResource(ZResource* res);
@@ -103,9 +143,19 @@ public:
 	void AddSymbolResource(uint32_t offset, ZSymbol* sym);
 	ZSymbol* GetSymbolResource(uint32_t offset) const;
 	ZSymbol* GetSymbolResourceRanged(uint32_t offset) const;
+	const std::map<uint32_t, ZSymbol*>& GetSymbolResources() const;
 
 	fs::path GetSourceOutputFolderPath() const;
 
+	/**
+	 * Writes the object file the compiler would build from the source file: the data of the
+	 * declarations, a symbol for each of them, and a relocation for every pointer in them which
+	 * was resolved to a symbol. Warns and returns `false` if the declarations don't cover the
+	 * data of the file contiguously or if it can't be written, removing the object file of a
+	 * previous extraction.
+	 */
+	bool GenerateObjectFile(const fs::path& outPath);
+
 	bool IsOffsetInFileRange(uint32_t offset) const;
 	bool IsSegmentedInFilespaceRange(segptr_t segAddress) const;
 
@@ -113,7 +163,9 @@ public:
 	static void RegisterNode(std::string nodeName, ZResourceFactoryFunc* nodeFunc);
 
 protected:
-	std::vector<uint8_t> rawData;
+	// The baserom file, mapped in memory, and the part of it this file covers
+	std::unique_ptr<MappedFile> rawDataFile;
+	ByteSpan rawData;
 	std::string name;
 	fs::path outName = "";
 	fs::path basePath;
@@ -125,18 +177,31 @@ protected:
 	// so ZFile shouldn't delete/free those textures.
 	std::map<uint32_t, ZTexture*> texturesResources;
 	std::map<uint32_t, ZSymbol*> symbolResources;
+	// Address ranges covered by each declaration and symbol, for the `*Ranged` lookups.
+	// Must be updated every time a declaration is added, removed or resized.
+	AddressIntervalIndex<Declaration> declarationsIndex;
+	AddressIntervalIndex<ZSymbol> symbolResourcesIndex;
 	ZFileMode mode = ZFileMode::Invalid;
 
 	ZFile();
 	void ParseXML(tinyxml2::XMLElement* reader, const std::string& filename);
+	// Maps the baserom file of this file
+	void OpenRawData();
 	void DeclareResourceSubReferences();
 	void GenerateSourceFiles();
 	void GenerateSourceHeaderFiles();
 	bool DeclarationSanityChecks(uint32_t address, const std::string& varName);
-	std::string ProcessDeclarations();
+	void ProcessDeclarations(OutputFormatter& output);
 	void MergeNeighboringDeclarations();
 	void ProcessDeclarationText(Declaration* decl);
-	std::string ProcessExterns();
+	/**
+	 * Whether `decl` can be output as an `.incbin` of its binary file, keeping its data at the
+	 * same place as its C array would. `sectionOffset` is where it starts in the data section of
+	 * the compiled file, and `lastDataEnd` where the data of the previous declaration ends.
+	 */
+	bool CanUseIncbin(const Declaration* decl, offset_t sectionOffset,
+	                  offset_t lastDataEnd) const;
+	void ProcessExterns(OutputFormatter& output);
 
 	std::string ProcessTextureIntersections(const std::string& prefix);
 	void HandleUnaccountedData();
@@ -2,8 +2,9 @@
 
 #include <cassert>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 #include "ZSkeleton.h"
@@ -61,51 +62,50 @@ void ZLimb::ParseXML(tinyxml2::XMLElement* reader)
 void ZLimb::ParseRawData()
 {
 	ZResource::ParseRawData();
-	const auto& rawData = parent->GetRawData();
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
 
 	if (type == ZLimbType::Curve)
 	{
-		childIndex = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0);
-		siblingIndex = BitConverter::ToUInt8BE(rawData, rawDataIndex + 1);
+		childIndex = view.ReadUInt8(0);
+		siblingIndex = view.ReadUInt8(1);
 
-		dListPtr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 4);
-		dList2Ptr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 8);
+		dListPtr = view.ReadUInt32(4);
+		dList2Ptr = view.ReadUInt32(8);
 		return;
 	}
 	if (type == ZLimbType::Legacy)
 	{
-		dListPtr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x00);
-		legTransX = BitConverter::ToFloatBE(rawData, rawDataIndex + 0x04);
-		legTransY = BitConverter::ToFloatBE(rawData, rawDataIndex + 0x08);
-		legTransZ = BitConverter::ToFloatBE(rawData, rawDataIndex + 0x0C);
-		rotX = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x10);
-		rotY = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x12);
-		rotZ = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x14);
-		childPtr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x18);
-		siblingPtr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x1C);
+		dListPtr = view.ReadUInt32(0x00);
+		legTransX = view.ReadFloat(0x04);
+		legTransY = view.ReadFloat(0x08);
+		legTransZ = view.ReadFloat(0x0C);
+		rotX = view.ReadUInt16(0x10);
+		rotY = view.ReadUInt16(0x12);
+		rotZ = view.ReadUInt16(0x14);
+		childPtr = view.ReadUInt32(0x18);
+		siblingPtr = view.ReadUInt32(0x1C);
 		return;
 	}
 
-	transX = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
-	transY = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-	transZ = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
+	transX = view.ReadInt16(0);
+	transY = view.ReadInt16(2);
+	transZ = view.ReadInt16(4);
 
-	childIndex = rawData.at(rawDataIndex + 6);
-	siblingIndex = rawData.at(rawDataIndex + 7);
+	childIndex = view.ReadUInt8(6);
+	siblingIndex = view.ReadUInt8(7);
 
 	switch (type)
 	{
 	case ZLimbType::LOD:
-		dList2Ptr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 12);
+		dList2Ptr = view.ReadUInt32(12);
 		[[fallthrough]];
 	case ZLimbType::Standard:
-		dListPtr = BitConverter::ToUInt32BE(rawData, rawDataIndex + 8);
+		dListPtr = view.ReadUInt32(8);
 		break;
 
 	case ZLimbType::Skin:
-		skinSegmentType =
-			static_cast<ZLimbSkinType>(BitConverter::ToInt32BE(rawData, rawDataIndex + 8));
-		skinSegment = BitConverter::ToUInt32BE(rawData, rawDataIndex + 12);
+		skinSegmentType = static_cast<ZLimbSkinType>(view.ReadInt32(8));
+		skinSegment = view.ReadUInt32(12);
 		if (skinSegmentType == ZLimbSkinType::SkinType_Animated)
 		{
 			if (skinSegment != 0 && GETSEGNUM(skinSegment) == parent->segment)
@@ -143,7 +143,7 @@ void ZLimb::DeclareReferences(const std::string& prefix)
 			uint32_t childOffset = Seg2Filespace(childPtr, parent->baseAddress);
 			if (!parent->HasDeclaration(childOffset))
 			{
-				ZLimb* child = new ZLimb(parent);
+				ZLimb* child = new (parent) ZLimb(parent);
 				child->ExtractFromBinary(childOffset, ZLimbType::Legacy);
 				child->DeclareVar(varPrefix, "");
 				child->DeclareReferences(varPrefix);
@@ -155,7 +155,7 @@ void ZLimb::DeclareReferences(const std::string& prefix)
 			uint32_t siblingdOffset = Seg2Filespace(siblingPtr, parent->baseAddress);
 			if (!parent->HasDeclaration(siblingdOffset))
 			{
-				ZLimb* sibling = new ZLimb(parent);
+				ZLimb* sibling = new (parent) ZLimb(parent);
 				sibling->ExtractFromBinary(siblingdOffset, ZLimbType::Legacy);
 				sibling->DeclareVar(varPrefix, "");
 				sibling->DeclareReferences(varPrefix);
@@ -227,18 +227,28 @@ size_t ZLimb::GetRawDataSize() const
 
 std::string ZLimb::GetBodySourceCode() const
 {
+	// The second display list always follows the first one
+	offset_t dListOffset = rawDataIndex + 8;
+	if (type == ZLimbType::Curve)
+		dListOffset = rawDataIndex + 4;
+	else if (type == ZLimbType::Legacy)
+		dListOffset = rawDataIndex;
+
 	std::string dListStr;
 	std::string dListStr2;
-	Globals::Instance->GetSegmentedArrayIndexedName(dListPtr, 8, parent, "Gfx", dListStr);
-	Globals::Instance->GetSegmentedArrayIndexedName(dList2Ptr, 8, parent, "Gfx", dListStr2);
+	parent->ctx->GetSegmentedArrayIndexedName(dListPtr, 8, parent, dListOffset, "Gfx", dListStr);
+	parent->ctx->GetSegmentedArrayIndexedName(dList2Ptr, 8, parent, dListOffset + 4, "Gfx",
+	                                          dListStr2);
 
 	std::string entryStr = "\n\t";
 	if (type == ZLimbType::Legacy)
 	{
 		std::string childName;
 		std::string siblingName;
-		Globals::Instance->GetSegmentedPtrName(childPtr, parent, "LegacyLimb", childName);
-		Globals::Instance->GetSegmentedPtrName(siblingPtr, parent, "LegacyLimb", siblingName);
+		parent->ctx->GetSegmentedPtrName(childPtr, parent, rawDataIndex + 0x18, "LegacyLimb",
+		                                 childName);
+		parent->ctx->GetSegmentedPtrName(siblingPtr, parent, rawDataIndex + 0x1C, "LegacyLimb",
+		                                 siblingName);
 
 		entryStr += StringHelper::Sprintf("%s,\n", dListStr.c_str());
 		entryStr +=
@@ -283,9 +293,10 @@ std::string ZLimb::GetBodySourceCode() const
 		case ZLimbType::Skin:
 		{
 			std::string skinSegmentStr;
-			Globals::Instance->GetSegmentedPtrName(skinSegment, parent, "", skinSegmentStr);
-			entryStr +=
-				StringHelper::Sprintf("\t0x%02X, %s\n", skinSegmentType, skinSegmentStr.c_str());
+			parent->ctx->GetSegmentedPtrName(skinSegment, parent, rawDataIndex + 12, "",
+			                                 skinSegmentStr);
+			entryStr += StringHelper::Sprintf("\t0x%02X, %s\n", static_cast<int>(skinSegmentType),
+			                                  skinSegmentStr.c_str());
 		}
 		break;
 
@@ -393,15 +404,15 @@ void ZLimb::DeclareDList(segptr_t dListSegmentedPtr, const std::string& prefix,
 		return;
 
 	std::string dlistName;
-	bool declFound = Globals::Instance->GetSegmentedArrayIndexedName(dListSegmentedPtr, 8, parent,
-	                                                                 "Gfx", dlistName, false);
+	bool declFound = parent->ctx->GetSegmentedArrayIndexedName(
+		dListSegmentedPtr, 8, parent, NO_SOURCE_OFFSET, "Gfx", dlistName, false);
 	if (declFound)
 		return;
 
 	int32_t dlistLength = ZDisplayList::GetDListLength(
 		parent->GetRawData(), dlistOffset,
-		Globals::Instance->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
-	ZDisplayList* dlist = new ZDisplayList(parent);
+		parent->ctx->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
+	ZDisplayList* dlist = new (parent) ZDisplayList(parent);
 	dlist->ExtractFromBinary(dlistOffset, dlistLength);
 
 	std::string dListStr =
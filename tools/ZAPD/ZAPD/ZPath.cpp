@@ -1,5 +1,6 @@
 #include "ZPath.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -145,8 +146,9 @@ void PathwayEntry::DeclareReferences(const std::string& prefix)
 		return;
 
 	std::string pointsName;
-	bool addressFound = Globals::Instance->GetSegmentedPtrName(listSegmentAddress, parent, "Vec3s",
-	                                                           pointsName, false);
+	bool addressFound = parent->ctx->GetSegmentedPtrName(listSegmentAddress, parent,
+	                                                     rawDataIndex + 4, "Vec3s", pointsName,
+	                                                     false);
 	if (addressFound)
 		return;
 
@@ -180,9 +182,10 @@ std::string PathwayEntry::GetBodySourceCode() const
 {
 	std::string declaration;
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(listSegmentAddress, parent, "Vec3s", listName);
+	parent->ctx->GetSegmentedPtrName(listSegmentAddress, parent, rawDataIndex + 4, "Vec3s",
+	                                 listName);
 
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 		declaration +=
 			StringHelper::Sprintf("%i, %i, %i, %s", numPoints, unk1, unk2, listName.c_str());
 	else
@@ -1,6 +1,7 @@
 #include "ZPlayerAnimationData.h"
 
 #include "Utils/BitConverter.h"
+#include "Utils/NumericEmitter.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 
@@ -53,31 +54,13 @@ Declaration* ZPlayerAnimationData::DeclareVar(const std::string& prefix, const s
 std::string ZPlayerAnimationData::GetBodySourceCode() const
 {
 	std::string declaration = "";
+	NumericArrayLayout layout;
 
-	size_t index = 0;
-	for (const auto entry : limbRotData)
-	{
-		if (index % 8 == 0)
-		{
-			declaration += "\t";
-		}
-
-		if (entry < 0)
-		{
-			declaration += StringHelper::Sprintf("-0x%04X, ", -entry);
-		}
-		else
-		{
-			declaration += StringHelper::Sprintf("0x%04X, ", entry);
-		}
-
-		if ((index + 1) % 8 == 0)
-		{
-			declaration += "\n";
-		}
-
-		index++;
-	}
+	layout.format = NumericArrayLayout::Format::SignedHex;
+	layout.width = 4;
+	layout.perLine = 8;
+	layout.lineStart = "\t";
+	NumericEmitter(declaration).Array(limbRotData.data(), limbRotData.size(), layout);
 
 	return declaration;
 }
@@ -1,5 +1,6 @@
 #include "ZPointer.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -31,7 +32,7 @@ std::string ZPointer::GetBodySourceCode() const
 {
 	std::string ptrName;
 
-	Globals::Instance->GetSegmentedPtrName(ptr, parent, "", ptrName);
+	parent->ctx->GetSegmentedPtrName(ptr, parent, rawDataIndex, "", ptrName);
 
 	return ptrName;
 }
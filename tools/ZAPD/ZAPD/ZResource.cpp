@@ -3,6 +3,7 @@
 #include <cassert>
 #include <regex>
 
+#include "Utils/Profiler.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 #include "ZFile.h"
@@ -24,6 +25,17 @@ ZResource::ZResource(ZFile* nParent)
 	RegisterOptionalAttribute("Static", "Global");
 }
 
+void* ZResource::operator new(size_t size, ZFile* owner)
+{
+	return ArenaAllocated::operator new(size,
+	                                    owner != nullptr ? owner->GetMemoryResource() : nullptr);
+}
+
+void ZResource::operator delete(void* ptr, ZFile* owner)
+{
+	ArenaAllocated::operator delete(ptr, owner != nullptr ? owner->GetMemoryResource() : nullptr);
+}
+
 void ZResource::ExtractWithXML(tinyxml2::XMLElement* reader, offset_t nRawDataIndex)
 {
 	rawDataIndex = nRawDataIndex;
@@ -35,6 +47,7 @@ void ZResource::ExtractWithXML(tinyxml2::XMLElement* reader, offset_t nRawDataIn
 	// Don't parse raw data of external files
 	if (parent->GetMode() != ZFileMode::ExternalFile)
 	{
+		ProfileScope scope("ParseRawData", GetResourceTypeName(GetResourceType()), name);
 		ParseRawData();
 		CalcHash();
 	}
@@ -58,6 +71,7 @@ void ZResource::ExtractFromFile(offset_t nRawDataIndex)
 	if (parent->GetMode() == ZFileMode::ExternalFile)
 		return;
 
+	ProfileScope scope("ParseRawData", GetResourceTypeName(GetResourceType()), name);
 	ParseRawData();
 	CalcHash();
 }
@@ -151,7 +165,9 @@ void ZResource::ParseXML(tinyxml2::XMLElement* reader)
 		{
 			HANDLE_ERROR_RESOURCE(
 				WarningType::InvalidAttributeValue, parent, this, rawDataIndex,
-				StringHelper::Sprintf("invalid value '%s' for 'Static' attribute", staticConf), "");
+				StringHelper::Sprintf("invalid value '%s' for 'Static' attribute",
+			                          staticXml.c_str()),
+				"");
 		}
 
 		declaredInXml = true;
@@ -290,6 +306,85 @@ ZResourceType ZResource::GetResourceType() const
 	return ZResourceType::Error;
 }
 
+const char* ZResource::GetResourceTypeName(ZResourceType type)
+{
+	switch (type)
+	{
+	case ZResourceType::Error:
+		return "Error";
+	case ZResourceType::ActorList:
+		return "ActorList";
+	case ZResourceType::Animation:
+		return "Animation";
+	case ZResourceType::Array:
+		return "Array";
+	case ZResourceType::AltHeader:
+		return "AltHeader";
+	case ZResourceType::Background:
+		return "Background";
+	case ZResourceType::Blob:
+		return "Blob";
+	case ZResourceType::CollisionHeader:
+		return "CollisionHeader";
+	case ZResourceType::CollisionPoly:
+		return "CollisionPoly";
+	case ZResourceType::Cutscene:
+		return "Cutscene";
+	case ZResourceType::DisplayList:
+		return "DisplayList";
+	case ZResourceType::Limb:
+		return "Limb";
+	case ZResourceType::LimbTable:
+		return "LimbTable";
+	case ZResourceType::Mtx:
+		return "Mtx";
+	case ZResourceType::Path:
+		return "Path";
+	case ZResourceType::PlayerAnimationData:
+		return "PlayerAnimationData";
+	case ZResourceType::Pointer:
+		return "Pointer";
+	case ZResourceType::Room:
+		return "Room";
+	case ZResourceType::RoomCommand:
+		return "RoomCommand";
+	case ZResourceType::Scalar:
+		return "Scalar";
+	case ZResourceType::Scene:
+		return "Scene";
+	case ZResourceType::Skeleton:
+		return "Skeleton";
+	case ZResourceType::String:
+		return "String";
+	case ZResourceType::SurfaceType:
+		return "SurfaceType";
+	case ZResourceType::Symbol:
+		return "Symbol";
+	case ZResourceType::Texture:
+		return "Texture";
+	case ZResourceType::TextureAnimation:
+		return "TextureAnimation";
+	case ZResourceType::TextureAnimationParams:
+		return "TextureAnimationParams";
+	case ZResourceType::Vector:
+		return "Vector";
+	case ZResourceType::Vertex:
+		return "Vertex";
+	case ZResourceType::Waterbox:
+		return "Waterbox";
+	case ZResourceType::KeyFrameFlexLimb:
+		return "KeyFrameFlexLimb";
+	case ZResourceType::KeyFrameStandardLimb:
+		return "KeyFrameStandardLimb";
+	case ZResourceType::KeyFrameSkel:
+		return "KeyFrameSkel";
+	case ZResourceType::KeyFrameAnimation:
+		return "KeyFrameAnimation";
+	}
+
+	return "Unknown";
+}
+
 void ZResource::CalcHash()
 {
 	hash = 0;
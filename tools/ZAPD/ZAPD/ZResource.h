@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include "Declaration.h"
+#include "Utils/ArenaAllocated.h"
 #include "Utils/BinaryWriter.h"
 #include "Utils/Directory.h"
 #include "tinyxml2.h"
@@ -70,7 +71,7 @@ public:
 	bool wasSet = false;
 };
 
-class ZResource
+class ZResource : public ArenaAllocated
 {
 public:
 	ZFile* parent;
@@ -84,6 +85,22 @@ public:
 	ZResource(ZFile* nParent);
 	virtual ~ZResource() = default;
 
+	// Resources which are stored by value, like the vertices of a display list, are moved
+	// instead of copied whenever possible
+	ZResource(const ZResource&) = default;
+	ZResource(ZResource&&) = default;
+	ZResource& operator=(const ZResource&) = default;
+	ZResource& operator=(ZResource&&) = default;
+
+	/**
+	 * Resources are allocated from the arena of the file they belong to, like
+	 * `new (parent) ZTexture(parent)`, so they have to be deleted before that file is. A null
+	 * `owner` allocates from the heap.
+	 */
+	static void* operator new(size_t size, ZFile* owner);
+	static void operator delete(void* ptr, ZFile* owner);
+	using ArenaAllocated::operator delete;
+
 	/// <summary>
 	/// Extracts/Parsees data from binary file using an XML to provide the needed metadata.
 	/// </summary>
@@ -157,6 +174,10 @@ public:
 	 * The type in the ZResource enum
 	 */
 	[[nodiscard]] virtual ZResourceType GetResourceType() const = 0;
+	/**
+	 * The name of a value of the ZResource enum, for profiling and diagnostics
+	 */
+	static const char* GetResourceTypeName(ZResourceType type);
 	/**
 	 * The filename extension for assets extracted as standalone files
 	 */
@@ -207,7 +228,7 @@ protected:
 	 * If set to true, create a reference for the asset in the file, but don't
 	 * actually try to extract it from the file
 	 */
-	bool isCustomAsset;
+	bool isCustomAsset = false;
 	bool declaredInXml = false;
 	StaticConfig staticConf = StaticConfig::Global;
 
@@ -241,7 +262,7 @@ typedef ZResource*(ZResourceFactoryFunc)(ZFile* nParent);
 #define REGISTER_ZFILENODE(nodeName, zResClass)                                                    \
 	static ZResource* ZResourceFactory_##zResClass_##nodeName(ZFile* nParent)                      \
 	{                                                                                              \
-		return static_cast<ZResource*>(new zResClass(nParent));                                    \
+		return static_cast<ZResource*>(new (nParent) zResClass(nParent));                          \
 	}                                                                                              \
                                                                                                    \
 	class ZRes_##nodeName                                                                          \
@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -16,7 +17,7 @@ void SetActorList::ParseRawData()
 	ZRoomCommand::ParseRawData();
 	numActors = cmdArg1;
 
-	actorList = new ZActorList(parent);
+	actorList = new (parent) ZActorList(parent);
 	actorList->ExtractFromBinary(segmentOffset, numActors);
 }
 
@@ -42,7 +43,7 @@ void SetActorList::DeclareReferences(const std::string& prefix)
 std::string SetActorList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "ActorEntry", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "ActorEntry", listName);
 
 	return StringHelper::Sprintf("SCENE_CMD_ACTOR_LIST(%i, %s)", numActors, listName.c_str());
 }
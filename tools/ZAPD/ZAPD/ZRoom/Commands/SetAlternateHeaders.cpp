@@ -1,7 +1,8 @@
 #include "SetAlternateHeaders.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 
@@ -23,15 +24,14 @@ void SetAlternateHeaders::ParseRawDataLate()
 {
 	size_t numHeaders = zRoom->parent->GetDeclarationSizeFromNeighbor(segmentOffset) / 4;
 
-	headers.reserve(numHeaders);
-	for (uint32_t i = 0; i < numHeaders; i++)
-	{
-		int32_t address = BitConverter::ToInt32BE(parent->GetRawData(), segmentOffset + (i * 4));
-		headers.push_back(address);
+	BEView view(parent->GetRawData(), segmentOffset, numHeaders * 4);
+	headers = view.ReadArray<uint32_t>(0, numHeaders);
 
+	for (uint32_t address : headers)
+	{
 		if (address != 0 && parent->GetDeclaration(GETSEGOFFSET(address)) == nullptr)
 		{
-			ZRoom* altheader = new ZRoom(parent);
+			ZRoom* altheader = new (parent) ZRoom(parent);
 			altheader->ExtractFromBinary(GETSEGOFFSET(address), zRoom->GetResourceType());
 			altheader->DeclareReferences(parent->GetName());
 
@@ -49,9 +49,10 @@ void SetAlternateHeaders::DeclareReferencesLate(const std::string& prefix)
 		for (size_t i = 0; i < headers.size(); i++)
 		{
 			std::string altHeaderName;
-			Globals::Instance->GetSegmentedPtrName(headers.at(i), parent, "", altHeaderName);
+			parent->ctx->GetSegmentedPtrName(headers.at(i), parent, segmentOffset + i * 4, "",
+			                                 altHeaderName);
 
-			declaration += StringHelper::Sprintf("\t%s,", altHeaderName.c_str());
+			StringHelper::AppendFormat(declaration, "\t%s,", altHeaderName.c_str());
 
 			if (i + 1 < headers.size())
 				declaration += "\n";
@@ -67,7 +68,7 @@ void SetAlternateHeaders::DeclareReferencesLate(const std::string& prefix)
 std::string SetAlternateHeaders::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "SceneCmd*", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "SceneCmd*", listName);
 	return StringHelper::Sprintf("SCENE_CMD_ALTERNATE_HEADER_LIST(%s)", listName.c_str());
 }
 
@@ -5,6 +5,7 @@
  */
 #include "SetAnimatedMaterialList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -33,7 +34,8 @@ void SetAnimatedMaterialList::DeclareReferences(const std::string& prefix)
 std::string SetAnimatedMaterialList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "AnimatedMaterial", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "AnimatedMaterial",
+	                                 listName);
 	return StringHelper::Sprintf("SCENE_CMD_ANIMATED_MATERIAL_LIST(%s)", listName.c_str());
 }
 
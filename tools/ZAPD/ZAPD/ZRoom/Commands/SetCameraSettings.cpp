@@ -1,6 +1,6 @@
 #include "SetCameraSettings.h"
 
-#include "Utils/BitConverter.h"
+#include "ExtractionContext.h"
 #include "Utils/StringHelper.h"
 #include "Globals.h"
 
@@ -12,12 +12,12 @@ void SetCameraSettings::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
 	cameraMovement = cmdArg1;
-	mapHighlight = BitConverter::ToUInt32BE(parent->GetRawData(), rawDataIndex + 4);
+	mapHighlight = cmdArg2;
 }
 
 std::string SetCameraSettings::GetBodySourceCode() const
 {
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 		return StringHelper::Sprintf("SCENE_CMD_SET_REGION_VISITED(0x%02X, 0x%08X)", cameraMovement,
 		                             mapHighlight);
 	else
@@ -1,5 +1,6 @@
 #include "SetCollisionHeader.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -14,7 +15,7 @@ void SetCollisionHeader::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
 
-	collisionHeader = new ZCollisionHeader(parent);
+	collisionHeader = new (parent) ZCollisionHeader(parent);
 	collisionHeader->SetName(
 		StringHelper::Sprintf("%sCollisionHeader_%06X", parent->GetName().c_str(), segmentOffset));
 	collisionHeader->ExtractFromFile(segmentOffset);
@@ -29,7 +30,8 @@ void SetCollisionHeader::DeclareReferences(const std::string& prefix)
 std::string SetCollisionHeader::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "CollisionHeader", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "CollisionHeader",
+	                                 listName);
 	return StringHelper::Sprintf("SCENE_CMD_COL_HEADER(%s)", listName.c_str());
 }
 
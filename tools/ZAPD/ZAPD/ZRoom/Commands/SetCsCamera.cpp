@@ -1,7 +1,8 @@
 #include "SetCsCamera.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZRoom.h"
@@ -52,7 +53,7 @@ void SetCsCamera::DeclareReferences(const std::string& prefix)
 		size_t index = 0;
 		for (auto& point : points)
 		{
-			declaration += StringHelper::Sprintf("\t{ %s },", point.GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declaration, "\t{ %s },", point.GetBodySourceCode().c_str());
 
 			if (index < points.size() - 1)
 				declaration += "\n";
@@ -72,17 +73,25 @@ void SetCsCamera::DeclareReferences(const std::string& prefix)
 	if (!cameras.empty())
 	{
 		std::string camPointsName;
-		Globals::Instance->GetSegmentedPtrName(cameras.at(0).GetCamAddress(), parent, "Vec3s",
-		                                       camPointsName);
+		bool camPointsFound = parent->ctx->GetSegmentedPtrName(
+			cameras.at(0).GetCamAddress(), parent, cameras.at(0).baseOffset + 4, "Vec3s",
+			camPointsName);
 		std::string declaration;
 
 		size_t index = 0;
 		size_t pointsIndex = 0;
 		for (const auto& entry : cameras)
 		{
-			declaration +=
-				StringHelper::Sprintf("\t{ %i, %i, &%s[%i] },", entry.type, entry.numPoints,
-			                          camPointsName.c_str(), pointsIndex);
+			StringHelper::AppendFormat(declaration, "\t{ %i, %i, &%s[%zu] },", entry.type,
+			                           entry.numPoints, camPointsName.c_str(), pointsIndex);
+
+			// The other cameras point inside the points of the first one
+			if (camPointsFound && index > 0)
+			{
+				ExtractionContext::AddPointerTarget(parent, entry.baseOffset + 4,
+				                                    entry.GetCamAddress(), camPointsName,
+				                                    pointsIndex * points.at(0).GetRawDataSize());
+			}
 
 			if (index < cameras.size() - 1)
 				declaration += "\n";
@@ -105,8 +114,8 @@ void SetCsCamera::DeclareReferences(const std::string& prefix)
 std::string SetCsCamera::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "ActorCsCamInfo", listName);
-	return StringHelper::Sprintf("SCENE_CMD_ACTOR_CUTSCENE_CAM_LIST(%i, %s)", cameras.size(),
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "ActorCsCamInfo", listName);
+	return StringHelper::Sprintf("SCENE_CMD_ACTOR_CUTSCENE_CAM_LIST(%zu, %s)", cameras.size(),
 	                             listName.c_str());
 }
 
@@ -120,11 +129,12 @@ RoomCommand SetCsCamera::GetRoomCommand() const
 	return RoomCommand::SetCsCamera;
 }
 
-ActorCsCamInfo::ActorCsCamInfo(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
-	: baseOffset(rawDataIndex), type(BitConverter::ToInt16BE(rawData, rawDataIndex + 0)),
-	  numPoints(BitConverter::ToInt16BE(rawData, rawDataIndex + 2))
+ActorCsCamInfo::ActorCsCamInfo(ByteSpan rawData, uint32_t rawDataIndex) : baseOffset(rawDataIndex)
 {
-	camAddress = BitConverter::ToInt32BE(rawData, rawDataIndex + 4);
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
+	type = view.ReadInt16(0);
+	numPoints = view.ReadInt16(2);
+	camAddress = view.ReadInt32(4);
 	segmentOffset = GETSEGOFFSET(camAddress);
 }
 
@@ -1,7 +1,8 @@
 #include "SetCutsceneEntryList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZRoom.h"
@@ -35,7 +36,8 @@ void SetActorCutsceneList::DeclareReferences(const std::string& prefix)
 		for (size_t i = 0; i < cutscenes.size(); i++)
 		{
 			const auto& entry = cutscenes.at(i);
-			declaration += StringHelper::Sprintf("    { %s },", entry.GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declaration, "    { %s },",
+			                           entry.GetBodySourceCode().c_str());
 
 			if (i + 1 < cutscenes.size())
 			{
@@ -55,8 +57,8 @@ void SetActorCutsceneList::DeclareReferences(const std::string& prefix)
 std::string SetActorCutsceneList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "CutsceneEntry", listName);
-	return StringHelper::Sprintf("SCENE_CMD_ACTOR_CUTSCENE_LIST(%i, %s)", cutscenes.size(),
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "CutsceneEntry", listName);
+	return StringHelper::Sprintf("SCENE_CMD_ACTOR_CUTSCENE_LIST(%zu, %s)", cutscenes.size(),
 	                             listName.c_str());
 }
 
@@ -70,26 +72,29 @@ RoomCommand SetActorCutsceneList::GetRoomCommand() const
 	return RoomCommand::SetActorCutsceneList;
 }
 
-CutsceneEntry::CutsceneEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
-	: priority(BitConverter::ToInt16BE(rawData, rawDataIndex + 0)),
-	  length(BitConverter::ToInt16BE(rawData, rawDataIndex + 2)),
-	  csCamId(BitConverter::ToInt16BE(rawData, rawDataIndex + 4)),
-	  scriptIndex(BitConverter::ToInt16BE(rawData, rawDataIndex + 6)),
-	  additionalCsId(BitConverter::ToInt16BE(rawData, rawDataIndex + 8)),
-	  endSfx(rawData[rawDataIndex + 0xA]), customValue(rawData[rawDataIndex + 0xB]),
-	  hudVisibility(BitConverter::ToInt16BE(rawData, rawDataIndex + 0xC)),
-	  endCam(rawData[rawDataIndex + 0xE]), letterboxSize(rawData[rawDataIndex + 0xF])
+CutsceneEntry::CutsceneEntry(ByteSpan rawData, uint32_t rawDataIndex)
 {
+	BEView view(rawData, rawDataIndex, 0x10);
+	priority = view.ReadInt16(0);
+	length = view.ReadInt16(2);
+	csCamId = view.ReadInt16(4);
+	scriptIndex = view.ReadInt16(6);
+	additionalCsId = view.ReadInt16(8);
+	endSfx = view.ReadUInt8(0xA);
+	customValue = view.ReadUInt8(0xB);
+	hudVisibility = view.ReadInt16(0xC);
+	endCam = view.ReadUInt8(0xE);
+	letterboxSize = view.ReadUInt8(0xF);
 }
 
 std::string CutsceneEntry::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 
-	if (enumData->endSfx.find(endSfx) != enumData->endSfx.end())
+	if (enumData->endSfx.Find(endSfx) != nullptr)
 		return StringHelper::Sprintf("%i, %i, %i, %i, %i, %s, %i, %i, %i, %i", priority, length,
 		                             csCamId, scriptIndex, additionalCsId,
-		                             enumData->endSfx[endSfx].c_str(), customValue, hudVisibility,
+		                             enumData->endSfx.Get(endSfx), customValue, hudVisibility,
 		                             endCam, letterboxSize);
 	else
 		return StringHelper::Sprintf("%i, %i, %i, %i, %i, %i, %i, %i, %i, %i", priority, length,
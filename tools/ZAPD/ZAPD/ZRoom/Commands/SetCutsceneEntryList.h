@@ -17,7 +17,7 @@ protected:
 	uint8_t letterboxSize;
 
 public:
-	CutsceneEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	CutsceneEntry(ByteSpan rawData, uint32_t rawDataIndex);
 
 	std::string GetBodySourceCode() const;
 	std::string GetSourceTypeName() const;
@@ -1,7 +1,8 @@
 #include "SetCutscenes.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZRoom.h"
@@ -16,7 +17,7 @@ void SetCutscenes::ParseRawData()
 
 	numCutscenes = cmdArg1;
 
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 	{
 		int32_t currentPtr = segmentOffset;
 
@@ -32,12 +33,12 @@ void SetCutscenes::ParseRawData()
 
 void SetCutscenes::DeclareReferences(const std::string& prefix)
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 	std::string varPrefix = name;
 	if (varPrefix == "")
 		varPrefix = prefix;
 
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 	{
 		std::string declaration;
 		size_t i = 0;
@@ -50,7 +51,7 @@ void SetCutscenes::DeclareReferences(const std::string& prefix)
 				offset_t csOffset = Seg2Filespace(entry.segmentPtr, parent->baseAddress);
 				if (!parent->HasDeclaration(csOffset))
 				{
-					auto* cutscene = new ZCutscene(parent);
+					auto* cutscene = new (parent) ZCutscene(parent);
 					cutscene->ExtractFromFile(csOffset);
 					cutscene->SetName(cutscene->GetDefaultName(varPrefix));
 					cutscene->DeclareVar(varPrefix, "");
@@ -60,17 +61,16 @@ void SetCutscenes::DeclareReferences(const std::string& prefix)
 			}
 
 			std::string csName;
-			Globals::Instance->GetSegmentedPtrName(entry.segmentPtr, parent, "CutsceneData",
-			                                       csName);
+			parent->ctx->GetSegmentedPtrName(entry.segmentPtr, parent, segmentOffset + i * 8,
+			                                 "CutsceneData", csName);
 
-			if (enumData->spawnFlag.find(entry.flag) != enumData->spawnFlag.end())
-				declaration += StringHelper::Sprintf("    { %s, 0x%04X, 0x%02X, %s },",
-				                                     csName.c_str(), entry.exit, entry.entrance,
-				                                     enumData->spawnFlag[entry.flag].c_str());
+			if (enumData->spawnFlag.Find(entry.flag) != nullptr)
+				StringHelper::AppendFormat(declaration, "    { %s, 0x%04X, 0x%02X, %s },",
+				                           csName.c_str(), entry.exit, entry.entrance,
+				                           enumData->spawnFlag.Get(entry.flag));
 			else
-				declaration +=
-					StringHelper::Sprintf("    { %s, 0x%04X, 0x%02X, 0x%02X },", csName.c_str(),
-				                          entry.exit, entry.entrance, entry.flag);
+				StringHelper::AppendFormat(declaration, "    { %s, 0x%04X, 0x%02X, 0x%02X },",
+				                           csName.c_str(), entry.exit, entry.entrance, entry.flag);
 			if (i + 1 < numCutscenes)
 				declaration += "\n";
 
@@ -90,7 +90,7 @@ void SetCutscenes::DeclareReferences(const std::string& prefix)
 			offset_t csOffset = Seg2Filespace(cmdArg2, parent->baseAddress);
 			if (!parent->HasDeclaration(csOffset))
 			{
-				auto* cutscene = new ZCutscene(parent);
+				auto* cutscene = new (parent) ZCutscene(parent);
 				cutscene->ExtractFromFile(csOffset);
 				cutscene->SetName(cutscene->GetDefaultName(varPrefix));
 				cutscene->DeclareVar(varPrefix, "");
@@ -105,14 +105,15 @@ std::string SetCutscenes::GetBodySourceCode() const
 {
 	std::string listName;
 
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 	{
-		Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "CutsceneScriptEntry", listName);
+		parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "CutsceneScriptEntry",
+		                                 listName);
 		return StringHelper::Sprintf("SCENE_CMD_CUTSCENE_SCRIPT_LIST(%i, %s)", numCutscenes,
 		                             listName.c_str());
 	}
 
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "CutsceneData", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "CutsceneData", listName);
 	return StringHelper::Sprintf("SCENE_CMD_CUTSCENE_DATA(%s)", listName.c_str());
 }
 
@@ -126,9 +127,11 @@ RoomCommand SetCutscenes::GetRoomCommand() const
 	return RoomCommand::SetCutscenes;
 }
 
-CutsceneScriptEntry::CutsceneScriptEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
-	: segmentPtr(BitConverter::ToInt32BE(rawData, rawDataIndex + 0)),
-	  exit(BitConverter::ToInt16BE(rawData, rawDataIndex + 4)), entrance(rawData[rawDataIndex + 6]),
-	  flag(rawData[rawDataIndex + 7])
+CutsceneScriptEntry::CutsceneScriptEntry(ByteSpan rawData, uint32_t rawDataIndex)
 {
+	BEView view(rawData, rawDataIndex, 8);
+	segmentPtr = view.ReadUInt32(0);
+	exit = view.ReadUInt16(4);
+	entrance = view.ReadUInt8(6);
+	flag = view.ReadUInt8(7);
 }
@@ -6,7 +6,7 @@
 class CutsceneScriptEntry
 {
 public:
-	CutsceneScriptEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	CutsceneScriptEntry(ByteSpan rawData, uint32_t rawDataIndex);
 
 	segptr_t segmentPtr;
 	uint16_t exit;
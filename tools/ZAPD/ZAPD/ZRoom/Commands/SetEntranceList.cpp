@@ -1,5 +1,6 @@
 #include "SetEntranceList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "SetStartPositionList.h"
 #include "Utils/BitConverter.h"
@@ -46,7 +47,8 @@ void SetEntranceList::DeclareReferencesLate([[maybe_unused]] const std::string&
 		size_t index = 0;
 		for (const auto& entry : entrances)
 		{
-			declaration += StringHelper::Sprintf("    { %s },", entry.GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declaration, "    { %s },",
+			                           entry.GetBodySourceCode().c_str());
 			if (index + 1 < entrances.size())
 				declaration += "\n";
 
@@ -56,7 +58,7 @@ void SetEntranceList::DeclareReferencesLate([[maybe_unused]] const std::string&
 		std::string varName =
 			StringHelper::Sprintf("%sEntranceList0x%06X", prefix.c_str(), segmentOffset);
 
-		if (Globals::Instance->game != ZGame::MM_RETAIL)
+		if (parent->ctx->game != ZGame::MM_RETAIL)
 			parent->AddDeclarationArray(segmentOffset, DeclarationAlignment::Align4,
 			                            entrances.size() * 2, "Spawn", varName, entrances.size(),
 			                            declaration);
@@ -70,10 +72,11 @@ void SetEntranceList::DeclareReferencesLate([[maybe_unused]] const std::string&
 std::string SetEntranceList::GetBodySourceCode() const
 {
 	std::string listName;
-	if (Globals::Instance->game != ZGame::MM_RETAIL)
-		Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "Spawn", listName);
+	if (parent->ctx->game != ZGame::MM_RETAIL)
+		parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "Spawn", listName);
 	else
-		Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "EntranceEntry", listName);
+		parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "EntranceEntry",
+		                                 listName);
 	return StringHelper::Sprintf("SCENE_CMD_ENTRANCE_LIST(%s)", listName.c_str());
 }
 
@@ -87,7 +90,7 @@ RoomCommand SetEntranceList::GetRoomCommand() const
 	return RoomCommand::SetEntranceList;
 }
 
-Spawn::Spawn(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+Spawn::Spawn(ByteSpan rawData, uint32_t rawDataIndex)
 {
 	startPositionIndex = rawData.at(rawDataIndex + 0);
 	roomToLoad = rawData.at(rawDataIndex + 1);
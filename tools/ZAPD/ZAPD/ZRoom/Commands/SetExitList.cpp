@@ -1,7 +1,8 @@
 #include "SetExitList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZNames.h"
@@ -25,16 +26,9 @@ void SetExitList::ParseRawDataLate()
 {
 	// Parse Entrances and Generate Declaration
 	uint32_t numEntrances = zRoom->parent->GetDeclarationSizeFromNeighbor(segmentOffset) / 2;
-	uint32_t currentPtr = segmentOffset;
 
-	exits.reserve(numEntrances);
-	for (uint32_t i = 0; i < numEntrances; i++)
-	{
-		uint16_t exit = BitConverter::ToUInt16BE(parent->GetRawData(), currentPtr);
-		exits.push_back(exit);
-
-		currentPtr += 2;
-	}
+	BEView view(parent->GetRawData(), segmentOffset, numEntrances * 2);
+	exits = view.ReadArray<uint16_t>(0, numEntrances);
 }
 
 void SetExitList::DeclareReferencesLate([[maybe_unused]] const std::string& prefix)
@@ -45,8 +39,8 @@ void SetExitList::DeclareReferencesLate([[maybe_unused]] const std::string& pref
 
 		for (size_t i = 0; i < exits.size(); i++)
 		{
-			declaration +=
-				StringHelper::Sprintf("    %s,", ZNames::GetEntranceName(exits[i]).c_str());
+			StringHelper::AppendFormat(declaration, "    %s,",
+			                           ZNames::GetEntranceName(exits[i]).c_str());
 			if (i + 1 < exits.size())
 				declaration += "\n";
 		}
@@ -61,7 +55,7 @@ void SetExitList::DeclareReferencesLate([[maybe_unused]] const std::string& pref
 std::string SetExitList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "u16", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "u16", listName);
 	return StringHelper::Sprintf("SCENE_CMD_EXIT_LIST(%s)", listName.c_str());
 }
 
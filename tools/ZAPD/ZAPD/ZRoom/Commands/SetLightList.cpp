@@ -1,7 +1,8 @@
 #include "SetLightList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 
 SetLightList::SetLightList(ZFile* nParent) : ZRoomCommand(nParent)
@@ -34,8 +35,8 @@ void SetLightList::DeclareReferences(const std::string& prefix)
 
 		for (size_t i = 0; i < lights.size(); i++)
 		{
-			declarations +=
-				StringHelper::Sprintf("\t{ %s },", lights.at(i).GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declarations, "\t{ %s },",
+			                           lights.at(i).GetBodySourceCode().c_str());
 
 			if (i < lights.size() - 1)
 				declarations += "\n";
@@ -54,7 +55,7 @@ void SetLightList::DeclareReferences(const std::string& prefix)
 std::string SetLightList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "LightInfo", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "LightInfo", listName);
 	return StringHelper::Sprintf("SCENE_CMD_LIGHT_LIST(%i, %s)", numLights, listName.c_str());
 }
 
@@ -68,17 +69,18 @@ RoomCommand SetLightList::GetRoomCommand() const
 	return RoomCommand::SetLightList;
 }
 
-LightInfo::LightInfo(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+LightInfo::LightInfo(ByteSpan rawData, uint32_t rawDataIndex)
 {
-	type = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0);
-	x = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-	y = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
-	z = BitConverter::ToInt16BE(rawData, rawDataIndex + 6);
-	r = BitConverter::ToUInt8BE(rawData, rawDataIndex + 8);
-	g = BitConverter::ToUInt8BE(rawData, rawDataIndex + 9);
-	b = BitConverter::ToUInt8BE(rawData, rawDataIndex + 10);
-	drawGlow = BitConverter::ToUInt8BE(rawData, rawDataIndex + 11);
-	radius = BitConverter::ToInt16BE(rawData, rawDataIndex + 12);
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
+	type = view.ReadUInt8(0);
+	x = view.ReadInt16(2);
+	y = view.ReadInt16(4);
+	z = view.ReadInt16(6);
+	r = view.ReadUInt8(8);
+	g = view.ReadUInt8(9);
+	b = view.ReadUInt8(10);
+	drawGlow = view.ReadUInt8(11);
+	radius = view.ReadInt16(12);
 }
 
 std::string LightInfo::GetBodySourceCode() const
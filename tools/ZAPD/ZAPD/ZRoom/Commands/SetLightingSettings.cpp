@@ -1,7 +1,8 @@
 #include "SetLightingSettings.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZRoom.h"
@@ -28,13 +29,13 @@ void SetLightingSettings::DeclareReferences(const std::string& prefix)
 
 		for (size_t i = 0; i < settings.size(); i++)
 		{
-			declaration +=
-				StringHelper::Sprintf("\t{ %s },", settings.at(i).GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declaration, "\t{ %s },",
+			                           settings.at(i).GetBodySourceCode().c_str());
 			if (i + 1 < settings.size())
 				declaration += "\n";
 		}
 
-		if (Globals::Instance->game != ZGame::MM_RETAIL)
+		if (parent->ctx->game != ZGame::MM_RETAIL)
 			parent->AddDeclarationArray(
 				segmentOffset, DeclarationAlignment::Align4,
 				settings.size() * settings.front().GetRawDataSize(), "EnvLightSettings",
@@ -52,11 +53,13 @@ void SetLightingSettings::DeclareReferences(const std::string& prefix)
 std::string SetLightingSettings::GetBodySourceCode() const
 {
 	std::string listName;
-	if (Globals::Instance->game != ZGame::MM_RETAIL)
-		Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "EnvLightSettings", listName);
+	if (parent->ctx->game != ZGame::MM_RETAIL)
+		parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "EnvLightSettings",
+		                                 listName);
 	else
-		Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "LightSettings", listName);
-	return StringHelper::Sprintf("SCENE_CMD_ENV_LIGHT_SETTINGS(%i, %s)", settings.size(),
+		parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "LightSettings",
+		                                 listName);
+	return StringHelper::Sprintf("SCENE_CMD_ENV_LIGHT_SETTINGS(%zu, %s)", settings.size(),
 	                             listName.c_str());
 }
 
@@ -70,34 +73,36 @@ RoomCommand SetLightingSettings::GetRoomCommand() const
 	return RoomCommand::SetLightingSettings;
 }
 
-LightingSettings::LightingSettings(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+LightingSettings::LightingSettings(ByteSpan rawData, uint32_t rawDataIndex)
 {
-	ambientClrR = rawData.at(rawDataIndex + 0);
-	ambientClrG = rawData.at(rawDataIndex + 1);
-	ambientClrB = rawData.at(rawDataIndex + 2);
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
 
-	diffuseClrA_R = rawData.at(rawDataIndex + 3);
-	diffuseClrA_G = rawData.at(rawDataIndex + 4);
-	diffuseClrA_B = rawData.at(rawDataIndex + 5);
+	ambientClrR = view.ReadUInt8(0);
+	ambientClrG = view.ReadUInt8(1);
+	ambientClrB = view.ReadUInt8(2);
 
-	diffuseDirA_X = rawData.at(rawDataIndex + 6);
-	diffuseDirA_Y = rawData.at(rawDataIndex + 7);
-	diffuseDirA_Z = rawData.at(rawDataIndex + 8);
+	diffuseClrA_R = view.ReadUInt8(3);
+	diffuseClrA_G = view.ReadUInt8(4);
+	diffuseClrA_B = view.ReadUInt8(5);
 
-	diffuseClrB_R = rawData.at(rawDataIndex + 9);
-	diffuseClrB_G = rawData.at(rawDataIndex + 10);
-	diffuseClrB_B = rawData.at(rawDataIndex + 11);
+	diffuseDirA_X = view.ReadUInt8(6);
+	diffuseDirA_Y = view.ReadUInt8(7);
+	diffuseDirA_Z = view.ReadUInt8(8);
 
-	diffuseDirB_X = rawData.at(rawDataIndex + 12);
-	diffuseDirB_Y = rawData.at(rawDataIndex + 13);
-	diffuseDirB_Z = rawData.at(rawDataIndex + 14);
+	diffuseClrB_R = view.ReadUInt8(9);
+	diffuseClrB_G = view.ReadUInt8(10);
+	diffuseClrB_B = view.ReadUInt8(11);
 
-	fogClrR = rawData.at(rawDataIndex + 15);
-	fogClrG = rawData.at(rawDataIndex + 16);
-	fogClrB = rawData.at(rawDataIndex + 17);
+	diffuseDirB_X = view.ReadUInt8(12);
+	diffuseDirB_Y = view.ReadUInt8(13);
+	diffuseDirB_Z = view.ReadUInt8(14);
 
-	unk = BitConverter::ToInt16BE(rawData, rawDataIndex + 18);
-	drawDistance = BitConverter::ToInt16BE(rawData, rawDataIndex + 20);
+	fogClrR = view.ReadUInt8(15);
+	fogClrG = view.ReadUInt8(16);
+	fogClrB = view.ReadUInt8(17);
+
+	unk = view.ReadInt16(18);
+	drawDistance = view.ReadInt16(20);
 }
 
 std::string LightingSettings::GetBodySourceCode() const
@@ -14,7 +14,7 @@ public:
 	uint16_t unk;
 	uint16_t drawDistance;
 
-	LightingSettings(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	LightingSettings(ByteSpan rawData, uint32_t rawDataIndex);
 
 	std::string GetBodySourceCode() const;
 
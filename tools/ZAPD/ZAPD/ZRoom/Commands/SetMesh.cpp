@@ -1,7 +1,8 @@
 #include "SetMesh.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/Path.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
@@ -66,8 +67,8 @@ std::string SetMesh::GenDListExterns(ZDisplayList* dList)
 {
 	std::string sourceOutput;
 
-	sourceOutput += StringHelper::Sprintf("extern Gfx %sDL_%06X[];\n", zRoom->GetName().c_str(),
-	                                      dList->GetRawDataIndex());
+	StringHelper::AppendFormat(sourceOutput, "extern Gfx %sDL_%06X[];\n", zRoom->GetName().c_str(),
+	                           dList->GetRawDataIndex());
 
 	for (ZDisplayList* otherDList : dList->otherDLists)
 		sourceOutput += GenDListExterns(otherDList);
@@ -78,7 +79,7 @@ std::string SetMesh::GenDListExterns(ZDisplayList* dList)
 std::string SetMesh::GetBodySourceCode() const
 {
 	std::string list;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "", list);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "", list);
 	return StringHelper::Sprintf("SCENE_CMD_ROOM_SHAPE(%s)", list.c_str());
 }
 
@@ -98,22 +99,22 @@ RoomShapeDListsEntry::RoomShapeDListsEntry(ZFile* nParent) : ZResource(nParent)
 
 void RoomShapeDListsEntry::ParseRawData()
 {
-	const auto& rawData = parent->GetRawData();
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
 	switch (polyType)
 	{
 	case 2:
-		x = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
-		y = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-		z = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
-		unk_06 = BitConverter::ToInt16BE(rawData, rawDataIndex + 6);
+		x = view.ReadInt16(0);
+		y = view.ReadInt16(2);
+		z = view.ReadInt16(4);
+		unk_06 = view.ReadInt16(6);
 
-		opa = BitConverter::ToUInt32BE(rawData, rawDataIndex + 8);
-		xlu = BitConverter::ToUInt32BE(rawData, rawDataIndex + 12);
+		opa = view.ReadUInt32(8);
+		xlu = view.ReadUInt32(12);
 		break;
 
 	default:
-		opa = BitConverter::ToUInt32BE(rawData, rawDataIndex);
-		xlu = BitConverter::ToUInt32BE(rawData, rawDataIndex + 4);
+		opa = view.ReadUInt32(0);
+		xlu = view.ReadUInt32(4);
 		break;
 	}
 }
@@ -129,15 +130,16 @@ std::string RoomShapeDListsEntry::GetBodySourceCode() const
 	std::string bodyStr;
 	std::string opaStr;
 	std::string xluStr;
-	Globals::Instance->GetSegmentedPtrName(opa, parent, "Gfx", opaStr);
-	Globals::Instance->GetSegmentedPtrName(xlu, parent, "Gfx", xluStr);
+	offset_t opaOffset = rawDataIndex + ((polyType == 2) ? 8 : 0);
+	parent->ctx->GetSegmentedPtrName(opa, parent, opaOffset, "Gfx", opaStr);
+	parent->ctx->GetSegmentedPtrName(xlu, parent, opaOffset + 4, "Gfx", xluStr);
 
 	if (polyType == 2)
 	{
-		bodyStr += StringHelper::Sprintf("{ %6i, %6i, %6i }, %6i, ", x, y, z, unk_06);
+		StringHelper::AppendFormat(bodyStr, "{ %6i, %6i, %6i }, %6i, ", x, y, z, unk_06);
 	}
 
-	bodyStr += StringHelper::Sprintf("%s, %s", opaStr.c_str(), xluStr.c_str());
+	StringHelper::AppendFormat(bodyStr, "%s, %s", opaStr.c_str(), xluStr.c_str());
 
 	return bodyStr;
 }
@@ -201,8 +203,8 @@ ZDisplayList* RoomShapeDListsEntry::MakeDlist(segptr_t ptr,
 
 	int32_t dlistLength = ZDisplayList::GetDListLength(
 		parent->GetRawData(), dlistAddress,
-		Globals::Instance->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
-	ZDisplayList* dlist = new ZDisplayList(parent);
+		parent->ctx->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
+	ZDisplayList* dlist = new (parent) ZDisplayList(parent);
 	parent->AddResource(dlist);
 	dlist->ExtractFromBinary(dlistAddress, dlistLength);
 	dlist->SetName(dlist->GetDefaultName(prefix));
@@ -234,23 +236,24 @@ RoomShapeImageMultiBgEntry::RoomShapeImageMultiBgEntry(bool nIsSubStruct, const
 void RoomShapeImageMultiBgEntry::ParseRawData()
 {
 	size_t pad = 0x00;
-	const auto& rawData = parent->GetRawData();
 	if (!isSubStruct)
-	{
 		pad = 0x04;
 
-		unk_00 = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x00);
-		id = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x02);
+	BEView view(parent->GetRawData(), rawDataIndex, pad + 0x16);
+	if (!isSubStruct)
+	{
+		unk_00 = view.ReadUInt16(0x00);
+		id = view.ReadUInt8(0x02);
 	}
-	source = BitConverter::ToUInt32BE(rawData, rawDataIndex + pad + 0x00);
-	unk_0C = BitConverter::ToUInt32BE(rawData, rawDataIndex + pad + 0x04);
-	tlut = BitConverter::ToUInt32BE(rawData, rawDataIndex + pad + 0x08);
-	width = BitConverter::ToUInt16BE(rawData, rawDataIndex + pad + 0x0C);
-	height = BitConverter::ToUInt16BE(rawData, rawDataIndex + pad + 0x0E);
-	fmt = BitConverter::ToUInt8BE(rawData, rawDataIndex + pad + 0x10);
-	siz = BitConverter::ToUInt8BE(rawData, rawDataIndex + pad + 0x11);
-	mode0 = BitConverter::ToUInt16BE(rawData, rawDataIndex + pad + 0x12);
-	tlutCount = BitConverter::ToUInt16BE(rawData, rawDataIndex + pad + 0x14);
+	source = view.ReadUInt32(pad + 0x00);
+	unk_0C = view.ReadUInt32(pad + 0x04);
+	tlut = view.ReadUInt32(pad + 0x08);
+	width = view.ReadUInt16(pad + 0x0C);
+	height = view.ReadUInt16(pad + 0x0E);
+	fmt = view.ReadUInt8(pad + 0x10);
+	siz = view.ReadUInt8(pad + 0x11);
+	mode0 = view.ReadUInt16(pad + 0x12);
+	tlutCount = view.ReadUInt16(pad + 0x14);
 }
 
 ZBackground* RoomShapeImageMultiBgEntry::MakeBackground(segptr_t ptr, const std::string& prefix)
@@ -260,7 +263,7 @@ ZBackground* RoomShapeImageMultiBgEntry::MakeBackground(segptr_t ptr, const std:
 
 	uint32_t backAddress = Seg2Filespace(ptr, parent->baseAddress);
 
-	ZBackground* background = new ZBackground(parent);
+	ZBackground* background = new (parent) ZBackground(parent);
 	background->ExtractFromFile(backAddress);
 
 	std::string defaultName = background->GetDefaultName(prefix);
@@ -288,47 +291,48 @@ std::string RoomShapeImageMultiBgEntry::GetBodySourceCode() const
 
 	if (!isSubStruct)
 	{
-		bodyStr += StringHelper::Sprintf("0x%04X, ", unk_00);
-		bodyStr += StringHelper::Sprintf("%i, ", id);
+		StringHelper::AppendFormat(bodyStr, "0x%04X, ", unk_00);
+		StringHelper::AppendFormat(bodyStr, "%i, ", id);
 		bodyStr += "\n    ";
 		bodyStr += "    ";
 	}
 
 	std::string backgroundName;
-	Globals::Instance->GetSegmentedPtrName(source, parent, "", backgroundName);
-	bodyStr += StringHelper::Sprintf("%s, ", backgroundName.c_str());
+	parent->ctx->GetSegmentedPtrName(source, parent, rawDataIndex + (isSubStruct ? 0x00 : 0x04),
+	                                 "", backgroundName);
+	StringHelper::AppendFormat(bodyStr, "%s, ", backgroundName.c_str());
 	bodyStr += "\n    ";
 	if (!isSubStruct)
 	{
 		bodyStr += "    ";
 	}
 
-	bodyStr += StringHelper::Sprintf("0x%08X, ", unk_0C);
-	bodyStr += StringHelper::Sprintf("0x%08X, ", tlut);
+	StringHelper::AppendFormat(bodyStr, "0x%08X, ", unk_0C);
+	StringHelper::AppendFormat(bodyStr, "0x%08X, ", tlut);
 	bodyStr += "\n    ";
 	if (!isSubStruct)
 	{
 		bodyStr += "    ";
 	}
 
-	bodyStr += StringHelper::Sprintf("%i, ", width);
-	bodyStr += StringHelper::Sprintf("%i, ", height);
+	StringHelper::AppendFormat(bodyStr, "%i, ", width);
+	StringHelper::AppendFormat(bodyStr, "%i, ", height);
 	bodyStr += "\n    ";
 	if (!isSubStruct)
 	{
 		bodyStr += "    ";
 	}
 
-	bodyStr += StringHelper::Sprintf("%i, ", fmt);
-	bodyStr += StringHelper::Sprintf("%i, ", siz);
+	StringHelper::AppendFormat(bodyStr, "%i, ", fmt);
+	StringHelper::AppendFormat(bodyStr, "%i, ", siz);
 	bodyStr += "\n    ";
 	if (!isSubStruct)
 	{
 		bodyStr += "    ";
 	}
 
-	bodyStr += StringHelper::Sprintf("0x%04X, ", mode0);
-	bodyStr += StringHelper::Sprintf("0x%04X, ", tlutCount);
+	StringHelper::AppendFormat(bodyStr, "0x%04X, ", mode0);
+	StringHelper::AppendFormat(bodyStr, "0x%04X, ", tlutCount);
 	if (!isSubStruct)
 	{
 		bodyStr += " \n    }, ";
@@ -358,7 +362,7 @@ PolygonTypeBase::PolygonTypeBase(ZFile* nParent, uint32_t nRawDataIndex, ZRoom*
 	: ZResource(nParent), zRoom{nRoom}
 {
 	rawDataIndex = nRawDataIndex;
-	type = BitConverter::ToUInt8BE(parent->GetRawData(), rawDataIndex);
+	type = BEView(parent->GetRawData(), rawDataIndex, 1).ReadUInt8(0);
 }
 
 void PolygonTypeBase::DeclareAndGenerateOutputCode(const std::string& prefix)
@@ -405,14 +409,17 @@ PolygonType1::PolygonType1(ZFile* nParent, uint32_t nRawDataIndex, ZRoom* nRoom)
 void PolygonType1::ParseRawData()
 {
 	const auto& rawData = parent->GetRawData();
+	BEView view(rawData, rawDataIndex, 0x08);
 
-	format = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x01);
-	dlist = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x04);
+	format = view.ReadUInt8(0x01);
+	dlist = view.ReadUInt32(0x04);
 
 	if (format == 2)
 	{
-		count = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x08);
-		list = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x0C);
+		// The multi-background header is bigger
+		view = BEView(rawData, rawDataIndex, 0x10);
+		count = view.ReadUInt8(0x08);
+		list = view.ReadUInt32(0x0C);
 	}
 
 	if (dlist != 0)
@@ -493,12 +500,12 @@ std::string PolygonType1::GetBodySourceCode() const
 	std::string bodyStr = "\n    ";
 
 	bodyStr += "{ ";
-	bodyStr += StringHelper::Sprintf("%i, %i, ", type, format);
+	StringHelper::AppendFormat(bodyStr, "%i, %i, ", type, format);
 
 	std::string dlistStr;
-	Globals::Instance->GetSegmentedPtrName(dlist, parent, "", dlistStr);
+	parent->ctx->GetSegmentedPtrName(dlist, parent, rawDataIndex + 0x04, "", dlistStr);
 
-	bodyStr += StringHelper::Sprintf("%s, ", dlistStr.c_str());
+	StringHelper::AppendFormat(bodyStr, "%s, ", dlistStr.c_str());
 	bodyStr += "}, \n";
 
 	std::string listStr = "NULL";
@@ -508,8 +515,9 @@ std::string PolygonType1::GetBodySourceCode() const
 		bodyStr += single.GetBodySourceCode();
 		break;
 	case 2:
-		Globals::Instance->GetSegmentedPtrName(list, parent, "RoomShapeImageMultiBgEntry", listStr);
-		bodyStr += StringHelper::Sprintf("    %i, %s, \n", count, listStr.c_str());
+		parent->ctx->GetSegmentedPtrName(list, parent, rawDataIndex + 0x0C,
+		                                 "RoomShapeImageMultiBgEntry", listStr);
+		StringHelper::AppendFormat(bodyStr, "    %i, %s, \n", count, listStr.c_str());
 		break;
 
 	default:
@@ -540,12 +548,12 @@ RoomShapeCullable::RoomShapeCullable(ZFile* nParent, uint32_t nRawDataIndex, ZRo
 
 void RoomShapeCullable::ParseRawData()
 {
-	const auto& rawData = parent->GetRawData();
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
 
-	num = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x01);
+	num = view.ReadUInt8(0x01);
 
-	start = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x04);
-	end = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x08);
+	start = view.ReadUInt32(0x04);
+	end = view.ReadUInt32(0x08);
 
 	uint32_t currentPtr = GETSEGOFFSET(start);
 
@@ -570,8 +578,8 @@ void RoomShapeCullable::DeclareReferences(const std::string& prefix)
 
 		for (size_t i = 0; i < polyDLists.size(); i++)
 		{
-			declaration +=
-				StringHelper::Sprintf("\t{ %s },", polyDLists.at(i).GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declaration, "\t{ %s },",
+			                           polyDLists.at(i).GetBodySourceCode().c_str());
 			if (i + 1 < polyDLists.size())
 				declaration += "\n";
 		}
@@ -597,12 +605,20 @@ void RoomShapeCullable::DeclareReferences(const std::string& prefix)
 std::string RoomShapeCullable::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(start, parent, "", listName);
+	bool listFound =
+		parent->ctx->GetSegmentedPtrName(start, parent, rawDataIndex + 0x04, "", listName);
+
+	// The end of the list is written relative to the list
+	if (listFound && start != SEGMENTED_NULL)
+	{
+		ExtractionContext::AddPointerTarget(parent, rawDataIndex + 0x08, end, listName,
+		                                    end - start);
+	}
 
-	std::string body = StringHelper::Sprintf("\n    %i, %i,\n", type, polyDLists.size());
-	body += StringHelper::Sprintf("    %s,\n", listName.c_str());
-	body +=
-		StringHelper::Sprintf("    %s + ARRAY_COUNTU(%s)\n", listName.c_str(), listName.c_str());
+	std::string body = StringHelper::Sprintf("\n    %i, %zu,\n", type, polyDLists.size());
+	StringHelper::AppendFormat(body, "    %s,\n", listName.c_str());
+	StringHelper::AppendFormat(body, "    %s + ARRAY_COUNTU(%s)\n", listName.c_str(),
+	                           listName.c_str());
 	return body;
 }
 
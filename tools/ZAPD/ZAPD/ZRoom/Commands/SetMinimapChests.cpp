@@ -1,7 +1,8 @@
 #include "SetMinimapChests.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZRoom.h"
@@ -34,7 +35,7 @@ void SetMinimapChests::DeclareReferences(const std::string& prefix)
 	size_t index = 0;
 	for (const auto& chest : chests)
 	{
-		declaration += StringHelper::Sprintf("    { %s },", chest.GetBodySourceCode().c_str());
+		StringHelper::AppendFormat(declaration, "    { %s },", chest.GetBodySourceCode().c_str());
 
 		if (index < chests.size() - 1)
 			declaration += "\n";
@@ -51,8 +52,8 @@ void SetMinimapChests::DeclareReferences(const std::string& prefix)
 std::string SetMinimapChests::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "MinimapChest", listName);
-	return StringHelper::Sprintf("SCENE_CMD_MINIMAP_COMPASS_ICON_INFO(0x%02X, %s)", chests.size(),
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "MinimapChest", listName);
+	return StringHelper::Sprintf("SCENE_CMD_MINIMAP_COMPASS_ICON_INFO(0x%02zX, %s)", chests.size(),
 	                             listName.c_str());
 }
 
@@ -66,13 +67,14 @@ RoomCommand SetMinimapChests::GetRoomCommand() const
 	return RoomCommand::SetMinimapChests;
 }
 
-MinimapChest::MinimapChest(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
-	: unk0(BitConverter::ToUInt16BE(rawData, rawDataIndex + 0)),
-	  unk2(BitConverter::ToUInt16BE(rawData, rawDataIndex + 2)),
-	  unk4(BitConverter::ToUInt16BE(rawData, rawDataIndex + 4)),
-	  unk6(BitConverter::ToUInt16BE(rawData, rawDataIndex + 6)),
-	  unk8(BitConverter::ToUInt16BE(rawData, rawDataIndex + 8))
+MinimapChest::MinimapChest(ByteSpan rawData, uint32_t rawDataIndex)
 {
+	BEView view(rawData, rawDataIndex, 10);
+	unk0 = view.ReadUInt16(0);
+	unk2 = view.ReadUInt16(2);
+	unk4 = view.ReadUInt16(4);
+	unk6 = view.ReadUInt16(6);
+	unk8 = view.ReadUInt16(8);
 }
 
 std::string MinimapChest::GetBodySourceCode() const
@@ -1,7 +1,8 @@
 #include "SetMinimapList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZRoom.h"
@@ -13,9 +14,10 @@ SetMinimapList::SetMinimapList(ZFile* nParent) : ZRoomCommand(nParent)
 void SetMinimapList::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
-	listSegmentAddr = BitConverter::ToInt32BE(parent->GetRawData(), segmentOffset);
+	BEView view(parent->GetRawData(), segmentOffset, 6);
+	listSegmentAddr = view.ReadInt32(0);
 	listSegmentOffset = GETSEGOFFSET(listSegmentAddr);
-	scale = BitConverter::ToInt16BE(parent->GetRawData(), segmentOffset + 4);
+	scale = view.ReadInt16(4);
 
 	uint32_t currentPtr = listSegmentOffset;
 
@@ -37,7 +39,8 @@ void SetMinimapList::DeclareReferences(const std::string& prefix)
 		size_t index = 0;
 		for (const auto& entry : minimaps)
 		{
-			declaration += StringHelper::Sprintf("    { %s },", entry.GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declaration, "    { %s },",
+			                           entry.GetBodySourceCode().c_str());
 
 			if (index < minimaps.size() - 1)
 				declaration += "\n";
@@ -53,7 +56,8 @@ void SetMinimapList::DeclareReferences(const std::string& prefix)
 
 	{
 		std::string listName;
-		Globals::Instance->GetSegmentedPtrName(listSegmentAddr, parent, "MinimapEntry", listName);
+		parent->ctx->GetSegmentedPtrName(listSegmentAddr, parent, segmentOffset, "MinimapEntry",
+		                                 listName);
 		std::string declaration = StringHelper::Sprintf("\n\t%s, %d\n", listName.c_str(), scale);
 
 		parent->AddDeclaration(
@@ -66,7 +70,7 @@ void SetMinimapList::DeclareReferences(const std::string& prefix)
 std::string SetMinimapList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "MinimapList", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "MinimapList", listName);
 	return StringHelper::Sprintf("SCENE_CMD_MINIMAP_INFO(%s)", listName.c_str());
 }
 
@@ -80,13 +84,14 @@ RoomCommand SetMinimapList::GetRoomCommand() const
 	return RoomCommand::SetMinimapList;
 }
 
-MinimapEntry::MinimapEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
-	: unk0(BitConverter::ToUInt16BE(rawData, rawDataIndex + 0)),
-	  unk2(BitConverter::ToUInt16BE(rawData, rawDataIndex + 2)),
-	  unk4(BitConverter::ToUInt16BE(rawData, rawDataIndex + 4)),
-	  unk6(BitConverter::ToUInt16BE(rawData, rawDataIndex + 6)),
-	  unk8(BitConverter::ToUInt16BE(rawData, rawDataIndex + 8))
+MinimapEntry::MinimapEntry(ByteSpan rawData, uint32_t rawDataIndex)
 {
+	BEView view(rawData, rawDataIndex, 10);
+	unk0 = view.ReadUInt16(0);
+	unk2 = view.ReadUInt16(2);
+	unk4 = view.ReadUInt16(4);
+	unk6 = view.ReadUInt16(6);
+	unk8 = view.ReadUInt16(8);
 }
 
 std::string MinimapEntry::GetBodySourceCode() const
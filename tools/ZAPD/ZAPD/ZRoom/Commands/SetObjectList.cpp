@@ -1,7 +1,8 @@
 #include "SetObjectList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZNames.h"
@@ -14,16 +15,10 @@ SetObjectList::SetObjectList(ZFile* nParent) : ZRoomCommand(nParent)
 void SetObjectList::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
-	uint8_t objectCnt = parent->GetRawData().at(rawDataIndex + 1);
-	uint32_t currentPtr = segmentOffset;
+	uint8_t objectCnt = cmdArg1;
 
-	objects.reserve(objectCnt);
-	for (uint8_t i = 0; i < objectCnt; i++)
-	{
-		uint16_t objectIndex = BitConverter::ToInt16BE(parent->GetRawData(), currentPtr);
-		objects.push_back(objectIndex);
-		currentPtr += 2;
-	}
+	BEView view(parent->GetRawData(), segmentOffset, objectCnt * 2);
+	objects = view.ReadArray<uint16_t>(0, objectCnt);
 }
 
 void SetObjectList::DeclareReferences(const std::string& prefix)
@@ -35,8 +30,8 @@ void SetObjectList::DeclareReferences(const std::string& prefix)
 		for (size_t i = 0; i < objects.size(); i++)
 		{
 			uint16_t objectIndex = objects[i];
-			declaration +=
-				StringHelper::Sprintf("    %s,", ZNames::GetObjectName(objectIndex).c_str());
+			StringHelper::AppendFormat(declaration, "    %s,",
+			                           ZNames::GetObjectName(objectIndex).c_str());
 
 			if (i < objects.size() - 1)
 				declaration += "\n";
@@ -52,8 +47,9 @@ void SetObjectList::DeclareReferences(const std::string& prefix)
 std::string SetObjectList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "s16", listName);
-	return StringHelper::Sprintf("SCENE_CMD_OBJECT_LIST(%i, %s)", objects.size(), listName.c_str());
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "s16", listName);
+	return StringHelper::Sprintf("SCENE_CMD_OBJECT_LIST(%zu, %s)", objects.size(),
+	                             listName.c_str());
 }
 
 std::string SetObjectList::GetCommandCName() const
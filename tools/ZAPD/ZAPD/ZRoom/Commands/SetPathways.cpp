@@ -1,5 +1,6 @@
 #include "SetPathways.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -22,7 +23,7 @@ void SetPathways::DeclareReferences([[maybe_unused]] const std::string& prefix)
 
 void SetPathways::ParseRawDataLate()
 {
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 	{
 		auto numPaths = zRoom->parent->GetDeclarationSizeFromNeighbor(segmentOffset) / 8;
 		pathwayList.SetNumPaths(numPaths);
@@ -42,7 +43,7 @@ void SetPathways::DeclareReferencesLate(const std::string& prefix)
 std::string SetPathways::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "Path", listName);
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "Path", listName);
 	return StringHelper::Sprintf("SCENE_CMD_PATH_LIST(%s)", listName.c_str());
 }
 
@@ -1,7 +1,7 @@
 #include "SetRoomBehavior.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
 
 SetRoomBehavior::SetRoomBehavior(ZFile* nParent) : ZRoomCommand(nParent)
@@ -12,7 +12,7 @@ void SetRoomBehavior::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
 	gameplayFlags = cmdArg1;
-	gameplayFlags2 = BitConverter::ToInt32BE(parent->GetRawData(), rawDataIndex + 0x04);
+	gameplayFlags2 = cmdArg2;
 
 	currRoomUnk2 = gameplayFlags2 & 0xFF;
 
@@ -26,7 +26,7 @@ void SetRoomBehavior::ParseRawData()
 
 std::string SetRoomBehavior::GetBodySourceCode() const
 {
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 	{
 		std::string enableLights = StringHelper::BoolStr(enablePosLights);
 		return StringHelper::Sprintf("SCENE_CMD_ROOM_BEHAVIOR(0x%02X, 0x%02X, %i, %i, %s, %i)",
@@ -1,7 +1,8 @@
 #include "SetRoomList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZRoom.h"
@@ -15,7 +16,7 @@ void SetRoomList::ParseRawData()
 	ZRoomCommand::ParseRawData();
 	int numRooms = cmdArg1;
 
-	romfile = new RomFile(parent);
+	romfile = new (parent) RomFile(parent);
 	romfile->numRooms = numRooms;
 	romfile->ExtractFromFile(segmentOffset);
 
@@ -34,8 +35,8 @@ void SetRoomList::DeclareReferences(const std::string& prefix)
 std::string SetRoomList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "RomFile", listName);
-	return StringHelper::Sprintf("SCENE_CMD_ROOM_LIST(%i, %s)", romfile->rooms.size(),
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "RomFile", listName);
+	return StringHelper::Sprintf("SCENE_CMD_ROOM_LIST(%zu, %s)", romfile->rooms.size(),
 	                             listName.c_str());
 }
 
@@ -94,8 +95,9 @@ std::string RomFile::GetBodySourceCode() const
 {
 	std::string declaration;
 	bool isFirst = true;
+	size_t roomIndex = 0;
 
-	for (ZFile* file : Globals::Instance->files)
+	for (ZFile* file : parent->ctx->files)
 	{
 		for (ZResource* res : file->resources)
 		{
@@ -105,10 +107,24 @@ std::string RomFile::GetBodySourceCode() const
 				if (!isFirst)
 					declaration += "\n";
 
-				declaration += StringHelper::Sprintf(
-					"\t{ (uintptr_t)_%sSegmentRomStart, (uintptr_t)_%sSegmentRomEnd },",
+				StringHelper::AppendFormat(
+					declaration, "\t{ (uintptr_t)_%sSegmentRomStart, (uintptr_t)_%sSegmentRomEnd },",
 					roomName.c_str(), roomName.c_str());
 				isFirst = false;
+
+				// The ROM addresses of the rooms are set by the linker
+				if (roomIndex < rooms.size())
+				{
+					const RoomEntry& entry = rooms[roomIndex];
+					offset_t entryOffset = rawDataIndex + roomIndex * entry.GetRawDataSize();
+					ExtractionContext::AddPointerTarget(parent, entryOffset,
+					                                    entry.virtualAddressStart,
+					                                    "_" + roomName + "SegmentRomStart", 0);
+					ExtractionContext::AddPointerTarget(parent, entryOffset + 4,
+					                                    entry.virtualAddressEnd,
+					                                    "_" + roomName + "SegmentRomEnd", 0);
+				}
+				roomIndex++;
 			}
 		}
 	}
@@ -143,10 +159,11 @@ RoomEntry::RoomEntry(uint32_t nVAS, uint32_t nVAE)
 	virtualAddressEnd = nVAE;
 }
 
-RoomEntry::RoomEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
-	: RoomEntry(BitConverter::ToInt32BE(rawData, rawDataIndex + 0),
-                BitConverter::ToInt32BE(rawData, rawDataIndex + 4))
+RoomEntry::RoomEntry(ByteSpan rawData, uint32_t rawDataIndex)
 {
+	BEView view(rawData, rawDataIndex, GetRawDataSize());
+	virtualAddressStart = view.ReadInt32(0);
+	virtualAddressEnd = view.ReadInt32(4);
 }
 
 size_t RoomEntry::GetRawDataSize() const
@@ -1,6 +1,5 @@
 #include "SetSpecialObjects.h"
 
-#include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
 #include "ZRoom/ZNames.h"
 
@@ -12,17 +11,17 @@ void SetSpecialObjects::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
 	elfMessage = cmdArg1;
-	globalObject = BitConverter::ToUInt16BE(parent->GetRawData(), rawDataIndex + 0x06);
+	globalObject = cmdArg2 & 0xFFFF;
 }
 
 std::string SetSpecialObjects::GetBodySourceCode() const
 {
-	EnumData* enumData = &Globals::Instance->cfg.enumData;
+	const EnumData* enumData = &Globals::Instance->cfg.enumData;
 	std::string objectName = ZNames::GetObjectName(globalObject);
 
-	if (enumData->naviQuestHintType.find(elfMessage) != enumData->naviQuestHintType.end())
+	if (enumData->naviQuestHintType.Find(elfMessage) != nullptr)
 		return StringHelper::Sprintf("SCENE_CMD_SPECIAL_FILES(%s, %s)",
-		                             enumData->naviQuestHintType[elfMessage].c_str(),
+		                             enumData->naviQuestHintType.Get(elfMessage),
 		                             objectName.c_str());
 
 	return StringHelper::Sprintf("SCENE_CMD_SPECIAL_FILES(0x%02X, %s)", elfMessage,
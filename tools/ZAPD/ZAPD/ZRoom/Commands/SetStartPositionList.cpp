@@ -1,5 +1,6 @@
 #include "SetStartPositionList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
@@ -21,7 +22,7 @@ void SetStartPositionList::ParseRawData()
 	actors.reserve(numActors);
 	for (uint32_t i = 0; i < numActors; i++)
 	{
-		actors.push_back(ActorSpawnEntry(parent->GetRawData(), currentPtr));
+		actors.push_back(ActorSpawnEntry(parent->GetRawData(), currentPtr, parent->ctx->game));
 		currentPtr += 16;
 	}
 }
@@ -35,7 +36,8 @@ void SetStartPositionList::DeclareReferences(const std::string& prefix)
 		size_t index = 0;
 		for (const auto& entry : actors)
 		{
-			declaration += StringHelper::Sprintf("    { %s },", entry.GetBodySourceCode().c_str());
+			StringHelper::AppendFormat(declaration, "    { %s },",
+			                           entry.GetBodySourceCode().c_str());
 			if (index + 1 < actors.size())
 				declaration += "\n";
 
@@ -52,8 +54,8 @@ void SetStartPositionList::DeclareReferences(const std::string& prefix)
 std::string SetStartPositionList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "ActorEntry", listName);
-	return StringHelper::Sprintf("SCENE_CMD_SPAWN_LIST(%i, %s)", actors.size(), listName.c_str());
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "ActorEntry", listName);
+	return StringHelper::Sprintf("SCENE_CMD_SPAWN_LIST(%zu, %s)", actors.size(), listName.c_str());
 }
 
 std::string SetStartPositionList::GetCommandCName() const
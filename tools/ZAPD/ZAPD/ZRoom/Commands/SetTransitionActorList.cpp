@@ -1,7 +1,8 @@
 #include "SetTransitionActorList.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 #include "ZRoom/ZNames.h"
@@ -20,7 +21,7 @@ void SetTransitionActorList::ParseRawData()
 	transitionActors.reserve(numActors);
 	for (int32_t i = 0; i < numActors; i++)
 	{
-		TransitionActorEntry entry(parent->GetRawData(), currentPtr);
+		TransitionActorEntry entry(parent->GetRawData(), currentPtr, parent->ctx->game);
 		transitionActors.push_back(entry);
 
 		currentPtr += 16;
@@ -34,7 +35,7 @@ void SetTransitionActorList::DeclareReferences(const std::string& prefix)
 	size_t index = 0;
 	for (const auto& entry : transitionActors)
 	{
-		declaration += StringHelper::Sprintf("    { %s },", entry.GetBodySourceCode().c_str());
+		StringHelper::AppendFormat(declaration, "    { %s },", entry.GetBodySourceCode().c_str());
 		if (index + 1 < transitionActors.size())
 		{
 			declaration += "\n";
@@ -53,9 +54,10 @@ void SetTransitionActorList::DeclareReferences(const std::string& prefix)
 std::string SetTransitionActorList::GetBodySourceCode() const
 {
 	std::string listName;
-	Globals::Instance->GetSegmentedPtrName(cmdArg2, parent, "TransitionActorEntry", listName);
-	return StringHelper::Sprintf("SCENE_CMD_TRANSITION_ACTOR_LIST(%i, %s)", transitionActors.size(),
-	                             listName.c_str());
+	parent->ctx->GetSegmentedPtrName(cmdArg2, parent, rawDataIndex + 4, "TransitionActorEntry",
+	                                 listName);
+	return StringHelper::Sprintf("SCENE_CMD_TRANSITION_ACTOR_LIST(%zu, %s)",
+	                             transitionActors.size(), listName.c_str());
 }
 
 std::string SetTransitionActorList::GetCommandCName() const
@@ -68,23 +70,25 @@ RoomCommand SetTransitionActorList::GetRoomCommand() const
 	return RoomCommand::SetTransitionActorList;
 }
 
-TransitionActorEntry::TransitionActorEntry(const std::vector<uint8_t>& rawData, int rawDataIndex)
+TransitionActorEntry::TransitionActorEntry(ByteSpan rawData, int rawDataIndex, ZGame nGame)
 {
-	frontObjectRoom = rawData[rawDataIndex + 0];
-	frontTransitionReaction = rawData[rawDataIndex + 1];
-	backObjectRoom = rawData[rawDataIndex + 2];
-	backTransitionReaction = rawData[rawDataIndex + 3];
-	actorNum = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
-	posX = BitConverter::ToInt16BE(rawData, rawDataIndex + 6);
-	posY = BitConverter::ToInt16BE(rawData, rawDataIndex + 8);
-	posZ = BitConverter::ToInt16BE(rawData, rawDataIndex + 10);
-	rotY = BitConverter::ToInt16BE(rawData, rawDataIndex + 12);
-	initVar = BitConverter::ToInt16BE(rawData, rawDataIndex + 14);
+	game = nGame;
+	BEView view(rawData, rawDataIndex, 16);
+	frontObjectRoom = view.ReadUInt8(0);
+	frontTransitionReaction = view.ReadUInt8(1);
+	backObjectRoom = view.ReadUInt8(2);
+	backTransitionReaction = view.ReadUInt8(3);
+	actorNum = view.ReadInt16(4);
+	posX = view.ReadInt16(6);
+	posY = view.ReadInt16(8);
+	posZ = view.ReadInt16(10);
+	rotY = view.ReadInt16(12);
+	initVar = view.ReadInt16(14);
 }
 
 std::string TransitionActorEntry::GetBodySourceCode() const
 {
-	std::string actorStr = ZNames::GetActorName(actorNum);
+	std::string actorStr = ZNames::GetActorName(actorNum, game);
 
 	return StringHelper::Sprintf("%i, %i, %i, %i, %s, %i, %i, %i, %i, 0x%04X", frontObjectRoom,
 	                             frontTransitionReaction, backObjectRoom, backTransitionReaction,
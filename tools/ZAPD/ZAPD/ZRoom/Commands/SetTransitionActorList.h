@@ -13,8 +13,9 @@ public:
 	int16_t posX, posY, posZ;
 	int16_t rotY;
 	uint16_t initVar;
+	ZGame game;
 
-	TransitionActorEntry(const std::vector<uint8_t>& rawData, int rawDataIndex);
+	TransitionActorEntry(ByteSpan rawData, int rawDataIndex, ZGame nGame);
 
 	std::string GetBodySourceCode() const;
 };
@@ -1,5 +1,6 @@
 #include "SetWorldMapVisited.h"
 
+#include "ExtractionContext.h"
 #include "Utils/StringHelper.h"
 #include "Globals.h"
 
@@ -9,7 +10,7 @@ SetWorldMapVisited::SetWorldMapVisited(ZFile* nParent) : ZRoomCommand(nParent)
 
 std::string SetWorldMapVisited::GetBodySourceCode() const
 {
-	if (Globals::Instance->game == ZGame::MM_RETAIL)
+	if (parent->ctx->game == ZGame::MM_RETAIL)
 		return "SCENE_CMD_SET_REGION_VISITED()";
 	else
 		return "SCENE_CMD_MISC_SETTINGS()";
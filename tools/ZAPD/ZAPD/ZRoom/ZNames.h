@@ -11,13 +11,13 @@ public:
 	static std::string GetObjectName(size_t id)
 	{
 		if (id >= Globals::Instance->cfg.objectList.size())
-			return StringHelper::Sprintf("0x%04X", id);
+			return StringHelper::Sprintf("0x%04zX", id);
 		return Globals::Instance->cfg.objectList[id];
 	}
 
-	static std::string GetActorName(uint16_t id)
+	static std::string GetActorName(uint16_t id, ZGame game)
 	{
-		switch (Globals::Instance->game)
+		switch (game)
 		{
 		case ZGame::OOT_RETAIL:
 		case ZGame::OOT_SW97:
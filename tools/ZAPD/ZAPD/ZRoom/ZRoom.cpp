@@ -38,6 +38,7 @@
 #include "Commands/Unused09.h"
 #include "Commands/Unused1D.h"
 #include "Commands/ZRoomCommandUnk.h"
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/File.h"
 #include "Utils/Path.h"
@@ -152,103 +153,103 @@ void ZRoom::ParseRawData()
 		switch (opcode)
 		{
 		case RoomCommand::SetStartPositionList:
-			cmd = new SetStartPositionList(parent);
+			cmd = new (parent) SetStartPositionList(parent);
 			break;  // 0x00
 		case RoomCommand::SetActorList:
-			cmd = new SetActorList(parent);
+			cmd = new (parent) SetActorList(parent);
 			break;  // 0x01
 		case RoomCommand::SetCsCamera:
-			cmd = new SetCsCamera(parent);
+			cmd = new (parent) SetCsCamera(parent);
 			break;  // 0x02 (MM-ONLY)
 		case RoomCommand::SetCollisionHeader:
-			cmd = new SetCollisionHeader(parent);
+			cmd = new (parent) SetCollisionHeader(parent);
 			break;  // 0x03
 		case RoomCommand::SetRoomList:
-			cmd = new SetRoomList(parent);
+			cmd = new (parent) SetRoomList(parent);
 			break;  // 0x04
 		case RoomCommand::SetWind:
-			cmd = new SetWind(parent);
+			cmd = new (parent) SetWind(parent);
 			break;  // 0x05
 		case RoomCommand::SetEntranceList:
-			cmd = new SetEntranceList(parent);
+			cmd = new (parent) SetEntranceList(parent);
 			break;  // 0x06
 		case RoomCommand::SetSpecialObjects:
-			cmd = new SetSpecialObjects(parent);
+			cmd = new (parent) SetSpecialObjects(parent);
 			break;  // 0x07
 		case RoomCommand::SetRoomBehavior:
-			cmd = new SetRoomBehavior(parent);
+			cmd = new (parent) SetRoomBehavior(parent);
 			break;  // 0x08
 		case RoomCommand::Unused09:
-			cmd = new Unused09(parent);
+			cmd = new (parent) Unused09(parent);
 			break;  // 0x09
 		case RoomCommand::SetMesh:
-			cmd = new SetMesh(parent);
+			cmd = new (parent) SetMesh(parent);
 			break;  // 0x0A
 		case RoomCommand::SetObjectList:
-			cmd = new SetObjectList(parent);
+			cmd = new (parent) SetObjectList(parent);
 			break;  // 0x0B
 		case RoomCommand::SetLightList:
-			cmd = new SetLightList(parent);
+			cmd = new (parent) SetLightList(parent);
 			break;  // 0x0C (MM-ONLY)
 		case RoomCommand::SetPathways:
-			cmd = new SetPathways(parent);
+			cmd = new (parent) SetPathways(parent);
 			break;  // 0x0D
 		case RoomCommand::SetTransitionActorList:
-			cmd = new SetTransitionActorList(parent);
+			cmd = new (parent) SetTransitionActorList(parent);
 			break;  // 0x0E
 		case RoomCommand::SetLightingSettings:
-			cmd = new SetLightingSettings(parent);
+			cmd = new (parent) SetLightingSettings(parent);
 			break;  // 0x0F
 		case RoomCommand::SetTimeSettings:
-			cmd = new SetTimeSettings(parent);
+			cmd = new (parent) SetTimeSettings(parent);
 			break;  // 0x10
 		case RoomCommand::SetSkyboxSettings:
-			cmd = new SetSkyboxSettings(parent);
+			cmd = new (parent) SetSkyboxSettings(parent);
 			break;  // 0x11
 		case RoomCommand::SetSkyboxModifier:
-			cmd = new SetSkyboxModifier(parent);
+			cmd = new (parent) SetSkyboxModifier(parent);
 			break;  // 0x12
 		case RoomCommand::SetExitList:
-			cmd = new SetExitList(parent);
+			cmd = new (parent) SetExitList(parent);
 			break;  // 0x13
 		case RoomCommand::EndMarker:
-			cmd = new EndMarker(parent);
+			cmd = new (parent) EndMarker(parent);
 			break;  // 0x14
 		case RoomCommand::SetSoundSettings:
-			cmd = new SetSoundSettings(parent);
+			cmd = new (parent) SetSoundSettings(parent);
 			break;  // 0x15
 		case RoomCommand::SetEchoSettings:
-			cmd = new SetEchoSettings(parent);
+			cmd = new (parent) SetEchoSettings(parent);
 			break;  // 0x16
 		case RoomCommand::SetCutscenes:
-			cmd = new SetCutscenes(parent);
+			cmd = new (parent) SetCutscenes(parent);
 			break;  // 0x17
 		case RoomCommand::SetAlternateHeaders:
-			cmd = new SetAlternateHeaders(parent);
+			cmd = new (parent) SetAlternateHeaders(parent);
 			break;  // 0x18
 		case RoomCommand::SetCameraSettings:
-			if (Globals::Instance->game == ZGame::MM_RETAIL)
-				cmd = new SetWorldMapVisited(parent);
+			if (parent->ctx->game == ZGame::MM_RETAIL)
+				cmd = new (parent) SetWorldMapVisited(parent);
 			else
-				cmd = new SetCameraSettings(parent);
+				cmd = new (parent) SetCameraSettings(parent);
 			break;  // 0x19
 		case RoomCommand::SetAnimatedMaterialList:
-			cmd = new SetAnimatedMaterialList(parent);
+			cmd = new (parent) SetAnimatedMaterialList(parent);
 			break;  // 0x1A (MM-ONLY)
 		case RoomCommand::SetActorCutsceneList:
-			cmd = new SetActorCutsceneList(parent);
+			cmd = new (parent) SetActorCutsceneList(parent);
 			break;  // 0x1B (MM-ONLY)
 		case RoomCommand::SetMinimapList:
-			cmd = new SetMinimapList(parent);
+			cmd = new (parent) SetMinimapList(parent);
 			break;  // 0x1C (MM-ONLY)
 		case RoomCommand::Unused1D:
-			cmd = new Unused1D(parent);
+			cmd = new (parent) Unused1D(parent);
 			break;  // 0x1D
 		case RoomCommand::SetMinimapChests:
-			cmd = new SetMinimapChests(parent);
+			cmd = new (parent) SetMinimapChests(parent);
 			break;  // 0x1E (MM-ONLY)
 		default:
-			cmd = new ZRoomCommandUnk(parent);
+			cmd = new (parent) ZRoomCommandUnk(parent);
 		}
 
 		cmd->commandSet = rawDataIndex;
@@ -315,7 +316,7 @@ std::string ZRoom::GetBodySourceCode() const
 	for (size_t i = 0; i < commands.size(); i++)
 	{
 		ZRoomCommand* cmd = commands[i];
-		declaration += StringHelper::Sprintf("\t%s,", cmd->GetBodySourceCode().c_str());
+		StringHelper::AppendFormat(declaration, "\t%s,", cmd->GetBodySourceCode().c_str());
 
 		if (i + 1 < commands.size())
 			declaration += "\n";
@@ -1,6 +1,6 @@
 #include "ZRoomCommand.h"
 
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 #include "ZRoom.h"
 
@@ -18,12 +18,12 @@ void ZRoomCommand::ExtractCommandFromRoom(ZRoom* nZRoom, uint32_t nRawDataIndex)
 
 void ZRoomCommand::ParseRawData()
 {
-	auto& parentRawData = parent->GetRawData();
-	cmdID = static_cast<RoomCommand>(parentRawData.at(rawDataIndex));
+	BEView view(parent->GetRawData(), rawDataIndex, 8);
+	cmdID = static_cast<RoomCommand>(view.ReadUInt8(0));
 	cmdAddress = rawDataIndex;
 
-	cmdArg1 = parentRawData.at(rawDataIndex + 1);
-	cmdArg2 = BitConverter::ToUInt32BE(parentRawData, rawDataIndex + 4);
+	cmdArg1 = view.ReadUInt8(1);
+	cmdArg2 = view.ReadUInt32(4);
 	segmentOffset = Seg2Filespace(cmdArg2, parent->baseAddress);
 }
 
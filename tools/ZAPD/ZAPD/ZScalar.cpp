@@ -1,8 +1,11 @@
 #include "ZScalar.h"
 
+#include <cinttypes>
+
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/File.h"
+#include "Utils/NumericEmitter.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 #include "ZFile.h"
@@ -170,42 +173,42 @@ size_t ZScalar::GetRawDataSize() const
 
 void ZScalar::ParseRawData()
 {
-	const auto& rawData = parent->GetRawData();
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
 	switch (scalarType)
 	{
 	case ZScalarType::ZSCALAR_S8:
-		scalarData.s8 = BitConverter::ToInt8BE(rawData, rawDataIndex);
+		scalarData.s8 = view.ReadInt8(0);
 		break;
 	case ZScalarType::ZSCALAR_U8:
 	case ZScalarType::ZSCALAR_X8:
-		scalarData.u8 = BitConverter::ToUInt8BE(rawData, rawDataIndex);
+		scalarData.u8 = view.ReadUInt8(0);
 		break;
 	case ZScalarType::ZSCALAR_S16:
-		scalarData.s16 = BitConverter::ToInt16BE(rawData, rawDataIndex);
+		scalarData.s16 = view.ReadInt16(0);
 		break;
 	case ZScalarType::ZSCALAR_U16:
 	case ZScalarType::ZSCALAR_X16:
-		scalarData.u16 = BitConverter::ToUInt16BE(rawData, rawDataIndex);
+		scalarData.u16 = view.ReadUInt16(0);
 		break;
 	case ZScalarType::ZSCALAR_S32:
-		scalarData.s32 = BitConverter::ToInt32BE(rawData, rawDataIndex);
+		scalarData.s32 = view.ReadInt32(0);
 		break;
 	case ZScalarType::ZSCALAR_U32:
 	case ZScalarType::ZSCALAR_X32:
-		scalarData.u32 = BitConverter::ToUInt32BE(rawData, rawDataIndex);
+		scalarData.u32 = view.ReadUInt32(0);
 		break;
 	case ZScalarType::ZSCALAR_S64:
-		scalarData.s64 = BitConverter::ToInt64BE(rawData, rawDataIndex);
+		scalarData.s64 = view.ReadInt64(0);
 		break;
 	case ZScalarType::ZSCALAR_U64:
 	case ZScalarType::ZSCALAR_X64:
-		scalarData.u64 = BitConverter::ToUInt64BE(rawData, rawDataIndex);
+		scalarData.u64 = view.ReadUInt64(0);
 		break;
 	case ZScalarType::ZSCALAR_F32:
-		scalarData.f32 = BitConverter::ToFloatBE(rawData, rawDataIndex);
+		scalarData.f32 = view.ReadFloat(0);
 		break;
 	case ZScalarType::ZSCALAR_F64:
-		scalarData.f64 = BitConverter::ToDoubleBE(rawData, rawDataIndex);
+		scalarData.f64 = view.ReadDouble(0);
 		break;
 	case ZScalarType::ZSCALAR_NONE:
 		HANDLE_ERROR_RESOURCE(WarningType::InvalidAttributeValue, parent, this, rawDataIndex,
@@ -221,32 +224,46 @@ std::string ZScalar::GetSourceTypeName() const
 
 std::string ZScalar::GetBodySourceCode() const
 {
+	std::string body;
+	NumericEmitter emitter(body);
+
 	switch (scalarType)
 	{
 	case ZScalarType::ZSCALAR_S8:
-		return StringHelper::Sprintf("%hhd", scalarData.s8);
+		emitter.Decimal(scalarData.s8);
+		return body;
 	case ZScalarType::ZSCALAR_U8:
-		return StringHelper::Sprintf("%hhu", scalarData.u8);
+		emitter.UnsignedDecimal(scalarData.u8);
+		return body;
 	case ZScalarType::ZSCALAR_X8:
-		return StringHelper::Sprintf("0x%02X", scalarData.u8);
+		emitter.Hex(scalarData.u8, 2);
+		return body;
 	case ZScalarType::ZSCALAR_S16:
-		return StringHelper::Sprintf("%hd", scalarData.s16);
+		emitter.Decimal(scalarData.s16);
+		return body;
 	case ZScalarType::ZSCALAR_U16:
-		return StringHelper::Sprintf("%hu", scalarData.u16);
+		emitter.UnsignedDecimal(scalarData.u16);
+		return body;
 	case ZScalarType::ZSCALAR_X16:
-		return StringHelper::Sprintf("0x%04X", scalarData.u16);
+		emitter.Hex(scalarData.u16, 4);
+		return body;
 	case ZScalarType::ZSCALAR_S32:
-		return StringHelper::Sprintf("%d", scalarData.s32);
+		emitter.Decimal(scalarData.s32);
+		return body;
 	case ZScalarType::ZSCALAR_U32:
-		return StringHelper::Sprintf("%u", scalarData.u32);
+		emitter.UnsignedDecimal(scalarData.u32);
+		return body;
 	case ZScalarType::ZSCALAR_X32:
-		return StringHelper::Sprintf("0x%08X", scalarData.u32);
+		emitter.Hex(scalarData.u32, 8);
+		return body;
 	case ZScalarType::ZSCALAR_S64:
-		return StringHelper::Sprintf("%lld", scalarData.s64);
+		emitter.Decimal(scalarData.s64);
+		return body;
 	case ZScalarType::ZSCALAR_U64:
-		return StringHelper::Sprintf("%llu", scalarData.u64);
+		emitter.UnsignedDecimal(scalarData.u64);
+		return body;
 	case ZScalarType::ZSCALAR_X64:
-		return StringHelper::Sprintf("0x%016X", scalarData.u64);
+		return StringHelper::Sprintf("0x%016" PRIX64, scalarData.u64);
 	case ZScalarType::ZSCALAR_F32:
 		return StringHelper::Sprintf("%f", scalarData.f32);
 	case ZScalarType::ZSCALAR_F64:
@@ -2,8 +2,10 @@
 
 #include <cassert>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
+#include "Utils/Profiler.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 
@@ -86,13 +88,13 @@ void ZSkeleton::ParseRawData()
 {
 	ZResource::ParseRawData();
 
-	const auto& rawData = parent->GetRawData();
-	limbsArrayAddress = BitConverter::ToUInt32BE(rawData, rawDataIndex);
-	limbCount = BitConverter::ToUInt8BE(rawData, rawDataIndex + 4);
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
+	limbsArrayAddress = view.ReadUInt32(0);
+	limbCount = view.ReadUInt8(4);
 
 	if (type == ZSkeletonType::Flex)
 	{
-		dListCount = BitConverter::ToUInt8BE(rawData, rawDataIndex + 8);
+		dListCount = view.ReadUInt8(8);
 	}
 }
 
@@ -110,7 +112,7 @@ void ZSkeleton::DeclareReferences(const std::string& prefix)
 
 		if (!parent->HasDeclaration(ptr))
 		{
-			limbsTable = new ZLimbTable(parent);
+			limbsTable = new (parent) ZLimbTable(parent);
 			limbsTable->ExtractFromBinary(ptr, limbType, limbCount);
 			limbsTable->SetName(StringHelper::Sprintf("%sLimbs", defaultPrefix.c_str()));
 			parent->AddResource(limbsTable);
@@ -138,7 +140,7 @@ void ZSkeleton::DeclareReferences(const std::string& prefix)
 std::string ZSkeleton::GetBodySourceCode() const
 {
 	std::string limbArrayName;
-	Globals::Instance->GetSegmentedPtrName(limbsArrayAddress, parent, "", limbArrayName);
+	parent->ctx->GetSegmentedPtrName(limbsArrayAddress, parent, rawDataIndex, "", limbArrayName);
 
 	std::string countStr;
 	assert(limbsTable != nullptr);
@@ -227,6 +229,7 @@ void ZLimbTable::ExtractFromBinary(uint32_t nRawDataIndex, ZLimbType nLimbType,
 	limbType = nLimbType;
 	count = nCount;
 
+	ProfileScope scope("ParseRawData", GetResourceTypeName(GetResourceType()), name);
 	ParseRawData();
 }
 
@@ -285,15 +288,8 @@ void ZLimbTable::ParseRawData()
 {
 	ZResource::ParseRawData();
 
-	const auto& rawData = parent->GetRawData();
-	uint32_t ptr = rawDataIndex;
-
-	limbsAddresses.reserve(count);
-	for (size_t i = 0; i < count; i++)
-	{
-		limbsAddresses.push_back(BitConverter::ToUInt32BE(rawData, ptr));
-		ptr += 4;
-	}
+	BEView view(parent->GetRawData(), rawDataIndex, 4 * count);
+	limbsAddresses = view.ReadArray<segptr_t>(0, count);
 }
 
 void ZLimbTable::DeclareReferences(const std::string& prefix)
@@ -315,7 +311,7 @@ void ZLimbTable::DeclareReferences(const std::string& prefix)
 
 			if (!parent->HasDeclaration(limbOffset))
 			{
-				limb = new ZLimb(parent);
+				limb = new (parent) ZLimb(parent);
 				limb->ExtractFromBinary(limbOffset, limbType);
 				limb->SetName(limb->GetDefaultName(varPrefix));
 				limb->DeclareVar(varPrefix, "");
@@ -358,7 +354,8 @@ std::string ZLimbTable::GetBodySourceCode() const
 	for (size_t i = 0; i < count; i++)
 	{
 		std::string limbName;
-		Globals::Instance->GetSegmentedPtrName(limbsAddresses[i], parent, "", limbName);
+		parent->ctx->GetSegmentedPtrName(limbsAddresses[i], parent, rawDataIndex + i * 4, "",
+		                                 limbName);
 		body += StringHelper::Sprintf("\t%s,", limbName.c_str());
 
 		auto& limb = limbsReferences.at(i);
@@ -401,14 +398,14 @@ std::string ZLimbTable::GetSourceOutputHeader([[maybe_unused]] const std::string
 				WarningType::MissingAttribute, parent, this, rawDataIndex,
 				"Skeleton's enum attributes were used but at least one limb is missing its "
 				"'LimbName' attribute",
-				StringHelper::Sprintf("When processing limb %02i, named '%s' at offset '0x%X'",
+				StringHelper::Sprintf("When processing limb %02zu, named '%s' at offset '0x%X'",
 			                          i + 1, limb->GetName().c_str(), limb->GetRawDataIndex()));
 		}
 
-		limbEnum += StringHelper::Sprintf("    /* 0x%02X */ %s,\n", i + 1, limbEnumName.c_str());
+		limbEnum += StringHelper::Sprintf("    /* 0x%02zX */ %s,\n", i + 1, limbEnumName.c_str());
 	}
 
-	limbEnum += StringHelper::Sprintf("    /* 0x%02X */ %s\n", i + 1, limbMaxName.c_str());
+	limbEnum += StringHelper::Sprintf("    /* 0x%02zX */ %s\n", i + 1, limbMaxName.c_str());
 
 	limbEnum += StringHelper::Sprintf("} %s;\n", enumName.c_str());
 
@@ -1,7 +1,7 @@
 #include "ZSurfaceType.h"
 
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 
 REGISTER_ZFILENODE(SurfaceType, ZSurfaceType);
@@ -16,10 +16,8 @@ ZSurfaceType::~ZSurfaceType()
 
 void ZSurfaceType::ParseRawData()
 {
-	const auto& rawData = parent->GetRawData();
-
-	data[0] = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0);
-	data[1] = BitConverter::ToUInt32BE(rawData, rawDataIndex + 4);
+	BEView view(parent->GetRawData(), rawDataIndex, GetRawDataSize());
+	view.ReadArray(0, data.data(), data.size());
 }
 
 void ZSurfaceType::DeclareReferences(const std::string& prefix)
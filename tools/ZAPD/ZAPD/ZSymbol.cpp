@@ -60,6 +60,16 @@ void ZSymbol::ParseXML(tinyxml2::XMLElement* reader)
 	staticConf = StaticConfig::Off;
 }
 
+void ZSymbol::SetSymbolInfo(const std::string& nType, size_t nTypeSize, bool nIsArray,
+                            uint32_t nCount)
+{
+	type = nType;
+	typeSize = nTypeSize;
+	isArray = nIsArray;
+	count = nCount;
+	staticConf = StaticConfig::Off;
+}
+
 Declaration* ZSymbol::DeclareVar([[maybe_unused]] const std::string& prefix,
                                  [[maybe_unused]] const std::string& bodyStr)
 {
@@ -74,6 +84,21 @@ size_t ZSymbol::GetRawDataSize() const
 	return typeSize;
 }
 
+size_t ZSymbol::GetTypeSize() const
+{
+	return typeSize;
+}
+
+bool ZSymbol::IsArray() const
+{
+	return isArray;
+}
+
+uint32_t ZSymbol::GetCount() const
+{
+	return count;
+}
+
 std::string ZSymbol::GetSourceOutputHeader([[maybe_unused]] const std::string& prefix)
 {
 	if (isArray)
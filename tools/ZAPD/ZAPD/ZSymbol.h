@@ -15,6 +15,10 @@ public:
 	ZSymbol(ZFile* nParent);
 
 	void ParseXML(tinyxml2::XMLElement* reader) override;
+	/**
+	 * Sets what `ParseXML` reads from the XML, for symbols restored from a snapshot
+	 */
+	void SetSymbolInfo(const std::string& nType, size_t nTypeSize, bool nIsArray, uint32_t nCount);
 
 	Declaration* DeclareVar(const std::string& prefix, const std::string& bodyStr) override;
 
@@ -24,4 +28,7 @@ public:
 	ZResourceType GetResourceType() const override;
 
 	size_t GetRawDataSize() const override;
+	size_t GetTypeSize() const;
+	bool IsArray() const;
+	uint32_t GetCount() const;
 };
@@ -2,12 +2,15 @@
 
 #include <cassert>
 
-#include "CRC32.h"
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/Directory.h"
 #include "Utils/File.h"
+#include "Utils/Hash.h"
+#include "Utils/NumericEmitter.h"
 #include "Utils/Path.h"
+#include "Utils/Profiler.h"
 #include "WarningHandler.h"
 
 REGISTER_ZFILENODE(Texture, ZTexture);
@@ -43,6 +46,7 @@ void ZTexture::ExtractFromBinary(uint32_t nRawDataIndex, int32_t nWidth, int32_t
 	if (parent->GetMode() == ZFileMode::ExternalFile)
 		return;
 
+	ProfileScope scope("ParseRawData", GetResourceTypeName(GetResourceType()), name);
 	ParseRawData();
 	CalcHash();
 }
@@ -134,41 +138,96 @@ void ZTexture::ParseRawData()
 	if (rawDataIndex % 8 != 0)
 		dWordAligned = false;
 
-	switch (format)
+	// Nothing but `Save` needs the decoded texture. Invalid textures are still decoded right away,
+	// to report them while parsing.
+	textureDataPending = true;
+	if (format == TextureType::Error ||
+	    rawDataIndex + GetRawDataSize() > parent->GetRawData().size())
+		DecodeTextureData();
+}
+
+void ZTexture::DecodeTextureData()
+{
+	textureDataPending = false;
+
+	const auto& parentRawData = parent->GetRawData();
+	size_t rawDataSize = GetRawDataSize();
+
+	if (format == TextureType::Error)
+	{
+		HANDLE_ERROR_RESOURCE(WarningType::InvalidAttributeValue, parent, this, rawDataIndex,
+		                      "Invalid texture format", "");
+	}
+	if (GetPixelMultiplyer() < 1 && width % 2 != 0)
 	{
-	case TextureType::RGBA16bpp:
-		ConvertN64ToBitmap_RGBA16();
-		break;
-	case TextureType::RGBA32bpp:
-		ConvertN64ToBitmap_RGBA32();
-		break;
-	case TextureType::Grayscale4bpp:
-		ConvertN64ToBitmap_Grayscale4();
-		break;
-	case TextureType::Grayscale8bpp:
-		ConvertN64ToBitmap_Grayscale8();
-		break;
-	case TextureType::GrayscaleAlpha4bpp:
-		ConvertN64ToBitmap_GrayscaleAlpha4();
-		break;
-	case TextureType::GrayscaleAlpha8bpp:
-		ConvertN64ToBitmap_GrayscaleAlpha8();
-		break;
-	case TextureType::GrayscaleAlpha16bpp:
-		ConvertN64ToBitmap_GrayscaleAlpha16();
-		break;
-	case TextureType::Palette4bpp:
-		ConvertN64ToBitmap_Palette4();
-		break;
-	case TextureType::Palette8bpp:
-		ConvertN64ToBitmap_Palette8();
-		break;
-	case TextureType::Error:
 		HANDLE_ERROR_RESOURCE(WarningType::InvalidAttributeValue, parent, this, rawDataIndex,
-		                      StringHelper::Sprintf("Invalid texture format", format), "");
-		assert(!"TODO");
-		break;
+		                      "4-bit textures must have an even width", "");
 	}
+	if (rawDataIndex + rawDataSize > parentRawData.size())
+	{
+		HANDLE_ERROR_RESOURCE(
+			WarningType::InvalidExtractedData, parent, this, rawDataIndex,
+			"texture goes past the end of the file",
+			StringHelper::Sprintf("texture is 0x%zX bytes long, file is 0x%zX bytes long",
+		                          rawDataSize, parentRawData.size()));
+	}
+
+	PixelLayout layout = TextureCodec::GetDecodedLayout(format);
+	if (layout == PixelLayout::Index)
+		textureData.InitEmptyPaletteImage(width, height);
+	else
+		textureData.InitEmptyRGBImage(width, height, layout == PixelLayout::RGBA);
+
+	// Neither the texture nor the image have padding between rows, so they're converted as one
+	// long row
+	uint8_t* pixels = textureData.GetPixels();
+	TextureCodec::DecodeRow(format, parentRawData.data() + rawDataIndex, pixels, width * height);
+
+	if (layout == PixelLayout::Index)
+	{
+		// Without a TLUT, the indices in use are shown as shades of gray
+		bool indexUsed[256] = {};
+		for (size_t i = 0; i < width * height; i++)
+			indexUsed[pixels[i]] = true;
+
+		uint8_t grayStep = (format == TextureType::Palette4bpp) ? 16 : 1;
+		for (size_t index = 0; index < 256; index++)
+		{
+			if (indexUsed[index])
+			{
+				uint8_t gray = index * grayStep;
+				textureData.SetPaletteIndex(index, gray, gray, gray, 255);
+			}
+		}
+	}
+
+	if (!tlutColors.empty())
+		textureData.SetPalette(tlutColors, splitTlut ? 128 : 0);
+}
+
+uint64_t ZTexture::GetContentKey() const
+{
+	const auto& parentRawData = parent->GetRawData();
+	const PngEncodeProfile& profile = Globals::Instance->pngProfile;
+	// The profile changes the bytes of the PNG, not its pixels
+	uint32_t header[] = {static_cast<uint32_t>(format),
+	                     width,
+	                     height,
+	                     static_cast<uint32_t>(tlutColors.size()),
+	                     splitTlut ? 128u : 0u,
+	                     static_cast<uint32_t>(profile.compressionLevel),
+	                     static_cast<uint32_t>(profile.compressionStrategy),
+	                     static_cast<uint32_t>(profile.filters)};
+
+	uint64_t key = Hash::Fnv1a64(header, sizeof(header));
+	key = Hash::Fnv1a64(parentRawData.data() + rawDataIndex, GetRawDataSize(), key);
+	for (const RGBAPixel& color : tlutColors)
+	{
+		uint8_t rgba[] = {color.r, color.g, color.b, color.a};
+		key = Hash::Fnv1a64(rgba, sizeof(rgba), key);
+	}
+
+	return key;
 }
 
 void ZTexture::ParseRawDataLate()
@@ -176,7 +235,7 @@ void ZTexture::ParseRawDataLate()
 	if (registeredAttributes["ExternalTlut"].wasSet)
 	{
 		const std::string externPalette = registeredAttributes["ExternalTlut"].value;
-		for (const auto& file : Globals::Instance->files)
+		for (const auto& file : parent->ctx->files)
 		{
 			if (file->GetName() == externPalette)
 			{
@@ -212,192 +271,6 @@ void ZTexture::ParseRawDataLate()
 	}
 }
 
-void ZTexture::ConvertN64ToBitmap_RGBA16()
-{
-	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			int32_t pos = rawDataIndex + ((y * width) + x) * 2;
-			uint16_t data = parentRawData.at(pos + 1) | (parentRawData.at(pos) << 8);
-			uint8_t r = (data & 0xF800) >> 11;
-			uint8_t g = (data & 0x07C0) >> 6;
-			uint8_t b = (data & 0x003E) >> 1;
-			uint8_t alpha = data & 0x01;
-
-			textureData.SetRGBPixel(y, x, (r << 3) | (r >> 2), (g << 3) | (g >> 2),
-			                        (b << 3) | (b >> 2), alpha * 255);
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_RGBA32()
-{
-	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 4;
-			uint8_t r = parentRawData.at(pos + 0);
-			uint8_t g = parentRawData.at(pos + 1);
-			uint8_t b = parentRawData.at(pos + 2);
-			uint8_t alpha = parentRawData.at(pos + 3);
-
-			textureData.SetRGBPixel(y, x, r, g, b, alpha);
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_Grayscale4()
-{
-	textureData.InitEmptyRGBImage(width, height, false);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x += 2)
-		{
-			for (uint8_t i = 0; i < 2; i++)
-			{
-				size_t pos = rawDataIndex + ((y * width) + x) / 2;
-				uint8_t grayscale = 0;
-
-				if (i == 0)
-					grayscale = parentRawData.at(pos) & 0xF0;
-				else
-					grayscale = (parentRawData.at(pos) & 0x0F) << 4;
-
-				textureData.SetGrayscalePixel(y, x + i, (grayscale << 4) | grayscale);
-			}
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_Grayscale8()
-{
-	textureData.InitEmptyRGBImage(width, height, false);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 1;
-
-			textureData.SetGrayscalePixel(y, x, parentRawData.at(pos));
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha4()
-{
-	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x += 2)
-		{
-			for (uint16_t i = 0; i < 2; i++)
-			{
-				size_t pos = rawDataIndex + ((y * width) + x) / 2;
-				uint8_t data = 0;
-
-				if (i == 0)
-					data = (parentRawData.at(pos) & 0xF0) >> 4;
-				else
-					data = parentRawData.at(pos) & 0x0F;
-
-				uint8_t grayscale = data & 0b1110;
-				grayscale = (grayscale << 4) | (grayscale << 1) | (grayscale >> 2);
-				uint8_t alpha = (data & 0x01) ? 255 : 0;
-
-				textureData.SetGrayscalePixel(y, x + i, grayscale, alpha);
-			}
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha8()
-{
-	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 1;
-			uint8_t pixel = parentRawData.at(pos);
-			uint8_t data = (pixel >> 4) & 0xF;
-
-			data = (data << 4) | data;
-			uint8_t grayscale = data;
-			uint8_t alpha = (pixel & 0xF);
-			alpha = (alpha << 4) | alpha;
-
-			textureData.SetGrayscalePixel(y, x, grayscale, alpha);
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha16()
-{
-	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 2;
-			uint8_t grayscale = parentRawData.at(pos + 0);
-			uint8_t alpha = parentRawData.at(pos + 1);
-
-			textureData.SetGrayscalePixel(y, x, grayscale, alpha);
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_Palette4()
-{
-	textureData.InitEmptyPaletteImage(width, height);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x += 2)
-		{
-			for (uint16_t i = 0; i < 2; i++)
-			{
-				size_t pos = rawDataIndex + ((y * width) + x) / 2;
-				uint8_t paletteIndex = 0;
-
-				if (i == 0)
-					paletteIndex = (parentRawData.at(pos) & 0xF0) >> 4;
-				else
-					paletteIndex = (parentRawData.at(pos) & 0x0F);
-
-				textureData.SetIndexedPixel(y, x + i, paletteIndex, paletteIndex * 16);
-			}
-		}
-	}
-}
-
-void ZTexture::ConvertN64ToBitmap_Palette8()
-{
-	textureData.InitEmptyPaletteImage(width, height);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 1;
-			uint8_t grayscale = parentRawData.at(pos);
-
-			textureData.SetIndexedPixel(y, x, grayscale, grayscale);
-		}
-	}
-}
-
 void ZTexture::DeclareReferences([[maybe_unused]] const std::string& prefix)
 {
 	if (tlutOffset != static_cast<uint32_t>(-1))
@@ -409,7 +282,7 @@ void ZTexture::DeclareReferences([[maybe_unused]] const std::string& prefix)
 			if (format == TextureType::Palette4bpp)
 				tlutDim = 4;
 
-			tlut = new ZTexture(parent);
+			tlut = new (parent) ZTexture(parent);
 			tlut->ExtractFromBinary(tlutOffset, tlutDim, tlutDim, TextureType::RGBA16bpp, true);
 			parent->AddTextureResource(tlutOffset, tlut);
 			tlut->DeclareVar(prefix, "");
@@ -429,201 +302,25 @@ void ZTexture::PrepareRawDataFromFile(const fs::path& pngFilePath)
 	width = textureData.GetWidth();
 	height = textureData.GetHeight();
 
-	textureDataRaw.clear();
-	textureDataRaw.resize(ALIGN8(GetRawDataSize()));
-
-	switch (format)
-	{
-	case TextureType::RGBA16bpp:
-		ConvertBitmapToN64_RGBA16();
-		break;
-	case TextureType::RGBA32bpp:
-		ConvertBitmapToN64_RGBA32();
-		break;
-	case TextureType::Grayscale4bpp:
-		ConvertBitmapToN64_Grayscale4();
-		break;
-	case TextureType::Grayscale8bpp:
-		ConvertBitmapToN64_Grayscale8();
-		break;
-	case TextureType::GrayscaleAlpha4bpp:
-		ConvertBitmapToN64_GrayscaleAlpha4();
-		break;
-	case TextureType::GrayscaleAlpha8bpp:
-		ConvertBitmapToN64_GrayscaleAlpha8();
-		break;
-	case TextureType::GrayscaleAlpha16bpp:
-		ConvertBitmapToN64_GrayscaleAlpha16();
-		break;
-	case TextureType::Palette4bpp:
-		ConvertBitmapToN64_Palette4();
-		break;
-	case TextureType::Palette8bpp:
-		ConvertBitmapToN64_Palette8();
-		break;
-	case TextureType::Error:
+	if (format == TextureType::Error)
 		HANDLE_ERROR_PROCESS(WarningType::InvalidPNG, "Input PNG file has invalid format type", "");
-		break;
-	}
-}
-
-void ZTexture::ConvertBitmapToN64_RGBA16()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 2;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
-
-			uint8_t r = pixel.r >> 3;
-			uint8_t g = pixel.g >> 3;
-			uint8_t b = pixel.b >> 3;
-
-			uint8_t alphaBit = pixel.a != 0;
-
-			uint16_t data = (r << 11) | (g << 6) | (b << 1) | alphaBit;
-
-			textureDataRaw[pos + 0] = (data & 0xFF00) >> 8;
-			textureDataRaw[pos + 1] = (data & 0x00FF);
-		}
-	}
-}
-
-void ZTexture::ConvertBitmapToN64_RGBA32()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 4;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
-
-			textureDataRaw[pos + 0] = pixel.r;
-			textureDataRaw[pos + 1] = pixel.g;
-			textureDataRaw[pos + 2] = pixel.b;
-			textureDataRaw[pos + 3] = pixel.a;
-		}
-	}
-}
-
-void ZTexture::ConvertBitmapToN64_Grayscale4()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x += 2)
-		{
-			size_t pos = ((y * width) + x) / 2;
-			uint8_t r1 = textureData.GetPixel(y, x).r;
-			uint8_t r2 = textureData.GetPixel(y, x + 1).r;
-
-			textureDataRaw[pos] = (uint8_t)(((r1 / 16) << 4) + (r2 / 16));
-		}
-	}
-}
-
-void ZTexture::ConvertBitmapToN64_Grayscale8()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = (y * width) + x;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
-			textureDataRaw[pos] = pixel.r;
-		}
-	}
-}
+	if (GetPixelMultiplyer() < 1 && width % 2 != 0)
+		HANDLE_ERROR_PROCESS(WarningType::InvalidPNG, "4-bit textures must have an even width", "");
 
-void ZTexture::ConvertBitmapToN64_GrayscaleAlpha4()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x += 2)
-		{
-			size_t pos = ((y * width) + x) / 2;
-			uint8_t data = 0;
-
-			for (uint16_t i = 0; i < 2; i++)
-			{
-				RGBAPixel pixel = textureData.GetPixel(y, x + i);
-				uint8_t cR = pixel.r;
-				uint8_t alphaBit = pixel.a != 0;
-
-				if (i == 0)
-					data = (((cR >> 5) << 1) | alphaBit) << 4;
-				else
-					data |= ((cR >> 5) << 1) | alphaBit;
-			}
-
-			textureDataRaw[pos] = data;
-		}
-	}
-}
-
-void ZTexture::ConvertBitmapToN64_GrayscaleAlpha8()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 1;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
-
-			uint8_t r = (pixel.r >> 4) & 0xF;
-			uint8_t a = (pixel.a >> 4) & 0xF;
-
-			textureDataRaw[pos] = (r << 4) | a;
-		}
-	}
-}
-
-void ZTexture::ConvertBitmapToN64_GrayscaleAlpha16()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 2;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
-
-			uint8_t cR = pixel.r;
-			uint8_t aR = pixel.a;
-
-			textureDataRaw[pos + 0] = cR;
-			textureDataRaw[pos + 1] = aR;
-		}
-	}
-}
-
-void ZTexture::ConvertBitmapToN64_Palette4()
-{
-	for (uint16_t y = 0; y < height; y++)
+	PixelLayout layout = textureData.GetPixelLayout();
+	if (IsColorIndexed() != (layout == PixelLayout::Index))
 	{
-		for (uint16_t x = 0; x < width; x += 2)
-		{
-			size_t pos = ((y * width) + x) / 2;
-
-			uint8_t cR1 = textureData.GetIndexedPixel(y, x);
-			uint8_t cR2 = textureData.GetIndexedPixel(y, x + 1);
-
-			textureDataRaw[pos] = (cR1 << 4) | (cR2);
-		}
+		HANDLE_ERROR_PROCESS(WarningType::InvalidPNG,
+		                     IsColorIndexed() ? "CI textures must be stored in palette PNG files" :
+		                                        "palette PNG files can only store CI textures",
+		                     "");
 	}
-}
 
-void ZTexture::ConvertBitmapToN64_Palette8()
-{
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x);
-			uint8_t cR = textureData.GetIndexedPixel(y, x);
+	textureDataRaw.clear();
+	textureDataRaw.resize(ALIGN8(GetRawDataSize()));
 
-			textureDataRaw[pos] = cR;
-		}
-	}
+	TextureCodec::EncodeRow(format, layout, textureData.GetPixels(), textureDataRaw.data(),
+	                        width * height);
 }
 
 float ZTexture::GetPixelMultiplyer() const
@@ -732,8 +429,9 @@ void ZTexture::Save(const fs::path& outFolder)
 	// process for generating the Texture Pool XML.
 	if (Globals::Instance->outputCrc)
 	{
-		File::WriteAllText((Globals::Instance->outputPath / (outName + ".txt")).string(),
-		                   StringHelper::Sprintf("%08lX", hash));
+		fs::path crcPath = parent->ctx->outputPath / (outName + ".txt");
+		bool written = File::WriteAllTextIfChanged(crcPath, StringHelper::Sprintf("%08X", hash));
+		parent->ctx->AddOutputFile(crcPath, written);
 	}
 
 	auto outPath = GetPoolOutPath(outFolder);
@@ -755,7 +453,15 @@ void ZTexture::Save(const fs::path& outFolder)
 		printf("\t TLUT name: %s\n", tlut->name.c_str());
 #endif
 
-	textureData.WritePng(outFileName);
+	bool written = Globals::Instance->contentStore.SaveOutput(
+		outFileName, [this]() { return GetContentKey(); },
+		[&]() {
+			ProfileScope scope("EncodePng", "Texture", name);
+			if (textureDataPending)
+				DecodeTextureData();
+			return textureData.WritePng(outFileName, Globals::Instance->pngProfile);
+		});
+	parent->ctx->AddOutputFile(outFileName, written);
 
 #ifdef TEXTURE_DEBUG
 	printf("\n");
@@ -774,7 +480,7 @@ Declaration* ZTexture::DeclareVar(const std::string& prefix,
 	if (auxOutName == "")
 		auxOutName = GetDefaultName(prefix);
 
-	auto filepath = Globals::Instance->outputPath / fs::path(auxOutName).stem();
+	auto filepath = parent->ctx->outputPath / fs::path(auxOutName).stem();
 
 	if (dWordAligned)
 		incStr = StringHelper::Sprintf("%s.%s.inc.c", filepath.string().c_str(),
@@ -788,16 +494,14 @@ Declaration* ZTexture::DeclareVar(const std::string& prefix,
 		CalcHash();
 
 		// TEXTURE POOL CHECK
-		const auto& poolEntry = Globals::Instance->cfg.texturePool.find(hash);
-		if (poolEntry != Globals::Instance->cfg.texturePool.end())
+		const char* poolPath = Globals::Instance->cfg.texturePool.Find(hash);
+		if (poolPath != nullptr)
 		{
 			if (dWordAligned)
-				incStr =
-					StringHelper::Sprintf("%s.%s.inc.c", poolEntry->second.path.string().c_str(),
-				                          GetExternalExtension().c_str());
+				incStr = StringHelper::Sprintf("%s.%s.inc.c", poolPath,
+				                               GetExternalExtension().c_str());
 			else
-				incStr = StringHelper::Sprintf("%s.u32.%s.inc.c",
-				                               poolEntry->second.path.string().c_str(),
+				incStr = StringHelper::Sprintf("%s.u32.%s.inc.c", poolPath,
 				                               GetExternalExtension().c_str());
 		}
 	}
@@ -818,25 +522,54 @@ Declaration* ZTexture::DeclareVar(const std::string& prefix,
 		                                          GetRawDataSize() / texSizeDivisor);
 	}
 	decl->staticConf = staticConf;
+
+	// The C array is padded to a multiple of 8 bytes, which the size of the declaration isn't
+	if (GetRawDataSize() % 8 == 0)
+		decl->incbinPath =
+			StringHelper::Replace(std::string(decl->includePath), ".inc.c", ".bin");
+
 	return decl;
 }
 
+const std::vector<uint8_t>& ZTexture::GetRawTextureData() const
+{
+	return textureDataRaw;
+}
+
 std::string ZTexture::GetBodySourceCode() const
 {
 	std::string sourceOutput;
-	size_t texSizeInc = (dWordAligned) ? 8 : 4;
-	for (size_t i = 0; i < textureDataRaw.size(); i += texSizeInc)
+	NumericEmitter emitter(sourceOutput);
+
+	if (dWordAligned)
 	{
-		if (i % 32 == 0)
-			sourceOutput += "    ";
-		if (dWordAligned)
-			sourceOutput +=
-				StringHelper::Sprintf("0x%016llX, ", BitConverter::ToUInt64BE(textureDataRaw, i));
-		else
-			sourceOutput +=
-				StringHelper::Sprintf("0x%08llX, ", BitConverter::ToUInt32BE(textureDataRaw, i));
-		if (i % 32 == 24)
-			sourceOutput += StringHelper::Sprintf(" // 0x%06X \n", rawDataIndex + ((i / 32) * 32));
+		// One line per 32 bytes
+		NumericArrayLayout layout;
+
+		layout.width = 16;
+		layout.perLine = 4;
+		layout.lineStart = "    ";
+		layout.lineEnd = " \n";
+		layout.offsetComments = true;
+		layout.baseOffset = rawDataIndex;
+		emitter.ArrayBE<uint64_t>(textureDataRaw, layout);
+	}
+	else
+	{
+		// The offset comment of each 32 bytes follows their 7th word, so the 8th word starts the
+		// next line, unindented. `NumericArrayLayout` can't describe that.
+		for (size_t i = 0; i + 4 <= textureDataRaw.size(); i += 4)
+		{
+			if (i % 32 == 0)
+				sourceOutput += "    ";
+			emitter.Hex(BitConverter::ToUInt32BE(textureDataRaw, i), 8);
+			sourceOutput += ", ";
+			if (i % 32 == 24)
+			{
+				emitter.OffsetComment(rawDataIndex + (i / 32) * 32);
+				sourceOutput += " \n";
+			}
+		}
 	}
 
 	// Ensure there's always a trailing line feed to prevent dumb warnings.
@@ -876,7 +609,7 @@ std::string ZTexture::GetSourceTypeName() const
 void ZTexture::CalcHash()
 {
 	const auto& parentRawData = parent->GetRawData();
-	hash = CRC32B(parentRawData.data() + rawDataIndex, GetRawDataSize());
+	hash = Hash::Crc32Signed(parentRawData.data() + rawDataIndex, GetRawDataSize());
 }
 
 std::string ZTexture::GetExternalExtension() const
@@ -908,8 +641,9 @@ std::string ZTexture::GetExternalExtension() const
 
 fs::path ZTexture::GetPoolOutPath(const fs::path& defaultValue)
 {
-	if (Globals::Instance->cfg.texturePool.find(hash) != Globals::Instance->cfg.texturePool.end())
-		return Path::GetDirectoryName(Globals::Instance->cfg.texturePool[hash].path.string());
+	const char* poolPath = Globals::Instance->cfg.texturePool.Find(hash);
+	if (poolPath != nullptr)
+		return Path::GetDirectoryName(poolPath);
 
 	return defaultValue;
 }
@@ -969,7 +703,12 @@ void ZTexture::SetTlut(ZTexture* nTlut)
 	assert(nTlut->isPalette);
 	tlut = nTlut;
 
-	textureData.SetPalette(tlut->textureData, splitTlut ? 128 : 0);
+	if (tlut->textureDataPending)
+		tlut->DecodeTextureData();
+	tlutColors = tlut->textureData.GetPaletteColors();
+
+	if (!textureDataPending)
+		textureData.SetPalette(tlutColors, splitTlut ? 128 : 0);
 }
 
 bool ZTexture::HasTlut() const
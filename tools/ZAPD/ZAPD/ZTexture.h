@@ -1,23 +1,10 @@
 #pragma once
 
 #include "ImageBackend.h"
+#include "TextureCodec.h"
 #include "ZResource.h"
 #include "tinyxml2.h"
 
-enum class TextureType
-{
-	Error,
-	RGBA32bpp,
-	RGBA16bpp,
-	Palette4bpp,
-	Palette8bpp,
-	Grayscale4bpp,
-	Grayscale8bpp,
-	GrayscaleAlpha4bpp,
-	GrayscaleAlpha8bpp,
-	GrayscaleAlpha16bpp,
-};
-
 class ZTexture : public ZResource
 {
 protected:
@@ -30,28 +17,24 @@ protected:
 	ZTexture* tlut = nullptr;
 	bool splitTlut;
 
-	// The following functions convert from N64 binary data to a bitmap to be saved to a PNG.
-	void ConvertN64ToBitmap_RGBA16();
-	void ConvertN64ToBitmap_RGBA32();
-	void ConvertN64ToBitmap_Grayscale8();
-	void ConvertN64ToBitmap_GrayscaleAlpha8();
-	void ConvertN64ToBitmap_Grayscale4();
-	void ConvertN64ToBitmap_GrayscaleAlpha4();
-	void ConvertN64ToBitmap_GrayscaleAlpha16();
-	void ConvertN64ToBitmap_Palette4();
-	void ConvertN64ToBitmap_Palette8();
-
-	// The following functions convert from a bitmap to N64 binary data.
-	void PrepareRawDataFromFile(const fs::path& inFolder);
-	void ConvertBitmapToN64_RGBA16();
-	void ConvertBitmapToN64_RGBA32();
-	void ConvertBitmapToN64_Grayscale4();
-	void ConvertBitmapToN64_Grayscale8();
-	void ConvertBitmapToN64_GrayscaleAlpha4();
-	void ConvertBitmapToN64_GrayscaleAlpha8();
-	void ConvertBitmapToN64_GrayscaleAlpha16();
-	void ConvertBitmapToN64_Palette4();
-	void ConvertBitmapToN64_Palette8();
+	// Decoding is deferred to `Save`, which may find the PNG in the content store instead
+	bool textureDataPending = false;
+	// Colors of the TLUT when it was set, applied every time the texture is decoded
+	std::vector<RGBAPixel> tlutColors;
+
+	/// <summary>
+	/// Converts the raw data of this texture to `textureData`.
+	/// </summary>
+	void DecodeTextureData();
+	/// <summary>
+	/// Hashes everything the PNG of this texture is generated from, for the content store.
+	/// </summary>
+	uint64_t GetContentKey() const;
+
+	/// <summary>
+	/// Converts a PNG file to the raw data of this texture, in `textureDataRaw`.
+	/// </summary>
+	void PrepareRawDataFromFile(const fs::path& pngFilePath);
 
 public:
 	ZTexture(ZFile* nParent);
@@ -70,6 +53,11 @@ public:
 
 	Declaration* DeclareVar(const std::string& prefix, const std::string& bodyStr) override;
 	std::string GetBodySourceCode() const override;
+	/// <summary>
+	/// The data converted from a PNG file by `FromPNG`, padded to a multiple of 8 bytes like the
+	/// array `GetBodySourceCode` outputs.
+	/// </summary>
+	const std::vector<uint8_t>& GetRawTextureData() const;
 
 	/// <summary>
 	/// Calculates the hash of this texture, for use with the texture pool.
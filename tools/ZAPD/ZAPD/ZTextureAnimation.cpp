@@ -80,6 +80,7 @@
 #include <memory>
 #include <vector>
 
+#include "ExtractionContext.h"
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "WarningHandler.h"
@@ -349,9 +350,12 @@ std::string TextureColorChangingParams::GetBodySourceCode() const
 	std::string envColorListName;
 	std::string frameDataListName;
 
-	Globals::Instance->GetSegmentedPtrName(primColorListAddress, parent, "", primColorListName);
-	Globals::Instance->GetSegmentedPtrName(envColorListAddress, parent, "", envColorListName);
-	Globals::Instance->GetSegmentedPtrName(frameDataListAddress, parent, "", frameDataListName);
+	parent->ctx->GetSegmentedPtrName(primColorListAddress, parent, rawDataIndex + 4, "",
+	                                 primColorListName);
+	parent->ctx->GetSegmentedPtrName(envColorListAddress, parent, rawDataIndex + 8, "",
+	                                 envColorListName);
+	parent->ctx->GetSegmentedPtrName(frameDataListAddress, parent, rawDataIndex + 0xC, "",
+	                                 frameDataListName);
 
 	std::string bodyStr = StringHelper::Sprintf(
 		"\n    %d, %d, %s, %s, %s,\n", animLength, colorListCount, primColorListName.c_str(),
@@ -420,10 +424,12 @@ void TextureCyclingParams::DeclareReferences([[maybe_unused]] const std::string&
 		std::string texturesBodyStr;
 		std::string texName;
 		std::string comment;
+		offset_t textureListOffset = Seg2Filespace(textureListAddress, parent->baseAddress);
 
-		for (const auto& tex : textureList)
+		for (size_t i = 0; i < textureList.size(); i++)
 		{
-			bool texFound = Globals::Instance->GetSegmentedPtrName(tex, parent, "", texName);
+			bool texFound = parent->ctx->GetSegmentedPtrName(
+				textureList[i], parent, textureListOffset + i * 4, "", texName);
 
 			// texName is a raw segmented pointer. This occurs if the texture is not declared
 			// separately since we cannot read the format. In theory we could scan DLists for the
@@ -477,9 +483,10 @@ std::string TextureCyclingParams::GetBodySourceCode() const
 	std::string textureListName;
 	std::string textureIndexListName;
 
-	Globals::Instance->GetSegmentedPtrName(textureListAddress, parent, "", textureListName);
-	Globals::Instance->GetSegmentedPtrName(textureIndexListAddress, parent, "",
-	                                       textureIndexListName);
+	parent->ctx->GetSegmentedPtrName(textureListAddress, parent, rawDataIndex + 4, "",
+	                                 textureListName);
+	parent->ctx->GetSegmentedPtrName(textureIndexListAddress, parent, rawDataIndex + 8, "",
+	                                 textureIndexListName);
 
 	std::string bodyStr = StringHelper::Sprintf(
 		"\n    %d, %s, %s,\n", cycleLength, textureListName.c_str(), textureIndexListName.c_str());
@@ -568,7 +575,7 @@ void ZTextureAnimation::DeclareReferences(const std::string& prefix)
 					case TextureAnimationParamsType::DualScroll:
 						count = 2;
 					}
-					params = new TextureScrollingParams(parent);
+					params = new (parent) TextureScrollingParams(parent);
 					params->type = entry.type;
 					params->ExtractFromBinary(paramsOffset, count);
 					break;
@@ -576,13 +583,13 @@ void ZTextureAnimation::DeclareReferences(const std::string& prefix)
 				case TextureAnimationParamsType::ColorChange:
 				case TextureAnimationParamsType::ColorChangeLERP:
 				case TextureAnimationParamsType::ColorChangeLagrange:
-					params = new TextureColorChangingParams(parent);
+					params = new (parent) TextureColorChangingParams(parent);
 					params->type = entry.type;
 					params->ExtractFromBinary(paramsOffset);
 					break;
 
 				case TextureAnimationParamsType::TextureCycle:
-					params = new TextureCyclingParams(parent);
+					params = new (parent) TextureCyclingParams(parent);
 					params->type = entry.type;
 					params->ExtractFromBinary(paramsOffset);
 					break;
@@ -651,13 +658,15 @@ std::string ZTextureAnimation::GetBodySourceCode() const
 {
 	std::string bodyStr;
 
-	for (const auto& entry : entries)
+	for (size_t i = 0; i < entries.size(); i++)
 	{
+		const auto& entry = entries[i];
 		std::string paramName;
-		Globals::Instance->GetSegmentedPtrName(entry.paramsPtr, parent, "", paramName);
+		parent->ctx->GetSegmentedPtrName(entry.paramsPtr, parent, rawDataIndex + i * 8 + 4, "",
+		                                 paramName);
 
-		bodyStr += StringHelper::Sprintf("\t{ %d, %d, %s },\n", entry.segment, entry.type,
-		                                 paramName.c_str());
+		bodyStr += StringHelper::Sprintf("\t{ %d, %d, %s },\n", entry.segment,
+		                                 static_cast<int>(entry.type), paramName.c_str());
 	}
 
 	bodyStr.pop_back();
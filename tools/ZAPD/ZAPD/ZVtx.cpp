@@ -1,6 +1,8 @@
 #include "ZVtx.h"
 
-#include "Utils/BitConverter.h"
+#include <iterator>
+
+#include "Utils/NumericEmitter.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
 
@@ -20,21 +22,47 @@ ZVtx::ZVtx(ZFile* nParent) : ZResource(nParent)
 	a = 0;
 }
 
+std::vector<ZVtx> ZVtx::ExtractArray(ZFile* nParent, offset_t offset, size_t count)
+{
+	std::vector<ZVtx> vertices;
+	vertices.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		vertices.emplace_back(nParent);
+		vertices[i].rawDataIndex = offset + i * 16;
+	}
+
+	// Don't parse raw data of external files
+	if (nParent->GetMode() == ZFileMode::ExternalFile)
+		return vertices;
+
+	BEView view(nParent->GetRawData(), offset, count * 16);
+	for (size_t i = 0; i < count; i++)
+		vertices[i].ParseFields(view, i * 16);
+
+	return vertices;
+}
+
 void ZVtx::ParseRawData()
 {
 	ZResource::ParseRawData();
 
-	const auto& rawData = parent->GetRawData();
-	x = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
-	y = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-	z = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
-	flag = BitConverter::ToInt16BE(rawData, rawDataIndex + 6);
-	s = BitConverter::ToInt16BE(rawData, rawDataIndex + 8);
-	t = BitConverter::ToInt16BE(rawData, rawDataIndex + 10);
-	r = rawData[rawDataIndex + 12];
-	g = rawData[rawDataIndex + 13];
-	b = rawData[rawDataIndex + 14];
-	a = rawData[rawDataIndex + 15];
+	ParseFields(BEView(parent->GetRawData(), rawDataIndex, GetRawDataSize()), 0);
+}
+
+void ZVtx::ParseFields(const BEView& view, size_t offset)
+{
+	x = view.ReadInt16(offset + 0);
+	y = view.ReadInt16(offset + 2);
+	z = view.ReadInt16(offset + 4);
+	flag = view.ReadUInt16(offset + 6);
+	s = view.ReadInt16(offset + 8);
+	t = view.ReadInt16(offset + 10);
+	r = view.ReadUInt8(offset + 12);
+	g = view.ReadUInt8(offset + 13);
+	b = view.ReadUInt8(offset + 14);
+	a = view.ReadUInt8(offset + 15);
 }
 
 Declaration* ZVtx::DeclareVar(const std::string& prefix, const std::string& bodyStr)
@@ -46,8 +74,19 @@ Declaration* ZVtx::DeclareVar(const std::string& prefix, const std::string& body
 
 std::string ZVtx::GetBodySourceCode() const
 {
-	return StringHelper::Sprintf("VTX(%i, %i, %i, %i, %i, %i, %i, %i, %i)", x, y, z, s, t, r, g, b,
-	                             a);
+	const int32_t values[] = {x, y, z, s, t, r, g, b, a};
+	std::string body = "VTX(";
+	NumericEmitter emitter(body);
+
+	for (size_t i = 0; i < std::size(values); i++)
+	{
+		if (i != 0)
+			body += ", ";
+		emitter.Decimal(values[i]);
+	}
+	body += ")";
+
+	return body;
 }
 
 size_t ZVtx::GetRawDataSize() const
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include "Utils/BEView.h"
 #include "ZResource.h"
 #include "ZScalar.h"
 #include "tinyxml2.h"
@@ -17,6 +18,12 @@ public:
 
 	ZVtx(ZFile* nParent);
 
+	/**
+	 * Extracts the `count` vertices at `offset` in `nParent`, decoding them from a single view of
+	 * the whole array.
+	 */
+	static std::vector<ZVtx> ExtractArray(ZFile* nParent, offset_t offset, size_t count);
+
 	void ParseRawData() override;
 
 	Declaration* DeclareVar(const std::string& prefix, const std::string& bodyStr) override;
@@ -30,4 +37,7 @@ public:
 
 	size_t GetRawDataSize() const override;
 	DeclarationAlignment GetDeclarationAlignment() const override;
+
+protected:
+	void ParseFields(const BEView& view, size_t offset);
 };
@@ -1,7 +1,8 @@
 #include "ZWaterbox.h"
 
+#include "ExtractionContext.h"
 #include "Globals.h"
-#include "Utils/BitConverter.h"
+#include "Utils/BEView.h"
 #include "Utils/StringHelper.h"
 
 REGISTER_ZFILENODE(Waterbox, ZWaterbox);
@@ -16,18 +17,19 @@ ZWaterbox::~ZWaterbox()
 
 void ZWaterbox::ParseRawData()
 {
-	const auto& rawData = parent->GetRawData();
+	bool isSW97 = parent->ctx->game == ZGame::OOT_SW97;
+	BEView view(parent->GetRawData(), rawDataIndex, isSW97 ? 12 : GetRawDataSize());
 
-	xMin = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
-	ySurface = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
-	zMin = BitConverter::ToInt16BE(rawData, rawDataIndex + 4);
-	xLength = BitConverter::ToInt16BE(rawData, rawDataIndex + 6);
-	zLength = BitConverter::ToInt16BE(rawData, rawDataIndex + 8);
+	xMin = view.ReadInt16(0);
+	ySurface = view.ReadInt16(2);
+	zMin = view.ReadInt16(4);
+	xLength = view.ReadInt16(6);
+	zLength = view.ReadInt16(8);
 
-	if (Globals::Instance->game == ZGame::OOT_SW97)
-		properties = BitConverter::ToInt16BE(rawData, rawDataIndex + 10);
+	if (isSW97)
+		properties = view.ReadInt16(10);
 	else
-		properties = BitConverter::ToInt32BE(rawData, rawDataIndex + 12);
+		properties = view.ReadInt32(12);
 }
 
 void ZWaterbox::DeclareReferences(const std::string& prefix)
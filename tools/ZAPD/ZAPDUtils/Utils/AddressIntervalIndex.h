@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Maps address ranges `[start, start + size)` to items, answering which item contains a given
+ * address without walking every stored item.
+ *
+ * The address space is split in fixed size buckets, and every item is registered in each bucket
+ * its range touches, sorted by start address. Items bigger than a few buckets are kept in a
+ * separate list instead, which is expected to stay short.
+ * Items can overlap; in that case the one which starts first is returned, which is what walking
+ * the items in address order would have found.
+ *
+ * Lookups don't modify the index, so they can be done from several threads as long as nothing
+ * is being added or removed at the same time.
+ */
+template <typename T>
+class AddressIntervalIndex
+{
+public:
+	/**
+	 * Registers `item` as covering `[start, start + size)`. If the item was already registered,
+	 * its previous range is replaced.
+	 */
+	void Set(T* item, uint32_t start, size_t size)
+	{
+		Remove(item);
+
+		Entry entry = {start, static_cast<uint64_t>(start) + size, item};
+		entries[item] = entry;
+
+		if (size == 0)
+			return;
+
+		if (size > LargeItemSize)
+		{
+			Insert(largeEntries, entry);
+			return;
+		}
+
+		for (uint64_t bucket = FirstBucket(entry); bucket <= LastBucket(entry); bucket++)
+			Insert(buckets[bucket], entry);
+	}
+
+	void Remove(T* item)
+	{
+		auto it = entries.find(item);
+		if (it == entries.end())
+			return;
+
+		const Entry& entry = it->second;
+
+		if (entry.end - entry.start > LargeItemSize)
+		{
+			Erase(largeEntries, item);
+		}
+		else if (entry.end > entry.start)
+		{
+			for (uint64_t bucket = FirstBucket(entry); bucket <= LastBucket(entry); bucket++)
+			{
+				auto bucketIt = buckets.find(bucket);
+				Erase(bucketIt->second, item);
+				if (bucketIt->second.empty())
+					buckets.erase(bucketIt);
+			}
+		}
+
+		entries.erase(it);
+	}
+
+	/**
+	 * Returns the first item (by start address) whose range contains `address`, or `nullptr`.
+	 */
+	T* Find(uint32_t address) const
+	{
+		const Entry* found = nullptr;
+
+		auto bucketIt = buckets.find(address >> BucketShift);
+		if (bucketIt != buckets.end())
+			found = FindIn(bucketIt->second, address);
+
+		const Entry* large = FindIn(largeEntries, address);
+		if (large != nullptr && (found == nullptr || large->start < found->start))
+			found = large;
+
+		return found != nullptr ? found->item : nullptr;
+	}
+
+	void Clear()
+	{
+		buckets.clear();
+		largeEntries.clear();
+		entries.clear();
+	}
+
+private:
+	struct Entry
+	{
+		uint64_t start;
+		uint64_t end;
+		T* item;
+	};
+
+	static constexpr uint32_t BucketShift = 8;
+	static constexpr size_t LargeItemSize = 64 << BucketShift;
+
+	std::unordered_map<uint64_t, std::vector<Entry>> buckets;
+	std::vector<Entry> largeEntries;
+	std::unordered_map<const T*, Entry> entries;
+
+	static uint64_t FirstBucket(const Entry& entry) { return entry.start >> BucketShift; }
+	static uint64_t LastBucket(const Entry& entry) { return (entry.end - 1) >> BucketShift; }
+
+	static void Insert(std::vector<Entry>& list, const Entry& entry)
+	{
+		auto it = std::upper_bound(
+			list.begin(), list.end(), entry.start,
+			[](uint64_t start, const Entry& other) { return start < other.start; });
+		list.insert(it, entry);
+	}
+
+	static void Erase(std::vector<Entry>& list, const T* item)
+	{
+		list.erase(std::find_if(list.begin(), list.end(),
+		                        [item](const Entry& entry) { return entry.item == item; }));
+	}
+
+	static const Entry* FindIn(const std::vector<Entry>& list, uint32_t address)
+	{
+		for (const Entry& entry : list)
+		{
+			if (entry.start > address)
+				break;
+			if (address < entry.end)
+				return &entry;
+		}
+
+		return nullptr;
+	}
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+/**
+ * Base of the classes whose objects are allocated from a `std::pmr::memory_resource`, usually
+ * an arena which is released all at once when everything allocated from it is gone:
+ *
+ *     std::pmr::monotonic_buffer_resource arena;
+ *     Item* item = new (&arena) Item();
+ *     delete item;  // Destroyed as usual, its memory is returned to `arena`
+ *
+ * The resource and size of each object are kept in front of it, so `delete` works on any of
+ * them, whichever resource it was allocated from. A null resource allocates from the heap.
+ */
+class ArenaAllocated
+{
+public:
+	static void* operator new(size_t size, std::pmr::memory_resource* memory)
+	{
+		memory = GetResource(memory);
+
+		void* block = memory->allocate(HeaderSize + size, alignof(std::max_align_t));
+		new (block) Header{memory, size};
+
+		return static_cast<char*>(block) + HeaderSize;
+	}
+
+	// Only called if the constructor throws
+	static void operator delete(void* ptr, std::pmr::memory_resource*) { Deallocate(ptr); }
+
+	static void operator delete(void* ptr) { Deallocate(ptr); }
+
+protected:
+	ArenaAllocated() = default;
+	~ArenaAllocated() = default;
+
+	// The resource `memory` stands for, for the members of an object allocated from it
+	static std::pmr::memory_resource* GetResource(std::pmr::memory_resource* memory)
+	{
+		return memory != nullptr ? memory : std::pmr::new_delete_resource();
+	}
+
+private:
+	struct Header
+	{
+		std::pmr::memory_resource* memory;
+		size_t size;
+	};
+
+	static constexpr size_t HeaderSize =
+		(sizeof(Header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+	static void Deallocate(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		void* block = static_cast<char*>(ptr) - HeaderSize;
+		Header header = *static_cast<Header*>(block);
+
+		header.memory->deallocate(block, HeaderSize + header.size, alignof(std::max_align_t));
+	}
+};
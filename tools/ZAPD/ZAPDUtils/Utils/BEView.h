@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "ByteSpan.h"
+#include "StringHelper.h"
+
+#ifdef _MSC_VER
+#include <cstdlib>
+#ifndef __PRETTY_FUNCTION__
+#define __PRETTY_FUNCTION__ __FUNCSIG__
+#endif
+#elif defined(__BYTE_ORDER__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "BEView expects a little-endian host");
+#endif
+
+/**
+ * Big-endian view of a struct-sized range of a data buffer.
+ *
+ * The range is checked once, when the view is made, and reported like `BitConverter` reports an
+ * out-of-bounds read. The fields are then decoded with a single unaligned load and byteswap each,
+ * without checking them again, so a parser can make one view of the struct it reads and then
+ * decode all its fields from it:
+ *
+ *     BEView view(rawData, rawDataIndex, GetRawDataSize());
+ *     x = view.ReadInt16(0x00);
+ *     segment = view.ReadUInt32(0x04);
+ *
+ * Offsets are relative to the start of the view. Reading past its end is only caught by an
+ * assertion in debug builds.
+ */
+class BEView
+{
+public:
+	BEView() = default;
+
+	/**
+	 * Views the `size` bytes of `data` starting at `offset`. Throws `std::out_of_range` if any of
+	 * them is outside of `data`.
+	 */
+	BEView(ByteSpan data, size_t offset, size_t size)
+	{
+		if (offset > data.size() || size > data.size() - offset)
+		{
+			fprintf(stderr, "%s\n", __PRETTY_FUNCTION__);
+			fprintf(stderr, "Error: Trying an out-of-bounds reading from a data buffer\n");
+			fprintf(stderr, "\t Buffer size: 0x%zX\n", data.size());
+			fprintf(stderr, "\t Trying to read 0x%zX bytes at offset: 0x%zX\n", size, offset);
+			throw std::out_of_range(
+				StringHelper::Sprintf("BEView: 0x%zX bytes at offset 0x%zX are out of range "
+			                          "(size is 0x%zX)",
+			                          size, offset, data.size()));
+		}
+
+		ptr = data.data() + offset;
+		count = size;
+	}
+
+	const uint8_t* data() const { return ptr; }
+	size_t size() const { return count; }
+
+	/**
+	 * Returns the `size` bytes at `offset` in this view, checked like the constructor checks them.
+	 */
+	BEView Subview(size_t offset, size_t size) const
+	{
+		return BEView(ByteSpan(ptr, count), offset, size);
+	}
+
+	int8_t ReadInt8(size_t offset) const { return static_cast<int8_t>(ReadUInt8(offset)); }
+	uint8_t ReadUInt8(size_t offset) const
+	{
+		assert(offset < count);
+		return ptr[offset];
+	}
+
+	int16_t ReadInt16(size_t offset) const { return static_cast<int16_t>(ReadUInt16(offset)); }
+	uint16_t ReadUInt16(size_t offset) const { return Load<uint16_t>(offset); }
+
+	int32_t ReadInt32(size_t offset) const { return static_cast<int32_t>(ReadUInt32(offset)); }
+	uint32_t ReadUInt32(size_t offset) const { return Load<uint32_t>(offset); }
+
+	int64_t ReadInt64(size_t offset) const { return static_cast<int64_t>(ReadUInt64(offset)); }
+	uint64_t ReadUInt64(size_t offset) const { return Load<uint64_t>(offset); }
+
+	float ReadFloat(size_t offset) const
+	{
+		static_assert(sizeof(uint32_t) == sizeof(float), "expected 32-bit float");
+		static_assert(std::numeric_limits<float>::is_iec559, "expected IEC559 floats on host");
+
+		uint32_t bits = ReadUInt32(offset);
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	double ReadDouble(size_t offset) const
+	{
+		static_assert(sizeof(uint64_t) == sizeof(double), "expected 64-bit double");
+		static_assert(std::numeric_limits<double>::is_iec559, "expected IEC559 doubles on host");
+
+		uint64_t bits = ReadUInt64(offset);
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	/**
+	 * Decodes the `elemCount` big-endian integers at `offset` into `dst`, like an array of `T` in
+	 * the data (`Vec3s[]` is read as `3 * count` `int16_t`, `u16[]` as `uint16_t`, ...).
+	 */
+	template <typename T>
+	void ReadArray(size_t offset, T* dst, size_t elemCount) const
+	{
+		static_assert(std::is_integral_v<T>, "BEView::ReadArray reads integers");
+		assert(elemCount <= (count - offset) / sizeof(T));
+
+		using U = std::make_unsigned_t<T>;
+		for (size_t i = 0; i < elemCount; i++)
+			dst[i] = static_cast<T>(Load<U>(offset + i * sizeof(T)));
+	}
+
+	template <typename T>
+	std::vector<T> ReadArray(size_t offset, size_t elemCount) const
+	{
+		std::vector<T> values(elemCount);
+		ReadArray(offset, values.data(), elemCount);
+		return values;
+	}
+
+private:
+	const uint8_t* ptr = nullptr;
+	size_t count = 0;
+
+	template <typename T>
+	T Load(size_t offset) const
+	{
+		assert(offset <= count && sizeof(T) <= count - offset);
+
+		T value;
+		std::memcpy(&value, ptr + offset, sizeof(T));
+		return ByteSwap(value);
+	}
+
+	static uint8_t ByteSwap(uint8_t value) { return value; }
+
+#ifdef _MSC_VER
+	static uint16_t ByteSwap(uint16_t value) { return _byteswap_ushort(value); }
+	static uint32_t ByteSwap(uint32_t value) { return _byteswap_ulong(value); }
+	static uint64_t ByteSwap(uint64_t value) { return _byteswap_uint64(value); }
+#else
+	static uint16_t ByteSwap(uint16_t value) { return __builtin_bswap16(value); }
+	static uint32_t ByteSwap(uint32_t value) { return __builtin_bswap32(value); }
+	static uint64_t ByteSwap(uint64_t value) { return __builtin_bswap64(value); }
+#endif
+};
@@ -0,0 +1,45 @@
+#include "BinaryImage.h"
+
+#include <cstring>
+#include <functional>
+
+bool BinaryImage::HasLayout(const ByteSpan& data, size_t headerSize,
+                            std::initializer_list<Table> tables, uint32_t stringsSize)
+{
+	uint64_t expectedSize = headerSize;
+
+	for (const Table& table : tables)
+		expectedSize += uint64_t(table.count) * table.recordSize;
+	expectedSize += stringsSize;
+
+	return expectedSize == data.size() && stringsSize != 0 && data[data.size() - 1] == '\0';
+}
+
+// Sized for the largest of them, the compiled config of the games, with a few thousand strings
+BinaryImageStrings::BinaryImageStrings() : offsets(8192, StringHash{&data}, StringEqual{&data})
+{
+	data.reserve(128 * 1024);
+}
+
+uint32_t BinaryImageStrings::Add(std::string_view str)
+{
+	// The string is appended to be looked up, and removed if it was already there
+	uint32_t offset = data.size();
+	data.insert(data.end(), str.begin(), str.end());
+	data.push_back('\0');
+
+	auto [it, inserted] = offsets.insert(offset);
+	if (!inserted)
+		data.resize(offset);
+	return *it;
+}
+
+size_t BinaryImageStrings::StringHash::operator()(uint32_t offset) const
+{
+	return std::hash<std::string_view>()(data->data() + offset);
+}
+
+bool BinaryImageStrings::StringEqual::operator()(uint32_t a, uint32_t b) const
+{
+	return strcmp(data->data() + a, data->data() + b) == 0;
+}
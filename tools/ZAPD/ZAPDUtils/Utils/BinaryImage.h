@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "ByteSpan.h"
+
+/**
+ * Files mapped in memory and used in place instead of being parsed: a header followed by tables
+ * of fixed-size records, and a string table. Every string is stored once, as an offset in the
+ * string table.
+ *
+ * The headers start with a magic number and a version, and are read in the byte order of the
+ * machine, so files written by another one are ignored.
+ */
+class BinaryImage
+{
+public:
+	struct Table
+	{
+		uint32_t count;
+		size_t recordSize;
+	};
+
+	/**
+	 * The header at the start of `data`, or `nullptr` if `data` is too small to hold it or if its
+	 * magic number or version don't match.
+	 */
+	template <typename Header>
+	static const Header* GetHeader(const ByteSpan& data, uint32_t magic, uint32_t version)
+	{
+		if (data.size() < sizeof(Header))
+			return nullptr;
+
+		const Header* header = reinterpret_cast<const Header*>(data.data());
+		if (header->magic != magic || header->version != version)
+			return nullptr;
+		return header;
+	}
+
+	/**
+	 * Whether `data` is exactly a header of `headerSize` bytes, followed by `tables` and a
+	 * non-empty string table of `stringsSize` bytes ending with a terminator. The counts come from
+	 * the file, so the sizes are computed without overflowing.
+	 */
+	static bool HasLayout(const ByteSpan& data, size_t headerSize,
+	                      std::initializer_list<Table> tables, uint32_t stringsSize);
+
+	template <typename T>
+	static void AppendRecords(std::vector<uint8_t>& out, const std::vector<T>& records)
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(records.data());
+		out.insert(out.end(), bytes, bytes + records.size() * sizeof(T));
+	}
+};
+
+/**
+ * Builds the string table of a `BinaryImage`, storing each string only once.
+ */
+class BinaryImageStrings
+{
+public:
+	BinaryImageStrings();
+
+	BinaryImageStrings(const BinaryImageStrings&) = delete;
+	BinaryImageStrings& operator=(const BinaryImageStrings&) = delete;
+
+	uint32_t Add(std::string_view str);
+
+	std::vector<char> data;
+
+private:
+	// The strings are identified by their offset, so they are only stored in `data`
+	struct StringHash
+	{
+		const std::vector<char>* data;
+
+		size_t operator()(uint32_t offset) const;
+	};
+
+	struct StringEqual
+	{
+		const std::vector<char>* data;
+
+		bool operator()(uint32_t a, uint32_t b) const;
+	};
+
+	std::unordered_set<uint32_t, StringHash, StringEqual> offsets;
+};
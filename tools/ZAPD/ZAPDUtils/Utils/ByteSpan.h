@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "StringHelper.h"
+
+/**
+ * Read-only view of a contiguous range of bytes, owned by someone else (usually a vector or a
+ * `MappedFile`). The owner must outlive the span.
+ *
+ * Offers the subset of the `std::vector` interface used to read raw data, so code taking a span
+ * reads the same as code taking a vector, and vectors can be passed where a span is expected.
+ */
+class ByteSpan
+{
+public:
+	ByteSpan() = default;
+	ByteSpan(const uint8_t* nData, size_t nSize) : ptr(nData), count(nSize) {}
+	ByteSpan(const std::vector<uint8_t>& vector) : ptr(vector.data()), count(vector.size()) {}
+
+	const uint8_t* data() const { return ptr; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	const uint8_t* begin() const { return ptr; }
+	const uint8_t* end() const { return ptr + count; }
+
+	const uint8_t& operator[](size_t index) const { return ptr[index]; }
+
+	const uint8_t& at(size_t index) const
+	{
+		if (index >= count)
+		{
+			throw std::out_of_range(StringHelper::Sprintf(
+				"ByteSpan::at: offset 0x%zX is out of range (size is 0x%zX)", index, count));
+		}
+		return ptr[index];
+	}
+
+	/**
+	 * Returns the bytes in `[offset, offset + length)`, clamped to the end of this span.
+	 */
+	ByteSpan subspan(size_t offset, size_t length = SIZE_MAX) const
+	{
+		if (offset > count)
+			offset = count;
+		if (length > count - offset)
+			length = count - offset;
+		return ByteSpan(ptr + offset, length);
+	}
+
+private:
+	const uint8_t* ptr = nullptr;
+	size_t count = 0;
+};
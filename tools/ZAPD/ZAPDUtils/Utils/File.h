@@ -6,9 +6,14 @@
 #include <fstream>
 #endif
 
+#include <algorithm>
+#include <ctime>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "Directory.h"
+#include "Utils/Profiler.h"
 #include "Utils/StringHelper.h"
 
 class File
@@ -16,9 +21,11 @@ class File
 #ifdef USE_BOOST_FS
 	typedef fs::ifstream ifstream;
 	typedef fs::ofstream ofstream;
+	typedef boost::system::error_code error_code;
 #else
 	typedef std::ifstream ifstream;
 	typedef std::ofstream ofstream;
+	typedef std::error_code error_code;
 #endif
 
 public:
@@ -28,15 +35,55 @@ public:
 		return file.good();
 	}
 
+	/**
+	 * Reads the size and the modification time of the file at `filePath`, which tell whether it
+	 * changed without reading it. Returns `false` if it doesn't exist.
+	 */
+	static bool GetSizeAndTime(const fs::path& filePath, uint64_t& size, int64_t& time)
+	{
+		error_code ec;
+
+		size = fs::file_size(filePath, ec);
+		if (ec)
+			return false;
+
+		auto writeTime = fs::last_write_time(filePath, ec);
+		if (ec)
+			return false;
+
+#ifdef USE_BOOST_FS
+		time = writeTime;
+#else
+		time = writeTime.time_since_epoch().count();
+#endif
+		return true;
+	}
+
+	/**
+	 * Sets the modification time of the file at `filePath` to now, like `touch`, without changing
+	 * its contents.
+	 */
+	static void Touch(const fs::path& filePath)
+	{
+		error_code ec;
+
+#ifdef USE_BOOST_FS
+		fs::last_write_time(filePath, std::time(nullptr), ec);
+#else
+		fs::last_write_time(filePath, fs::file_time_type::clock::now(), ec);
+#endif
+	}
+
 	static std::vector<uint8_t> ReadAllBytes(const fs::path& filePath)
 	{
 		ifstream file(filePath, std::ios::in | std::ios::binary | std::ios::ate);
-		int32_t fileSize = (int32_t)file.tellg();
+		std::streamoff fileSize = file.tellg();
+		if (fileSize < 0)
+			return {};
+
 		file.seekg(0);
-		char* data = new char[fileSize];
-		file.read(data, fileSize);
-		std::vector<uint8_t> result = std::vector<uint8_t>(data, data + fileSize);
-		delete[] data;
+		std::vector<uint8_t> result(fileSize);
+		file.read(reinterpret_cast<char*>(result.data()), fileSize);
 		file.close();
 
 		return result;
@@ -69,6 +116,7 @@ public:
 
 	static void WriteAllBytes(const fs::path& filePath, const std::vector<uint8_t>& data)
 	{
+		ProfileScope scope("WriteFile", nullptr, filePath);
 		ofstream file(filePath, std::ios::binary);
 		file.write((char*)data.data(), data.size());
 		file.close();
@@ -76,6 +124,7 @@ public:
 
 	static void WriteAllBytes(const std::string& filePath, const std::vector<char>& data)
 	{
+		ProfileScope scope("WriteFile", nullptr, filePath);
 		ofstream file(filePath, std::ios::binary);
 		file.write((char*)data.data(), data.size());
 		file.close();
@@ -83,15 +132,94 @@ public:
 
 	static void WriteAllBytes(const std::string& filePath, const char* data, int dataSize)
 	{
+		ProfileScope scope("WriteFile", nullptr, filePath);
 		ofstream file(filePath, std::ios::binary);
 		file.write((char*)data, dataSize);
 		file.close();
 	};
 
-	static void WriteAllText(const fs::path& filePath, const std::string& text)
+	static void WriteAllText(const fs::path& filePath, std::string_view text)
 	{
+		ProfileScope scope("WriteFile", nullptr, filePath);
 		ofstream file(filePath, std::ios::out);
-		file.write(text.c_str(), text.size());
+		file.write(text.data(), text.size());
 		file.close();
 	}
+
+	/**
+	 * Writes `data` to `filePath`, unless the file already has exactly those contents, so its
+	 * modification time only changes when its contents do. Returns whether the file was written.
+	 * The file is removed before being written, so any file linked to it is left untouched.
+	 */
+	static bool WriteAllBytesIfChanged(const fs::path& filePath, const void* data, size_t size)
+	{
+		if (HasContents(filePath, static_cast<const char*>(data), size, std::ios::binary))
+			return false;
+
+		error_code ec;
+		fs::remove(filePath, ec);
+		WriteAllBytes(filePath.string(), static_cast<const char*>(data), static_cast<int>(size));
+		return true;
+	}
+
+	static bool WriteAllBytesIfChanged(const fs::path& filePath, const std::vector<uint8_t>& data)
+	{
+		return WriteAllBytesIfChanged(filePath, data.data(), data.size());
+	}
+
+	static bool WriteAllBytesIfChanged(const fs::path& filePath, const std::vector<char>& data)
+	{
+		return WriteAllBytesIfChanged(filePath, data.data(), data.size());
+	}
+
+	/**
+	 * Like `WriteAllBytesIfChanged`, for text files.
+	 */
+	static bool WriteAllTextIfChanged(const fs::path& filePath, std::string_view text)
+	{
+		if (HasContents(filePath, text.data(), text.size(), std::ios::in))
+			return false;
+
+		error_code ec;
+		fs::remove(filePath, ec);
+		WriteAllText(filePath, text);
+		return true;
+	}
+
+	/**
+	 * Whether the file at `filePath` exists and contains exactly `size` bytes equal to `data`,
+	 * once read in `mode`.
+	 */
+	static bool HasContents(const fs::path& filePath, const char* data, size_t size,
+	                        std::ios::openmode mode)
+	{
+		ProfileScope scope("CompareFile", nullptr, filePath);
+		ifstream file(filePath, mode | std::ios::in);
+		if (!file.is_open())
+			return false;
+
+		// Binary files can be told apart by their size alone, without reading them
+		if (mode & std::ios::binary)
+		{
+			file.seekg(0, std::ios::end);
+			if (file.tellg() != static_cast<std::streamoff>(size))
+				return false;
+			file.seekg(0);
+		}
+
+		char buffer[0x10000];
+
+		for (size_t pos = 0; pos < size;)
+		{
+			size_t count = std::min(size - pos, sizeof(buffer));
+
+			file.read(buffer, count);
+			if (static_cast<size_t>(file.gcount()) != count || memcmp(buffer, data + pos, count))
+				return false;
+			pos += count;
+		}
+
+		// The file may be longer
+		return file.peek() == std::char_traits<char>::eof();
+	}
 };
@@ -0,0 +1,227 @@
+#include "Hash.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HASH_CRC32_CLMUL
+#define TARGET_CLMUL __attribute__((target("pclmul,sse4.1")))
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr uint32_t Crc32Polynomial = 0xEDB88320;
+
+/**
+ * Shifts the CRC right by `n` bits. `Crc32Signed` keeps the CRC in a signed integer, which
+ * repeats bit 31 when shifting.
+ */
+template <bool signedShift>
+constexpr uint32_t ShiftCrc(uint32_t crc, int n)
+{
+	if constexpr (signedShift)
+		return static_cast<uint32_t>(static_cast<int32_t>(crc) >> n);
+	else
+		return crc >> n;
+}
+
+/**
+ * `tables[k][b]` is the CRC of byte `b` followed by `k` zero bytes, so 8 bytes can be folded at
+ * once with one lookup each. Both CRCs are linear, so those add up.
+ */
+template <bool signedShift>
+struct Crc32Tables
+{
+	uint32_t tables[8][256] = {};
+	// The CRC of byte `b` in bit 24 to 31 after 8 zero bytes. With an unsigned CRC, that's
+	// `tables[4][b]`, so this is only used by `Crc32Signed`.
+	uint32_t topByte[256] = {};
+
+	constexpr Crc32Tables()
+	{
+		for (uint32_t b = 0; b < 256; b++)
+		{
+			uint32_t crc = b;
+			for (int i = 0; i < 8; i++)
+				crc = ShiftCrc<signedShift>(crc, 1) ^ (Crc32Polynomial & (0 - (crc & 1)));
+			tables[0][b] = crc;
+		}
+		for (uint32_t b = 0; b < 256; b++)
+		{
+			for (int k = 1; k < 8; k++)
+				tables[k][b] = ZeroByte(tables[k - 1][b]);
+
+			uint32_t crc = b << 24;
+			for (int k = 0; k < 8; k++)
+				crc = ZeroByte(crc);
+			topByte[b] = crc;
+		}
+	}
+
+	constexpr uint32_t ZeroByte(uint32_t crc) const
+	{
+		return ShiftCrc<signedShift>(crc, 8) ^ tables[0][crc & 0xFF];
+	}
+};
+
+template <bool signedShift>
+constexpr Crc32Tables<signedShift> crc32Tables;
+
+uint32_t LoadLE32(const uint8_t* data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Works on the inverted CRC, like the functions below
+template <bool signedShift>
+uint32_t Crc32SliceBy8(const uint8_t* data, size_t size, uint32_t crc)
+{
+	const auto& tables = crc32Tables<signedShift>;
+	const auto& t = tables.tables;
+
+	for (; size >= 8; size -= 8, data += 8)
+	{
+		uint32_t lo = crc ^ LoadLE32(data);
+		uint32_t hi = LoadLE32(data + 4);
+
+		uint32_t next = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^
+		                t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^
+		                t[0][hi >> 24];
+
+		// The bits repeated by the signed shifts depend on the CRC, not on the data
+		if constexpr (signedShift)
+			next ^= tables.topByte[crc >> 24] ^ t[4][data[3]];
+		else
+			next ^= t[4][lo >> 24];
+
+		crc = next;
+	}
+
+	for (; size > 0; size--, data++)
+		crc = tables.ZeroByte(crc ^ *data);
+
+	return crc;
+}
+
+#ifdef HASH_CRC32_CLMUL
+// Folding 4 blocks of 16 bytes at once needs at least 64 bytes
+constexpr size_t Crc32ClmulMinSize = 64;
+
+const bool sHasClmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+bool sUseClmul = sHasClmul;
+
+TARGET_CLMUL __m128i Load(const uint8_t* data)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+// Moves the 128 bits of `x` forward by the distance `k` was computed for, onto `next`
+TARGET_CLMUL __m128i Fold(__m128i x, __m128i k, __m128i next)
+{
+	__m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+	__m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+	return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+/**
+ * Folds `size` bytes, a multiple of 16 of at least `Crc32ClmulMinSize`, with carry-less
+ * multiplications. See Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+ * Instruction", whose bit-reflected constants are used here.
+ */
+TARGET_CLMUL uint32_t Crc32Clmul(const uint8_t* data, size_t size, uint32_t crc)
+{
+	const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+	const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+	const __m128i k5k0 = _mm_set_epi64x(0, 0x0163CD6124);
+	const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+	__m128i x1 = _mm_xor_si128(Load(data), _mm_cvtsi32_si128(crc));
+	__m128i x2 = Load(data + 16);
+	__m128i x3 = Load(data + 32);
+	__m128i x4 = Load(data + 48);
+	data += 64;
+	size -= 64;
+
+	for (; size >= 64; size -= 64, data += 64)
+	{
+		x1 = Fold(x1, k1k2, Load(data));
+		x2 = Fold(x2, k1k2, Load(data + 16));
+		x3 = Fold(x3, k1k2, Load(data + 32));
+		x4 = Fold(x4, k1k2, Load(data + 48));
+	}
+
+	x1 = Fold(x1, k3k4, x2);
+	x1 = Fold(x1, k3k4, x3);
+	x1 = Fold(x1, k3k4, x4);
+
+	for (; size >= 16; size -= 16, data += 16)
+		x1 = Fold(x1, k3k4, Load(data));
+
+	// 128 bits to 64
+	__m128i x = _mm_xor_si128(_mm_srli_si128(x1, 8), _mm_clmulepi64_si128(x1, k3k4, 0x10));
+	x = _mm_xor_si128(_mm_srli_si128(x, 4),
+	                  _mm_clmulepi64_si128(_mm_and_si128(x, mask32), k5k0, 0x00));
+
+	// Barrett reduction to 32 bits
+	__m128i t = _mm_clmulepi64_si128(_mm_and_si128(x, mask32), poly, 0x10);
+	t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), poly, 0x00);
+	x = _mm_xor_si128(x, t);
+
+	return _mm_extract_epi32(x, 1);
+}
+#endif
+}  // namespace
+
+uint64_t Hash::Fnv1a64(const void* data, size_t size, uint64_t seed)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint64_t hash = seed;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001B3;
+	}
+
+	return hash;
+}
+
+uint32_t Hash::Crc32(const void* data, size_t size, uint32_t crc)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+	crc = ~crc;
+
+#ifdef HASH_CRC32_CLMUL
+	if (sUseClmul && size >= Crc32ClmulMinSize)
+	{
+		size_t folded = size & ~static_cast<size_t>(15);
+
+		crc = Crc32Clmul(bytes, folded, crc);
+		bytes += folded;
+		size -= folded;
+	}
+#endif
+
+	return ~Crc32SliceBy8<false>(bytes, size, crc);
+}
+
+bool Hash::IsCrc32ClmulEnabled()
+{
+#ifdef HASH_CRC32_CLMUL
+	return sUseClmul;
+#else
+	return false;
+#endif
+}
+
+void Hash::SetCrc32ClmulEnabled([[maybe_unused]] bool enabled)
+{
+#ifdef HASH_CRC32_CLMUL
+	sUseClmul = enabled && sHasClmul;
+#endif
+}
+
+uint32_t Hash::Crc32Signed(const void* data, size_t size, uint32_t crc)
+{
+	return ~Crc32SliceBy8<true>(static_cast<const uint8_t*>(data), size, ~crc);
+}
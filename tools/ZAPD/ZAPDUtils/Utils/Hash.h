@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Non-cryptographic hashes, meant to tell whether some data changed, not to protect it.
+ */
+class Hash
+{
+public:
+	static constexpr uint64_t Fnv1a64Seed = 0xCBF29CE484222325;
+
+	/**
+	 * 64-bit FNV-1a. The result of a previous call can be passed as `seed` to hash several
+	 * buffers as if they were a single one.
+	 */
+	static uint64_t Fnv1a64(const void* data, size_t size, uint64_t seed = Fnv1a64Seed);
+
+	static uint64_t Fnv1a64(std::string_view str, uint64_t seed = Fnv1a64Seed)
+	{
+		return Fnv1a64(str.data(), str.size(), seed);
+	}
+
+	/**
+	 * CRC-32 as computed by zlib and PNG (reflected polynomial 0xEDB88320). The result of a
+	 * previous call can be passed as `crc` to hash several buffers as if they were a single one.
+	 *
+	 * Large buffers are folded with PCLMULQDQ when the CPU has it, everything else goes through
+	 * slice-by-8 tables.
+	 */
+	static uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
+
+	/**
+	 * Whether `Crc32` folds with PCLMULQDQ, which it does when the CPU has it. Turning it off
+	 * makes `Crc32` only use the tables, to compare or benchmark them; it can't be turned on if
+	 * the CPU doesn't have it.
+	 */
+	static bool IsCrc32ClmulEnabled();
+	static void SetCrc32ClmulEnabled(bool enabled);
+
+	/**
+	 * The CRC-32 variant ZAPD has always identified textures with, in texture pools and in the
+	 * files `outputCrc` writes. Its CRC was a signed integer, so shifting it right repeats bit 31
+	 * instead of clearing it; it only matches `Crc32` for data which never sets that bit.
+	 */
+	static uint32_t Crc32Signed(const void* data, size_t size, uint32_t crc = 0);
+};
@@ -0,0 +1,64 @@
+#include "MappedFile.h"
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const fs::path& path)
+{
+#ifndef _WIN32
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd >= 0)
+	{
+		struct stat st;
+		bool hasSize = fstat(fd, &st) == 0;
+
+		if (hasSize && st.st_size > 0)
+		{
+			void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (ptr != MAP_FAILED)
+			{
+				mapping = ptr;
+				mappingSize = st.st_size;
+			}
+		}
+		close(fd);
+
+		// Empty files can't be mapped, but there's nothing to read from them either
+		if (mapping != nullptr || (hasSize && st.st_size == 0))
+		{
+			data = ByteSpan(static_cast<const uint8_t*>(mapping), mappingSize);
+			return;
+		}
+	}
+#endif
+
+	std::ifstream file(path.string(), std::ios::in | std::ios::binary | std::ios::ate);
+	std::streamoff fileSize = file.tellg();
+
+	if (fileSize > 0)
+	{
+		file.seekg(0);
+		buffer.resize(fileSize);
+		file.read(reinterpret_cast<char*>(buffer.data()), fileSize);
+	}
+	data = ByteSpan(buffer);
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+	if (mapping != nullptr)
+		munmap(mapping, mappingSize);
+#endif
+}
+
+ByteSpan MappedFile::GetData() const
+{
+	return data;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ByteSpan.h"
+#include "Directory.h"
+
+/**
+ * Read-only view of the whole contents of a file.
+ *
+ * The file is mapped in memory, so its bytes are only read from disk when they are first accessed
+ * and are never copied. If the file can't be mapped, it's read into memory instead.
+ * The file must not be modified while it's open.
+ */
+class MappedFile
+{
+public:
+	explicit MappedFile(const fs::path& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	ByteSpan GetData() const;
+
+protected:
+	void* mapping = nullptr;
+	size_t mappingSize = 0;
+	// Contents of the file, if it couldn't be mapped
+	std::vector<uint8_t> buffer;
+	ByteSpan data;
+};
@@ -0,0 +1,167 @@
+#include "NumericEmitter.h"
+
+#include <algorithm>
+
+namespace
+{
+struct DigitTables
+{
+	// "00" to "FF" and "00" to "99", so digits are converted two at a time
+	char hexPairs[256][2] = {};
+	char decimalPairs[100][2] = {};
+
+	constexpr DigitTables()
+	{
+		const char hexDigits[] = "0123456789ABCDEF";
+
+		for (int i = 0; i < 256; i++)
+		{
+			hexPairs[i][0] = hexDigits[i >> 4];
+			hexPairs[i][1] = hexDigits[i & 0xF];
+		}
+		for (int i = 0; i < 100; i++)
+		{
+			decimalPairs[i][0] = '0' + i / 10;
+			decimalPairs[i][1] = '0' + i % 10;
+		}
+	}
+};
+
+constexpr DigitTables digitTables;
+
+int CountHexDigits(uint64_t value)
+{
+	int digits = 1;
+	while (value >>= 4)
+		digits++;
+	return digits;
+}
+
+int CountDecimalDigits(uint64_t value)
+{
+	int digits = 1;
+	for (; value >= 10000; value /= 10000)
+		digits += 4;
+	if (value >= 1000)
+		return digits + 3;
+	if (value >= 100)
+		return digits + 2;
+	if (value >= 10)
+		return digits + 1;
+	return digits;
+}
+
+// Writes the `digits` last digits of `value` backwards from `end`
+void WriteHexDigits(char* end, uint64_t value, int digits)
+{
+	for (; digits >= 2; digits -= 2, value >>= 8)
+	{
+		end -= 2;
+		memcpy(end, digitTables.hexPairs[value & 0xFF], 2);
+	}
+	if (digits == 1)
+		end[-1] = digitTables.hexPairs[value & 0xF][1];
+}
+
+void WriteDecimalDigits(char* end, uint64_t value)
+{
+	for (; value >= 100; value /= 100)
+	{
+		end -= 2;
+		memcpy(end, digitTables.decimalPairs[value % 100], 2);
+	}
+	if (value >= 10)
+		memcpy(end - 2, digitTables.decimalPairs[value], 2);
+	else
+		end[-1] = '0' + value;
+}
+
+char* WriteDecimalNumber(char* dst, uint64_t magnitude, bool negative, int width)
+{
+	int digits = CountDecimalDigits(magnitude);
+	int length = digits + (negative ? 1 : 0);
+
+	for (; width > length; width--)
+		*dst++ = ' ';
+	if (negative)
+		*dst++ = '-';
+
+	WriteDecimalDigits(dst + digits, magnitude);
+	return dst + digits;
+}
+}  // namespace
+
+void NumericEmitter::Hex(uint64_t value, int digits)
+{
+	char* dst = Reserve(std::max(digits, 0) + maxNumberLength);
+	Commit(WriteHex(dst, value, digits));
+}
+
+void NumericEmitter::Decimal(int64_t value, int width)
+{
+	char* dst = Reserve(std::max(width, 0) + maxNumberLength);
+	Commit(WriteDecimal(dst, value, width));
+}
+
+void NumericEmitter::UnsignedDecimal(uint64_t value, int width)
+{
+	char* dst = Reserve(std::max(width, 0) + maxNumberLength);
+	Commit(WriteUnsignedDecimal(dst, value, width));
+}
+
+void NumericEmitter::OffsetComment(uint32_t offset)
+{
+	Commit(WriteOffsetComment(Reserve(offsetCommentLength), offset));
+}
+
+char* NumericEmitter::WriteHex(char* dst, uint64_t value, int digits)
+{
+	digits = std::max(digits, CountHexDigits(value));
+
+	*dst++ = '0';
+	*dst++ = 'x';
+	if (digits > 16)
+	{
+		memset(dst, '0', digits - 16);
+		dst += digits - 16;
+		digits = 16;
+	}
+
+	WriteHexDigits(dst + digits, value, digits);
+	return dst + digits;
+}
+
+char* NumericEmitter::WriteDecimal(char* dst, int64_t value, int width)
+{
+	bool negative = value < 0;
+	uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value) : value;
+
+	return WriteDecimalNumber(dst, magnitude, negative, width);
+}
+
+char* NumericEmitter::WriteUnsignedDecimal(char* dst, uint64_t value, int width)
+{
+	return WriteDecimalNumber(dst, value, false, width);
+}
+
+char* NumericEmitter::WriteOffsetComment(char* dst, uint32_t offset)
+{
+	memcpy(dst, " // 0x", 6);
+	dst += 6;
+
+	int digits = std::max(6, CountHexDigits(offset));
+	WriteHexDigits(dst + digits, offset, digits);
+	return dst + digits;
+}
+
+char* NumericEmitter::Reserve(size_t length)
+{
+	size_t oldSize = output.size();
+	output.resize(oldSize + length);
+	return &output[oldSize];
+}
+
+void NumericEmitter::Commit(const char* end)
+{
+	output.resize(end - output.data());
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "ByteSpan.h"
+
+/**
+ * How `NumericEmitter` lays out the elements of an array.
+ *
+ * Every element is followed by `", "`. Lines are `perLine` elements long, start with `lineStart`
+ * and full lines end with `lineEnd`.
+ */
+struct NumericArrayLayout
+{
+	enum class Format
+	{
+		Hex,        // 0x%0*X
+		SignedHex,  // 0x%0*X, or -0x%0*X for negative values
+		Decimal,    // %*i
+	};
+
+	Format format = Format::Hex;
+	// Minimum number of digits for hex formats, minimum width (padded with spaces) for decimal
+	int width = 0;
+
+	size_t perLine = 16;
+	const char* lineStart = "";
+	const char* lineEnd = "\n";
+	// If false, `lineEnd` is only written between lines, not after the last element
+	bool endLastLine = true;
+
+	// Comments each full line with ` // 0x%06X`, the offset of its first element from
+	// `baseOffset`, before `lineEnd`
+	bool offsetComments = false;
+	uint32_t baseOffset = 0;
+};
+
+/**
+ * Appends numbers, and arrays of numbers, formatted like C literals to a string.
+ *
+ * This replaces `StringHelper::Sprintf` where generated sources dump lots of numbers (textures,
+ * blobs, animation data...): digits are converted with lookup tables, and arrays are written in
+ * place into the string after growing it once, so there is no allocation or temporary string per
+ * number. The output matches the `printf` format each function documents.
+ */
+class NumericEmitter
+{
+public:
+	explicit NumericEmitter(std::string& nOutput) : output(nOutput) {}
+
+	// 0x%0*llX
+	void Hex(uint64_t value, int digits = 0);
+	// %*lli
+	void Decimal(int64_t value, int width = 0);
+	// %*llu
+	void UnsignedDecimal(uint64_t value, int width = 0);
+	// " // 0x%06X"
+	void OffsetComment(uint32_t offset);
+
+	template <typename T>
+	void Array(const T* values, size_t count, const NumericArrayLayout& layout)
+	{
+		WriteArray<T>(count, layout, [values](size_t i) { return values[i]; });
+	}
+
+	/**
+	 * Writes the big-endian values of type `T` stored in `data`. Trailing bytes that don't make a
+	 * whole value are ignored.
+	 */
+	template <typename T>
+	void ArrayBE(ByteSpan data, const NumericArrayLayout& layout)
+	{
+		const uint8_t* bytes = data.data();
+
+		WriteArray<T>(data.size() / sizeof(T), layout, [bytes](size_t i) {
+			std::make_unsigned_t<T> value = 0;
+			for (size_t b = 0; b < sizeof(T); b++)
+				value = (value << 8) | bytes[i * sizeof(T) + b];
+			return static_cast<T>(value);
+		});
+	}
+
+	/**
+	 * The functions below write to `dst`, which must have enough room, and return the end of what
+	 * they wrote.
+	 */
+	static char* WriteHex(char* dst, uint64_t value, int digits);
+	static char* WriteDecimal(char* dst, int64_t value, int width);
+	static char* WriteUnsignedDecimal(char* dst, uint64_t value, int width);
+	static char* WriteOffsetComment(char* dst, uint32_t offset);
+
+	// Longest number the functions above write, without padding
+	static constexpr size_t maxNumberLength = 20;
+	static constexpr size_t offsetCommentLength = 14;
+
+protected:
+	std::string& output;
+
+	/**
+	 * Grows the output by `length` characters, to be written at the returned pointer. `Commit`
+	 * then trims it to the end of what was written.
+	 */
+	char* Reserve(size_t length);
+	void Commit(const char* end);
+
+	template <typename T, typename Load>
+	void WriteArray(size_t count, const NumericArrayLayout& layout, Load load)
+	{
+		if (count == 0)
+			return;
+
+		size_t perLine = layout.perLine != 0 ? layout.perLine : count;
+		size_t lineStartLen = strlen(layout.lineStart);
+		size_t lineEndLen = strlen(layout.lineEnd);
+		size_t width = layout.width > 0 ? layout.width : 0;
+		size_t numLines = (count + perLine - 1) / perLine;
+
+		size_t maxLength = count * (width + maxNumberLength + 2) +
+		                   numLines * (lineStartLen + lineEndLen + offsetCommentLength);
+
+		char* dst = Reserve(maxLength);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			size_t column = i % perLine;
+
+			if (column == 0)
+			{
+				memcpy(dst, layout.lineStart, lineStartLen);
+				dst += lineStartLen;
+			}
+
+			T value = load(i);
+
+			switch (layout.format)
+			{
+			case NumericArrayLayout::Format::Decimal:
+				if constexpr (std::is_signed_v<T>)
+					dst = WriteDecimal(dst, value, layout.width);
+				else
+					dst = WriteUnsignedDecimal(dst, value, layout.width);
+				break;
+
+			case NumericArrayLayout::Format::SignedHex:
+				if constexpr (std::is_signed_v<T>)
+				{
+					if (value < 0)
+					{
+						*dst++ = '-';
+						dst = WriteHex(dst, 0 - static_cast<uint64_t>(value), layout.width);
+						break;
+					}
+				}
+				[[fallthrough]];
+
+			case NumericArrayLayout::Format::Hex:
+				dst = WriteHex(dst, static_cast<std::make_unsigned_t<T>>(value), layout.width);
+				break;
+			}
+
+			*dst++ = ',';
+			*dst++ = ' ';
+
+			if (column == perLine - 1)
+			{
+				if (layout.offsetComments)
+					dst = WriteOffsetComment(dst, layout.baseOffset + (i - column) * sizeof(T));
+
+				if (layout.endLastLine || i + 1 < count)
+				{
+					memcpy(dst, layout.lineEnd, lineEndLen);
+					dst += lineEndLen;
+				}
+			}
+		}
+
+		Commit(dst);
+	}
+};
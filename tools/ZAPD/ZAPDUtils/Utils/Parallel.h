@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Parallel
+{
+public:
+	/**
+	 * Returns the number of worker threads to use when the user didn't request a specific amount.
+	 */
+	static uint32_t GetDefaultThreadCount()
+	{
+		uint32_t count = std::thread::hardware_concurrency();
+
+		return count == 0 ? 1 : count;
+	}
+
+	/**
+	 * Calls `func(i)` for every `i` in `[0, count)` using up to `numThreads` worker threads.
+	 * Work items are handed out one at a time, so uneven item costs are balanced automatically.
+	 * If `numThreads` is 0, `GetDefaultThreadCount()` threads are used.
+	 *
+	 * If any call throws, the remaining items are still processed and the first exception is
+	 * rethrown on the calling thread once every worker has finished.
+	 */
+	static void For(size_t count, uint32_t numThreads, const std::function<void(size_t)>& func)
+	{
+		if (numThreads == 0)
+			numThreads = GetDefaultThreadCount();
+		numThreads = static_cast<uint32_t>(std::min<size_t>(numThreads, count));
+
+		if (numThreads <= 1)
+		{
+			for (size_t i = 0; i < count; i++)
+				func(i);
+			return;
+		}
+
+		std::atomic<size_t> next = 0;
+		std::exception_ptr firstException = nullptr;
+		std::mutex exceptionMutex;
+
+		auto worker = [&]() {
+			for (size_t i = next++; i < count; i = next++)
+			{
+				try
+				{
+					func(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(exceptionMutex);
+					if (firstException == nullptr)
+						firstException = std::current_exception();
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(numThreads - 1);
+		for (uint32_t t = 1; t < numThreads; t++)
+			threads.emplace_back(worker);
+
+		worker();
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		if (firstException != nullptr)
+			std::rethrow_exception(firstException);
+	}
+};
@@ -0,0 +1,245 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+struct ScopeRecord
+{
+	const char* phase;
+	const char* category;
+	std::string detail;
+	int64_t start;
+	int64_t duration;
+	int64_t selfTime;
+};
+
+// Each thread records its scopes on its own, they are only gathered by the summary and the trace
+struct ThreadRecords
+{
+	size_t threadIndex;
+	std::vector<ScopeRecord> records;
+};
+
+std::chrono::steady_clock::time_point sStartTime;
+std::vector<std::unique_ptr<ThreadRecords>> sThreads;
+std::mutex sThreadsMutex;
+
+thread_local ThreadRecords* tRecords = nullptr;
+thread_local ProfileScope* tCurrentScope = nullptr;
+
+int64_t GetTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+	                                                            sStartTime)
+		.count();
+}
+
+ThreadRecords& GetThreadRecords()
+{
+	if (tRecords == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(sThreadsMutex);
+		sThreads.push_back(std::make_unique<ThreadRecords>());
+		tRecords = sThreads.back().get();
+		tRecords->threadIndex = sThreads.size() - 1;
+	}
+
+	return *tRecords;
+}
+
+double ToMs(int64_t ns)
+{
+	return ns / 1e6;
+}
+
+double ToPercent(int64_t part, int64_t total)
+{
+	return total > 0 ? 100.0 * part / total : 0.0;
+}
+
+void WriteJsonString(FILE* file, std::string_view str)
+{
+	fputc('"', file);
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+			fprintf(file, "\\%c", c);
+		else if (static_cast<unsigned char>(c) < 0x20)
+			fprintf(file, "\\u%04X", c);
+		else
+			fputc(c, file);
+	}
+	fputc('"', file);
+}
+}  // namespace
+
+bool Profiler::enabled = false;
+
+void Profiler::Enable()
+{
+	sStartTime = std::chrono::steady_clock::now();
+	enabled = true;
+}
+
+void Profiler::PrintSummary(const char* countPhase, const char* detailPhase)
+{
+	struct Totals
+	{
+		size_t calls = 0;
+		int64_t totalTime = 0;
+		int64_t selfTime = 0;
+	};
+
+	std::map<std::string_view, Totals> phases;
+	std::map<std::string_view, Totals> categories;
+	std::vector<const ScopeRecord*> details;
+	int64_t profiledTime = 0;
+	int64_t wallTime = GetTime();
+
+	std::lock_guard<std::mutex> lock(sThreadsMutex);
+
+	for (const auto& thread : sThreads)
+	{
+		for (const ScopeRecord& record : thread->records)
+		{
+			Totals& phase = phases[record.phase];
+			phase.calls++;
+			phase.totalTime += record.duration;
+			phase.selfTime += record.selfTime;
+			profiledTime += record.selfTime;
+
+			if (record.category != nullptr)
+			{
+				Totals& category = categories[record.category];
+				if (std::string_view(record.phase) == countPhase)
+					category.calls++;
+				category.selfTime += record.selfTime;
+			}
+
+			if (std::string_view(record.phase) == detailPhase)
+				details.push_back(&record);
+		}
+	}
+
+	auto bySelfTime = [](const auto& a, const auto& b) {
+		return a.second.selfTime > b.second.selfTime;
+	};
+	std::vector<std::pair<std::string_view, Totals>> sortedPhases(phases.begin(), phases.end());
+	std::vector<std::pair<std::string_view, Totals>> sortedCategories(categories.begin(),
+	                                                                  categories.end());
+	std::sort(sortedPhases.begin(), sortedPhases.end(), bySelfTime);
+	std::sort(sortedCategories.begin(), sortedCategories.end(), bySelfTime);
+	std::sort(details.begin(), details.end(),
+	          [](const ScopeRecord* a, const ScopeRecord* b) { return a->duration > b->duration; });
+
+	printf("\nProfile: %.1f ms wall time, %.1f ms in profiled scopes over %zu thread(s)\n\n",
+	       ToMs(wallTime), ToMs(profiledTime), sThreads.size());
+
+	printf("%-24s %10s %12s %12s %7s\n", "Phase", "Calls", "Total ms", "Self ms", "Self %");
+	for (const auto& [name, totals] : sortedPhases)
+	{
+		printf("%-24.*s %10zu %12.2f %12.2f %6.1f%%\n", static_cast<int>(name.size()),
+		       name.data(), totals.calls, ToMs(totals.totalTime), ToMs(totals.selfTime),
+		       ToPercent(totals.selfTime, profiledTime));
+	}
+
+	if (!sortedCategories.empty())
+	{
+		printf("\n%-24s %10s %12s %7s\n", "Resource type", "Count", "Self ms", "Self %");
+		for (const auto& [name, totals] : sortedCategories)
+		{
+			printf("%-24.*s %10zu %12.2f %6.1f%%\n", static_cast<int>(name.size()), name.data(),
+			       totals.calls, ToMs(totals.selfTime), ToPercent(totals.selfTime, profiledTime));
+		}
+	}
+
+	if (!details.empty())
+	{
+		const size_t maxDetails = 10;
+
+		printf("\nSlowest %s (%zu of %zu)\n", detailPhase, std::min(details.size(), maxDetails),
+		       details.size());
+		for (size_t i = 0; i < details.size() && i < maxDetails; i++)
+			printf("%12.2f ms  %s\n", ToMs(details[i]->duration), details[i]->detail.c_str());
+	}
+
+	printf("\n");
+}
+
+bool Profiler::WriteTrace(const fs::path& path)
+{
+	FILE* file = fopen(path.string().c_str(), "w");
+	if (file == nullptr)
+		return false;
+
+	std::lock_guard<std::mutex> lock(sThreadsMutex);
+
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(file,
+	        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"ZAPD\"}}");
+
+	for (const auto& thread : sThreads)
+	{
+		fprintf(file,
+		        ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+		        "\"args\":{\"name\":\"Thread %zu\"}}",
+		        thread->threadIndex, thread->threadIndex);
+
+		for (const ScopeRecord& record : thread->records)
+		{
+			// Timestamps are in microseconds
+			fprintf(file, ",\n{\"name\":");
+			WriteJsonString(file, record.phase);
+			fprintf(file, ",\"cat\":");
+			WriteJsonString(file, record.category != nullptr ? record.category : "ZAPD");
+			fprintf(file,
+			        ",\"ph\":\"X\",\"ts\":%" PRIi64 ".%03" PRIi64 ",\"dur\":%" PRIi64
+			        ".%03" PRIi64 ",\"pid\":1,\"tid\":%zu",
+			        record.start / 1000, record.start % 1000, record.duration / 1000,
+			        record.duration % 1000, thread->threadIndex);
+
+			if (!record.detail.empty())
+			{
+				fprintf(file, ",\"args\":{\"detail\":");
+				WriteJsonString(file, record.detail);
+				fprintf(file, "}");
+			}
+			fprintf(file, "}");
+		}
+	}
+
+	fprintf(file, "\n]}\n");
+
+	bool success = ferror(file) == 0;
+	return fclose(file) == 0 && success;
+}
+
+void ProfileScope::Begin(const char* nPhase, const char* nCategory, std::string_view nDetail)
+{
+	phase = nPhase;
+	category = nCategory;
+	detail = nDetail;
+	parent = tCurrentScope;
+	tCurrentScope = this;
+	start = GetTime();
+}
+
+void ProfileScope::End()
+{
+	int64_t duration = GetTime() - start;
+
+	if (parent != nullptr)
+		parent->childTime += duration;
+	tCurrentScope = parent;
+
+	GetThreadRecords().records.push_back(
+		{phase, category, std::move(detail), start, duration, duration - childTime});
+}
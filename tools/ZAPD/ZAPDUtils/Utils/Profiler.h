@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Directory.h"
+
+/**
+ * Measures how long the phases of a run take, from `ProfileScope`s placed around them.
+ *
+ * Nothing is recorded until `Enable` is called, and a disabled scope only checks a flag. Every
+ * scope is kept, so `PrintSummary` can break the time down by phase, by category and by detail,
+ * and `WriteTrace` can save the whole timeline for `chrome://tracing` or Perfetto.
+ *
+ * Scopes can be nested, and used from several threads at once. The time spent in a scope minus
+ * the time spent in the scopes nested in it on the same thread is its self time, so the self
+ * times of every scope add up to the time the threads spent in scopes.
+ */
+class Profiler
+{
+public:
+	/**
+	 * Starts recording. Must be called before any scope starts, and before any other thread is
+	 * created.
+	 */
+	static void Enable();
+	static bool IsEnabled() { return enabled; }
+
+	/**
+	 * Prints, to stdout, the calls, total and self time of every phase, the self time of every
+	 * category and the details with the longest scopes of `detailPhase`.
+	 * `countPhase` is the phase whose calls are the count of each category.
+	 */
+	static void PrintSummary(const char* countPhase, const char* detailPhase);
+
+	/**
+	 * Writes every scope as a complete event of the Chrome trace event format. Returns false if
+	 * the file couldn't be written.
+	 */
+	static bool WriteTrace(const fs::path& path);
+
+protected:
+	static bool enabled;
+};
+
+class ProfileScope
+{
+public:
+	/**
+	 * Measures the time until this scope is destroyed as a call to `phase`. `category` (the type
+	 * of resource being processed, for example) and `detail` (its name) are optional.
+	 * `phase` and `category` must be string literals or otherwise outlive the profiler.
+	 */
+	explicit ProfileScope(const char* nPhase, const char* nCategory = nullptr,
+	                      std::string_view nDetail = {})
+	{
+		if (Profiler::IsEnabled())
+			Begin(nPhase, nCategory, nDetail);
+	}
+
+	/**
+	 * Like the above, with a path as the detail. It's only converted to a string while profiling,
+	 * so a disabled scope doesn't allocate anything.
+	 */
+	template <typename Path, std::enable_if_t<std::is_same_v<Path, fs::path>, int> = 0>
+	ProfileScope(const char* nPhase, const char* nCategory, const Path& nDetail)
+	{
+		if (Profiler::IsEnabled())
+			Begin(nPhase, nCategory, nDetail.string());
+	}
+
+	~ProfileScope()
+	{
+		if (phase != nullptr)
+			End();
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+protected:
+	const char* phase = nullptr;
+	const char* category = nullptr;
+	std::string detail;
+	int64_t start = 0;        // ns since `Profiler::Enable`
+	int64_t childTime = 0;    // ns spent in the scopes nested in this one
+	ProfileScope* parent = nullptr;
+
+	void Begin(const char* nPhase, const char* nCategory, std::string_view nDetail);
+	void End();
+};
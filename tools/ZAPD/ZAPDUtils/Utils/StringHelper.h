@@ -2,11 +2,18 @@
 
 #include <algorithm>
 #include <cstdarg>
+#include <cstdio>
 #include <cstring>
 #include <numeric>
 #include <string>
 #include <vector>
 
+#if defined(__GNUC__) || defined(__clang__)
+#define ATTRIBUTE_PRINTF(fmt, firstArg) __attribute__((format(printf, fmt, firstArg)))
+#else
+#define ATTRIBUTE_PRINTF(fmt, firstArg)
+#endif
+
 class StringHelper
 {
 public:
@@ -86,21 +93,59 @@ public:
 		return s.rfind(input) == (s.size() - inputLen);
 	}
 
-	static std::string Sprintf(const char* format, ...)
+	/**
+	 * Formats like `printf`, with no limit on the length of the result.
+	 */
+	ATTRIBUTE_PRINTF(1, 2) static std::string Sprintf(const char* format, ...)
 	{
-		char buffer[32768];
-		// char buffer[2048];
 		std::string output;
 		va_list va;
 
 		va_start(va, format);
-		vsprintf(buffer, format, va);
+		AppendFormatV(output, format, va);
 		va_end(va);
 
-		output = buffer;
 		return output;
 	}
 
+	/**
+	 * Formats like `printf` at the end of `output`. Prefer this to `output += Sprintf(...)` when
+	 * building large strings, which would format into a temporary string first.
+	 */
+	ATTRIBUTE_PRINTF(2, 3) static void AppendFormat(std::string& output, const char* format, ...)
+	{
+		va_list va;
+
+		va_start(va, format);
+		AppendFormatV(output, format, va);
+		va_end(va);
+	}
+
+	static void AppendFormatV(std::string& output, const char* format, va_list va)
+	{
+		// Most results are short, so they're formatted on the stack and only formatted again
+		// straight into `output` when they don't fit
+		char buffer[512];
+		va_list vaCopy;
+
+		va_copy(vaCopy, va);
+		int length = vsnprintf(buffer, sizeof(buffer), format, va);
+
+		if (length >= 0 && static_cast<size_t>(length) < sizeof(buffer))
+		{
+			output.append(buffer, length);
+		}
+		else if (length >= 0)
+		{
+			size_t oldSize = output.size();
+
+			output.resize(oldSize + length);
+			vsnprintf(&output[oldSize], length + 1, format, vaCopy);
+		}
+
+		va_end(vaCopy);
+	}
+
 	static std::string Implode(std::vector<std::string>& elements, const char* const separator)
 	{
 		return std::accumulate(std::begin(elements), std::end(elements), std::string(),
@@ -482,6 +482,8 @@ class GlobalAsmBlock:
         self.fn_ins_inds = []
         self.glued_line = ''
         self.num_lines = 0
+        # Files included with .incbin, as written, for the dependency file
+        self.incbin_files = []
 
     def fail(self, message, line=None):
         context = self.fn_desc
@@ -595,6 +597,7 @@ class GlobalAsmBlock:
             self.late_rodata_alignment = value
             changed_section = True
         elif line.startswith('.incbin'):
+            self.incbin_files.append(line[len('.incbin'):].split(',')[0].strip().strip('"'))
             self.add_sized(int(line.split(',')[-1].strip(), 0), real_line)
         elif line.startswith('.word') or line.startswith('.float'):
             self.align4()
@@ -859,6 +862,7 @@ def parse_source(f, opt, framepointer, mips1, input_enc, output_enc, out_depende
                 for i, line2 in enumerate(src):
                     output_lines[start_index + i] = line2
                 asm_functions.append(fn)
+                out_dependencies.extend(global_asm.incbin_files)
                 global_asm = None
             else:
                 global_asm.process_line(raw_line, output_enc)
@@ -876,6 +880,7 @@ def parse_source(f, opt, framepointer, mips1, input_enc, output_enc, out_depende
             src, fn = global_asm.finish(state)
             output_lines[-1] = ''.join(src)
             asm_functions.append(fn)
+            out_dependencies.extend(global_asm.incbin_files)
             global_asm = None
         elif line == '#pragma asmproc recurse':
             # C includes qualified as
@@ -101,6 +101,21 @@ with tempfile.TemporaryDirectory(prefix="asm_processor") as tmpdirname:
         functions=functions,
     )
 
+    # The files included with .incbin are found like the assembler does: as written, or else in
+    # one of its include directories
+    include_dirs = [arg[2:] for arg in assembler_args if arg.startswith("-I") and len(arg) > 2]
+
+    def resolve_dep(dep):
+        if Path(dep).exists():
+            return dep
+        for include_dir in include_dirs:
+            path = Path(include_dir) / dep
+            if path.exists():
+                return str(path)
+        return dep
+
+    deps = [resolve_dep(dep) for dep in deps]
+
     deps_file = out_file.with_suffix(".asmproc.d")
     if deps:
         with deps_file.open("w") as f: